@@ -20,6 +20,7 @@ struct EnemyTypeConfig {
   float attack_exit_radius =
       40.0f;  // 退出攻击状态的距离阈值（像素，需 >= enter）
   float attack_interval_seconds = 0.8f;  // 近战攻击间隔（秒）
+  uint32_t spawn_weight = 1;  // 随机刷怪权重（0 表示不参与随机刷怪）
 };
 
 struct EnemyTypesConfig {
@@ -31,6 +31,23 @@ struct ServerConfig {
   uint32_t max_enemies_alive = 256;         // 同时存活敌人上限
   uint32_t max_enemy_spawn_per_tick = 4;    // 单 tick 最大刷怪数量（防止卡顿）
   uint32_t max_enemy_replan_per_tick = 16;  // 单 tick 最大寻路重算次数
+  uint32_t path_planner_threads = 2;  // 异步寻路线程数（0 表示 tick 内同步寻路）
+  uint32_t projectile_hit_threads =
+      2;  // 射弹命中检测的并行 worker 数（0 表示串行；射弹较少时也串行）
+  uint32_t path_cache_capacity = 256;  // 场景路径缓存条目数（LRU）
+  uint32_t enemy_reorder_interval_ticks =
+      0;  // 敌人存储按 Morton 序重排的间隔（tick，0 表示不重排）
+  // 敌人模拟 LOD：按到最近玩家的距离降频更新远处敌人
+  // 敌人模拟 LOD 默认关闭（会改变敌人步进与寻路节奏），由运维按需开启
+  float enemy_lod_mid_distance = 0.0f;  // 中档起始距离（像素，0 表示关闭）
+  float enemy_lod_far_distance = 0.0f;  // 远档起始距离（像素，0 表示无远档）
+  uint32_t enemy_lod_mid_interval = 2;  // 中档每隔几 tick 更新一次
+  uint32_t enemy_lod_far_interval = 4;  // 远档每隔几 tick 更新一次
+  // 确定性回放（固定种子 + 固定步长 + 寻路结果按提交顺序在下一帧应用）
+  uint32_t rng_seed = 0;              // 场景随机种子（0 表示按时间生成）
+  bool deterministic_replay = false;  // 是否开启确定性回放模式
+  // 固定步长：累积墙钟时间，每次唤醒按 1/tick_rate 补跑若干步（0 表示变步长）
+  uint32_t max_substeps_per_tick = 4;
   // 射弹/战斗参数（用于快速调参，不用重新编译）
   float projectile_speed = 420.0f;         // 射弹速度（像素/秒）
   float projectile_radius = 6.0f;          // 射弹碰撞半径（像素）
@@ -45,6 +62,14 @@ struct ServerConfig {
   float reconnect_grace_seconds = 15.0f;      // 断线重连宽限期（秒）
   uint32_t perf_sample_stride = 1;            // 性能采样步长（每 N 帧记录一条）
   uint32_t tcp_packet_debug_log_stride = 60;  // TCP包debug日志步长
+  // 定点坐标增量（仅对协商了 QUANTIZED_POSITIONS 的客户端生效）
+  uint32_t delta_position_scale = 8;  // 每像素定点单位数（8 即 1/8 像素）
+  uint32_t delta_rotation_bits = 10;  // 朝向位数（8~10）
+  // 兴趣区域（仅对协商了 INTEREST_FILTER 的客户端生效）：视野 + 余量内的
+  // 敌人进入，超出视野 + 2 倍余量才移出
+  float aoi_view_half_width = 640.0f;   // 视野矩形半宽（像素）
+  float aoi_view_half_height = 360.0f;  // 视野矩形半高（像素）
+  float aoi_margin = 128.0f;            // 视野外扩余量（像素）
   std::string log_level = "info";
 };
 
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+// 存活数聚合：出生 / 死亡 / 离开时增量维护，刷怪预算与结算判定直接读取。
+// 按类型 / 波次的计数归零时删除条目，表大小只随当前存活的类型与波次变化。
+// 减到 0 以下时钳制为 0（重复扣减不会回绕）。
+struct AliveCounters {
+  uint32_t players = 0;                                    // 存活玩家数
+  uint32_t enemies = 0;                                    // 存活敌人数
+  std::unordered_map<uint32_t, uint32_t> enemies_by_type;  // type_id -> 存活数
+  std::unordered_map<uint32_t, uint32_t> enemies_by_wave;  // wave_id -> 存活数
+
+  bool operator==(const AliveCounters&) const = default;
+
+  // 玩家出生 / 死亡 / 离开场景时调用（delta 为 +1 / -1）
+  void AddPlayers(int32_t delta) { players = AddClamped(players, delta); }
+
+  // 敌人出生 / 死亡时调用；死亡敌人回收时已不计入，无需再调用
+  void AddEnemies(uint32_t type_id, uint32_t wave_id, int32_t delta) {
+    enemies = AddClamped(enemies, delta);
+    AddKeyed(&enemies_by_type, type_id, delta);
+    AddKeyed(&enemies_by_wave, wave_id, delta);
+  }
+
+ private:
+  static uint32_t AddClamped(uint32_t value, int32_t delta) {
+    const int64_t next = static_cast<int64_t>(value) + delta;
+    return next > 0 ? static_cast<uint32_t>(next) : 0u;
+  }
+
+  // 按键增减计数，归零时删除条目
+  static void AddKeyed(std::unordered_map<uint32_t, uint32_t>* counts,
+                       uint32_t key, int32_t delta) {
+    if (counts == nullptr || delta == 0) {
+      return;
+    }
+    auto& count = (*counts)[key];
+    count = AddClamped(count, delta);
+    if (count == 0) {
+      counts->erase(key);
+    }
+  }
+};
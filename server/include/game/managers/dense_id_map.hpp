@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// id -> 值 的稠密存储：值连续存放在 vector 中，另有 id -> 槽位 映射。
+// 接口与 unordered_map 的常用子集一致（find/emplace/erase/遍历，元素为
+// pair<id, 值>），遍历按槽位顺序进行，可通过 SortByKey 重排以改善局部性。
+// 注意：emplace / erase / SortByKey 会移动元素，之前取得的指针与迭代器失效。
+template <typename T>
+class DenseIdMap {
+ public:
+  using value_type = std::pair<uint32_t, T>;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  iterator begin() { return slots_.begin(); }
+  iterator end() { return slots_.end(); }
+  const_iterator begin() const { return slots_.begin(); }
+  const_iterator end() const { return slots_.end(); }
+
+  std::size_t size() const { return slots_.size(); }
+  bool empty() const { return slots_.empty(); }
+
+  void reserve(std::size_t count) {
+    slots_.reserve(count);
+    slot_of_.reserve(count);
+  }
+
+  void clear() {
+    slots_.clear();
+    slot_of_.clear();
+  }
+
+  iterator find(uint32_t id) {
+    const auto it = slot_of_.find(id);
+    return it == slot_of_.end() ? slots_.end() : slots_.begin() + it->second;
+  }
+  const_iterator find(uint32_t id) const {
+    const auto it = slot_of_.find(id);
+    return it == slot_of_.end() ? slots_.end() : slots_.begin() + it->second;
+  }
+
+  std::pair<iterator, bool> emplace(uint32_t id, T&& value) {
+    const auto [it, inserted] =
+        slot_of_.emplace(id, static_cast<uint32_t>(slots_.size()));
+    if (!inserted) {
+      return {slots_.begin() + it->second, false};
+    }
+    slots_.emplace_back(id, std::move(value));
+    return {slots_.end() - 1, true};
+  }
+
+  // 末尾元素搬入被删槽位（swap-and-pop），返回指向同一槽位的迭代器，
+  // 因此 `it = erase(it)` 的遍历写法不会漏掉元素。
+  iterator erase(iterator pos) {
+    const std::size_t slot = static_cast<std::size_t>(pos - slots_.begin());
+    slot_of_.erase(pos->first);
+    const std::size_t last = slots_.size() - 1;
+    if (slot != last) {
+      slots_[slot] = std::move(slots_[last]);
+      slot_of_[slots_[slot].first] = static_cast<uint32_t>(slot);
+    }
+    slots_.pop_back();
+    return slots_.begin() + static_cast<std::ptrdiff_t>(slot);
+  }
+
+  // 按 key_fn(id, 值) 返回的 uint64 升序重排槽位，并修正 id -> 槽位 映射。
+  // 键相同时保持原槽位顺序；暂存缓冲跨调用复用。
+  template <typename KeyFn>
+  void SortByKey(KeyFn&& key_fn) {
+    order_.resize(slots_.size());
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+      order_[i] = {key_fn(slots_[i].first, slots_[i].second),
+                   static_cast<uint32_t>(i)};
+    }
+    if (std::is_sorted(order_.begin(), order_.end())) {
+      return;  // 已有序时不搬动元素
+    }
+    std::sort(order_.begin(), order_.end());
+    spare_.clear();
+    spare_.reserve(slots_.capacity());
+    for (const auto& [_, slot] : order_) {
+      spare_.push_back(std::move(slots_[slot]));
+    }
+    slots_.swap(spare_);
+    spare_.clear();
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+      slot_of_[slots_[i].first] = static_cast<uint32_t>(i);
+    }
+  }
+
+ private:
+  std::vector<value_type> slots_;
+  std::unordered_map<uint32_t, uint32_t> slot_of_;
+  std::vector<std::pair<uint64_t, uint32_t>> order_;  // SortByKey 暂存
+  std::vector<value_type> spare_;                     // SortByKey 暂存
+};
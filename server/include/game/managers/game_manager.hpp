@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <asio/steady_timer.hpp>
 #include <chrono>
 #include <cstdint>
@@ -17,11 +18,47 @@
 #include "config/player_roles_config.hpp"
 #include "config/server_config.hpp"
 #include "config/upgrade_config.hpp"
+#include "game/managers/alive_counters.hpp"
+#include "game/managers/dense_id_map.hpp"
 #include "message.pb.h"
+#include "network/delta_wire.hpp"
 
 // 游戏管理器：负责场景初始化、玩家状态更新与同步
 class UdpServer;
 class TcpSession;
+namespace game_manager_nav {
+struct NavScratch;
+}  // namespace game_manager_nav
+namespace game_manager_path_cache {
+struct PathRef;
+class PathCache;
+}  // namespace game_manager_path_cache
+namespace game_manager_spatial {
+class SpatialIndex;
+}  // namespace game_manager_spatial
+namespace game_manager_steering {
+struct SteeringBatch;
+}  // namespace game_manager_steering
+namespace game_manager_sleep {
+class TickWheel;
+class SleepGrid;
+}  // namespace game_manager_sleep
+namespace game_manager_alias {
+class AliasTable;
+}  // namespace game_manager_alias
+namespace game_manager_parallel {
+class ParallelForPool;
+}  // namespace game_manager_parallel
+namespace game_manager_rng {
+class RngStream;
+}  // namespace game_manager_rng
+namespace game_manager_path_planner {
+class PathPlanChannel;
+class PathPlannerPool;
+}  // namespace game_manager_path_planner
+namespace game_manager_snapshot {
+class SnapshotRing;
+}  // namespace game_manager_snapshot
 
 class GameManager {
  public:
@@ -56,16 +93,17 @@ class GameManager {
   // 注册 UDP 服务（用于高频同步）
   void SetUdpServer(UdpServer* udp);
   [[nodiscard]] UdpServer* GetUdpServer() const { return udp_server_; }
+  // 释放玩家的 UDP 可靠通道；session 非空时先经 TCP 补发未确认的消息
+  void ReleaseReliableChannel(uint32_t player_id,
+                              const std::shared_ptr<TcpSession>& session);
   [[nodiscard]] asio::io_context* GetIoContext() const { return io_context_; }
   void SetConfig(const ServerConfig& cfg) { config_ = cfg; }
   void SetPlayerRolesConfig(const PlayerRolesConfig& cfg) {
     player_roles_config_ = cfg;
   }
-  void SetEnemyTypesConfig(const EnemyTypesConfig& cfg) {
-    enemy_types_config_ = cfg;
-  }
-  void SetItemsConfig(const ItemsConfig& cfg) { items_config_ = cfg; }
-  void SetUpgradeConfig(const UpgradeConfig& cfg) { upgrade_config_ = cfg; }
+  void SetEnemyTypesConfig(const EnemyTypesConfig& cfg);
+  void SetItemsConfig(const ItemsConfig& cfg);
+  void SetUpgradeConfig(const UpgradeConfig& cfg);
 
   // 在游戏开始后为房间启动固定逻辑帧循环与状态同步
   void StartGameLoop(uint32_t room_id);
@@ -101,10 +139,12 @@ class GameManager {
   [[nodiscard]] bool TryReconnectPlayer(uint32_t player_id, uint32_t room_id,
                                         uint32_t last_input_seq,
                                         uint32_t last_server_tick,
+                                        bool quantized_positions,
+                                        bool interest_filter,
                                         ReconnectSnapshot* out);
 
  private:
-  GameManager() = default;
+  GameManager();
 
   // clang-format off
 #include "game/managers/internal/game_manager_private_types.inc"
@@ -4,6 +4,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -60,9 +61,13 @@ class RoomManager {
   // 游戏结束：重置房间 is_playing
   [[nodiscard]] bool FinishGame(uint32_t room_id);
 
-  // 获取房间内所有成员会话（用于广播）
+  // 获取房间内所有成员会话（用于广播），可跳过指定玩家
   std::vector<std::weak_ptr<TcpSession>> GetRoomSessions(
-      uint32_t room_id) const;
+      uint32_t room_id,
+      std::span<const uint32_t> exclude_player_ids = {}) const;
+  // 获取房间内指定玩家的会话
+  std::vector<std::weak_ptr<TcpSession>> GetPlayerSessions(
+      uint32_t room_id, std::span<const uint32_t> player_ids) const;
 
   // 查询玩家所在房间（无则返回空）
   [[nodiscard]] std::optional<uint32_t> GetPlayerRoom(uint32_t player_id) const;
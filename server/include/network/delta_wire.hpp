@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "network/packet_codec.hpp"
+
+// 共享基线状态增量（S2C_GameStateDeltaSync）的直写编码：tick 线程只把变化
+// 字段记进下面的平铺记录，编码时按静态字段表算长度并直接写出 protobuf 线格式
+// 字节，不创建 EnemyStateDelta / Vector2 等消息对象。输出与按同样字段填充
+// 消息后 SerializeAsString 的结果逐字节一致（字段号升序、proto3 隐式字段零值
+// 省略、optional 字段按 changed_mask 位写出）。定点编码与按确认基线增量的
+// 扩展字段不在此路径上，唯一例外是兴趣区域过滤用到的 removed_enemy_ids。
+namespace delta_wire {
+
+struct PlayerDelta {
+  uint32_t player_id = 0;
+  uint32_t changed_mask = 0;  // PlayerDeltaMask
+  float x = 0.0f;
+  float y = 0.0f;
+  float rotation = 0.0f;
+  bool is_alive = false;
+  int32_t last_processed_input_seq = 0;
+};
+
+struct EnemyDelta {
+  uint32_t enemy_id = 0;
+  uint32_t changed_mask = 0;  // EnemyDeltaMask
+  float x = 0.0f;
+  float y = 0.0f;
+  int32_t health = 0;
+  bool is_alive = false;
+};
+
+struct ItemDelta {
+  uint32_t item_id = 0;
+  uint32_t changed_mask = 0;  // ItemDeltaMask
+  float x = 0.0f;
+  float y = 0.0f;
+  bool is_picked = false;
+  uint32_t type_id = 0;
+};
+
+struct DeltaFrame {
+  bool has_sync_time = false;
+  uint64_t server_time_ms = 0;
+  uint32_t tick = 0;
+  uint32_t room_id = 0;
+  std::vector<PlayerDelta> players;
+  std::vector<EnemyDelta> enemies;
+  std::vector<ItemDelta> items;
+  // 离开兴趣区域的敌人（字段 9，packed 编码），仅逐玩家过滤后的增量使用
+  std::vector<uint32_t> removed_enemy_ids;
+
+  void Clear();
+  [[nodiscard]] bool Empty() const {
+    return players.empty() && enemies.empty() && items.empty() &&
+           removed_enemy_ids.empty();
+  }
+};
+
+// S2C_GameStateDeltaSync 序列化长度与写入（返回写入末尾）
+std::size_t PayloadSize(const DeltaFrame& frame);
+uint8_t* WritePayload(const DeltaFrame& frame, uint8_t* target);
+
+// MSG_S2C_GAME_STATE_DELTA_SYNC 包：UDP 数据报 / TCP 帧
+packet_codec::EncodedPacket EncodeDatagram(const DeltaFrame& frame);
+packet_codec::EncodedPacket EncodeFramed(const DeltaFrame& frame);
+
+}  // namespace delta_wire
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <google/protobuf/message_lite.h>
+#include <memory>
+#include <string>
+
+#include "message.pb.h"
+
+// 出站包编码：按 ByteSizeLong 一次算好 Packet 信封与业务消息的长度，
+// 把包长前缀、msg_type / payload 字段头和业务消息直接写进同一块预分配
+// 缓冲，业务消息只序列化一次、无中间拷贝。输出与
+// 「message.SerializeAsString() -> Packet.set_payload -> SerializeAsString」
+// 的旧写法逐字节一致（proto3 默认值字段同样省略）。
+namespace packet_codec {
+
+struct EncodedPacket {
+  lawnmower::MessageType type = lawnmower::MessageType::MSG_UNKNOWN;
+  std::shared_ptr<const std::string> bytes;  // 编码失败时为空
+  std::size_t payload_len = 0;               // 业务消息序列化长度
+  std::size_t body_len = 0;                  // Packet 序列化长度（不含包长）
+};
+
+// TCP：4 字节大端包长 + Packet
+EncodedPacket EncodeFramed(lawnmower::MessageType type,
+                           const google::protobuf::MessageLite& message);
+
+// UDP：单个数据报即一个 Packet，无包长前缀
+EncodedPacket EncodeDatagram(lawnmower::MessageType type,
+                             const google::protobuf::MessageLite& message);
+
+// 业务消息由调用方直接写入 payload 区（不经 protobuf 消息对象）：write 须恰好
+// 写入 payload_len 字节并返回写入末尾，否则编码失败
+using PayloadWriter = std::function<uint8_t*(uint8_t* target)>;
+EncodedPacket EncodeFramed(lawnmower::MessageType type,
+                           std::size_t payload_len,
+                           const PayloadWriter& write);
+EncodedPacket EncodeDatagram(lawnmower::MessageType type,
+                             std::size_t payload_len,
+                             const PayloadWriter& write);
+
+}  // namespace packet_codec
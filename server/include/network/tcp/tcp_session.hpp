@@ -9,12 +9,14 @@
 #include <google/protobuf/message.h>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "message.pb.h"
+#include "network/packet_codec.hpp"
 
 using tcp = asio::ip::tcp;
 
@@ -26,9 +28,23 @@ class TcpSession : public std::enable_shared_from_this<TcpSession> {
   void start();
   void SendProto(lawnmower::MessageType type,
                  const google::protobuf::Message& message);
-  void SendFramedPacket(const std::shared_ptr<const std::string>& framed,
-                        lawnmower::MessageType type, std::size_t payload_len,
-                        std::size_t body_len);
+  // 发送已编码好的帧（多个会话可共享同一块缓冲）
+  void SendEncoded(const packet_codec::EncodedPacket& packet);
+  // 房间广播：message 只编码一次，各目标会话的写队列共享同一块帧缓冲
+  static void Broadcast(std::span<const std::weak_ptr<TcpSession>> sessions,
+                        lawnmower::MessageType type,
+                        const google::protobuf::Message& message);
+  static void BroadcastEncoded(
+      std::span<const std::weak_ptr<TcpSession>> sessions,
+      const packet_codec::EncodedPacket& packet);
+  // 登录/重连时协商：客户端声明支持 S2C_TickEvents 合包
+  bool SupportsTickEvents() const;
+  // 协商了 UDP 可靠通道时返回玩家ID，否则为 0（可在游戏线程读取）
+  uint32_t ReliableUdpPlayerId() const;
+  // 协商了定点坐标：按确认基线的增量改用 qx/qy/qrotation 编码
+  bool SupportsQuantizedPositions() const;
+  // 协商了兴趣区域过滤：共享基线同步只收自身视野附近的敌人
+  bool SupportsInterestFilter() const;
   static bool VerifyToken(uint32_t player_id, std::string_view token);
   static void RevokeToken(uint32_t player_id);
   static void SetPacketDebugLogStride(uint32_t stride);
@@ -36,13 +52,17 @@ class TcpSession : public std::enable_shared_from_this<TcpSession> {
  private:
   static std::string GenerateToken();
   static void RegisterToken(uint32_t player_id, std::string token);
+  // 只记录本会话启用的能力，不影响其他连接
+  uint32_t NegotiateFeatures(uint32_t client_features);
+  // 协商了可靠通道时重置该玩家的发送端并改走 UDP 可靠通道
+  void ActivateReliableUdp(uint32_t player_id);
   static bool ShouldLogPacketDebug();
 
   void read_header();
   void read_body(std::size_t length);
   void do_write();
   void handle_packet(const lawnmower::Packet& packet);
-  void send_packet(const lawnmower::Packet& packet);
+  void send_framed(std::shared_ptr<const std::string> framed);
   void handle_disconnect();
   enum class SessionCloseReason {
     kNetworkError = 0,
@@ -85,6 +105,9 @@ class TcpSession : public std::enable_shared_from_this<TcpSession> {
   uint32_t player_id_ = 0;
   std::string player_name_;
   std::string session_token_;
+  // 已启用的 ClientFeature 位（IO 线程写，游戏线程广播时读）
+  std::atomic<uint32_t> enabled_features_{0};
+  std::atomic<uint32_t> reliable_udp_player_id_{0};
   static std::atomic<uint32_t> next_player_id_;
   static std::atomic<uint32_t> active_sessions_;  // 原子变量用于存储活跃会话
   static std::unordered_map<uint32_t, std::string>
@@ -15,6 +15,12 @@ inline constexpr std::size_t kMaxPacketSize = 64 * 1024;  // 设定最大包大
 inline constexpr std::size_t kMaxWriteQueueSize = 1024;   // 防止慢连接无限堆积
 inline constexpr std::size_t kTokenBytes = 16;            // 128bit 令牌
 inline constexpr uint64_t kPacketDebugLogStride = 60;     // 高频日志限流步长
+// 服务器支持的 ClientFeature 位，协商结果为与客户端声明的交集
+inline constexpr uint32_t kServerFeatures =
+    lawnmower::CLIENT_FEATURE_TICK_EVENTS |
+    lawnmower::CLIENT_FEATURE_UDP_RELIABLE |
+    lawnmower::CLIENT_FEATURE_QUANTIZED_POSITIONS |
+    lawnmower::CLIENT_FEATURE_INTEREST_FILTER;
 
 inline std::string MessageTypeToString(lawnmower::MessageType type) {
   const std::string name = lawnmower::MessageType_Name(type);
@@ -27,11 +33,7 @@ inline std::string MessageTypeToString(lawnmower::MessageType type) {
 inline void BroadcastToRoom(std::span<const std::weak_ptr<TcpSession>> sessions,
                             lawnmower::MessageType type,
                             const google::protobuf::Message& message) {
-  for (const auto& weak_session : sessions) {
-    if (auto session = weak_session.lock()) {
-      session->SendProto(type, message);
-    }
-  }
+  TcpSession::Broadcast(sessions, type, message);
 }
 
 template <typename T>
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "message.pb.h"
+
+// UDP 之上的轻量可靠有序通道（纯逻辑，不含 socket）：
+// - 发送端：消息按 seq 编号排队，直到被确认；超过重发间隔未确认则重发；
+//   未确认数量达到发送窗口时拒收，由调用方退回 TCP。
+// - 接收端：乱序到达的消息在窗口内缓存，按 seq 连续投递，重复的丢弃；
+//   回执为「已按序投递的最大 seq + 其后 32 个 seq 的位图」。
+// - 退回 TCP 时发送端可把未确认消息整体取出（Drain）改经 TCP 补发，序号
+//   继续递增；之后的数据报带 skip_through，接收端据此跳过这段空洞。
+// seq 为 uint32 回绕序号，比较一律用差值的有符号解释。
+namespace reliable_channel {
+
+using Clock = std::chrono::steady_clock;
+
+inline constexpr std::size_t kDefaultWindow = 256;
+inline constexpr std::chrono::milliseconds kDefaultResendInterval{100};
+// 单个数据报里可靠消息部分的预算（低于常见 MTU，尽量避免 IP 分片）
+inline constexpr std::size_t kDefaultMaxBatchBytes = 1200;
+inline constexpr uint32_t kAckBitsCount = 32;
+
+// a 是否在 b 之后（回绕安全）
+inline bool SeqAfter(uint32_t a, uint32_t b) {
+  return static_cast<int32_t>(a - b) > 0;
+}
+
+struct Options {
+  std::size_t window = kDefaultWindow;
+  Clock::duration resend_interval = kDefaultResendInterval;
+  std::size_t max_batch_bytes = kDefaultMaxBatchBytes;
+};
+
+// 从发送端取出、改经其他通道补发的消息
+struct DrainedMessage {
+  lawnmower::MessageType type = lawnmower::MessageType::MSG_UNKNOWN;
+  std::shared_ptr<const std::string> payload;
+};
+
+class Sender {
+ public:
+  explicit Sender(Options options = {});
+
+  // 入队一条消息；发送窗口已满时返回 false（消息未入队）
+  bool Enqueue(lawnmower::MessageType type,
+               std::shared_ptr<const std::string> payload);
+  // 是否有需要在 now 发出的消息（从未发出或已到重发时间）
+  [[nodiscard]] bool HasDue(Clock::time_point now) const;
+  // 按 seq 升序取出到期消息写入 out（至少一条，其余受字节预算限制），
+  // 并记为已在 now 发出；返回写入条数
+  std::size_t CollectDue(Clock::time_point now,
+                         lawnmower::S2C_UdpReliable* out);
+  // 处理对端回执：累计确认的消息移除，ack_bits 确认的停止重发；返回本次
+  // 确认的条数
+  std::size_t OnAck(uint32_t ack, uint32_t ack_bits);
+  // 按 seq 升序取出累计确认之后的全部消息追加到 out 并清空队列；已分配的
+  // seq 不再复用，此后 CollectDue 的数据报带上 skip_through。返回取出条数
+  std::size_t Drain(std::vector<DrainedMessage>* out);
+
+  // 尚未确认的条数（不含已被 ack_bits 确认、仍在等缺口的消息）
+  [[nodiscard]] std::size_t pending() const { return unacked_; }
+  [[nodiscard]] uint32_t skip_through() const { return skip_through_; }
+  [[nodiscard]] uint64_t resend_count() const { return resend_count_; }
+
+ private:
+  struct Pending {
+    uint32_t seq = 0;
+    lawnmower::MessageType type = lawnmower::MessageType::MSG_UNKNOWN;
+    std::shared_ptr<const std::string> payload;
+    bool sent = false;
+    // 已被 ack_bits 确认：不再重发，但对端尚未按序投递，Drain 时仍需补发
+    bool acked = false;
+    Clock::time_point last_sent{};
+  };
+
+  [[nodiscard]] bool IsDue(const Pending& message, Clock::time_point now) const;
+
+  Options options_;
+  uint32_t next_seq_ = 1;
+  uint32_t skip_through_ = 0;  // 最近一次 Drain 取出的最大 seq
+  // seq 升序；累计确认之后的全部消息，窗口按其长度计
+  std::deque<Pending> pending_;
+  std::size_t unacked_ = 0;
+  uint64_t resend_count_ = 0;
+};
+
+class Receiver {
+ public:
+  explicit Receiver(Options options = {});
+
+  // 收到一条消息；按序可投递的消息（含此前缓存的后续消息）追加到 delivered。
+  // 重复或超出接收窗口的消息被丢弃，返回 false
+  bool OnMessage(const lawnmower::ReliableMessage& message,
+                 std::vector<lawnmower::ReliableMessage>* delivered);
+  // 处理数据报的 skip_through：seq 及之前的消息已改经 TCP 送达，不再等待。
+  // 丢弃其中仍在缓存的消息，随后可连续投递的追加到 delivered
+  void OnSkipThrough(uint32_t seq,
+                     std::vector<lawnmower::ReliableMessage>* delivered);
+  // 生成当前回执
+  void FillAck(uint32_t* ack, uint32_t* ack_bits) const;
+
+  [[nodiscard]] uint32_t delivered_seq() const { return delivered_seq_; }
+  [[nodiscard]] std::size_t buffered() const { return buffered_.size(); }
+
+ private:
+  Options options_;
+  uint32_t delivered_seq_ = 0;  // 已按序投递的最大 seq
+  // 乱序到达、尚不能投递的消息
+  std::unordered_map<uint32_t, lawnmower::ReliableMessage> buffered_;
+};
+
+}  // namespace reliable_channel
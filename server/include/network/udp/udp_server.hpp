@@ -6,11 +6,14 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "message.pb.h"
+#include "network/delta_wire.hpp"
+#include "network/udp/reliable_channel.hpp"
 
 using udp = asio::ip::udp;
 
@@ -22,12 +25,37 @@ class UdpServer {
   // 开始异步接收（需与 io_context.run() 同步驱动）
   void Start();
 
-  // 广播游戏状态到指定房间的已登记终端
-  std::size_t BroadcastState(uint32_t room_id,
-                             const lawnmower::S2C_GameStateSync& sync);
-  // 广播游戏状态增量到指定房间的已登记终端
+  // 广播游戏状态到指定房间的已登记终端（跳过 exclude_player_ids）
+  std::size_t BroadcastState(
+      uint32_t room_id, const lawnmower::S2C_GameStateSync& sync,
+      std::span<const uint32_t> exclude_player_ids = {});
+  // 广播游戏状态增量到指定房间的已登记终端（跳过 exclude_player_ids）
   std::size_t BroadcastDeltaState(
-      uint32_t room_id, const lawnmower::S2C_GameStateDeltaSync& sync);
+      uint32_t room_id, const delta_wire::DeltaFrame& sync,
+      std::span<const uint32_t> exclude_player_ids = {});
+  // 发送同一份增量给指定玩家；未登记终端的玩家追加到 unreached
+  std::size_t SendDeltaState(std::span<const uint32_t> player_ids,
+                             const lawnmower::S2C_GameStateDeltaSync& sync,
+                             std::vector<uint32_t>* unreached);
+  std::size_t SendDeltaState(std::span<const uint32_t> player_ids,
+                             const delta_wire::DeltaFrame& sync,
+                             std::vector<uint32_t>* unreached);
+
+  // 可靠有序通道：玩家已登记 UDP 终端时才可用，否则调用方走 TCP
+  bool HasEndpoint(uint32_t player_id);
+  // 入队可靠消息（payload 为业务消息序列化结果，可在多名玩家间共享）；
+  // 终端不存在或发送窗口已满时返回 false
+  bool QueueReliable(uint32_t player_id, lawnmower::MessageType type,
+                     std::shared_ptr<const std::string> payload);
+  // 发出房间内各通道的到期消息（本 tick 未被同步包捎带的新消息与超时重发）
+  std::size_t FlushReliable(uint32_t room_id);
+  // 退回 TCP 前取出玩家尚未确认的可靠消息（seq 升序），由调用方先经 TCP
+  // 补发；通道保留，序号延续。返回取出条数
+  std::size_t DrainReliable(uint32_t player_id,
+                            std::vector<reliable_channel::DrainedMessage>* out);
+  // 丢弃玩家的通道：重新登录/重连后序号从头开始；离开房间、会话关闭、
+  // 宽限期超时移除时释放（调用方先经 DrainReliable 补发）
+  void ResetReliable(uint32_t player_id);
 
  private:
   struct EndpointInfo {
@@ -36,13 +64,34 @@ class UdpServer {
     std::chrono::steady_clock::time_point last_seen;
   };
 
+  struct RoomTarget {
+    uint32_t player_id = 0;
+    udp::endpoint endpoint;
+  };
+
   void DoReceive();
   void HandlePacket(const lawnmower::Packet& packet, const udp::endpoint& from);
   void HandlePlayerInput(const lawnmower::Packet& packet,
                          const udp::endpoint& from);
+  void HandleUdpAck(const lawnmower::Packet& packet,
+                    const udp::endpoint& from);
+  // 校验令牌与房间后刷新终端登记，失败返回 false
+  bool TouchEndpoint(uint32_t player_id, const std::string& session_token,
+                     const udp::endpoint& from);
   void SendPacket(const std::shared_ptr<const std::string>& data,
                   const udp::endpoint& to);
-  std::vector<udp::endpoint> EndpointsForRoom(uint32_t room_id);
+  // 发送共享数据报；有到期可靠消息的终端改发捎带该数据报的 S2C_UdpReliable
+  void SendToTargets(const std::vector<RoomTarget>& targets,
+                     const std::shared_ptr<const std::string>& data);
+  // 取出到期可靠消息并编码成数据报，无到期消息返回空（需持有 mutex_）
+  std::shared_ptr<const std::string> BuildReliableDatagramLocked(
+      uint32_t player_id, reliable_channel::Clock::time_point now,
+      const std::string* piggyback);
+  std::vector<RoomTarget> EndpointsForRoom(
+      uint32_t room_id, std::span<const uint32_t> exclude_player_ids = {});
+  // 指定玩家的有效终端；未登记或已过期的玩家追加到 unreached
+  std::vector<RoomTarget> EndpointsForPlayers(
+      std::span<const uint32_t> player_ids, std::vector<uint32_t>* unreached);
 
   asio::io_context& io_context_;
   udp::socket socket_;
@@ -51,4 +100,5 @@ class UdpServer {
 
   mutable std::mutex mutex_;
   std::unordered_map<uint32_t, EndpointInfo> player_endpoints_;
+  std::unordered_map<uint32_t, reliable_channel::Sender> reliable_senders_;
 };
@@ -281,6 +281,10 @@ bool LoadEnemyTypesConfig(EnemyTypesConfig* out) {
       }
       enemy.attack_interval_seconds = attack_interval;
 
+      uint32_t spawn_weight = enemy.spawn_weight;
+      ExtractUint(obj, "spawn_weight", &spawn_weight);
+      enemy.spawn_weight = ClampUInt32(spawn_weight, 0u, 10000u);
+
       if (enemy.type_id == 0) {
         continue;
       }
@@ -92,6 +92,22 @@ void ExtractFloat(const google::protobuf::Struct& root, std::string_view key,
   *out = static_cast<float>(value);
 }
 
+void ExtractBool(const google::protobuf::Struct& root, std::string_view key,
+                 bool* out) {
+  if (out == nullptr) {
+    return;
+  }
+  const google::protobuf::Value* field = FindField(root, key);
+  if (field == nullptr) {
+    return;
+  }
+  if (field->kind_case() != google::protobuf::Value::kBoolValue) {
+    spdlog::warn("配置项 {} 类型错误，期望 bool，保持默认值", key);
+    return;
+  }
+  *out = field->bool_value();
+}
+
 void ExtractString(const google::protobuf::Struct& root, std::string_view key,
                    std::string* out) {
   if (out == nullptr) {
@@ -170,6 +186,18 @@ bool LoadServerConfig(ServerConfig* out) {
   ExtractUint(root, "max_enemy_spawn_per_tick", &cfg.max_enemy_spawn_per_tick);
   ExtractUint(root, "max_enemy_replan_per_tick",
               &cfg.max_enemy_replan_per_tick);
+  ExtractUint(root, "path_planner_threads", &cfg.path_planner_threads);
+  ExtractUint(root, "projectile_hit_threads", &cfg.projectile_hit_threads);
+  ExtractUint(root, "path_cache_capacity", &cfg.path_cache_capacity);
+  ExtractUint(root, "enemy_reorder_interval_ticks",
+              &cfg.enemy_reorder_interval_ticks);
+  ExtractFloat(root, "enemy_lod_mid_distance", &cfg.enemy_lod_mid_distance);
+  ExtractFloat(root, "enemy_lod_far_distance", &cfg.enemy_lod_far_distance);
+  ExtractUint(root, "enemy_lod_mid_interval", &cfg.enemy_lod_mid_interval);
+  ExtractUint(root, "enemy_lod_far_interval", &cfg.enemy_lod_far_interval);
+  ExtractUint(root, "rng_seed", &cfg.rng_seed);
+  ExtractBool(root, "deterministic_replay", &cfg.deterministic_replay);
+  ExtractUint(root, "max_substeps_per_tick", &cfg.max_substeps_per_tick);
   ExtractFloat(root, "projectile_speed", &cfg.projectile_speed);
   ExtractFloat(root, "projectile_radius", &cfg.projectile_radius);
   ExtractFloat(root, "projectile_muzzle_offset", &cfg.projectile_muzzle_offset);
@@ -184,6 +212,11 @@ bool LoadServerConfig(ServerConfig* out) {
   ExtractUint(root, "perf_sample_stride", &cfg.perf_sample_stride);
   ExtractUint(root, "tcp_packet_debug_log_stride",
               &cfg.tcp_packet_debug_log_stride);
+  ExtractUint(root, "delta_position_scale", &cfg.delta_position_scale);
+  ExtractUint(root, "delta_rotation_bits", &cfg.delta_rotation_bits);
+  ExtractFloat(root, "aoi_view_half_width", &cfg.aoi_view_half_width);
+  ExtractFloat(root, "aoi_view_half_height", &cfg.aoi_view_half_height);
+  ExtractFloat(root, "aoi_margin", &cfg.aoi_margin);
   ExtractString(root, "log_level", &cfg.log_level);
 
   cfg.prediction_history_seconds =
@@ -202,6 +235,32 @@ bool LoadServerConfig(ServerConfig* out) {
       std::clamp(cfg.reconnect_grace_seconds, 1.0f, 600.0f);
   cfg.max_enemy_replan_per_tick =
       std::max<uint32_t>(1, cfg.max_enemy_replan_per_tick);
+  cfg.path_planner_threads = std::min<uint32_t>(cfg.path_planner_threads, 16);
+  cfg.projectile_hit_threads =
+      std::min<uint32_t>(cfg.projectile_hit_threads, 16);
+  cfg.path_cache_capacity =
+      std::clamp<uint32_t>(cfg.path_cache_capacity, 16, 65536);
+  cfg.enemy_reorder_interval_ticks =
+      std::min<uint32_t>(cfg.enemy_reorder_interval_ticks, 3600);
+  cfg.delta_position_scale =
+      std::clamp<uint32_t>(cfg.delta_position_scale, 1, 64);
+  cfg.delta_rotation_bits =
+      std::clamp<uint32_t>(cfg.delta_rotation_bits, 8, 10);
+  cfg.aoi_view_half_width =
+      std::clamp(cfg.aoi_view_half_width, 16.0f, 100000.0f);
+  cfg.aoi_view_half_height =
+      std::clamp(cfg.aoi_view_half_height, 16.0f, 100000.0f);
+  cfg.aoi_margin = std::clamp(cfg.aoi_margin, 0.0f, 100000.0f);
+  cfg.enemy_lod_mid_distance =
+      std::clamp(cfg.enemy_lod_mid_distance, 0.0f, 100000.0f);
+  cfg.enemy_lod_far_distance =
+      std::clamp(cfg.enemy_lod_far_distance, 0.0f, 100000.0f);
+  cfg.enemy_lod_mid_interval =
+      std::clamp<uint32_t>(cfg.enemy_lod_mid_interval, 1, 60);
+  cfg.enemy_lod_far_interval = std::clamp<uint32_t>(
+      cfg.enemy_lod_far_interval, cfg.enemy_lod_mid_interval, 60);
+  cfg.max_substeps_per_tick =
+      std::min<uint32_t>(cfg.max_substeps_per_tick, 16);
   cfg.perf_sample_stride = std::max<uint32_t>(1, cfg.perf_sample_stride);
   cfg.tcp_packet_debug_log_stride =
       std::max<uint32_t>(1, cfg.tcp_packet_debug_log_stride);
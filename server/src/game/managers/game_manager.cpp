@@ -1,4 +1,9 @@
+#include <spdlog/spdlog.h>
+
 #include "game/managers/game_manager.hpp"
+#include "internal/game_manager_event_dispatch.hpp"
+#include "internal/game_manager_parallel.hpp"
+#include "internal/game_manager_path_planner.hpp"
 
 // 单例构造
 GameManager& GameManager::Instance() {
@@ -6,6 +11,27 @@ GameManager& GameManager::Instance() {
   return instance;
 }
 
+GameManager::GameManager() {
+  RebuildEnemyTypeTable();
+  RebuildItemTypeTable();
+  RebuildUpgradeTable();
+}
+
+void GameManager::SetEnemyTypesConfig(const EnemyTypesConfig& cfg) {
+  enemy_types_config_ = cfg;
+  RebuildEnemyTypeTable();
+}
+
+void GameManager::SetItemsConfig(const ItemsConfig& cfg) {
+  items_config_ = cfg;
+  RebuildItemTypeTable();
+}
+
+void GameManager::SetUpgradeConfig(const UpgradeConfig& cfg) {
+  upgrade_config_ = cfg;
+  RebuildUpgradeTable();
+}
+
 // 构建场景默认配置
 GameManager::SceneConfig GameManager::BuildDefaultConfig() const {
   SceneConfig cfg;
@@ -17,6 +43,29 @@ GameManager::SceneConfig GameManager::BuildDefaultConfig() const {
   return cfg;
 }
 
+// 按配置创建异步寻路线程池（path_planner_threads 为 0 时保持同步寻路）
+void GameManager::EnsurePathPlannerLocked() {
+  if (path_planner_ != nullptr || config_.path_planner_threads == 0) {
+    return;
+  }
+  path_planner_ =
+      std::make_shared<game_manager_path_planner::PathPlannerPool>(
+          config_.path_planner_threads);
+  spdlog::info("异步寻路线程池已启动: threads={}, deterministic_replay={}",
+               path_planner_->ThreadCount(), config_.deterministic_replay);
+}
+
+// 按配置创建射弹命中检测线程池（projectile_hit_threads 为 0 时串行检测）
+void GameManager::EnsureHitWorkersLocked() {
+  if (hit_workers_ != nullptr || config_.projectile_hit_threads == 0) {
+    return;
+  }
+  hit_workers_ = std::make_shared<game_manager_parallel::ParallelForPool>(
+      config_.projectile_hit_threads);
+  spdlog::info("射弹命中检测线程池已启动: threads={}",
+               hit_workers_->ThreadCount());
+}
+
 // 解析道具类型
 const ItemTypeConfig& GameManager::ResolveItemType(uint32_t type_id) const {
   // 后备配置
@@ -55,3 +104,9 @@ void GameManager::SetIoContext(asio::io_context* io) { io_context_ = io; }
 
 // 设置UDP服务器
 void GameManager::SetUdpServer(UdpServer* udp) { udp_server_ = udp; }
+
+void GameManager::ReleaseReliableChannel(
+    uint32_t player_id, const std::shared_ptr<TcpSession>& session) {
+  game_manager_event_dispatch::ReleaseReliableChannel(udp_server_, player_id,
+                                                      session);
+}
@@ -0,0 +1,66 @@
+#include "internal/game_manager_alias.hpp"
+
+#include <limits>
+
+namespace game_manager_alias {
+namespace {
+// 定标时 scaled << 16 需不溢出 64 位：scaled < total <= 2^32 * n
+constexpr std::size_t kMaxEntries = 1u << 16;
+}  // namespace
+
+void AliasTable::Build(const std::vector<uint32_t>& weights) {
+  Clear();
+  const std::size_t n = weights.size();
+  uint64_t total = 0;
+  for (const uint32_t weight : weights) {
+    total += weight;
+  }
+  if (n == 0 || n > kMaxEntries || total == 0) {
+    return;
+  }
+
+  // 以 total 为一列的容量，scaled[i] = weight * n；全程整数运算，结果与平台无关
+  std::vector<uint64_t> scaled(n);
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  small.reserve(n);
+  large.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    scaled[i] = static_cast<uint64_t>(weights[i]) * n;
+    (scaled[i] < total ? small : large).push_back(static_cast<uint32_t>(i));
+  }
+
+  prob_.assign(n, std::numeric_limits<uint32_t>::max());
+  alias_.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    alias_[i] = static_cast<uint32_t>(i);
+  }
+
+  // 按 2^32 定标：prob = scaled / total * 2^32，拆成整数部分与余数避免溢出
+  const auto to_threshold = [total](uint64_t value) {
+    const uint64_t hi = (value << 16) / total;
+    const uint64_t rem = (value << 16) % total;
+    return static_cast<uint32_t>((hi << 16) + (rem << 16) / total);
+  };
+
+  while (!small.empty() && !large.empty()) {
+    const uint32_t s = small.back();
+    small.pop_back();
+    const uint32_t l = large.back();
+    prob_[s] = to_threshold(scaled[s]);
+    alias_[s] = l;
+    scaled[l] -= total - scaled[s];
+    if (scaled[l] < total) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // 整数运算无舍入，循环结束时剩余的列恰好满额，整列保留（alias 指回自身）
+}
+
+void AliasTable::Clear() {
+  prob_.clear();
+  alias_.clear();
+}
+
+}  // namespace game_manager_alias
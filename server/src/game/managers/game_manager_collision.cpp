@@ -0,0 +1,217 @@
+#include "internal/game_manager_collision.hpp"
+
+#include <algorithm>
+
+#if LAWNMOWER_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// 说明：各档位严格按标量版本的运算顺序逐步计算（先乘后加、真除法、
+// clamp 用 min(1, max(0, t)) 复现 std::clamp 的比较语义），不使用 FMA /
+// 倒数近似，保证结果逐位一致。构建默认 -std=c++20（非 gnu++），
+// GCC 不会自动收缩为 FMA。
+
+namespace {
+using game_manager_collision::Segment;
+using game_manager_collision::SimdLevel;
+
+constexpr float kMinSegmentLenSq = 1e-6f;
+
+// 逐个条目的标量循环；SIMD 档位也用它处理尾部
+std::ptrdiff_t EarliestHitScalar(const Segment& seg, const float* xs,
+                                 const float* ys, std::size_t begin,
+                                 std::size_t end, float radius,
+                                 std::ptrdiff_t best_index, float* best_t) {
+  for (std::size_t i = begin; i < end; ++i) {
+    float t = 0.0f;
+    if (game_manager_collision::SegmentCircleOverlap(
+            seg.ax, seg.ay, seg.bx, seg.by, xs[i], ys[i], radius, &t) &&
+        (best_index < 0 || t < *best_t)) {
+      best_index = static_cast<std::ptrdiff_t>(i);
+      *best_t = t;
+    }
+  }
+  return best_index;
+}
+
+#if LAWNMOWER_X86_SIMD
+// 命中掩码按下标顺序合入当前最优（严格小于，保证同 t 时取下标小者）
+std::ptrdiff_t MergeLaneHits(int mask, const float* lane_t, std::size_t base,
+                             std::ptrdiff_t best_index, float* best_t) {
+  while (mask != 0) {
+    const int lane = __builtin_ctz(static_cast<unsigned>(mask));
+    mask &= mask - 1;
+    if (best_index < 0 || lane_t[lane] < *best_t) {
+      best_index = static_cast<std::ptrdiff_t>(base + lane);
+      *best_t = lane_t[lane];
+    }
+  }
+  return best_index;
+}
+
+__attribute__((target("sse4.2"))) std::ptrdiff_t EarliestHitSse42(
+    const Segment& seg, const float* xs, const float* ys, std::size_t count,
+    float radius, float* out_t) {
+  const float dx = seg.bx - seg.ax;
+  const float dy = seg.by - seg.ay;
+  const float len_sq = dx * dx + dy * dy;
+  const bool has_len = len_sq > kMinSegmentLenSq;
+  const __m128 v_ax = _mm_set1_ps(seg.ax);
+  const __m128 v_ay = _mm_set1_ps(seg.ay);
+  const __m128 v_dx = _mm_set1_ps(dx);
+  const __m128 v_dy = _mm_set1_ps(dy);
+  const __m128 v_len_sq = _mm_set1_ps(len_sq);
+  const __m128 v_r_sq = _mm_set1_ps(radius * radius);
+  const __m128 v_zero = _mm_setzero_ps();
+  const __m128 v_one = _mm_set1_ps(1.0f);
+
+  std::ptrdiff_t best_index = -1;
+  float best_t = 0.0f;
+  alignas(16) float lane_t[4];
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 cx = _mm_loadu_ps(xs + i);
+    const __m128 cy = _mm_loadu_ps(ys + i);
+    __m128 t = v_zero;
+    if (has_len) {
+      const __m128 dot =
+          _mm_add_ps(_mm_mul_ps(_mm_sub_ps(cx, v_ax), v_dx),
+                     _mm_mul_ps(_mm_sub_ps(cy, v_ay), v_dy));
+      t = _mm_min_ps(v_one, _mm_max_ps(v_zero, _mm_div_ps(dot, v_len_sq)));
+    }
+    const __m128 ex =
+        _mm_sub_ps(_mm_add_ps(v_ax, _mm_mul_ps(v_dx, t)), cx);
+    const __m128 ey =
+        _mm_sub_ps(_mm_add_ps(v_ay, _mm_mul_ps(v_dy, t)), cy);
+    const __m128 dist_sq =
+        _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+    const int mask = _mm_movemask_ps(_mm_cmple_ps(dist_sq, v_r_sq));
+    if (mask != 0) {
+      _mm_store_ps(lane_t, t);
+      best_index = MergeLaneHits(mask, lane_t, i, best_index, &best_t);
+    }
+  }
+  best_index = EarliestHitScalar(seg, xs, ys, i, count, radius, best_index,
+                                 &best_t);
+  if (best_index >= 0 && out_t != nullptr) {
+    *out_t = best_t;
+  }
+  return best_index;
+}
+
+__attribute__((target("avx2"))) std::ptrdiff_t EarliestHitAvx2(
+    const Segment& seg, const float* xs, const float* ys, std::size_t count,
+    float radius, float* out_t) {
+  const float dx = seg.bx - seg.ax;
+  const float dy = seg.by - seg.ay;
+  const float len_sq = dx * dx + dy * dy;
+  const bool has_len = len_sq > kMinSegmentLenSq;
+  const __m256 v_ax = _mm256_set1_ps(seg.ax);
+  const __m256 v_ay = _mm256_set1_ps(seg.ay);
+  const __m256 v_dx = _mm256_set1_ps(dx);
+  const __m256 v_dy = _mm256_set1_ps(dy);
+  const __m256 v_len_sq = _mm256_set1_ps(len_sq);
+  const __m256 v_r_sq = _mm256_set1_ps(radius * radius);
+  const __m256 v_zero = _mm256_setzero_ps();
+  const __m256 v_one = _mm256_set1_ps(1.0f);
+
+  std::ptrdiff_t best_index = -1;
+  float best_t = 0.0f;
+  alignas(32) float lane_t[8];
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 cx = _mm256_loadu_ps(xs + i);
+    const __m256 cy = _mm256_loadu_ps(ys + i);
+    __m256 t = v_zero;
+    if (has_len) {
+      const __m256 dot =
+          _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(cx, v_ax), v_dx),
+                        _mm256_mul_ps(_mm256_sub_ps(cy, v_ay), v_dy));
+      t = _mm256_min_ps(v_one,
+                        _mm256_max_ps(v_zero, _mm256_div_ps(dot, v_len_sq)));
+    }
+    const __m256 ex =
+        _mm256_sub_ps(_mm256_add_ps(v_ax, _mm256_mul_ps(v_dx, t)), cx);
+    const __m256 ey =
+        _mm256_sub_ps(_mm256_add_ps(v_ay, _mm256_mul_ps(v_dy, t)), cy);
+    const __m256 dist_sq =
+        _mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey));
+    const int mask =
+        _mm256_movemask_ps(_mm256_cmp_ps(dist_sq, v_r_sq, _CMP_LE_OQ));
+    if (mask != 0) {
+      _mm256_store_ps(lane_t, t);
+      best_index = MergeLaneHits(mask, lane_t, i, best_index, &best_t);
+    }
+  }
+  // 回到非 VEX 编码的标量代码前清零上半部，避免 AVX/SSE 切换惩罚
+  _mm256_zeroupper();
+  best_index = EarliestHitScalar(seg, xs, ys, i, count, radius, best_index,
+                                 &best_t);
+  if (best_index >= 0 && out_t != nullptr) {
+    *out_t = best_t;
+  }
+  return best_index;
+}
+#endif
+
+}  // namespace
+
+namespace game_manager_collision {
+
+bool SegmentCircleOverlap(float ax, float ay, float bx, float by, float cx,
+                          float cy, float radius, float* out_t) {
+  const float dx = bx - ax;
+  const float dy = by - ay;
+  const float len_sq = dx * dx + dy * dy;
+  float t = 0.0f;
+  if (len_sq > kMinSegmentLenSq) {
+    t = ((cx - ax) * dx + (cy - ay) * dy) / len_sq;
+    t = std::clamp(t, 0.0f, 1.0f);
+  }
+  const float closest_x = ax + dx * t;
+  const float closest_y = ay + dy * t;
+  const float ex = closest_x - cx;
+  const float ey = closest_y - cy;
+  const float dist_sq = ex * ex + ey * ey;
+  if (dist_sq <= radius * radius) {
+    if (out_t != nullptr) {
+      *out_t = t;
+    }
+    return true;
+  }
+  return false;
+}
+
+std::ptrdiff_t EarliestSegmentCircleHit(const Segment& seg, const float* xs,
+                                        const float* ys, std::size_t count,
+                                        float radius, float* out_t) {
+  return EarliestSegmentCircleHitAt(game_manager_simd::ActiveSimdLevel(), seg,
+                                    xs, ys, count, radius, out_t);
+}
+
+std::ptrdiff_t EarliestSegmentCircleHitAt(SimdLevel level, const Segment& seg,
+                                          const float* xs, const float* ys,
+                                          std::size_t count, float radius,
+                                          float* out_t) {
+  if (xs == nullptr || ys == nullptr || count == 0) {
+    return -1;
+  }
+  level = game_manager_simd::ClampSimdLevel(level);
+#if LAWNMOWER_X86_SIMD
+  if (level == SimdLevel::kAvx2) {
+    return EarliestHitAvx2(seg, xs, ys, count, radius, out_t);
+  }
+  if (level == SimdLevel::kSse42) {
+    return EarliestHitSse42(seg, xs, ys, count, radius, out_t);
+  }
+#endif
+  float best_t = 0.0f;
+  const std::ptrdiff_t best_index =
+      EarliestHitScalar(seg, xs, ys, 0, count, radius, -1, &best_t);
+  if (best_index >= 0 && out_t != nullptr) {
+    *out_t = best_t;
+  }
+  return best_index;
+}
+
+}  // namespace game_manager_collision
@@ -1,12 +1,14 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
-#include <numbers>
 #include <spdlog/spdlog.h>
 #include <vector>
 
 #include "game/managers/game_manager.hpp"
+#include "internal/game_manager_fastmath.hpp"
 #include "internal/game_manager_misc_utils.hpp"
+#include "internal/game_manager_rng.hpp"
+#include "internal/game_manager_spatial.hpp"
 
 namespace {
 // 碰撞/战斗相关（后续可考虑挪到配置）
@@ -38,29 +40,6 @@ bool CirclesOverlap(float ax, float ay, float ar, float bx, float by,
   return DistanceSq(ax, ay, bx, by) <= r * r;
 }
 
-// 线段与圆是否相交（用于连续碰撞检测，避免高速穿透）
-bool SegmentCircleOverlap(float ax, float ay, float bx, float by, float cx,
-                          float cy, float radius, float* out_t) {
-  const float dx = bx - ax;
-  const float dy = by - ay;
-  const float len_sq = dx * dx + dy * dy;
-  float t = 0.0f;
-  if (len_sq > 1e-6f) {
-    t = ((cx - ax) * dx + (cy - ay) * dy) / len_sq;
-    t = std::clamp(t, 0.0f, 1.0f);
-  }
-  const float closest_x = ax + dx * t;
-  const float closest_y = ay + dy * t;
-  const float dist_sq = DistanceSq(closest_x, closest_y, cx, cy);
-  if (dist_sq <= radius * radius) {
-    if (out_t != nullptr) {
-      *out_t = t;
-    }
-    return true;
-  }
-  return false;
-}
-
 double PlayerAttackIntervalSeconds(uint32_t attack_speed, double min_interval,
                                    double max_interval) {
   // attack_speed 语义：数值越大越快（默认 1 表示 1 次/秒）。
@@ -149,16 +128,14 @@ void GameManager::GrantExpForCombat(
 }
 
 std::pair<float, float> GameManager::RotationDir(float rotation_deg) {
-  const float rad = rotation_deg * std::numbers::pi_v<float> / 180.0f;
-  return {std::cos(rad), std::sin(rad)};
+  return game_manager_fastmath::FastDirFromDeg(rotation_deg);
 }
 
 float GameManager::RotationFromDir(float dir_x, float dir_y) {
   if (std::abs(dir_x) < 1e-6f && std::abs(dir_y) < 1e-6f) {
     return 0.0f;
   }
-  const float angle_rad = std::atan2(dir_y, dir_x);
-  return angle_rad * 180.0f / std::numbers::pi_v<float>;
+  return game_manager_fastmath::FastAtan2Deg(dir_y, dir_x);
 }
 
 std::pair<float, float> GameManager::ComputeProjectileOrigin(
@@ -169,25 +146,47 @@ std::pair<float, float> GameManager::ComputeProjectileOrigin(
           player.state.position().y() + kProjectileMouthOffsetUp};
 }
 
-uint32_t GameManager::FindNearestEnemyIdForPlayerFire(
-    const Scene& scene, const PlayerRuntime& player) const {
-  const float px = player.state.position().x();
-  const float py = player.state.position().y();
-  float best_dist_sq = std::numeric_limits<float>::infinity();
-  uint32_t best_id = 0;
+game_manager_spatial::SpatialIndex& GameManager::ResetEnemySpatialIndexLocked(
+    Scene& scene) const {
+  if (scene.enemy_spatial == nullptr) {
+    scene.enemy_spatial =
+        std::make_shared<game_manager_spatial::SpatialIndex>();
+  }
+  scene.enemy_spatial->Reset(static_cast<float>(scene.config.width),
+                             static_cast<float>(scene.config.height),
+                             static_cast<float>(kNavCellSize));
+  scene.enemy_spatial_tick = 0;
+  return *scene.enemy_spatial;
+}
+
+// 正常情况下 ProcessEnemies 移动敌人时已顺带建好本帧索引；
+// 开火阶段内敌人既不移动也不死亡，这里只在索引过期时补建
+void GameManager::EnsureEnemySpatialIndexLocked(Scene& scene) const {
+  if (scene.enemy_spatial != nullptr &&
+      scene.enemy_spatial_tick == scene.tick + 1) {
+    return;
+  }
+  auto& index = ResetEnemySpatialIndexLocked(scene);
   for (const auto& [enemy_id, enemy] : scene.enemies) {
     if (!enemy.state.is_alive()) {
       continue;
     }
-    const float ex = enemy.state.position().x();
-    const float ey = enemy.state.position().y();
-    const float dist_sq = DistanceSq(px, py, ex, ey);
-    if (dist_sq < best_dist_sq) {
-      best_dist_sq = dist_sq;
-      best_id = enemy_id;
-    }
+    index.Insert(enemy_id, enemy.state.position().x(),
+                 enemy.state.position().y());
+  }
+  index.Build();
+  scene.enemy_spatial_tick = scene.tick + 1;
+}
+
+uint32_t GameManager::FindNearestEnemyIdForPlayerFire(
+    Scene& scene, const PlayerRuntime& player) const {
+  EnsureEnemySpatialIndexLocked(scene);
+  game_manager_spatial::SpatialHit hit;
+  if (!scene.enemy_spatial->Nearest(player.state.position().x(),
+                                    player.state.position().y(), &hit)) {
+    return 0;
   }
-  return best_id;
+  return hit.id;
 }
 
 const GameManager::EnemyRuntime* GameManager::ResolveLockedTargetForPlayerFire(
@@ -314,16 +313,16 @@ bool GameManager::ResolveProjectileDirectionForPlayerFire(
 }
 
 int32_t GameManager::ComputeProjectileDamageForPlayerFire(
-    Scene& scene, const PlayerRuntime& player) const {
+    const PlayerRuntime& player, game_manager_rng::RngStream* rng) const {
   int32_t damage = std::max<int32_t>(1, player.state.attack());
   if (player.state.has_buff()) {
     damage = static_cast<int32_t>(std::llround(damage * 1.2));
   }
-  if (player.state.critical_hit_rate() > 0) {
+  if (player.state.critical_hit_rate() > 0 && rng != nullptr) {
     const float chance = std::clamp(
         static_cast<float>(player.state.critical_hit_rate()) / 1000.0f, 0.0f,
         1.0f);
-    if (NextRngUnitFloat(&scene.rng_state) < chance) {
+    if (rng->NextUnitFloat() < chance) {
       damage *= 2;
     }
   }
@@ -411,6 +410,10 @@ void GameManager::ProcessPlayerFireStage(
     const double interval = PlayerAttackIntervalSeconds(
         player.state.attack_speed(), params.attack_min_interval,
         params.attack_max_interval);
+    // 每个玩家每 tick 一条暴击随机流，按开火顺序取用
+    game_manager_rng::RngStream crit_rng(
+        scene.rng_seed, scene.tick, game_manager_rng::RngStage::kPlayerCrit,
+        player_id);
     uint32_t fired = 0;
     const uint32_t max_shots_this_tick =
         params.allow_catchup ? std::min<uint32_t>(params.max_shots_per_tick, 2u)
@@ -421,7 +424,7 @@ void GameManager::ProcessPlayerFireStage(
       fired += 1;
 
       const int32_t damage =
-          ComputeProjectileDamageForPlayerFire(scene, player);
+          ComputeProjectileDamageForPlayerFire(player, &crit_rng);
       SpawnProjectileForPlayerFire(scene, params, player_id, player, *target,
                                    damage, dir_x, dir_y, rotation,
                                    projectile_spawns);
@@ -3,46 +3,19 @@
 #include <vector>
 
 #include "game/managers/game_manager.hpp"
+#include "internal/game_manager_alias.hpp"
 #include "internal/game_manager_misc_utils.hpp"
+#include "internal/game_manager_rng.hpp"
+#include "internal/game_manager_sleep.hpp"
 
-void GameManager::BuildDropCandidatesForStage(
-    std::vector<std::pair<uint32_t, uint32_t>>* drop_candidates,
-    uint32_t* drop_weight_total) const {
-  if (drop_candidates == nullptr || drop_weight_total == nullptr) {
-    return;
-  }
-  drop_candidates->clear();
-  drop_candidates->reserve(items_config_.items.size());
-  *drop_weight_total = 0;
-  for (const auto& [type_id, item] : items_config_.items) {
-    if (game_manager_misc_utils::ResolveItemEffectType(item.effect) !=
-        lawnmower::ITEM_EFFECT_HEAL) {
-      continue;
-    }
-    if (item.drop_weight == 0) {
-      continue;
-    }
-    drop_candidates->emplace_back(type_id, item.drop_weight);
-    *drop_weight_total += item.drop_weight;
-  }
-}
-
+// 按预编译的别名表抽取掉落类型，没有候选时返回 0
 uint32_t GameManager::PickDropTypeIdForStage(
-    Scene& scene,
-    const std::vector<std::pair<uint32_t, uint32_t>>& drop_candidates,
-    uint32_t drop_weight_total) const {
-  if (drop_candidates.empty() || drop_weight_total == 0) {
+    game_manager_rng::RngStream* rng) const {
+  if (rng == nullptr || item_drop_alias_ == nullptr ||
+      item_drop_alias_->Empty()) {
     return 0;
   }
-  const uint32_t roll = NextRng(&scene.rng_state) % drop_weight_total;
-  uint32_t accum = 0;
-  for (const auto& [type_id, weight] : drop_candidates) {
-    accum += weight;
-    if (roll < accum) {
-      return type_id;
-    }
-  }
-  return drop_candidates.back().first;
+  return item_drop_type_ids_[item_drop_alias_->Sample(rng->NextU32())];
 }
 
 void GameManager::SpawnDropItemForStage(
@@ -71,6 +44,7 @@ void GameManager::SpawnDropItemForStage(
   }
   runtime.item_id = scene.next_item_id++;
   runtime.type_id = type.type_id;
+  runtime.type_slot = ItemTypeSlot(type.type_id);
   runtime.effect_type = effect_type;
   runtime.x = clamped_pos.x();
   runtime.y = clamped_pos.y();
@@ -78,6 +52,9 @@ void GameManager::SpawnDropItemForStage(
   runtime.force_sync_left = 1;
   runtime.dirty = false;
   auto [it, _] = scene.items.emplace(runtime.item_id, runtime);
+  if (scene.item_sleep != nullptr) {
+    scene.item_sleep->Insert(runtime.item_id, runtime.x, runtime.y);
+  }
   MarkItemDirty(scene, it->first, it->second);
 
   auto& dropped = dropped_items->emplace_back();
@@ -99,10 +76,7 @@ void GameManager::ProcessEnemyDropStage(
 
   const uint32_t max_items_alive =
       items_config_.max_items_alive > 0 ? items_config_.max_items_alive : 64;
-  std::vector<std::pair<uint32_t, uint32_t>> drop_candidates;
-  uint32_t drop_weight_total = 0;
-  BuildDropCandidatesForStage(&drop_candidates, &drop_weight_total);
-  if (drop_weight_total == 0) {
+  if (item_drop_alias_ == nullptr || item_drop_alias_->Empty()) {
     return;
   }
 
@@ -111,18 +85,20 @@ void GameManager::ProcessEnemyDropStage(
     if (enemy_it == scene.enemies.end() || enemy_it->second.state.is_alive()) {
       continue;
     }
-    const EnemyTypeConfig& type =
-        ResolveEnemyType(enemy_it->second.state.type_id());
-    const uint32_t chance = std::min(type.drop_chance, 100u);
+    const uint32_t chance =
+        EnemyTypeRowAt(enemy_it->second.type_slot).drop_chance;
     if (chance == 0) {
       continue;
     }
-    const float roll = NextRngUnitFloat(&scene.rng_state) * 100.0f;
+    // 随机流按被击杀的敌人划分，与击杀的处理顺序无关
+    game_manager_rng::RngStream rng(scene.rng_seed, scene.tick,
+                                    game_manager_rng::RngStage::kEnemyDrop,
+                                    enemy_id);
+    const float roll = rng.NextUnitFloat() * 100.0f;
     if (roll >= static_cast<float>(chance)) {
       continue;
     }
-    const uint32_t type_id =
-        PickDropTypeIdForStage(scene, drop_candidates, drop_weight_total);
+    const uint32_t type_id = PickDropTypeIdForStage(&rng);
     if (type_id == 0) {
       continue;
     }
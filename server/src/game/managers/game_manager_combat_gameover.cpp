@@ -6,9 +6,7 @@
 
 std::size_t GameManager::CountAlivePlayersAfterCombatForStage(
     const Scene& scene) {
-  return std::count_if(
-      scene.players.begin(), scene.players.end(),
-      [](const auto& kv) { return kv.second.state.is_alive(); });
+  return scene.alive.players;
 }
 
 void GameManager::BuildGameOverMessageForStage(
@@ -3,6 +3,7 @@
 #include <limits>
 
 #include "game/managers/game_manager.hpp"
+#include "internal/game_manager_lod.hpp"
 
 namespace {
 float DistanceSq(float ax, float ay, float bx, float by) {
@@ -39,6 +40,15 @@ void GameManager::ResolveEnemyAttackRadiiForStage(const EnemyTypeConfig& type,
   *exit_radius = attack_exit_radius;
 }
 
+double GameManager::ResolveEnemyAttackIntervalForStage(
+    const EnemyTypeConfig& type) {
+  return std::clamp(type.attack_interval_seconds > 0.0f
+                        ? static_cast<double>(type.attack_interval_seconds)
+                        : kDefaultEnemyAttackIntervalSeconds,
+                    kMinEnemyAttackIntervalSeconds,
+                    kMaxEnemyAttackIntervalSeconds);
+}
+
 uint32_t GameManager::SelectEnemyMeleeTargetForStage(const Scene& scene,
                                                      const EnemyRuntime& enemy,
                                                      float ex, float ey,
@@ -101,7 +111,7 @@ void GameManager::PushEnemyAttackStateForStage(
 
 void GameManager::TryApplyEnemyMeleeDamageForStage(
     Scene& scene, uint32_t enemy_id, EnemyRuntime& enemy,
-    uint32_t target_player_id, const EnemyTypeConfig& type,
+    uint32_t target_player_id, const EnemyTypeRow& type,
     std::vector<lawnmower::S2C_PlayerHurt>* player_hurts, bool* has_dirty) {
   if (player_hurts == nullptr || has_dirty == nullptr) {
     return;
@@ -121,13 +131,8 @@ void GameManager::TryApplyEnemyMeleeDamageForStage(
     return;
   }
 
-  const int32_t damage = std::max<int32_t>(0, type.damage);
-  const double attack_interval_seconds = std::clamp(
-      type.attack_interval_seconds > 0.0f
-          ? static_cast<double>(type.attack_interval_seconds)
-          : kDefaultEnemyAttackIntervalSeconds,
-      kMinEnemyAttackIntervalSeconds, kMaxEnemyAttackIntervalSeconds);
-  enemy.attack_cooldown_seconds = attack_interval_seconds;
+  const int32_t damage = type.damage;
+  enemy.attack_cooldown_seconds = type.attack_interval_seconds;
 
   // 伤害为0时不产生受伤事件（避免客户端误触发受击表现），仍保留攻击状态动画。
   if (damage <= 0) {
@@ -146,8 +151,9 @@ void GameManager::TryApplyEnemyMeleeDamageForStage(
   hurt.set_source_id(enemy_id);
   player_hurts->push_back(std::move(hurt));
 
-  if (player.state.health() <= 0) {
+  if (player.state.health() <= 0 && player.state.is_alive()) {
     player.state.set_is_alive(false);
+    AddAlivePlayerLocked(scene, -1);
     player.wants_attacking = false;
     MarkPlayerLowFreqDirtyForCombat(scene, player);
   }
@@ -169,14 +175,16 @@ void GameManager::ProcessEnemyMeleeStage(
     if (!enemy.state.is_alive()) {
       continue;
     }
+    // 远处敌人（LOD 非近档）不可能进入攻击距离，未在攻击中时直接跳过
+    if (enemy.lod_tier !=
+            static_cast<uint8_t>(game_manager_lod::LodTier::kNear) &&
+        !enemy.is_attacking) {
+      continue;
+    }
 
-    const EnemyTypeConfig& type = ResolveEnemyType(enemy.state.type_id());
-    float attack_enter_radius = 0.0f;
-    float attack_exit_radius = 0.0f;
-    ResolveEnemyAttackRadiiForStage(type, &attack_enter_radius,
-                                    &attack_exit_radius);
-    const float enter_sq = attack_enter_radius * attack_enter_radius;
-    const float exit_sq = attack_exit_radius * attack_exit_radius;
+    const EnemyTypeRow& type = EnemyTypeRowAt(enemy.type_slot);
+    const float enter_sq = type.attack_enter_radius_sq;
+    const float exit_sq = type.attack_exit_radius_sq;
     const float ex = enemy.state.position().x();
     const float ey = enemy.state.position().y();
 
@@ -4,38 +4,14 @@
 #include <vector>
 
 #include "game/managers/game_manager.hpp"
+#include "internal/game_manager_collision.hpp"
+#include "internal/game_manager_parallel.hpp"
 
 namespace {
-float DistanceSq(float ax, float ay, float bx, float by) {
-  const float dx = ax - bx;
-  const float dy = ay - by;
-  return dx * dx + dy * dy;
-}
-
-// 线段与圆是否相交（用于连续碰撞检测，避免高速穿透）
-bool SegmentCircleOverlap(float ax, float ay, float bx, float by, float cx,
-                          float cy, float radius, float* out_t) {
-  const float dx = bx - ax;
-  const float dy = by - ay;
-  const float len_sq = dx * dx + dy * dy;
-  float t = 0.0f;
-  if (len_sq > 1e-6f) {
-    t = ((cx - ax) * dx + (cy - ay) * dy) / len_sq;
-    t = std::clamp(t, 0.0f, 1.0f);
-  }
-  const float closest_x = ax + dx * t;
-  const float closest_y = ay + dy * t;
-  const float dist_sq = DistanceSq(closest_x, closest_y, cx, cy);
-  if (dist_sq <= radius * radius) {
-    if (out_t != nullptr) {
-      *out_t = t;
-    }
-    return true;
-  }
-  return false;
-}
-
 constexpr float kEnemyCollisionRadius = 16.0f;
+// 射弹数达到该值且配置了 worker 时并行计算命中，每段至少 kProjectileChunk 发
+constexpr std::size_t kParallelProjectileMin = 128;
+constexpr std::size_t kProjectileChunk = 32;
 }  // namespace
 
 void GameManager::BuildEnemyHitGridForProjectileStage(
@@ -47,7 +23,10 @@ void GameManager::BuildEnemyHitGridForProjectileStage(
   out_grid->cells_y = 0;
   out_grid->cell_size = 0.0f;
   out_grid->enabled = scene.enemies.size() >= 16 && !scene.projectiles.empty();
-  out_grid->cells.clear();
+  out_grid->cell_start.clear();
+  out_grid->xs.clear();
+  out_grid->ys.clear();
+  out_grid->enemies.clear();
   if (!out_grid->enabled) {
     return;
   }
@@ -60,13 +39,18 @@ void GameManager::BuildEnemyHitGridForProjectileStage(
       std::max(1, static_cast<int>(std::ceil(map_w / out_grid->cell_size)));
   out_grid->cells_y =
       std::max(1, static_cast<int>(std::ceil(map_h / out_grid->cell_size)));
-  out_grid->cells.resize(
-      static_cast<std::size_t>(out_grid->cells_x * out_grid->cells_y));
+  const std::size_t cell_count =
+      static_cast<std::size_t>(out_grid->cells_x * out_grid->cells_y);
   const int max_cx = out_grid->cells_x - 1;
   const int max_cy = out_grid->cells_y - 1;
   auto clamp_int = [](int v, int lo, int hi) {
     return std::min(std::max(v, lo), hi);
   };
+
+  // 计数排序分桶：格内保持遍历顺序，与逐格 push_back 的命中优先级一致
+  std::vector<uint32_t> enemy_cell;
+  enemy_cell.reserve(scene.enemies.size());
+  out_grid->cell_start.assign(cell_count + 1, 0);
   for (auto& [_, enemy] : scene.enemies) {
     if (!enemy.state.is_alive()) {
       continue;
@@ -77,13 +61,33 @@ void GameManager::BuildEnemyHitGridForProjectileStage(
         static_cast<int>(std::floor(ex / out_grid->cell_size)), 0, max_cx);
     const int cy = clamp_int(
         static_cast<int>(std::floor(ey / out_grid->cell_size)), 0, max_cy);
-    out_grid->cells[static_cast<std::size_t>(cy * out_grid->cells_x + cx)]
-        .push_back(&enemy);
+    const uint32_t cell = static_cast<uint32_t>(cy * out_grid->cells_x + cx);
+    enemy_cell.push_back(cell);
+    out_grid->cell_start[cell + 1] += 1;
+  }
+  for (std::size_t c = 1; c <= cell_count; ++c) {
+    out_grid->cell_start[c] += out_grid->cell_start[c - 1];
+  }
+  const std::size_t alive_count = enemy_cell.size();
+  out_grid->xs.resize(alive_count);
+  out_grid->ys.resize(alive_count);
+  out_grid->enemies.resize(alive_count);
+  std::vector<uint32_t> cursor(out_grid->cell_start.begin(),
+                               out_grid->cell_start.end() - 1);
+  std::size_t k = 0;
+  for (auto& [_, enemy] : scene.enemies) {
+    if (!enemy.state.is_alive()) {
+      continue;
+    }
+    const uint32_t slot = cursor[enemy_cell[k++]]++;
+    out_grid->xs[slot] = enemy.state.position().x();
+    out_grid->ys[slot] = enemy.state.position().y();
+    out_grid->enemies[slot] = &enemy;
   }
 }
 
 bool GameManager::FindProjectileHitEnemyForStage(
-    Scene& scene, const CombatTickParams& params, const EnemyHitGrid& grid,
+    Scene& scene, const CombatTickParams& params, EnemyHitGrid& grid,
     float prev_x, float prev_y, float next_x, float next_y,
     EnemyRuntime** hit_enemy, uint32_t* hit_enemy_id, float* out_hit_t) const {
   if (hit_enemy == nullptr || hit_enemy_id == nullptr || out_hit_t == nullptr) {
@@ -94,28 +98,12 @@ bool GameManager::FindProjectileHitEnemyForStage(
   float best_t = std::numeric_limits<float>::infinity();
   const float combined_radius =
       params.projectile_radius + kEnemyCollisionRadius;
-  auto test_enemy_hit = [&](EnemyRuntime& enemy) {
-    if (!enemy.state.is_alive()) {
-      return;
-    }
-    const float ex = enemy.state.position().x();
-    const float ey = enemy.state.position().y();
-    float hit_t = 0.0f;
-    if (!SegmentCircleOverlap(prev_x, prev_y, next_x, next_y, ex, ey,
-                              combined_radius, &hit_t)) {
-      return;
-    }
-    if (hit_t < best_t) {
-      best_t = hit_t;
-      *hit_enemy = &enemy;
-      *hit_enemy_id = enemy.state.enemy_id();
-    }
-  };
 
   auto clamp_int = [](int v, int lo, int hi) {
     return std::min(std::max(v, lo), hi);
   };
   if (grid.enabled) {
+    const game_manager_collision::Segment seg{prev_x, prev_y, next_x, next_y};
     const float min_x = std::min(prev_x, next_x) - combined_radius;
     const float max_x = std::max(prev_x, next_x) + combined_radius;
     const float min_y = std::min(prev_y, next_y) - combined_radius;
@@ -131,21 +119,53 @@ bool GameManager::FindProjectileHitEnemyForStage(
     const int max_cy_range = clamp_int(
         static_cast<int>(std::floor(max_y / grid.cell_size)), 0, max_cy);
     for (int cy = min_cy; cy <= max_cy_range; ++cy) {
-      for (int cx = min_cx; cx <= max_cx_range; ++cx) {
-        const auto& cell =
-            grid.cells[static_cast<std::size_t>(cy * grid.cells_x + cx)];
-        for (EnemyRuntime* enemy : cell) {
-          if (enemy == nullptr) {
-            continue;
-          }
-          test_enemy_hit(*enemy);
+      // 同一行 [min_cx, max_cx_range] 的条目在 CSR 中连续，整段批量检测
+      const std::size_t row = static_cast<std::size_t>(cy * grid.cells_x);
+      const std::size_t begin =
+          grid.cell_start[row + static_cast<std::size_t>(min_cx)];
+      const std::size_t end =
+          grid.cell_start[row + static_cast<std::size_t>(max_cx_range) + 1];
+      while (begin < end) {
+        float row_t = 0.0f;
+        const std::ptrdiff_t idx =
+            game_manager_collision::EarliestSegmentCircleHit(
+                seg, grid.xs.data() + begin, grid.ys.data() + begin,
+                end - begin, combined_radius, &row_t);
+        if (idx < 0) {
+          break;
+        }
+        const std::size_t slot = begin + static_cast<std::size_t>(idx);
+        EnemyRuntime* enemy = grid.enemies[slot];
+        if (enemy == nullptr || !enemy->state.is_alive()) {
+          // 本阶段已被击杀：置为空位后重查该行
+          grid.xs[slot] = std::numeric_limits<float>::quiet_NaN();
+          grid.ys[slot] = std::numeric_limits<float>::quiet_NaN();
+          continue;
+        }
+        if (row_t < best_t) {
+          best_t = row_t;
+          *hit_enemy = enemy;
+          *hit_enemy_id = enemy->state.enemy_id();
         }
+        break;
       }
     }
   } else {
     for (auto& [enemy_id, enemy] : scene.enemies) {
-      (void)enemy_id;
-      test_enemy_hit(enemy);
+      if (!enemy.state.is_alive()) {
+        continue;
+      }
+      float hit_t = 0.0f;
+      if (!game_manager_collision::SegmentCircleOverlap(
+              prev_x, prev_y, next_x, next_y, enemy.state.position().x(),
+              enemy.state.position().y(), combined_radius, &hit_t)) {
+        continue;
+      }
+      if (hit_t < best_t) {
+        best_t = hit_t;
+        *hit_enemy = &enemy;
+        *hit_enemy_id = enemy_id;
+      }
     }
   }
   *out_hit_t = best_t;
@@ -180,6 +200,7 @@ void GameManager::ApplyProjectileHitForStage(
   }
 
   hit_enemy.state.set_is_alive(false);
+  AddAliveEnemyLocked(scene, hit_enemy, -1);
   if (hit_enemy.is_attacking || hit_enemy.attack_target_player_id != 0) {
     hit_enemy.is_attacking = false;
     hit_enemy.attack_target_player_id = 0;
@@ -189,7 +210,7 @@ void GameManager::ApplyProjectileHitForStage(
     delta.set_target_player_id(0);
     enemy_attack_states->push_back(std::move(delta));
   }
-  hit_enemy.dead_elapsed_seconds = 0.0;
+  ScheduleEnemyDespawnLocked(scene, hit_enemy_id);
   hit_enemy.force_sync_left =
       std::max(hit_enemy.force_sync_left, kEnemySpawnForceSyncCount);
   MarkEnemyDirty(scene, hit_enemy_id, hit_enemy);
@@ -204,8 +225,7 @@ void GameManager::ApplyProjectileHitForStage(
 
   if (owner_it != scene.players.end()) {
     owner_it->second.kill_count += 1;
-    const uint32_t exp_reward = static_cast<uint32_t>(std::max<int32_t>(
-        0, ResolveEnemyType(hit_enemy.state.type_id()).exp_reward));
+    const uint32_t exp_reward = EnemyTypeRowAt(hit_enemy.type_slot).exp_reward;
     GrantExpForCombat(scene, owner_it->second, exp_reward, level_ups);
   }
 }
@@ -231,6 +251,33 @@ void GameManager::PushProjectileDespawnForStage(
   projectile_despawns->push_back(std::move(evt));
 }
 
+void GameManager::ComputeProjectileStepForStage(
+    Scene& scene, double dt_seconds, const CombatTickParams& params,
+    EnemyHitGrid& grid, ProjectileStep* step) const {
+  if (step == nullptr || step->proj == nullptr) {
+    return;
+  }
+  ProjectileRuntime& proj = *step->proj;
+  proj.remaining_seconds -= dt_seconds;
+  step->prev_x = proj.x;
+  step->prev_y = proj.y;
+  const float delta_seconds = static_cast<float>(std::max(0.0, dt_seconds));
+  step->next_x = step->prev_x + proj.dir_x * proj.speed * delta_seconds;
+  step->next_y = step->prev_y + proj.dir_y * proj.speed * delta_seconds;
+  proj.x = step->next_x;
+  proj.y = step->next_y;
+
+  step->expired = proj.remaining_seconds <= 0.0;
+  step->hit_enemy = nullptr;
+  step->hit_enemy_id = 0;
+  if (!step->expired) {
+    FindProjectileHitEnemyForStage(scene, params, grid, step->prev_x,
+                                   step->prev_y, step->next_x, step->next_y,
+                                   &step->hit_enemy, &step->hit_enemy_id,
+                                   &step->hit_t);
+  }
+}
+
 void GameManager::ProcessProjectileHitStage(
     Scene& scene, double dt_seconds, const CombatTickParams& params,
     std::vector<lawnmower::S2C_EnemyDied>* enemy_dieds,
@@ -249,52 +296,70 @@ void GameManager::ProcessProjectileHitStage(
   EnemyHitGrid enemy_grid;
   BuildEnemyHitGridForProjectileStage(scene, &enemy_grid);
 
-  for (auto it = scene.projectiles.begin(); it != scene.projectiles.end();) {
-    ProjectileRuntime& proj = it->second;
-    proj.remaining_seconds -= dt_seconds;
-    const float prev_x = proj.x;
-    const float prev_y = proj.y;
-    const float delta_seconds = static_cast<float>(std::max(0.0, dt_seconds));
-    const float next_x = prev_x + proj.dir_x * proj.speed * delta_seconds;
-    const float next_y = prev_y + proj.dir_y * proj.speed * delta_seconds;
-    proj.x = next_x;
-    proj.y = next_y;
+  std::vector<ProjectileStep> steps;
+  steps.reserve(scene.projectiles.size());
+  for (auto& [_, proj] : scene.projectiles) {
+    ProjectileStep step;
+    step.proj = &proj;
+    steps.push_back(step);
+  }
+  std::sort(steps.begin(), steps.end(),
+            [](const ProjectileStep& a, const ProjectileStep& b) {
+              return a.proj->projectile_id < b.proj->projectile_id;
+            });
 
+  // 第一步：各射弹只写自己的状态，对敌人与网格只读（网格中只有存活敌人，
+  // 查询不会触发置空写入），射弹较多时分段并行
+  auto compute_steps = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      ComputeProjectileStepForStage(scene, dt_seconds, params, enemy_grid,
+                                    &steps[i]);
+    }
+  };
+  if (hit_workers_ != nullptr && steps.size() >= kParallelProjectileMin) {
+    hit_workers_->Run(steps.size(), kProjectileChunk, compute_steps);
+  } else {
+    compute_steps(0, steps.size());
+  }
+
+  // 第二步：按射弹 id 顺序结算。目标已被更早的射弹击杀时按当前存活状态重查；
+  // 敌人在本阶段只会减少，目标仍存活时快照结果即串行结果
+  for (ProjectileStep& step : steps) {
+    ProjectileRuntime& proj = *step.proj;
     bool despawn = false;
     lawnmower::ProjectileDespawnReason reason =
         lawnmower::PROJECTILE_DESPAWN_UNKNOWN;
-    uint32_t hit_enemy_id = 0;
-    EnemyRuntime* hit_enemy = nullptr;
-    float hit_t = std::numeric_limits<float>::infinity();
 
-    if (proj.remaining_seconds <= 0.0) {
+    if (step.expired) {
       despawn = true;
       reason = lawnmower::PROJECTILE_DESPAWN_EXPIRED;
-    } else if (FindProjectileHitEnemyForStage(
-                   scene, params, enemy_grid, prev_x, prev_y, next_x, next_y,
-                   &hit_enemy, &hit_enemy_id, &hit_t)) {
-      const float hit_x = prev_x + (next_x - prev_x) * hit_t;
-      const float hit_y = prev_y + (next_y - prev_y) * hit_t;
-      proj.x = hit_x;
-      proj.y = hit_y;
-      despawn = true;
-      reason = lawnmower::PROJECTILE_DESPAWN_HIT;
-      ApplyProjectileHitForStage(scene, proj, *hit_enemy, enemy_dieds,
-                                 enemy_attack_states, level_ups,
-                                 killed_enemy_ids, has_dirty);
-    } else if (IsProjectileOutOfBoundsForStage(proj, map_w, map_h)) {
-      despawn = true;
-      reason = lawnmower::PROJECTILE_DESPAWN_OUT_OF_BOUNDS;
+    } else {
+      if (step.hit_enemy != nullptr && !step.hit_enemy->state.is_alive()) {
+        FindProjectileHitEnemyForStage(
+            scene, params, enemy_grid, step.prev_x, step.prev_y, step.next_x,
+            step.next_y, &step.hit_enemy, &step.hit_enemy_id, &step.hit_t);
+      }
+      if (step.hit_enemy != nullptr) {
+        proj.x = step.prev_x + (step.next_x - step.prev_x) * step.hit_t;
+        proj.y = step.prev_y + (step.next_y - step.prev_y) * step.hit_t;
+        despawn = true;
+        reason = lawnmower::PROJECTILE_DESPAWN_HIT;
+        ApplyProjectileHitForStage(scene, proj, *step.hit_enemy, enemy_dieds,
+                                   enemy_attack_states, level_ups,
+                                   killed_enemy_ids, has_dirty);
+      } else if (IsProjectileOutOfBoundsForStage(proj, map_w, map_h)) {
+        despawn = true;
+        reason = lawnmower::PROJECTILE_DESPAWN_OUT_OF_BOUNDS;
+      }
     }
 
     if (despawn) {
-      PushProjectileDespawnForStage(proj, reason, hit_enemy_id,
+      PushProjectileDespawnForStage(proj, reason, step.hit_enemy_id,
                                     projectile_despawns);
-
+      // unordered_map 删除只使被删元素的指针失效
+      const uint32_t projectile_id = proj.projectile_id;
       scene.projectile_pool.push_back(std::move(proj));
-      it = scene.projectiles.erase(it);
-    } else {
-      ++it;
+      scene.projectiles.erase(projectile_id);
     }
   }
 }
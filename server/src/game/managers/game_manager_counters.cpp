@@ -0,0 +1,53 @@
+#include <cassert>
+#include <spdlog/spdlog.h>
+
+#include "game/managers/game_manager.hpp"
+
+// 玩家出生 / 死亡 / 离开场景时调用（delta 为 +1 / -1）
+void GameManager::AddAlivePlayerLocked(Scene& scene, int32_t delta) {
+  scene.alive.AddPlayers(delta);
+}
+
+// 敌人出生 / 死亡时调用；死亡敌人回收时已不计入，无需再调用
+void GameManager::AddAliveEnemyLocked(Scene& scene, const EnemyRuntime& enemy,
+                                      int32_t delta) {
+  scene.alive.AddEnemies(enemy.state.type_id(), enemy.state.wave_id(), delta);
+}
+
+GameManager::AliveCounters GameManager::RecountAliveLocked(
+    const Scene& scene) {
+  AliveCounters counters;
+  for (const auto& [_, player] : scene.players) {
+    if (player.state.is_alive()) {
+      counters.players += 1;
+    }
+  }
+  for (const auto& [_, enemy] : scene.enemies) {
+    if (!enemy.state.is_alive()) {
+      continue;
+    }
+    counters.enemies += 1;
+    counters.enemies_by_type[enemy.state.type_id()] += 1;
+    counters.enemies_by_wave[enemy.state.wave_id()] += 1;
+  }
+  return counters;
+}
+
+// Debug 构建下与全量重算比对，发现漏维护的出生 / 死亡路径；Release 下为空
+void GameManager::VerifyAliveCountersLocked(
+    [[maybe_unused]] const Scene& scene) {
+#ifndef NDEBUG
+  const AliveCounters recount = RecountAliveLocked(scene);
+  if (recount == scene.alive) {
+    return;
+  }
+  spdlog::error(
+      "存活计数与重算不一致: players {} != {}, enemies {} != {}, "
+      "types {} != {}, waves {} != {}",
+      scene.alive.players, recount.players, scene.alive.enemies,
+      recount.enemies, scene.alive.enemies_by_type.size(),
+      recount.enemies_by_type.size(), scene.alive.enemies_by_wave.size(),
+      recount.enemies_by_wave.size());
+  assert(false && "AliveCounters out of sync");
+#endif
+}
@@ -1,13 +1,20 @@
 #include <algorithm>
-#include <array>
+#include <chrono>
 #include <cmath>
 #include <limits>
-#include <numbers>
-#include <queue>
 #include <utility>
 #include <vector>
 
 #include "game/managers/game_manager.hpp"
+#include "internal/game_manager_alias.hpp"
+#include "internal/game_manager_nav.hpp"
+#include "internal/game_manager_path_cache.hpp"
+#include "internal/game_manager_spatial.hpp"
+#include "internal/game_manager_path_planner.hpp"
+#include "internal/game_manager_rng.hpp"
+#include "internal/game_manager_lod.hpp"
+#include "internal/game_manager_sleep.hpp"
+#include "internal/game_manager_steering.hpp"
 
 namespace {
 constexpr double kEnemyReplanIntervalSeconds = 0.25;
@@ -15,195 +22,10 @@ constexpr float kEnemyWaypointReachRadius = 12.0f;
 constexpr double kEnemyDespawnDelaySeconds =
     3.0;  // 死亡敌人保留时间（用于客户端表现）
 
-struct NavGrid {
-  int cells_x = 0;
-  int cells_y = 0;
-  int cell_size = 0;
-};
-
-int ClampInt(int v, int lo, int hi) { return std::min(std::max(v, lo), hi); }
-
-int ToIndex(const NavGrid& grid, int x, int y) { return y * grid.cells_x + x; }
-
-std::pair<int, int> WorldToCell(const NavGrid& grid, float x, float y) {
-  const int cx =
-      ClampInt(static_cast<int>(x / static_cast<float>(grid.cell_size)), 0,
-               std::max(0, grid.cells_x - 1));
-  const int cy =
-      ClampInt(static_cast<int>(y / static_cast<float>(grid.cell_size)), 0,
-               std::max(0, grid.cells_y - 1));
-  return {cx, cy};
-}
-
-std::pair<float, float> CellCenterWorld(const NavGrid& grid, int cx, int cy) {
-  const float fx =
-      (static_cast<float>(cx) + 0.5f) * static_cast<float>(grid.cell_size);
-  const float fy =
-      (static_cast<float>(cy) + 0.5f) * static_cast<float>(grid.cell_size);
-  return {fx, fy};
-}
-
-float Heuristic(const std::pair<int, int>& a, const std::pair<int, int>& b) {
-  const float dx = static_cast<float>(a.first - b.first);
-  const float dy = static_cast<float>(a.second - b.second);
-  return std::sqrt(dx * dx + dy * dy);
-}
-
-bool FindPathAstar(const NavGrid& grid, const std::pair<int, int>& start,
-                   const std::pair<int, int>& goal,
-                   std::vector<std::pair<int, int>>* out_path,
-                   std::vector<int>& came_from, std::vector<float>& g_score,
-                   std::vector<uint32_t>& visit_epoch,
-                   std::vector<uint32_t>& closed_epoch,
-                   uint32_t* epoch_counter) {
-  if (out_path == nullptr) {
-    return false;
-  }
-  out_path->clear();
-  if (grid.cells_x <= 0 || grid.cells_y <= 0) {
-    return false;
-  }
-
-  const int total = grid.cells_x * grid.cells_y;
-  if (total <= 0) {
-    return false;
-  }
-  if (epoch_counter == nullptr) {
-    return false;
-  }
-  const std::size_t total_size = static_cast<std::size_t>(total);
-  if (came_from.size() != total_size) {
-    came_from.assign(total_size, -1);
-  }
-  if (g_score.size() != total_size) {
-    g_score.assign(total_size, std::numeric_limits<float>::infinity());
-  }
-  if (visit_epoch.size() != total_size) {
-    visit_epoch.assign(total_size, 0);
-  }
-  if (closed_epoch.size() != total_size) {
-    closed_epoch.assign(total_size, 0);
-  }
-  uint32_t epoch = ++(*epoch_counter);
-  if (epoch == 0) {
-    std::fill(visit_epoch.begin(), visit_epoch.end(), 0u);
-    std::fill(closed_epoch.begin(), closed_epoch.end(), 0u);
-    *epoch_counter = 1;
-    epoch = 1;
-  }
-
-  const int start_idx = ToIndex(grid, start.first, start.second);
-  const int goal_idx = ToIndex(grid, goal.first, goal.second);
-  if (start_idx < 0 || start_idx >= total || goal_idx < 0 ||
-      goal_idx >= total) {
-    return false;
-  }
-
-  struct OpenNode {
-    int idx = 0;
-    float f = 0.0f;
-    float g = 0.0f;
-  };
-  auto cmp = [](const OpenNode& a, const OpenNode& b) { return a.f > b.f; };
-  std::priority_queue<OpenNode, std::vector<OpenNode>, decltype(cmp)> open(cmp);
-
-  visit_epoch[static_cast<std::size_t>(start_idx)] = epoch;
-  came_from[static_cast<std::size_t>(start_idx)] = -1;
-  g_score[static_cast<std::size_t>(start_idx)] = 0.0f;
-  open.push(OpenNode{start_idx, Heuristic(start, goal), 0.0f});
-
-  constexpr std::array<std::pair<int, int>, 8> kDirs = {{
-      {1, 0},
-      {-1, 0},
-      {0, 1},
-      {0, -1},
-      {1, 1},
-      {1, -1},
-      {-1, 1},
-      {-1, -1},
-  }};
-
-  bool found = false;
-  while (!open.empty()) {
-    const OpenNode cur = open.top();
-    open.pop();
-    if (cur.idx == goal_idx) {
-      found = true;
-      break;
-    }
-    if (closed_epoch[static_cast<std::size_t>(cur.idx)] == epoch) {
-      continue;
-    }
-    if (visit_epoch[static_cast<std::size_t>(cur.idx)] != epoch) {
-      continue;
-    }
-    if (cur.g > g_score[static_cast<std::size_t>(cur.idx)]) {
-      continue;
-    }
-    closed_epoch[static_cast<std::size_t>(cur.idx)] = epoch;
-
-    const int cx = cur.idx % grid.cells_x;
-    const int cy = cur.idx / grid.cells_x;
-
-    for (const auto& [dx, dy] : kDirs) {
-      const int nx = cx + dx;
-      const int ny = cy + dy;
-      if (nx < 0 || ny < 0 || nx >= grid.cells_x || ny >= grid.cells_y) {
-        continue;
-      }
-      const int nidx = ToIndex(grid, nx, ny);
-      if (closed_epoch[static_cast<std::size_t>(nidx)] == epoch) {
-        continue;
-      }
-
-      const float step_cost =
-          (dx == 0 || dy == 0) ? 1.0f : std::numbers::sqrt2_v<float>;
-      const float tentative_g =
-          g_score[static_cast<std::size_t>(cur.idx)] + step_cost;
-      const bool visited = visit_epoch[static_cast<std::size_t>(nidx)] == epoch;
-      const float current_g = visited ? g_score[static_cast<std::size_t>(nidx)]
-                                      : std::numeric_limits<float>::infinity();
-      if (!visited || tentative_g < current_g) {
-        visit_epoch[static_cast<std::size_t>(nidx)] = epoch;
-        came_from[static_cast<std::size_t>(nidx)] = cur.idx;
-        g_score[static_cast<std::size_t>(nidx)] = tentative_g;
-        const std::pair<int, int> ncell{nx, ny};
-        const float f = tentative_g + Heuristic(ncell, goal);
-        open.push(OpenNode{nidx, f, tentative_g});
-      }
-    }
-  }
-
-  if (!found) {
-    return false;
-  }
-
-  // Reconstruct path (goal -> start).
-  std::vector<int> rev;
-  rev.reserve(32);
-  int cur = goal_idx;
-  while (cur >= 0 && cur < total &&
-         visit_epoch[static_cast<std::size_t>(cur)] == epoch) {
-    rev.push_back(cur);
-    if (cur == start_idx) {
-      break;
-    }
-    cur = came_from[static_cast<std::size_t>(cur)];
-  }
-
-  if (rev.empty() || rev.back() != start_idx) {
-    return false;
-  }
-
-  out_path->reserve(rev.size());
-  for (auto it = rev.rbegin(); it != rev.rend(); ++it) {
-    const int idx = *it;
-    const int x = idx % grid.cells_x;
-    const int y = idx / grid.cells_x;
-    out_path->push_back({x, y});
-  }
-  return true;
-}
+using game_manager_nav::CellCenterWorld;
+using game_manager_nav::FindPathAstar;
+using game_manager_nav::NavGrid;
+using game_manager_nav::WorldToCell;
 }  // namespace
 
 // 解析敌人类型
@@ -246,17 +68,250 @@ const EnemyTypeConfig& GameManager::ResolveEnemyType(uint32_t type_id) const {
   return kFallback;
 }
 
-uint32_t GameManager::PickSpawnEnemyTypeId(uint32_t* rng_state) const {
-  if (rng_state == nullptr) {
+uint32_t GameManager::PickSpawnEnemyTypeId(
+    game_manager_rng::RngStream* rng) const {
+  if (rng == nullptr) {
     return ResolveEnemyType(0).type_id;
   }
 
-  const auto& ids = enemy_types_config_.spawn_type_ids;
-  if (ids.empty()) {
+  if (enemy_spawn_alias_ == nullptr || enemy_spawn_alias_->Empty()) {
     return ResolveEnemyType(0).type_id;
   }
 
-  return ids[static_cast<std::size_t>(NextRng(rng_state)) % ids.size()];
+  return enemy_spawn_type_ids_[enemy_spawn_alias_->Sample(rng->NextU32())];
+}
+
+// 当前路径长度；引用的缓存槽位已被淘汰时视为无路径（内联路径始终有效）
+std::size_t GameManager::EnemyPathLengthLocked(const Scene& scene,
+                                               const EnemyRuntime& enemy) {
+  if (enemy.path_length == 0 || enemy.path_inline) {
+    return enemy.path_length;
+  }
+  if (scene.path_cache == nullptr) {
+    return 0;
+  }
+  return scene.path_cache->IsLive(EnemyPathRef(enemy)) ? enemy.path_length
+                                                        : 0;
+}
+
+// 调用方需保证 index < EnemyPathLengthLocked(scene, enemy)
+std::pair<int, int> GameManager::EnemyPathCellLocked(const Scene& scene,
+                                                     const EnemyRuntime& enemy,
+                                                     std::size_t index) {
+  if (!enemy.path_inline) {
+    return scene.path_cache->CellAt(EnemyPathRef(enemy), index);
+  }
+  const int cells_x = std::max(1, scene.nav_cells_x);
+  const int cell = enemy.path_cells[index];
+  return {cell % cells_x, cell / cells_x};
+}
+
+game_manager_path_cache::PathRef GameManager::EnemyPathRef(
+    const EnemyRuntime& enemy) {
+  game_manager_path_cache::PathRef ref;
+  ref.offset = enemy.path_offset;
+  ref.generation = enemy.path_generation;
+  ref.length = enemy.path_length;
+  return ref;
+}
+
+// 放开 arena 路径的 Pin，槽位重新参与 LRU 淘汰
+void GameManager::ClearEnemyPath(Scene& scene, EnemyRuntime& enemy) {
+  if (enemy.path_length > 0 && !enemy.path_inline &&
+      scene.path_cache != nullptr) {
+    scene.path_cache->Unpin(EnemyPathRef(enemy));
+  }
+  enemy.path_offset = 0;
+  enemy.path_generation = 0;
+  enemy.path_length = 0;
+  enemy.path_index = 0;
+  enemy.path_inline = false;
+  enemy.has_cached_path = false;
+}
+
+// 短路径拷入敌人内联缓冲，长路径（及大地图上的路径）引用缓存 arena；
+// 若已走进路径上的格子则从其后继续
+void GameManager::AssignEnemyPathLocked(
+    Scene& scene, EnemyRuntime& enemy,
+    const game_manager_path_cache::PathRef& ref,
+    const std::pair<int, int>& start_cell,
+    const std::pair<int, int>& goal_cell) {
+  ClearEnemyPath(scene, enemy);
+  enemy.path_length = ref.length;
+  enemy.path_inline = ref.length <= kEnemyInlinePathCells &&
+                      scene.path_cache->CompactCells();
+  if (enemy.path_inline) {
+    for (std::size_t i = 0; i < ref.length; ++i) {
+      enemy.path_cells[i] =
+          static_cast<uint16_t>(scene.path_cache->CellIndexAt(ref, i));
+    }
+    enemy.path_offset = 0;
+    enemy.path_generation = 0;
+    scene.perf.path_inline_assigns += 1;
+  } else {
+    enemy.path_offset = ref.offset;
+    enemy.path_generation = ref.generation;
+    scene.path_cache->Pin(ref);
+    scene.perf.path_arena_assigns += 1;
+  }
+
+  const NavGrid nav{scene.nav_cells_x, scene.nav_cells_y, kNavCellSize};
+  const auto cur_cell = WorldToCell(nav, enemy.state.position().x(),
+                                    enemy.state.position().y());
+  uint16_t next_index = 1;  // 跳过起点格
+  for (uint16_t i = 1; i < ref.length; ++i) {
+    if (scene.path_cache->CellAt(ref, i) == cur_cell) {
+      next_index = static_cast<uint16_t>(i + 1);
+      break;
+    }
+  }
+  enemy.path_index = next_index;
+  enemy.has_cached_path = true;
+  enemy.last_path_start_cell = start_cell;
+  enemy.last_path_goal_cell = goal_cell;
+}
+
+// 敌人死亡时调用：按 tick_rate 折算保留时长，挂到到期的模拟帧上
+// （用 sim_tick，升级暂停期间尸体不会提前消失）
+void GameManager::ScheduleEnemyDespawnLocked(Scene& scene, uint32_t enemy_id) {
+  if (scene.enemy_despawns == nullptr) {
+    scene.enemy_despawns = std::make_shared<game_manager_sleep::TickWheel>(
+        kEnemyDespawnWheelSlots);
+  }
+  const double tick_rate =
+      static_cast<double>(std::max<uint32_t>(1, scene.config.tick_rate));
+  const uint64_t delay_ticks = static_cast<uint64_t>(
+      std::ceil(kEnemyDespawnDelaySeconds * tick_rate));
+  scene.enemy_despawns->Schedule(scene.sim_tick + delay_ticks, enemy_id);
+}
+
+// 回收到期的死亡敌人；死亡状态还没同步出去的推迟到下一 tick 再看
+void GameManager::DespawnDueEnemiesLocked(Scene& scene) {
+  if (scene.enemy_despawns == nullptr) {
+    return;
+  }
+  auto& due_ids = scene.wake_ids;
+  due_ids.clear();
+  scene.enemy_despawns->PopDue(scene.sim_tick, &due_ids);
+  for (const uint32_t enemy_id : due_ids) {
+    auto it = scene.enemies.find(enemy_id);
+    if (it == scene.enemies.end() || it->second.state.is_alive()) {
+      continue;
+    }
+    EnemyRuntime& enemy = it->second;
+    if (enemy.force_sync_left > 0) {
+      scene.enemy_despawns->Schedule(scene.sim_tick + 1, enemy_id);
+      continue;
+    }
+    enemy.dirty_queued = false;
+    ClearEnemyPath(scene, enemy);
+    scene.enemy_pool.push_back(std::move(enemy));
+    scene.enemies.erase(it);
+  }
+}
+
+// 按 Morton 序重排敌人存储：存活敌人按所在导航格的 Z 序排在前面（同格按 id），
+// 死亡敌人排在末尾，之后按存储顺序遍历即可按空间邻近访问
+void GameManager::ReorderEnemiesByMortonLocked(Scene& scene) {
+  const auto begin = std::chrono::steady_clock::now();
+  const NavGrid nav{scene.nav_cells_x, scene.nav_cells_y, kNavCellSize};
+  scene.enemies.SortByKey([&nav](uint32_t enemy_id,
+                                 const EnemyRuntime& enemy) -> uint64_t {
+    const uint64_t id = enemy_id;
+    if (!enemy.state.is_alive()) {
+      return (uint64_t{1} << 63) | id;
+    }
+    const auto [cx, cy] = WorldToCell(nav, enemy.state.position().x(),
+                                      enemy.state.position().y());
+    const uint32_t morton = game_manager_spatial::MortonCode(
+        static_cast<uint32_t>(std::max(0, cx)),
+        static_cast<uint32_t>(std::max(0, cy)));
+    return (static_cast<uint64_t>(morton & 0x7fffffffu) << 32) | id;
+  });
+  scene.perf.enemy_reorders += 1;
+  scene.perf.enemy_reorder_ns += static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - begin)
+          .count());
+}
+
+// 收集存活玩家（按 id 升序）与存活敌人的 SoA 位置，顺带推进攻击冷却
+void GameManager::GatherEnemySteeringLocked(Scene& scene, double dt_seconds) {
+  if (scene.steering == nullptr) {
+    scene.steering = std::make_shared<game_manager_steering::SteeringBatch>();
+  }
+  auto& batch = *scene.steering;
+  batch.player_ids.clear();
+  for (const auto& [player_id, player] : scene.players) {
+    if (player.state.is_alive()) {
+      batch.player_ids.push_back(player_id);
+    }
+  }
+  std::sort(batch.player_ids.begin(), batch.player_ids.end());
+  batch.player_xs.resize(batch.player_ids.size());
+  batch.player_ys.resize(batch.player_ids.size());
+  for (std::size_t i = 0; i < batch.player_ids.size(); ++i) {
+    const auto& pos = scene.players.at(batch.player_ids[i]).state.position();
+    batch.player_xs[i] = pos.x();
+    batch.player_ys[i] = pos.y();
+  }
+
+  scene.steering_enemies.clear();
+  for (auto& [_, enemy] : scene.enemies) {
+    if (!enemy.state.is_alive()) {
+      continue;
+    }
+    enemy.attack_cooldown_seconds =
+        std::max(0.0, enemy.attack_cooldown_seconds - dt_seconds);
+    scene.steering_enemies.push_back(&enemy);
+  }
+  batch.ResizeEnemies(scene.steering_enemies.size());
+  for (std::size_t i = 0; i < scene.steering_enemies.size(); ++i) {
+    const auto& pos = scene.steering_enemies[i]->state.position();
+    batch.xs[i] = pos.x();
+    batch.ys[i] = pos.y();
+  }
+}
+
+// 应用线程池返回的寻路结果：过期请求（序号不匹配/敌人已回收）直接丢弃
+void GameManager::ApplyCompletedPathPlansLocked(Scene& scene) {
+  if (scene.path_channel == nullptr || scene.path_cache == nullptr) {
+    return;
+  }
+
+  // 回放模式下等待上一帧提交的请求全部完成，保证结果总在下一帧按提交顺序生效
+  std::vector<game_manager_path_planner::PathResult> results;
+  scene.path_channel->Collect(config_.deterministic_replay, &results);
+  if (results.empty()) {
+    return;
+  }
+
+  for (auto& result : results) {
+    // 敌人可能已被回收，但路径本身仍可供后续同格查询复用
+    game_manager_path_cache::PathRef ref;
+    const bool cached =
+        result.found &&
+        scene.path_cache->Insert(result.start, result.goal, result.path, &ref);
+
+    auto it = scene.enemies.find(result.enemy_id);
+    if (it == scene.enemies.end()) {
+      continue;
+    }
+    EnemyRuntime& enemy = it->second;
+    if (!enemy.path_request_pending ||
+        enemy.path_request_seq != result.request_seq) {
+      continue;
+    }
+    enemy.path_request_pending = false;
+    if (!enemy.state.is_alive()) {
+      continue;
+    }
+    if (!cached) {
+      ClearEnemyPath(scene, enemy);
+      continue;
+    }
+    AssignEnemyPathLocked(scene, enemy, ref, result.start, result.goal);
+  }
 }
 
 void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
@@ -272,29 +327,10 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
   scene.wave_id = std::max<uint32_t>(
       1, 1u + static_cast<uint32_t>(scene.elapsed / wave_interval_seconds));
 
-  const std::size_t alive_players =
-      std::count_if(scene.players.begin(), scene.players.end(),
-                    [](const auto& kv) { return kv.second.state.is_alive(); });
+  const std::size_t alive_players = scene.alive.players;
 
   // 清理已死亡的敌人（在客户端收到死亡事件后可移除渲染）
-  for (auto it = scene.enemies.begin(); it != scene.enemies.end();) {
-    EnemyRuntime& enemy = it->second;
-    if (!enemy.state.is_alive()) {
-      enemy.dead_elapsed_seconds += dt_seconds;
-      if (enemy.force_sync_left == 0 &&
-          enemy.dead_elapsed_seconds >= kEnemyDespawnDelaySeconds) {
-        enemy.dirty_queued = false;
-        scene.enemy_pool.push_back(std::move(enemy));
-        it = scene.enemies.erase(it);
-        continue;
-      }
-    }
-    ++it;
-  }
-
-  std::size_t alive_enemies =
-      std::count_if(scene.enemies.begin(), scene.enemies.end(),
-                    [](const auto& kv) { return kv.second.state.is_alive(); });
+  DespawnDueEnemiesLocked(scene);
 
   const std::size_t max_enemies_alive =
       config_.max_enemies_alive > 0 ? config_.max_enemies_alive : 256;
@@ -302,8 +338,8 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
                                              ? config_.max_enemy_spawn_per_tick
                                              : 4;
 
-  auto spawn_enemy = [&](uint32_t type_id) {
-    if (alive_enemies >= max_enemies_alive) {
+  auto spawn_enemy = [&](uint32_t type_id, game_manager_rng::RngStream* rng) {
+    if (scene.alive.enemies >= max_enemies_alive) {
       return false;
     }
     if (alive_players == 0) {
@@ -314,8 +350,8 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
 
     const float map_w = static_cast<float>(scene.config.width);
     const float map_h = static_cast<float>(scene.config.height);
-    const float t = NextRngUnitFloat(&scene.rng_state);
-    const uint32_t edge = NextRng(&scene.rng_state) % 4u;
+    const float t = rng->NextUnitFloat();
+    const uint32_t edge = rng->NextU32() % 4u;
 
     float x = 0.0f;
     float y = 0.0f;
@@ -342,11 +378,11 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
     if (!scene.enemy_pool.empty()) {
       runtime = std::move(scene.enemy_pool.back());
       scene.enemy_pool.pop_back();
-      runtime.path.clear();
     }
     runtime.state.Clear();
     runtime.state.set_enemy_id(scene.next_enemy_id++);
     runtime.state.set_type_id(type.type_id);
+    runtime.type_slot = EnemyTypeSlot(type.type_id);
     const auto clamped_pos = ClampToMap(scene.config, x, y);
     runtime.state.mutable_position()->set_x(clamped_pos.x());
     runtime.state.mutable_position()->set_y(clamped_pos.y());
@@ -356,24 +392,26 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
     runtime.state.set_wave_id(scene.wave_id);
     runtime.state.set_is_friendly(false);
     runtime.target_player_id = 0;
-    runtime.path_index = 0;
+    ClearEnemyPath(scene, runtime);
     runtime.last_path_start_cell = {0, 0};
     runtime.last_path_goal_cell = {0, 0};
-    runtime.has_cached_path = false;
+    runtime.path_request_pending = false;
     runtime.replan_elapsed = 0.0;
+    runtime.lod_elapsed = 0.0;
+    runtime.lod_tier = 0;
     runtime.attack_cooldown_seconds = 0.0;
     runtime.is_attacking = false;
     runtime.attack_target_player_id = 0;
-    runtime.dead_elapsed_seconds = 0.0;
-    runtime.last_sync_position = runtime.state.position();
+    runtime.last_sync_x = runtime.state.position().x();
+    runtime.last_sync_y = runtime.state.position().y();
     runtime.last_sync_health = runtime.state.health();
     runtime.last_sync_is_alive = runtime.state.is_alive();
     runtime.force_sync_left = kEnemySpawnForceSyncCount;
     runtime.dirty = false;
     auto [it, _] =
         scene.enemies.emplace(runtime.state.enemy_id(), std::move(runtime));
+    AddAliveEnemyLocked(scene, it->second, 1);
     MarkEnemyDirty(scene, it->first, it->second);
-    alive_enemies += 1;
     return true;
   };
 
@@ -395,9 +433,14 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
     scene.spawn_elapsed += dt_seconds;
     std::size_t spawned = 0;
     while (spawn_interval > 0.0 && scene.spawn_elapsed >= spawn_interval &&
-           alive_enemies < max_enemies_alive && spawned < max_spawn_per_tick) {
+           scene.alive.enemies < max_enemies_alive &&
+           spawned < max_spawn_per_tick) {
       scene.spawn_elapsed -= spawn_interval;
-      if (spawn_enemy(PickSpawnEnemyTypeId(&scene.rng_state))) {
+      // 随机流按即将分配的敌人 id 划分
+      game_manager_rng::RngStream rng(scene.rng_seed, scene.tick,
+                                      game_manager_rng::RngStage::kEnemySpawn,
+                                      scene.next_enemy_id);
+      if (spawn_enemy(PickSpawnEnemyTypeId(&rng), &rng)) {
         spawned += 1;
         *has_dirty = true;
       } else {
@@ -406,69 +449,89 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
     }
   }
 
+  const uint32_t reorder_interval = config_.enemy_reorder_interval_ticks;
+  if (reorder_interval > 0 && scene.tick % reorder_interval == 0 &&
+      scene.enemies.size() > 1) {
+    ReorderEnemiesByMortonLocked(scene);
+  }
+
+  ApplyCompletedPathPlansLocked(scene);
+
   const NavGrid nav{scene.nav_cells_x, scene.nav_cells_y, kNavCellSize};
+  const bool async_planner =
+      path_planner_ != nullptr && scene.path_channel != nullptr;
   const float reach_sq = kEnemyWaypointReachRadius * kEnemyWaypointReachRadius;
   const uint32_t max_replans_per_tick =
       std::max<uint32_t>(1, config_.max_enemy_replan_per_tick);
   uint32_t replans_remaining = max_replans_per_tick;
-
-  auto nearest_player_id = [&](float x, float y) -> uint32_t {
-    uint32_t best_id = 0;
-    float best_dist_sq = std::numeric_limits<float>::infinity();
-    for (const auto& [pid, pr] : scene.players) {
-      if (!pr.state.is_alive()) {
-        continue;
-      }
-      const float dx = pr.state.position().x() - x;
-      const float dy = pr.state.position().y() - y;
-      const float dist_sq = dx * dx + dy * dy;
-      if (dist_sq < best_dist_sq) {
-        best_dist_sq = dist_sq;
-        best_id = pid;
-      }
-    }
-    return best_id;
-  };
-
-  for (auto& [_, enemy] : scene.enemies) {
-    if (!enemy.state.is_alive()) {
-      continue;
-    }
-
-    enemy.attack_cooldown_seconds =
-        std::max(0.0, enemy.attack_cooldown_seconds - dt_seconds);
-
-    auto* pos = enemy.state.mutable_position();
-    const float prev_x = pos->x();
-    const float prev_y = pos->y();
-
-    const uint32_t target_id = nearest_player_id(prev_x, prev_y);
-    if (target_id == 0) {
+  const auto lod = game_manager_lod::MakeLodConfig(
+      config_.enemy_lod_mid_distance, config_.enemy_lod_far_distance,
+      config_.enemy_lod_mid_interval, config_.enemy_lod_far_interval);
+  const float frame_dt = static_cast<float>(dt_seconds);
+
+  const auto steering_begin = std::chrono::steady_clock::now();
+  GatherEnemySteeringLocked(scene, dt_seconds);
+  auto& batch = *scene.steering;
+  const std::size_t steering_count = scene.steering_enemies.size();
+  // 玩家数很少（房间上限默认 4），直接广播给每个敌人块做暴力最近邻
+  game_manager_steering::NearestPlayers(
+      batch.player_xs.data(), batch.player_ys.data(), batch.player_ids.size(),
+      batch.xs.data(), batch.ys.data(), steering_count,
+      batch.nearest_player.data());
+
+  // 标量阶段：目标切换、重算路径、推进路点，得出每个敌人的目标点与速度
+  for (std::size_t i = 0; i < steering_count; ++i) {
+    EnemyRuntime& enemy = *scene.steering_enemies[i];
+    const float prev_x = batch.xs[i];
+    const float prev_y = batch.ys[i];
+    // 无目标时目标点取自身位置，内核中不会移动
+    batch.goal_xs[i] = prev_x;
+    batch.goal_ys[i] = prev_y;
+    batch.speeds[i] = 0.0f;
+    batch.dts[i] = frame_dt;
+
+    const int32_t target_slot = batch.nearest_player[i];
+    if (target_slot < 0) {
+      enemy.lod_tier = 0;
       continue;
     }
-
-    const auto target_it = scene.players.find(target_id);
-    if (target_it == scene.players.end()) {
+    const uint32_t target_id = batch.player_ids[target_slot];
+    const float target_x = batch.player_xs[target_slot];
+    const float target_y = batch.player_ys[target_slot];
+
+    // 远处敌人降频：未轮到的 tick 速度为 0 原地不动，累计时长留到下次更新；
+    // 仍保留 nearest_player，写回阶段照常检查 dirty / force_sync_left，
+    // 降频期间被击中或刚生成的敌人不会漏报
+    const float to_target_x = target_x - prev_x;
+    const float to_target_y = target_y - prev_y;
+    const auto tier = game_manager_lod::ClassifyLod(
+        lod, to_target_x * to_target_x + to_target_y * to_target_y);
+    enemy.lod_tier = static_cast<uint8_t>(tier);
+    enemy.lod_elapsed += dt_seconds;
+    if (!game_manager_lod::ShouldSimulate(lod, tier, scene.tick,
+                                          enemy.state.enemy_id())) {
+      scene.perf.enemy_lod_skips += 1;
       continue;
     }
-
-    const float target_x = target_it->second.state.position().x();
-    const float target_y = target_it->second.state.position().y();
+    const double step_seconds = enemy.lod_elapsed;
+    enemy.lod_elapsed = 0.0;
+    batch.dts[i] = static_cast<float>(step_seconds);
 
     const bool target_changed = (enemy.target_player_id != target_id);
-    enemy.replan_elapsed += dt_seconds;
+    enemy.replan_elapsed += step_seconds;
 
-    const bool path_exhausted = enemy.path_index >= enemy.path.size();
+    const std::size_t path_length = EnemyPathLengthLocked(scene, enemy);
+    const bool path_exhausted = enemy.path_index >= path_length;
     const bool should_replan =
         target_changed || enemy.replan_elapsed >= kEnemyReplanIntervalSeconds ||
         path_exhausted;
 
     if (should_replan) {
       enemy.target_player_id = target_id;
-      if (replans_remaining == 0) {
-        enemy.path.clear();
-        enemy.path_index = 0;
-        enemy.has_cached_path = false;
+      if (enemy.path_request_pending) {
+        // 异步结果返回前沿用当前路点，不重复提交
+      } else if (replans_remaining == 0) {
+        ClearEnemyPath(scene, enemy);
         enemy.last_path_start_cell = {0, 0};
         enemy.last_path_goal_cell = {0, 0};
       } else {
@@ -479,35 +542,68 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
                                 enemy.last_path_start_cell == start_cell &&
                                 enemy.last_path_goal_cell == goal_cell;
 
+        const bool need_path =
+            start_cell != goal_cell && (!same_cells || path_exhausted);
+        game_manager_path_cache::PathRef ref;
+        bool cache_hit = false;
+        if (need_path) {
+          scene.perf.path_cache_lookups += 1;
+          cache_hit = scene.path_cache->Lookup(start_cell, goal_cell, &ref);
+          if (cache_hit) {
+            scene.perf.path_cache_hits += 1;
+          }
+        }
+
         if (start_cell == goal_cell) {
-          enemy.path.clear();
-          enemy.path_index = 0;
-          enemy.has_cached_path = false;
+          ClearEnemyPath(scene, enemy);
           enemy.last_path_start_cell = start_cell;
           enemy.last_path_goal_cell = goal_cell;
-        } else if (!same_cells || path_exhausted) {
-          if (FindPathAstar(nav, start_cell, goal_cell, &enemy.path,
-                            scene.nav_came_from, scene.nav_g_score,
-                            scene.nav_visit_epoch, scene.nav_closed_epoch,
-                            &scene.nav_epoch) &&
-              enemy.path.size() > 1) {
-            enemy.path_index = 1;  // 跳过起点格
-            enemy.has_cached_path = true;
-            enemy.last_path_start_cell = start_cell;
-            enemy.last_path_goal_cell = goal_cell;
+        } else if (!need_path) {
+          // 起终点格未变，继续沿用当前路径
+        } else if (cache_hit) {
+          // 同步、异步寻路都在提交前查缓存，命中即省去一次 A*
+          scene.perf.astar_calls_avoided += 1;
+          AssignEnemyPathLocked(scene, enemy, ref, start_cell, goal_cell);
+        } else if (async_planner) {
+          game_manager_path_planner::PathRequest request;
+          request.enemy_id = enemy.state.enemy_id();
+          request.request_seq = ++enemy.path_request_seq;
+          request.submit_tick = scene.tick;
+          request.grid = nav;
+          request.start = start_cell;
+          request.goal = goal_cell;
+          path_planner_->Submit(scene.path_channel, std::move(request));
+          enemy.path_request_pending = true;
+          scene.perf.astar_calls += 1;
+        } else {
+          auto& path_buffer = scene.nav_scratch->path_buffer;
+          const std::size_t buffer_capacity = path_buffer.capacity();
+          scene.perf.astar_calls += 1;
+          const bool found = FindPathAstar(nav, start_cell, goal_cell,
+                                           &path_buffer,
+                                           scene.nav_scratch.get());
+          if (path_buffer.capacity() != buffer_capacity) {
+            scene.perf.path_replan_allocs += 1;
+          }
+          if (found &&
+              path_buffer.size() > 1 &&
+              scene.path_cache->Insert(start_cell, goal_cell, path_buffer,
+                                       &ref)) {
+            AssignEnemyPathLocked(scene, enemy, ref, start_cell, goal_cell);
           } else {
-            enemy.path.clear();
-            enemy.path_index = 0;
-            enemy.has_cached_path = false;
+            ClearEnemyPath(scene, enemy);
           }
         }
         enemy.replan_elapsed = 0.0;
       }
     }
 
+    // 重算后路径可能已替换，这里重新取长度
+    const std::size_t cur_path_length = EnemyPathLengthLocked(scene, enemy);
     auto select_goal = [&]() -> std::pair<float, float> {
-      if (enemy.path_index < enemy.path.size()) {
-        const auto [cx, cy] = enemy.path[enemy.path_index];
+      if (enemy.path_index < cur_path_length) {
+        const auto [cx, cy] =
+            EnemyPathCellLocked(scene, enemy, enemy.path_index);
         const auto [wx, wy] = CellCenterWorld(nav, cx, cy);
         const auto clamped = ClampToMap(scene.config, wx, wy);
         return {clamped.x(), clamped.y()};
@@ -520,7 +616,7 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
       const float dx = goal.first - prev_x;
       const float dy = goal.second - prev_y;
       const float dist_sq = dx * dx + dy * dy;
-      if (enemy.path_index < enemy.path.size() && dist_sq <= reach_sq) {
+      if (enemy.path_index < cur_path_length && dist_sq <= reach_sq) {
         enemy.path_index += 1;
         goal = select_goal();
         continue;
@@ -528,32 +624,44 @@ void GameManager::ProcessEnemies(Scene& scene, double dt_seconds,
       break;
     }
 
-    const float dx = goal.first - prev_x;
-    const float dy = goal.second - prev_y;
-    const float dist_sq = dx * dx + dy * dy;
-    if (dist_sq > 1e-6f) {
-      const float inv_len = 1.0f / std::sqrt(dist_sq);
-      const float dir_x = dx * inv_len;
-      const float dir_y = dy * inv_len;
-
-      const EnemyTypeConfig& type = ResolveEnemyType(enemy.state.type_id());
-      const float speed = type.move_speed > 0.0f ? type.move_speed : 60.0f;
-
-      const auto new_pos = ClampToMap(
-          scene.config, prev_x + dir_x * speed * static_cast<float>(dt_seconds),
-          prev_y + dir_y * speed * static_cast<float>(dt_seconds));
-      const float new_x = new_pos.x();
-      const float new_y = new_pos.y();
-      if (std::abs(new_x - prev_x) > 1e-4f ||
-          std::abs(new_y - prev_y) > 1e-4f) {
-        pos->set_x(new_x);
-        pos->set_y(new_y);
-        MarkEnemyDirty(scene, enemy.state.enemy_id(), enemy);
-      }
-    }
+    batch.goal_xs[i] = goal.first;
+    batch.goal_ys[i] = goal.second;
+    batch.speeds[i] = EnemyTypeRowAt(enemy.type_slot).move_speed;
+  }
 
+  game_manager_steering::SteerParams steer;
+  steer.map_w = static_cast<float>(scene.config.width);
+  steer.map_h = static_cast<float>(scene.config.height);
+  game_manager_steering::SteerTowardGoals(steer, &batch);
+
+  // 写回位置、标脏，并把最终位置收进敌人索引供本帧开火阶段查询
+  auto& enemy_index = ResetEnemySpatialIndexLocked(scene);
+  for (std::size_t i = 0; i < steering_count; ++i) {
+    EnemyRuntime& enemy = *scene.steering_enemies[i];
+    float x = batch.xs[i];
+    float y = batch.ys[i];
+    if (batch.moved[i] != 0) {
+      x = batch.out_xs[i];
+      y = batch.out_ys[i];
+      auto* pos = enemy.state.mutable_position();
+      pos->set_x(x);
+      pos->set_y(y);
+      MarkEnemyDirty(scene, enemy.state.enemy_id(), enemy);
+    }
+    enemy_index.Insert(enemy.state.enemy_id(), x, y);
+    if (batch.nearest_player[i] < 0) {
+      continue;
+    }
     if (enemy.dirty || enemy.force_sync_left > 0) {
       *has_dirty = true;
     }
   }
+  enemy_index.Build();
+  scene.enemy_spatial_tick = scene.tick + 1;
+  scene.steering_enemies.clear();
+  scene.perf.steering_ns += static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - steering_begin)
+          .count());
+  scene.perf.steering_enemies += steering_count;
 }
@@ -1,15 +1,25 @@
 #include "internal/game_manager_event_dispatch.hpp"
 
+#include <cstring>
+#include <memory>
 #include <span>
 #include <spdlog/spdlog.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "game/managers/room_manager.hpp"
 #include "internal/game_manager_internal_utils.hpp"
+#include "network/packet_codec.hpp"
 #include "network/tcp/tcp_session.hpp"
+#include "network/udp/udp_server.hpp"
 
 namespace {
 using game_manager_internal::NowMs;
 
+// 每 tick 至多各一条的事件消息：射弹生成/销毁、掉落、敌人攻击态、升级请求、结算
+constexpr std::size_t kFixedTickEventKinds = 6;
+
 struct TickEventMessages {
   bool has_projectile_spawn = false;
   bool has_projectile_despawn = false;
@@ -111,18 +121,147 @@ void LogGameOverSummary(
 }
 
 bool HasTickEventsToBroadcast(
-    const TickEventMessages& messages,
+    const std::vector<lawnmower::ProjectileState>& projectile_spawns,
+    const std::vector<lawnmower::ProjectileDespawn>& projectile_despawns,
+    const std::vector<lawnmower::ItemState>& dropped_items,
+    const std::vector<lawnmower::EnemyAttackStateDelta>& enemy_attack_states,
     const std::vector<lawnmower::S2C_PlayerHurt>& player_hurts,
     const std::vector<lawnmower::S2C_EnemyDied>& enemy_dieds,
     const std::vector<lawnmower::S2C_PlayerLevelUp>& level_ups,
     const std::optional<lawnmower::S2C_GameOver>& game_over,
     const std::optional<lawnmower::S2C_UpgradeRequest>& upgrade_request) {
-  return messages.has_projectile_spawn || messages.has_projectile_despawn ||
-         messages.has_dropped_items || messages.has_enemy_attack_state ||
+  return !projectile_spawns.empty() || !projectile_despawns.empty() ||
+         !dropped_items.empty() || !enemy_attack_states.empty() ||
          !player_hurts.empty() || !enemy_dieds.empty() || !level_ups.empty() ||
          game_over.has_value() || upgrade_request.has_value();
 }
 
+struct ReliableTarget {
+  uint32_t player_id = 0;
+  std::weak_ptr<TcpSession> session;  // 退回 TCP 时的投递会话
+  bool use_udp = false;  // 本 tick 可入队；否则先补发未确认消息再走 TCP
+};
+
+// 按协商结果拆分：协商了可靠通道的玩家归入 reliable_targets（终端有效且
+// allow_udp 时经 UDP 收 S2C_TickEvents），其余支持合包的会话经 TCP 收，
+// 剩下的走逐条发送。udp_server 为空表示没有可靠通道
+void PartitionSessionsByTickEvents(
+    const std::vector<std::weak_ptr<TcpSession>>& sessions,
+    UdpServer* udp_server, bool allow_udp,
+    std::vector<ReliableTarget>* reliable_targets,
+    std::vector<std::weak_ptr<TcpSession>>* envelope_sessions,
+    std::vector<std::weak_ptr<TcpSession>>* legacy_sessions) {
+  if (reliable_targets == nullptr || envelope_sessions == nullptr ||
+      legacy_sessions == nullptr) {
+    return;
+  }
+  envelope_sessions->reserve(sessions.size());
+  legacy_sessions->reserve(sessions.size());
+  for (const auto& weak_session : sessions) {
+    const auto session = weak_session.lock();
+    if (!session) {
+      continue;
+    }
+    const uint32_t reliable_player_id = session->ReliableUdpPlayerId();
+    if (udp_server != nullptr && reliable_player_id != 0) {
+      reliable_targets->push_back(ReliableTarget{
+          reliable_player_id, weak_session,
+          allow_udp && udp_server->HasEndpoint(reliable_player_id)});
+    } else if (session->SupportsTickEvents()) {
+      envelope_sessions->push_back(weak_session);
+    } else {
+      legacy_sessions->push_back(weak_session);
+    }
+  }
+}
+
+template <typename T>
+void AppendRepeated(const std::vector<T>& src,
+                    google::protobuf::RepeatedPtrField<T>* dst) {
+  if (dst == nullptr || src.empty()) {
+    return;
+  }
+  dst->Reserve(static_cast<int>(src.size()));
+  for (const auto& item : src) {
+    *dst->Add() = item;
+  }
+}
+
+// 单 tick 全部事件合成一条消息，字段顺序即旧路径的发送顺序
+void BuildTickEventsEnvelope(
+    uint32_t room_id, uint64_t event_tick, uint32_t event_wave_id,
+    uint64_t event_now_count,
+    const std::vector<lawnmower::ProjectileState>& projectile_spawns,
+    const std::vector<lawnmower::ProjectileDespawn>& projectile_despawns,
+    const std::vector<lawnmower::ItemState>& dropped_items,
+    const std::vector<lawnmower::EnemyAttackStateDelta>& enemy_attack_states,
+    const std::vector<lawnmower::S2C_PlayerHurt>& player_hurts,
+    const std::vector<lawnmower::S2C_EnemyDied>& enemy_dieds,
+    const std::vector<lawnmower::S2C_PlayerLevelUp>& level_ups,
+    const std::optional<lawnmower::S2C_GameOver>& game_over,
+    const std::optional<lawnmower::S2C_UpgradeRequest>& upgrade_request,
+    lawnmower::S2C_TickEvents* out) {
+  if (out == nullptr) {
+    return;
+  }
+  FillTickEventSyncTime(out, event_now_count, event_tick);
+  out->set_room_id(room_id);
+  if (!dropped_items.empty()) {
+    out->set_wave_id(event_wave_id);
+  }
+  AppendRepeated(projectile_spawns, out->mutable_projectile_spawns());
+  AppendRepeated(projectile_despawns, out->mutable_projectile_despawns());
+  AppendRepeated(dropped_items, out->mutable_dropped_items());
+  AppendRepeated(enemy_attack_states, out->mutable_enemy_attack_states());
+  AppendRepeated(player_hurts, out->mutable_player_hurts());
+  AppendRepeated(enemy_dieds, out->mutable_enemy_dieds());
+  AppendRepeated(level_ups, out->mutable_level_ups());
+  if (upgrade_request.has_value()) {
+    *out->mutable_upgrade_request() = *upgrade_request;
+  }
+  if (game_over.has_value()) {
+    *out->mutable_game_over() = *game_over;
+  }
+}
+
+// 可靠通道玩家退回 TCP：先把未确认的可靠消息按 seq 经 TCP 补发，再发本
+// tick 合包，保证客户端看到的事件顺序与可靠通道一致
+void DrainReliableToSession(UdpServer& udp_server, uint32_t player_id,
+                            TcpSession& session) {
+  std::vector<reliable_channel::DrainedMessage> drained;
+  udp_server.DrainReliable(player_id, &drained);
+  for (const auto& message : drained) {
+    if (message.payload == nullptr) {
+      continue;
+    }
+    const auto& payload = *message.payload;
+    auto framed = packet_codec::EncodeFramed(
+        message.type, payload.size(), [&payload](uint8_t* target_bytes) {
+          std::memcpy(target_bytes, payload.data(), payload.size());
+          return target_bytes + payload.size();
+        });
+    if (framed.bytes == nullptr) {
+      spdlog::error("补发可靠消息编码失败 player_id={}", player_id);
+      continue;
+    }
+    session.SendEncoded(framed);
+  }
+  if (!drained.empty()) {
+    spdlog::debug("可靠通道退回 TCP player_id={} 补发 {} 条", player_id,
+                  drained.size());
+  }
+}
+
+void SendReliableFallback(UdpServer& udp_server, const ReliableTarget& target,
+                          const packet_codec::EncodedPacket& packet) {
+  const auto session = target.session.lock();
+  if (!session) {
+    return;
+  }
+  DrainReliableToSession(udp_server, target.player_id, *session);
+  session->SendEncoded(packet);
+}
+
 void SendTickEventsToSessions(
     std::span<const std::weak_ptr<TcpSession>> sessions,
     const TickEventMessages& messages,
@@ -131,44 +270,58 @@ void SendTickEventsToSessions(
     const std::vector<lawnmower::S2C_PlayerLevelUp>& level_ups,
     const std::optional<lawnmower::S2C_GameOver>& game_over,
     const std::optional<lawnmower::S2C_UpgradeRequest>& upgrade_request) {
+  // 每条消息只编码一次，按原有顺序依次投递到各会话（共享帧缓冲）
+  std::vector<packet_codec::EncodedPacket> packets;
+  packets.reserve(kFixedTickEventKinds + player_hurts.size() +
+                  enemy_dieds.size() + level_ups.size());
+  const auto encode = [&packets](lawnmower::MessageType type,
+                                 const google::protobuf::Message& message) {
+    auto packet = packet_codec::EncodeFramed(type, message);
+    if (packet.bytes == nullptr) {
+      spdlog::error("编码事件消息失败: type {}", static_cast<int>(type));
+      return;
+    }
+    packets.push_back(std::move(packet));
+  };
+  if (messages.has_projectile_spawn) {
+    encode(lawnmower::MessageType::MSG_S2C_PROJECTILE_SPAWN,
+           messages.projectile_spawn_msg);
+  }
+  if (messages.has_projectile_despawn) {
+    encode(lawnmower::MessageType::MSG_S2C_PROJECTILE_DESPAWN,
+           messages.projectile_despawn_msg);
+  }
+  if (messages.has_dropped_items) {
+    encode(lawnmower::MessageType::MSG_S2C_DROPPED_ITEM,
+           messages.dropped_item_msg);
+  }
+  if (messages.has_enemy_attack_state) {
+    encode(lawnmower::MessageType::MSG_S2C_ENEMY_ATTACK_STATE_SYNC,
+           messages.enemy_attack_state_msg);
+  }
+  for (const auto& hurt : player_hurts) {
+    encode(lawnmower::MessageType::MSG_S2C_PLAYER_HURT, hurt);
+  }
+  for (const auto& died : enemy_dieds) {
+    encode(lawnmower::MessageType::MSG_S2C_ENEMY_DIED, died);
+  }
+  for (const auto& level_up : level_ups) {
+    encode(lawnmower::MessageType::MSG_S2C_PLAYER_LEVEL_UP, level_up);
+  }
+  if (upgrade_request.has_value()) {
+    encode(lawnmower::MessageType::MSG_S2C_UPGRADE_REQUEST, *upgrade_request);
+  }
+  if (game_over.has_value()) {
+    encode(lawnmower::MessageType::MSG_S2C_GAME_OVER, *game_over);
+  }
+
   for (const auto& weak_session : sessions) {
     auto session = weak_session.lock();
     if (!session) {
       continue;
     }
-    if (messages.has_projectile_spawn) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_PROJECTILE_SPAWN,
-                         messages.projectile_spawn_msg);
-    }
-    if (messages.has_projectile_despawn) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_PROJECTILE_DESPAWN,
-                         messages.projectile_despawn_msg);
-    }
-    if (messages.has_dropped_items) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_DROPPED_ITEM,
-                         messages.dropped_item_msg);
-    }
-    if (messages.has_enemy_attack_state) {
-      session->SendProto(
-          lawnmower::MessageType::MSG_S2C_ENEMY_ATTACK_STATE_SYNC,
-          messages.enemy_attack_state_msg);
-    }
-    for (const auto& hurt : player_hurts) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_PLAYER_HURT, hurt);
-    }
-    for (const auto& died : enemy_dieds) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_ENEMY_DIED, died);
-    }
-    for (const auto& level_up : level_ups) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_PLAYER_LEVEL_UP,
-                         level_up);
-    }
-    if (upgrade_request.has_value()) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_UPGRADE_REQUEST,
-                         *upgrade_request);
-    }
-    if (game_over.has_value()) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_GAME_OVER, *game_over);
+    for (const auto& packet : packets) {
+      session->SendEncoded(packet);
     }
   }
 }
@@ -177,7 +330,8 @@ void SendTickEventsToSessions(
 namespace game_manager_event_dispatch {
 
 void DispatchTickEvents(
-    uint32_t room_id, uint64_t event_tick, uint32_t event_wave_id,
+    uint32_t room_id, UdpServer* udp_server, uint64_t event_tick,
+    uint32_t event_wave_id,
     const std::vector<lawnmower::ProjectileState>& projectile_spawns,
     const std::vector<lawnmower::ProjectileDespawn>& projectile_despawns,
     const std::vector<lawnmower::ItemState>& dropped_items,
@@ -187,21 +341,89 @@ void DispatchTickEvents(
     const std::vector<lawnmower::S2C_PlayerLevelUp>& level_ups,
     const std::optional<lawnmower::S2C_GameOver>& game_over,
     const std::optional<lawnmower::S2C_UpgradeRequest>& upgrade_request) {
-  const uint64_t event_now_count = static_cast<uint64_t>(NowMs().count());
-  TickEventMessages tick_event_messages;
-  BuildTickEventMessages(room_id, event_tick, event_wave_id, event_now_count,
-                         projectile_spawns, projectile_despawns, dropped_items,
-                         enemy_attack_states, &tick_event_messages);
-
   LogGameOverSummary(room_id, game_over);
 
-  if (HasTickEventsToBroadcast(tick_event_messages, player_hurts, enemy_dieds,
-                               level_ups, game_over, upgrade_request)) {
-    const auto sessions = RoomManager::Instance().GetRoomSessions(room_id);
-    SendTickEventsToSessions(sessions, tick_event_messages, player_hurts,
-                             enemy_dieds, level_ups, game_over,
+  if (!HasTickEventsToBroadcast(projectile_spawns, projectile_despawns,
+                                dropped_items, enemy_attack_states,
+                                player_hurts, enemy_dieds, level_ups,
+                                game_over, upgrade_request)) {
+    return;
+  }
+
+  const auto sessions = RoomManager::Instance().GetRoomSessions(room_id);
+  // 结算后不再有 tick 驱动可靠通道重发，升级请求也须立即送达，所在 tick
+  // 整体走 TCP（可靠通道玩家先补发未确认消息，顺序不变）
+  const bool allow_udp = !game_over.has_value() && !upgrade_request.has_value();
+  std::vector<ReliableTarget> reliable_targets;
+  std::vector<std::weak_ptr<TcpSession>> envelope_sessions;
+  std::vector<std::weak_ptr<TcpSession>> legacy_sessions;
+  PartitionSessionsByTickEvents(sessions, udp_server, allow_udp,
+                                &reliable_targets, &envelope_sessions,
+                                &legacy_sessions);
+  const uint64_t event_now_count = static_cast<uint64_t>(NowMs().count());
+
+  if (!legacy_sessions.empty()) {
+    TickEventMessages tick_event_messages;
+    BuildTickEventMessages(room_id, event_tick, event_wave_id,
+                           event_now_count, projectile_spawns,
+                           projectile_despawns, dropped_items,
+                           enemy_attack_states, &tick_event_messages);
+    SendTickEventsToSessions(legacy_sessions, tick_event_messages,
+                             player_hurts, enemy_dieds, level_ups, game_over,
                              upgrade_request);
   }
+
+  if (reliable_targets.empty() && envelope_sessions.empty()) {
+    return;
+  }
+  lawnmower::S2C_TickEvents envelope;
+  BuildTickEventsEnvelope(room_id, event_tick, event_wave_id, event_now_count,
+                          projectile_spawns, projectile_despawns,
+                          dropped_items, enemy_attack_states, player_hurts,
+                          enemy_dieds, level_ups, game_over, upgrade_request,
+                          &envelope);
+
+  std::vector<ReliableTarget> fallback_targets;
+  if (!reliable_targets.empty()) {
+    // 序列化一次，各玩家的可靠通道共享同一份 payload
+    const auto payload =
+        std::make_shared<const std::string>(envelope.SerializeAsString());
+    for (const auto& target : reliable_targets) {
+      if (!target.use_udp ||
+          !udp_server->QueueReliable(
+              target.player_id, lawnmower::MessageType::MSG_S2C_TICK_EVENTS,
+              payload)) {
+        fallback_targets.push_back(target);
+      }
+    }
+  }
+
+  if (envelope_sessions.empty() && fallback_targets.empty()) {
+    return;
+  }
+  const auto packet = packet_codec::EncodeFramed(
+      lawnmower::MessageType::MSG_S2C_TICK_EVENTS, envelope);
+  if (packet.bytes == nullptr) {
+    spdlog::error("编码 S2C_TickEvents 失败: room_id={}", room_id);
+    return;
+  }
+  if (!envelope_sessions.empty()) {
+    TcpSession::BroadcastEncoded(envelope_sessions, packet);
+  }
+  for (const auto& target : fallback_targets) {
+    SendReliableFallback(*udp_server, target, packet);
+  }
+}
+
+void ReleaseReliableChannel(UdpServer* udp_server, uint32_t player_id,
+                            const std::shared_ptr<TcpSession>& session) {
+  if (udp_server == nullptr || player_id == 0) {
+    return;
+  }
+  if (session) {
+    DrainReliableToSession(*udp_server, player_id, *session);
+  }
+  udp_server->ResetReliable(player_id);
 }
 
 }  // namespace game_manager_event_dispatch
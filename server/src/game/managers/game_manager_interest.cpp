@@ -0,0 +1,91 @@
+#include "internal/game_manager_interest.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace game_manager_interest {
+
+void UpdateInterestSet(const game_manager_spatial::SpatialIndex& index,
+                       float x, float y, const InterestParams& params,
+                       const std::vector<uint32_t>& previous,
+                       InterestUpdate* out) {
+  if (out == nullptr) {
+    return;
+  }
+  out->ids.clear();
+  out->entered.clear();
+  out->left.clear();
+
+  const float enter_w = params.half_width + params.margin;
+  const float enter_h = params.half_height + params.margin;
+  const float leave_w = enter_w + params.margin;
+  const float leave_h = enter_h + params.margin;
+  index.QueryRect(x - enter_w, y - enter_h, x + enter_w, y + enter_h,
+                  &out->inner);
+  index.QueryRect(x - leave_w, y - leave_h, x + leave_w, y + leave_h,
+                  &out->outer);
+
+  // 新兴趣集 = 进入矩形内的全部 + 离开矩形内且原本就在集合里的
+  // （进入矩形包含在离开矩形内，遍历 outer 即可保持升序）
+  for (const auto id : out->outer) {
+    if (std::binary_search(out->inner.begin(), out->inner.end(), id) ||
+        std::binary_search(previous.begin(), previous.end(), id)) {
+      out->ids.push_back(id);
+    }
+  }
+  std::set_difference(out->ids.begin(), out->ids.end(), previous.begin(),
+                      previous.end(), std::back_inserter(out->entered));
+  std::set_difference(previous.begin(), previous.end(), out->ids.begin(),
+                      out->ids.end(), std::back_inserter(out->left));
+}
+
+void FilterDeltaFrame(const delta_wire::DeltaFrame& shared,
+                      const InterestUpdate& update,
+                      delta_wire::DeltaFrame* out) {
+  if (out == nullptr) {
+    return;
+  }
+  out->has_sync_time = shared.has_sync_time;
+  out->server_time_ms = shared.server_time_ms;
+  out->tick = shared.tick;
+  out->room_id = shared.room_id;
+  out->players = shared.players;
+  out->items = shared.items;
+  out->enemies.clear();
+  for (const auto& enemy : shared.enemies) {
+    if (std::binary_search(update.ids.begin(), update.ids.end(),
+                           enemy.enemy_id) &&
+        !std::binary_search(update.entered.begin(), update.entered.end(),
+                            enemy.enemy_id)) {
+      out->enemies.push_back(enemy);
+    }
+  }
+  out->removed_enemy_ids = update.left;
+}
+
+void AdvanceEnteredResync(const InterestUpdate& update, uint32_t count,
+                          std::vector<std::pair<uint32_t, uint32_t>>* resync,
+                          std::vector<uint32_t>* due) {
+  if (resync == nullptr || due == nullptr) {
+    return;
+  }
+  due->clear();
+  std::erase_if(*resync, [&update, due](auto& entry) {
+    if (!std::binary_search(update.ids.begin(), update.ids.end(),
+                            entry.first)) {
+      return true;
+    }
+    due->push_back(entry.first);
+    entry.second -= 1;
+    return entry.second == 0;
+  });
+  if (count == 0 || update.entered.empty()) {
+    return;
+  }
+  for (const auto enemy_id : update.entered) {
+    resync->emplace_back(enemy_id, count);
+  }
+  std::sort(resync->begin(), resync->end());
+}
+
+}  // namespace game_manager_interest
@@ -33,4 +33,16 @@ void FillDeltaTiming(uint32_t room_id, uint64_t tick,
   ts->set_tick(static_cast<uint32_t>(tick));
 }
 
+void FillDeltaTiming(uint32_t room_id, uint64_t tick,
+                     delta_wire::DeltaFrame* frame) {
+  if (frame == nullptr) {
+    return;
+  }
+
+  frame->room_id = room_id;
+  frame->has_sync_time = true;
+  frame->server_time_ms = static_cast<uint64_t>(NowMs().count());
+  frame->tick = static_cast<uint32_t>(tick);
+}
+
 }  // namespace game_manager_internal
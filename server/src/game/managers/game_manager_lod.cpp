@@ -0,0 +1,23 @@
+#include "internal/game_manager_lod.hpp"
+
+#include <algorithm>
+
+namespace game_manager_lod {
+
+LodConfig MakeLodConfig(float mid_distance, float far_distance,
+                        uint32_t mid_interval, uint32_t far_interval) {
+  LodConfig config;
+  if (mid_distance <= 0.0f) {
+    return config;
+  }
+  config.mid_distance_sq = mid_distance * mid_distance;
+  config.mid_interval = std::max<uint32_t>(1, mid_interval);
+  if (far_distance > 0.0f) {
+    const float far = std::max(far_distance, mid_distance);
+    config.far_distance_sq = far * far;
+    config.far_interval = std::max(config.mid_interval, far_interval);
+  }
+  return config;
+}
+
+}  // namespace game_manager_lod
@@ -110,11 +110,13 @@ void GameManager::StartGameLoop(uint32_t room_id) {
     timer = std::make_shared<asio::steady_timer>(*io_context_);
     scene.loop_timer = timer;
     scene.tick = 0;
+    scene.sim_tick = 0;
     scene.sync_accumulator = 0.0;
     scene.sync_idle_elapsed = 0.0;
     scene.full_sync_elapsed = 0.0;
     scene.last_tick_time = std::chrono::steady_clock::now();
     scene.next_tick_time = std::chrono::steady_clock::time_point{};
+    scene.step_accumulator = std::chrono::steady_clock::duration::zero();
     scene.dynamic_sync_interval = scene.sync_interval;
     ResetPerfStats(scene);
   }
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "game/managers/game_manager.hpp"
+#include "internal/game_manager_simd.hpp"
 
 namespace {
 constexpr const char* kPerfRootDir = "server_metrics";
@@ -76,6 +77,18 @@ void GameManager::ResetPerfStats(Scene& scene) {
   scene.perf.max_ms = 0.0;
   scene.perf.min_ms = 0.0;
   scene.perf.tick_count = 0;
+  scene.perf.path_cache_lookups = 0;
+  scene.perf.path_cache_hits = 0;
+  scene.perf.astar_calls = 0;
+  scene.perf.astar_calls_avoided = 0;
+  scene.perf.path_inline_assigns = 0;
+  scene.perf.path_arena_assigns = 0;
+  scene.perf.path_replan_allocs = 0;
+  scene.perf.steering_ns = 0;
+  scene.perf.steering_enemies = 0;
+  scene.perf.enemy_reorders = 0;
+  scene.perf.enemy_reorder_ns = 0;
+  scene.perf.enemy_lod_skips = 0;
   scene.perf.start_time = std::chrono::system_clock::now();
   scene.perf.end_time = scene.perf.start_time;
 }
@@ -201,6 +214,61 @@ void GameManager::SavePerfStatsToFile(uint32_t room_id, const PerfStats& stats,
       << dirty_enemy_ratio << ",\n";
   out << "  \"dirty_item_ratio\": " << std::fixed << std::setprecision(6)
       << dirty_item_ratio << ",\n";
+  const double path_cache_hit_rate =
+      stats.path_cache_lookups > 0
+          ? static_cast<double>(stats.path_cache_hits) /
+                static_cast<double>(stats.path_cache_lookups)
+          : 0.0;
+  out << "  \"path_cache_lookups\": " << stats.path_cache_lookups << ",\n";
+  out << "  \"path_cache_hits\": " << stats.path_cache_hits << ",\n";
+  out << "  \"path_cache_hit_rate\": " << std::fixed << std::setprecision(6)
+      << path_cache_hit_rate << ",\n";
+  out << "  \"astar_calls\": " << stats.astar_calls << ",\n";
+  out << "  \"astar_calls_avoided\": " << stats.astar_calls_avoided << ",\n";
+  // 每个敌人的常驻字节数（路径内联缓冲已计入；arena 为场景共享，单独统计）
+  constexpr std::size_t kEnemyPathBytes =
+      sizeof(EnemyRuntime::path_offset) +
+      sizeof(EnemyRuntime::path_generation) +
+      sizeof(EnemyRuntime::path_length) + sizeof(EnemyRuntime::path_index) +
+      sizeof(EnemyRuntime::path_inline) + sizeof(EnemyRuntime::path_cells);
+  const double replan_allocs_per_second =
+      elapsed_seconds > 0.0
+          ? static_cast<double>(stats.path_replan_allocs) / elapsed_seconds
+          : 0.0;
+  out << "  \"enemy_runtime_bytes\": " << sizeof(EnemyRuntime) << ",\n";
+  out << "  \"enemy_path_bytes\": " << kEnemyPathBytes << ",\n";
+  out << "  \"path_inline_assigns\": " << stats.path_inline_assigns << ",\n";
+  out << "  \"path_arena_assigns\": " << stats.path_arena_assigns << ",\n";
+  out << "  \"path_replan_allocs\": " << stats.path_replan_allocs << ",\n";
+  out << "  \"path_replan_allocs_per_second\": " << std::fixed
+      << std::setprecision(3) << replan_allocs_per_second << ",\n";
+  const double steering_ns_per_enemy =
+      stats.steering_enemies > 0
+          ? static_cast<double>(stats.steering_ns) /
+                static_cast<double>(stats.steering_enemies)
+          : 0.0;
+  out << "  \"simd_level\": \""
+      << game_manager_simd::SimdLevelName(game_manager_simd::ActiveSimdLevel())
+      << "\",\n";
+  out << "  \"steering_enemies\": " << stats.steering_enemies << ",\n";
+  out << "  \"steering_ns_per_enemy\": " << std::fixed << std::setprecision(1)
+      << steering_ns_per_enemy << ",\n";
+  const double enemy_reorder_us_avg =
+      stats.enemy_reorders > 0
+          ? static_cast<double>(stats.enemy_reorder_ns) / 1000.0 /
+                static_cast<double>(stats.enemy_reorders)
+          : 0.0;
+  out << "  \"enemy_reorders\": " << stats.enemy_reorders << ",\n";
+  out << "  \"enemy_reorder_us_avg\": " << std::fixed << std::setprecision(1)
+      << enemy_reorder_us_avg << ",\n";
+  const double enemy_lod_skip_ratio =
+      stats.steering_enemies > 0
+          ? static_cast<double>(stats.enemy_lod_skips) /
+                static_cast<double>(stats.steering_enemies)
+          : 0.0;
+  out << "  \"enemy_lod_skips\": " << stats.enemy_lod_skips << ",\n";
+  out << "  \"enemy_lod_skip_ratio\": " << std::fixed << std::setprecision(3)
+      << enemy_lod_skip_ratio << ",\n";
   out << "  \"samples\": [\n";
   for (std::size_t i = 0; i < stats.samples.size(); ++i) {
     const auto& sample = stats.samples[i];
@@ -1,9 +1,10 @@
 #include "internal/game_manager_misc_utils.hpp"
 
 #include <cmath>
-#include <numbers>
 #include <unordered_set>
 
+#include "internal/game_manager_fastmath.hpp"
+
 namespace {
 constexpr float kDirectionEpsilonSq =
     1e-6f;  // 方向向量长度平方的极小阈值，小于此视为无效输入
@@ -71,8 +72,7 @@ float DegreesFromDirection(float x, float y) {
   if (std::abs(x) < kDirectionEpsilonSq && std::abs(y) < kDirectionEpsilonSq) {
     return 0.0f;
   }
-  const float angle_rad = std::atan2(y, x);
-  return angle_rad * 180.0f / std::numbers::pi_v<float>;
+  return game_manager_fastmath::FastAtan2Deg(y, x);
 }
 
 }  // namespace game_manager_misc_utils
@@ -0,0 +1,237 @@
+#include "internal/game_manager_nav.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace {
+using game_manager_nav::NavCell;
+using game_manager_nav::NavGrid;
+
+int ClampInt(int v, int lo, int hi) { return std::min(std::max(v, lo), hi); }
+
+int ToIndex(const NavGrid& grid, int x, int y) { return y * grid.cells_x + x; }
+
+float Heuristic(const NavCell& a, const NavCell& b) {
+  const float dx = static_cast<float>(a.first - b.first);
+  const float dy = static_cast<float>(a.second - b.second);
+  return std::sqrt(dx * dx + dy * dy);
+}
+}  // namespace
+
+namespace game_manager_nav {
+
+NavCell WorldToCell(const NavGrid& grid, float x, float y) {
+  const int cx =
+      ClampInt(static_cast<int>(x / static_cast<float>(grid.cell_size)), 0,
+               std::max(0, grid.cells_x - 1));
+  const int cy =
+      ClampInt(static_cast<int>(y / static_cast<float>(grid.cell_size)), 0,
+               std::max(0, grid.cells_y - 1));
+  return {cx, cy};
+}
+
+std::pair<float, float> CellCenterWorld(const NavGrid& grid, int cx, int cy) {
+  const float fx =
+      (static_cast<float>(cx) + 0.5f) * static_cast<float>(grid.cell_size);
+  const float fy =
+      (static_cast<float>(cy) + 0.5f) * static_cast<float>(grid.cell_size);
+  return {fx, fy};
+}
+
+void NavScratch::Reserve(std::size_t cells) {
+  if (came_from.size() == cells) {
+    return;
+  }
+  came_from.assign(cells, -1);
+  g_score.assign(cells, std::numeric_limits<float>::infinity());
+  f_score.assign(cells, std::numeric_limits<float>::infinity());
+  visit_epoch.assign(cells, 0);
+  closed_epoch.assign(cells, 0);
+  heap_pos.assign(cells, -1);
+  heap.clear();
+  heap.reserve(cells);
+  epoch = 0;
+}
+
+bool FindPathAstar(const NavGrid& grid, const NavCell& start,
+                   const NavCell& goal, std::vector<NavCell>* out_path,
+                   NavScratch* scratch) {
+  if (out_path == nullptr) {
+    return false;
+  }
+  out_path->clear();
+  if (scratch == nullptr || grid.cells_x <= 0 || grid.cells_y <= 0) {
+    return false;
+  }
+
+  const int total = grid.cells_x * grid.cells_y;
+  if (total <= 0) {
+    return false;
+  }
+  auto inside = [&grid](const NavCell& cell) {
+    return cell.first >= 0 && cell.second >= 0 && cell.first < grid.cells_x &&
+           cell.second < grid.cells_y;
+  };
+  if (!inside(start) || !inside(goal)) {
+    return false;
+  }
+
+  NavScratch& s = *scratch;
+  s.Reserve(static_cast<std::size_t>(total));
+  uint32_t epoch = ++s.epoch;
+  if (epoch == 0) {
+    std::fill(s.visit_epoch.begin(), s.visit_epoch.end(), 0u);
+    std::fill(s.closed_epoch.begin(), s.closed_epoch.end(), 0u);
+    s.epoch = 1;
+    epoch = 1;
+  }
+
+  const int start_idx = ToIndex(grid, start.first, start.second);
+  const int goal_idx = ToIndex(grid, goal.first, goal.second);
+
+  // 索引堆：f 小者优先，f 相同按格子索引，保证结果与提交线程无关
+  auto less = [&s](int a, int b) {
+    const float fa = s.f_score[static_cast<std::size_t>(a)];
+    const float fb = s.f_score[static_cast<std::size_t>(b)];
+    return fa < fb || (fa == fb && a < b);
+  };
+  auto place = [&s](std::size_t pos, int idx) {
+    s.heap[pos] = idx;
+    s.heap_pos[static_cast<std::size_t>(idx)] = static_cast<int>(pos);
+  };
+  auto sift_up = [&](std::size_t pos) {
+    const int idx = s.heap[pos];
+    while (pos > 0) {
+      const std::size_t parent = (pos - 1) / 2;
+      if (!less(idx, s.heap[parent])) {
+        break;
+      }
+      place(pos, s.heap[parent]);
+      pos = parent;
+    }
+    place(pos, idx);
+  };
+  auto sift_down = [&](std::size_t pos) {
+    const std::size_t size = s.heap.size();
+    const int idx = s.heap[pos];
+    while (true) {
+      std::size_t child = pos * 2 + 1;
+      if (child >= size) {
+        break;
+      }
+      if (child + 1 < size && less(s.heap[child + 1], s.heap[child])) {
+        child += 1;
+      }
+      if (!less(s.heap[child], idx)) {
+        break;
+      }
+      place(pos, s.heap[child]);
+      pos = child;
+    }
+    place(pos, idx);
+  };
+  auto pop_min = [&]() {
+    const int top = s.heap.front();
+    const int last = s.heap.back();
+    s.heap.pop_back();
+    if (!s.heap.empty()) {
+      s.heap[0] = last;
+      sift_down(0);
+    }
+    s.heap_pos[static_cast<std::size_t>(top)] = -1;
+    return top;
+  };
+
+  s.heap.clear();
+  s.visit_epoch[static_cast<std::size_t>(start_idx)] = epoch;
+  s.came_from[static_cast<std::size_t>(start_idx)] = -1;
+  s.g_score[static_cast<std::size_t>(start_idx)] = 0.0f;
+  s.f_score[static_cast<std::size_t>(start_idx)] = Heuristic(start, goal);
+  s.heap.push_back(start_idx);
+  sift_up(0);
+
+  constexpr std::array<std::pair<int, int>, 8> kDirs = {{
+      {1, 0},
+      {-1, 0},
+      {0, 1},
+      {0, -1},
+      {1, 1},
+      {1, -1},
+      {-1, 1},
+      {-1, -1},
+  }};
+
+  bool found = false;
+  while (!s.heap.empty()) {
+    const int cur_idx = pop_min();
+    if (cur_idx == goal_idx) {
+      found = true;
+      break;
+    }
+    s.closed_epoch[static_cast<std::size_t>(cur_idx)] = epoch;
+
+    const int cx = cur_idx % grid.cells_x;
+    const int cy = cur_idx / grid.cells_x;
+    const float cur_g = s.g_score[static_cast<std::size_t>(cur_idx)];
+
+    for (const auto& [dx, dy] : kDirs) {
+      const int nx = cx + dx;
+      const int ny = cy + dy;
+      if (nx < 0 || ny < 0 || nx >= grid.cells_x || ny >= grid.cells_y) {
+        continue;
+      }
+      const int nidx = ToIndex(grid, nx, ny);
+      const std::size_t n = static_cast<std::size_t>(nidx);
+      if (s.closed_epoch[n] == epoch) {
+        continue;
+      }
+
+      const float step_cost =
+          (dx == 0 || dy == 0) ? 1.0f : std::numbers::sqrt2_v<float>;
+      const float tentative_g = cur_g + step_cost;
+      const bool visited = s.visit_epoch[n] == epoch;
+      if (visited && tentative_g >= s.g_score[n]) {
+        continue;
+      }
+
+      s.came_from[n] = cur_idx;
+      s.g_score[n] = tentative_g;
+      s.f_score[n] = tentative_g + Heuristic(NavCell{nx, ny}, goal);
+      if (visited) {
+        // 已在开放列表中：decrease-key，原地上浮
+        sift_up(static_cast<std::size_t>(s.heap_pos[n]));
+      } else {
+        s.visit_epoch[n] = epoch;
+        s.heap.push_back(nidx);
+        sift_up(s.heap.size() - 1);
+      }
+    }
+  }
+
+  if (!found) {
+    return false;
+  }
+
+  // 回溯路径（goal -> start），再原地翻转
+  int cur = goal_idx;
+  while (cur >= 0 && cur < total &&
+         s.visit_epoch[static_cast<std::size_t>(cur)] == epoch) {
+    out_path->push_back({cur % grid.cells_x, cur / grid.cells_x});
+    if (cur == start_idx) {
+      break;
+    }
+    cur = s.came_from[static_cast<std::size_t>(cur)];
+  }
+
+  if (out_path->empty() || cur != start_idx) {
+    out_path->clear();
+    return false;
+  }
+  std::reverse(out_path->begin(), out_path->end());
+  return true;
+}
+
+}  // namespace game_manager_nav
@@ -0,0 +1,91 @@
+#include "internal/game_manager_parallel.hpp"
+
+#include <algorithm>
+
+namespace game_manager_parallel {
+
+ParallelForPool::ParallelForPool(std::size_t thread_count) {
+  workers_.reserve(thread_count);
+  for (std::size_t i = 0; i < thread_count; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+ParallelForPool::~ParallelForPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void ParallelForPool::Run(std::size_t count, std::size_t min_chunk,
+                          const RangeFn& fn) {
+  if (count == 0) {
+    return;
+  }
+  min_chunk = std::max<std::size_t>(1, min_chunk);
+  if (workers_.empty() || count <= min_chunk) {
+    fn(0, count);
+    return;
+  }
+
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  // 段数约为线程数的 4 倍，段间负载不均时由先完成的线程继续领取
+  const std::size_t lanes = (workers_.size() + 1) * 4;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fn_ = &fn;
+    count_ = count;
+    chunk_ = std::max(min_chunk, (count + lanes - 1) / lanes);
+    next_.store(0, std::memory_order_relaxed);
+    busy_workers_ = workers_.size();
+    generation_ += 1;
+  }
+  start_cv_.notify_all();
+  DrainChunks();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
+  fn_ = nullptr;
+}
+
+void ParallelForPool::DrainChunks() {
+  while (true) {
+    const std::size_t begin =
+        next_.fetch_add(chunk_, std::memory_order_relaxed);
+    if (begin >= count_) {
+      return;
+    }
+    (*fn_)(begin, std::min(count_, begin + chunk_));
+  }
+}
+
+void ParallelForPool::WorkerLoop() {
+  uint64_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_cv_.wait(lock, [this, seen_generation] {
+        return stopping_ || generation_ != seen_generation;
+      });
+      if (stopping_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+    DrainChunks();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_workers_ -= 1;
+    }
+    done_cv_.notify_one();
+  }
+}
+
+}  // namespace game_manager_parallel
@@ -0,0 +1,198 @@
+#include "internal/game_manager_path_cache.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace game_manager_path_cache {
+
+void PathCache::Init(const NavGrid& grid, std::size_t capacity) {
+  grid_ = grid;
+  // 无障碍 8 邻接网格上最优路径格数不超过 max(cells_x, cells_y)，这里留足余量
+  stride_ = static_cast<std::size_t>(std::max(0, grid.cells_x) +
+                                     std::max(0, grid.cells_y));
+  stride_ = std::min<std::size_t>(stride_,
+                                  std::numeric_limits<uint16_t>::max());
+  const std::size_t total_cells =
+      static_cast<std::size_t>(std::max(0, grid.cells_x)) *
+      static_cast<std::size_t>(std::max(0, grid.cells_y));
+  wide_ = total_cells > std::numeric_limits<uint16_t>::max();
+  capacity_ = total_cells > 0 ? capacity : 0;
+  max_capacity_ = capacity_ * kMaxPinnedGrowthFactor;
+  arena_.clear();
+  wide_arena_.clear();
+  ResizeArena();
+  slots_.assign(capacity_, Slot{});
+  index_.clear();
+  index_.reserve(capacity_);
+  head_ = kNone;
+  tail_ = kNone;
+  used_slots_ = 0;
+}
+
+uint64_t PathCache::MakeKey(const NavCell& start, const NavCell& goal) const {
+  const uint64_t s = static_cast<uint64_t>(
+      static_cast<uint32_t>(start.second * grid_.cells_x + start.first));
+  const uint64_t g = static_cast<uint64_t>(
+      static_cast<uint32_t>(goal.second * grid_.cells_x + goal.first));
+  return (s << 32) | g;
+}
+
+void PathCache::Unlink(uint32_t slot) {
+  Slot& s = slots_[slot];
+  if (s.prev != kNone) {
+    slots_[s.prev].next = s.next;
+  } else {
+    head_ = s.next;
+  }
+  if (s.next != kNone) {
+    slots_[s.next].prev = s.prev;
+  } else {
+    tail_ = s.prev;
+  }
+  s.prev = kNone;
+  s.next = kNone;
+}
+
+void PathCache::PushFront(uint32_t slot) {
+  Slot& s = slots_[slot];
+  s.prev = kNone;
+  s.next = head_;
+  if (head_ != kNone) {
+    slots_[head_].prev = slot;
+  }
+  head_ = slot;
+  if (tail_ == kNone) {
+    tail_ = slot;
+  }
+}
+
+PathRef PathCache::RefOf(uint32_t slot) const {
+  PathRef ref;
+  ref.offset = static_cast<uint32_t>(slot * stride_);
+  ref.generation = slots_[slot].generation;
+  ref.length = slots_[slot].length;
+  return ref;
+}
+
+bool PathCache::Lookup(const NavCell& start, const NavCell& goal,
+                       PathRef* out) {
+  if (out == nullptr || !Enabled()) {
+    return false;
+  }
+  const auto it = index_.find(MakeKey(start, goal));
+  if (it == index_.end()) {
+    return false;
+  }
+  const uint32_t slot = it->second;
+  if (slots_[slot].pins == 0 && head_ != slot) {
+    Unlink(slot);
+    PushFront(slot);
+  }
+  *out = RefOf(slot);
+  return true;
+}
+
+bool PathCache::Insert(const NavCell& start, const NavCell& goal,
+                       const std::vector<NavCell>& path, PathRef* out) {
+  if (out == nullptr || !Enabled() || path.empty() || path.size() > stride_) {
+    return false;
+  }
+  const uint64_t key = MakeKey(start, goal);
+  if (Lookup(start, goal, out)) {
+    return true;
+  }
+
+  const uint32_t slot = AcquireSlot();
+  if (slot == kNone) {
+    return false;
+  }
+  Slot& s = slots_[slot];
+  s.key = key;
+  s.generation += 1;
+  s.length = static_cast<uint16_t>(path.size());
+  s.in_use = true;
+  const std::size_t base = static_cast<std::size_t>(slot) * stride_;
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    const auto cell =
+        static_cast<uint32_t>(path[i].second * grid_.cells_x + path[i].first);
+    if (wide_) {
+      wide_arena_[base + i] = cell;
+    } else {
+      arena_[base + i] = static_cast<uint16_t>(cell);
+    }
+  }
+  PushFront(slot);
+  index_.emplace(key, slot);
+  *out = RefOf(slot);
+  return true;
+}
+
+uint32_t PathCache::AcquireSlot() {
+  if (used_slots_ < capacity_) {
+    return used_slots_++;
+  }
+  if (tail_ != kNone) {
+    // 淘汰最久未用的槽位，旧引用通过 generation 失效
+    const uint32_t slot = tail_;
+    Unlink(slot);
+    index_.erase(slots_[slot].key);
+    return slot;
+  }
+  // 所有槽位都被敌人引用：扩容一个槽位（引用是偏移，arena 重新分配不影响）
+  if (capacity_ >= max_capacity_) {
+    return kNone;
+  }
+  capacity_ += 1;
+  slots_.emplace_back();
+  ResizeArena();
+  return used_slots_++;
+}
+
+void PathCache::ResizeArena() {
+  if (wide_) {
+    wide_arena_.resize(capacity_ * stride_, 0);
+  } else {
+    arena_.resize(capacity_ * stride_, 0);
+  }
+}
+
+bool PathCache::IsLive(const PathRef& ref) const {
+  if (!Enabled() || ref.length == 0) {
+    return false;
+  }
+  const std::size_t slot = ref.offset / stride_;
+  if (slot >= slots_.size()) {
+    return false;
+  }
+  const Slot& s = slots_[slot];
+  return s.in_use && s.generation == ref.generation && s.length == ref.length;
+}
+
+void PathCache::Pin(const PathRef& ref) {
+  if (!IsLive(ref)) {
+    return;
+  }
+  const auto slot = static_cast<uint32_t>(ref.offset / stride_);
+  if (slots_[slot].pins++ == 0) {
+    Unlink(slot);
+  }
+}
+
+void PathCache::Unpin(const PathRef& ref) {
+  if (!IsLive(ref)) {
+    return;
+  }
+  const auto slot = static_cast<uint32_t>(ref.offset / stride_);
+  Slot& s = slots_[slot];
+  if (s.pins > 0 && --s.pins == 0) {
+    PushFront(slot);
+  }
+}
+
+NavCell PathCache::CellAt(const PathRef& ref, std::size_t index) const {
+  const uint32_t cell = CellIndexAt(ref, index);
+  const uint32_t cells_x = static_cast<uint32_t>(std::max(1, grid_.cells_x));
+  return {static_cast<int>(cell % cells_x), static_cast<int>(cell / cells_x)};
+}
+
+}  // namespace game_manager_path_cache
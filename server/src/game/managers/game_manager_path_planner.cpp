@@ -0,0 +1,122 @@
+#include "internal/game_manager_path_planner.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace game_manager_path_planner {
+
+void PathPlanChannel::MarkSubmitted(PathRequest* request) {
+  if (request == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  request->order = next_order_++;
+  in_flight_ += 1;
+}
+
+void PathPlanChannel::Complete(PathResult result) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed_.push_back(std::move(result));
+    if (in_flight_ > 0) {
+      in_flight_ -= 1;
+    }
+  }
+  cv_.notify_all();
+}
+
+void PathPlanChannel::Collect(bool wait_all, std::vector<PathResult>* out) {
+  if (out == nullptr) {
+    return;
+  }
+  out->clear();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (wait_all) {
+      cv_.wait(lock, [this]() { return in_flight_ == 0; });
+    }
+    out->swap(completed_);
+  }
+  // worker 完成顺序不确定，统一按提交顺序应用
+  std::sort(out->begin(), out->end(),
+            [](const PathResult& a, const PathResult& b) {
+              return a.order < b.order;
+            });
+}
+
+std::size_t PathPlanChannel::InFlight() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return in_flight_;
+}
+
+PathPlannerPool::PathPlannerPool(std::size_t thread_count) {
+  const std::size_t count = std::max<std::size_t>(1, thread_count);
+  workers_.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    workers_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+PathPlannerPool::~PathPlannerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void PathPlannerPool::Submit(const std::shared_ptr<PathPlanChannel>& channel,
+                             PathRequest request) {
+  if (channel == nullptr) {
+    return;
+  }
+  channel->MarkSubmitted(&request);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(Job{channel, std::move(request)});
+  }
+  cv_.notify_one();
+}
+
+void PathPlannerPool::WorkerLoop() {
+  // 每个 worker 独享一份 A* 缓冲，避免与 tick 线程争用场景缓冲
+  thread_local game_manager_nav::NavScratch scratch;
+
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        // stopping_ 且队列已清空
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+
+    PathResult result;
+    result.enemy_id = job.request.enemy_id;
+    result.request_seq = job.request.request_seq;
+    result.submit_tick = job.request.submit_tick;
+    result.order = job.request.order;
+    result.start = job.request.start;
+    result.goal = job.request.goal;
+    result.found =
+        game_manager_nav::FindPathAstar(job.request.grid, job.request.start,
+                                        job.request.goal, &result.path,
+                                        &scratch) &&
+        result.path.size() > 1;
+    if (!result.found) {
+      result.path.clear();
+    }
+    job.channel->Complete(std::move(result));
+  }
+}
+
+}  // namespace game_manager_path_planner
@@ -7,25 +7,6 @@
 #include "game/managers/room_manager.hpp"
 #include "network/tcp/tcp_session.hpp"
 
-// 简单的伪随机数生成器, state 是随机数种子指针
-uint32_t GameManager::NextRng(uint32_t* state) {
-  if (state == nullptr) {
-    return 0;
-  }
-  // 线性同余法
-  // LCG: fast & deterministic for gameplay purposes.
-  *state = (*state * 1664525u) + 1013904223u;
-  return *state;
-}
-
-// 获取一个[0,1）的浮点随机值
-float GameManager::NextRngUnitFloat(uint32_t* state) {
-  const uint32_t r = NextRng(state);
-  // Use high 24 bits to build [0,1) float.
-  // 取r的高24位，再乘 2e-24 即可把整数映射为浮点数
-  return static_cast<float>((r >> 8) & 0x00FFFFFF) * (1.0f / 16777216.0f);
-}
-
 std::size_t GameManager::GetPredictionHistoryLimit(const Scene& scene) const {
   double tick_interval = scene.tick_interval.count();
   if (tick_interval <= 0.0) {
@@ -85,6 +66,8 @@ bool GameManager::HandlePausedTickLocked(
     return false;
   }
   scene.tick += 1;
+  // 暂停期间不累积步长，恢复后不会一次性补跑
+  scene.step_accumulator = std::chrono::steady_clock::duration::zero();
   const auto perf_end = std::chrono::steady_clock::now();
   const double perf_ms =
       std::chrono::duration<double, std::milli>(perf_end - perf_start).count();
@@ -102,6 +85,7 @@ void GameManager::CleanupExpiredPlayers(
     spdlog::info("[disconnect] timeout player_id={}", player_id);
     RoomManager::Instance().RemovePlayer(player_id);
     RemovePlayer(player_id);
+    ReleaseReliableChannel(player_id, nullptr);
     TcpSession::RevokeToken(player_id);
   }
 }
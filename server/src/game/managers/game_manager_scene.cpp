@@ -6,6 +6,12 @@
 
 #include "game/managers/game_manager.hpp"
 #include "internal/game_manager_internal_utils.hpp"
+#include "internal/game_manager_nav.hpp"
+#include "internal/game_manager_path_cache.hpp"
+#include "internal/game_manager_path_planner.hpp"
+#include "internal/game_manager_rng.hpp"
+#include "internal/game_manager_sleep.hpp"
+#include "network/tcp/tcp_session.hpp"
 
 namespace {
 using game_manager_internal::FillSyncTiming;
@@ -90,6 +96,10 @@ void GameManager::PlacePlayers(const SceneCreateSnapshot& snapshot,
     runtime.state.mutable_position()->set_x(clamped_pos.x());
     runtime.state.mutable_position()->set_y(clamped_pos.y());
     runtime.state.set_rotation(angle * 180.0f / std::numbers::pi_v<float>);
+    if (const auto session = player.session.lock()) {
+      runtime.quantized_positions = session->SupportsQuantizedPositions();
+      runtime.interest_filter = session->SupportsInterestFilter();
+    }
 
     const int32_t max_health =
         default_role != nullptr ? std::max<int32_t>(1, default_role->max_health)
@@ -134,6 +144,7 @@ void GameManager::PlacePlayers(const SceneCreateSnapshot& snapshot,
 
     // 将玩家对应玩家信息插入会话
     scene->players.emplace(player.player_id, std::move(runtime));
+    AddAlivePlayerLocked(*scene, 1);
     player_scene_[player.player_id] = snapshot.room_id;  // 增加玩家对应房间结构
   }
 }
@@ -162,10 +173,12 @@ lawnmower::SceneInfo GameManager::CreateScene(
   scene.spawn_elapsed = 0.0;
   scene.wave_id = 1;
   scene.game_over = false;
-  scene.rng_state = snapshot.room_id ^ static_cast<uint32_t>(NowMs().count());
-  if (scene.rng_state == 0) {
-    scene.rng_state = 1;
-  }
+  // 配置固定种子时与 room_id 拼接，保证回放可复现且各房间序列不同
+  const uint64_t seed_high =
+      config_.rng_seed != 0 ? config_.rng_seed
+                            : static_cast<uint32_t>(NowMs().count());
+  scene.rng_seed = (seed_high << 32) | snapshot.room_id;
+  scene.upgrade_rolls = 0;
   ResetPerfStats(scene);
 
   scene.nav_cells_x = std::max(
@@ -176,11 +189,22 @@ lawnmower::SceneInfo GameManager::CreateScene(
                                    kNavCellSize));
   const std::size_t nav_cells =
       static_cast<std::size_t>(scene.nav_cells_x * scene.nav_cells_y);
-  scene.nav_came_from.assign(nav_cells, -1);
-  scene.nav_g_score.assign(nav_cells, std::numeric_limits<float>::infinity());
-  scene.nav_visit_epoch.assign(nav_cells, 0);
-  scene.nav_closed_epoch.assign(nav_cells, 0);
-  scene.nav_epoch = 0;
+  scene.nav_scratch = std::make_shared<game_manager_nav::NavScratch>();
+  scene.nav_scratch->Reserve(nav_cells);
+  scene.path_cache = std::make_shared<game_manager_path_cache::PathCache>();
+  scene.path_cache->Init(
+      game_manager_nav::NavGrid{scene.nav_cells_x, scene.nav_cells_y,
+                                kNavCellSize},
+      config_.path_cache_capacity);
+  // 同步寻路输出缓冲按最长路径预留，重算路径时不再扩容
+  scene.nav_scratch->path_buffer.reserve(
+      static_cast<std::size_t>(scene.nav_cells_x + scene.nav_cells_y));
+  EnsurePathPlannerLocked();
+  EnsureHitWorkersLocked();
+  if (path_planner_ != nullptr) {
+    scene.path_channel =
+        std::make_shared<game_manager_path_planner::PathPlanChannel>();
+  }
 
   const std::size_t max_enemies_alive =
       config_.max_enemies_alive > 0 ? config_.max_enemies_alive : 256;
@@ -193,6 +217,12 @@ lawnmower::SceneInfo GameManager::CreateScene(
       items_config_.max_items_alive > 0 ? items_config_.max_items_alive : 64;
   scene.items.reserve(max_items_alive);
   scene.item_pool.reserve(max_items_alive);
+  scene.enemy_despawns = std::make_shared<game_manager_sleep::TickWheel>(
+      kEnemyDespawnWheelSlots);
+  scene.item_sleep = std::make_shared<game_manager_sleep::SleepGrid>();
+  scene.item_sleep->Reset(static_cast<float>(scene.config.width),
+                          static_cast<float>(scene.config.height),
+                          static_cast<float>(kNavCellSize));
   scene.dirty_player_ids.reserve(snapshot.players.size());
   scene.dirty_enemy_ids.reserve(max_enemies_alive);
   scene.dirty_item_ids.reserve(max_items_alive);
@@ -200,7 +230,7 @@ lawnmower::SceneInfo GameManager::CreateScene(
   PlacePlayers(snapshot, &scene);  // 放置玩家
 
   // 生成敌人lambda
-  auto spawn_enemy = [&](uint32_t type_id) {
+  auto spawn_enemy = [&](uint32_t type_id, game_manager_rng::RngStream* rng) {
     if (scene.enemies.size() >= max_enemies_alive) {
       return;
     }
@@ -210,10 +240,8 @@ lawnmower::SceneInfo GameManager::CreateScene(
 
     const float map_w = static_cast<float>(scene.config.width);
     const float map_h = static_cast<float>(scene.config.height);
-    const float t =
-        NextRngUnitFloat(&scene.rng_state);  // 获取一个[0,1)的浮点随机值
-    const uint32_t edge =
-        NextRng(&scene.rng_state) % 4u;  // 获取一个0-3的随机值
+    const float t = rng->NextUnitFloat();  // 获取一个[0,1)的浮点随机值
+    const uint32_t edge = rng->NextU32() % 4u;  // 获取一个0-3的随机值
 
     float x = 0.0f;
     float y = 0.0f;
@@ -241,6 +269,7 @@ lawnmower::SceneInfo GameManager::CreateScene(
     // 敌人运行时状态配置信息
     runtime.state.set_enemy_id(scene.next_enemy_id++);
     runtime.state.set_type_id(type.type_id);
+    runtime.type_slot = EnemyTypeSlot(type.type_id);
     const auto clamped_pos = ClampToMap(scene.config, x, y);  // 限制边界
     runtime.state.mutable_position()->set_x(clamped_pos.x());
     runtime.state.mutable_position()->set_y(clamped_pos.y());
@@ -250,13 +279,15 @@ lawnmower::SceneInfo GameManager::CreateScene(
     runtime.state.set_wave_id(scene.wave_id);
     runtime.state.set_is_friendly(false);
     // 初始化 delta 同步基线
-    runtime.last_sync_position = runtime.state.position();
+    runtime.last_sync_x = runtime.state.position().x();
+    runtime.last_sync_y = runtime.state.position().y();
     runtime.last_sync_health = runtime.state.health();
     runtime.last_sync_is_alive = runtime.state.is_alive();
     runtime.force_sync_left = kEnemySpawnForceSyncCount;
     runtime.dirty = false;
     auto [it, _] =
         scene.enemies.emplace(runtime.state.enemy_id(), std::move(runtime));
+    AddAliveEnemyLocked(scene, it->second, 1);
     MarkEnemyDirty(scene, it->first, it->second);
   };
 
@@ -264,8 +295,11 @@ lawnmower::SceneInfo GameManager::CreateScene(
   const std::size_t initial_enemy_count = std::min<std::size_t>(
       max_enemies_alive, std::max<std::size_t>(1, snapshot.players.size() * 2));
   for (std::size_t i = 0; i < initial_enemy_count; ++i) {
-    // 生成敌人
-    spawn_enemy(PickSpawnEnemyTypeId(&scene.rng_state));
+    // 生成敌人（随机流按即将分配的敌人 id 划分）
+    game_manager_rng::RngStream rng(scene.rng_seed, scene.tick,
+                                    game_manager_rng::RngStage::kEnemySpawn,
+                                    scene.next_enemy_id);
+    spawn_enemy(PickSpawnEnemyTypeId(&rng), &rng);
   }
   scenes_[snapshot.room_id] = std::move(scene);  // 房间对应会话map
 
@@ -296,11 +330,35 @@ bool GameManager::BuildFullState(uint32_t room_id,
     return false;
   }
 
+  FillFullStateLocked(room_id, scene_it->second, sync);
+  // 房间级全量不做兴趣过滤：开启过滤的玩家此时已知全部敌人，记入兴趣集，
+  // 下一次同步再把视野外的敌人经 removed_enemy_ids 移出
+  std::vector<uint32_t> all_enemy_ids;
+  all_enemy_ids.reserve(scene_it->second.enemies.size());
+  for (const auto& enemy : sync->enemies()) {
+    all_enemy_ids.push_back(enemy.enemy_id());
+  }
+  std::sort(all_enemy_ids.begin(), all_enemy_ids.end());
+  for (auto& [_, runtime] : scene_it->second.players) {
+    if (runtime.interest_filter) {
+      runtime.interest_enemy_ids = all_enemy_ids;
+      runtime.interest_resync.clear();
+    }
+  }
+  return true;
+}
+
+// 填充完整的游戏状态（需持有 mutex_）
+void GameManager::FillFullStateLocked(uint32_t room_id, const Scene& scene,
+                                      lawnmower::S2C_GameStateSync* sync) {
+  if (sync == nullptr) {
+    return;
+  }
+
   sync->Clear();
   // 填充同步时间
-  FillSyncTiming(room_id, scene_it->second.tick, sync);
+  FillSyncTiming(room_id, scene.tick, sync);
 
-  const Scene& scene = scene_it->second;
   if (!scene.players.empty()) {
     sync->mutable_players()->Reserve(static_cast<int>(scene.players.size()));
   }
@@ -333,7 +391,6 @@ bool GameManager::BuildFullState(uint32_t room_id,
     item_state->mutable_position()->set_x(item.x);
     item_state->mutable_position()->set_y(item.y);
   }
-  return true;
 }
 
 void GameManager::ProcessItems(Scene& scene, bool* has_dirty) {
@@ -341,10 +398,8 @@ void GameManager::ProcessItems(Scene& scene, bool* has_dirty) {
     return;
   }
 
-  const std::size_t alive_players =
-      std::count_if(scene.players.begin(), scene.players.end(),
-                    [](const auto& kv) { return kv.second.state.is_alive(); });
-  if (alive_players == 0) {
+  if (scene.alive.players == 0 || scene.item_sleep == nullptr ||
+      scene.item_sleep->Size() == 0) {
     return;
   }
 
@@ -356,10 +411,31 @@ void GameManager::ProcessItems(Scene& scene, bool* has_dirty) {
       items_config_.pick_radius > 0.0f ? items_config_.pick_radius : 24.0f;
   const float pick_radius_sq = pick_radius * pick_radius;
 
-  for (auto& [_, item] : scene.items) {
-    if (item.is_picked) {
+  // 只唤醒存活玩家拾取半径覆盖到的格子里的道具，其余道具保持休眠
+  auto& wake_ids = scene.wake_ids;
+  wake_ids.clear();
+  for (const auto& [_, player] : scene.players) {
+    if (!player.state.is_alive()) {
+      continue;
+    }
+    scene.item_sleep->Query(player.state.position().x(),
+                            player.state.position().y(), pick_radius,
+                            &wake_ids);
+  }
+  if (wake_ids.empty()) {
+    return;
+  }
+  // 玩家相邻时同一格会被查到多次
+  std::sort(wake_ids.begin(), wake_ids.end());
+  wake_ids.erase(std::unique(wake_ids.begin(), wake_ids.end()),
+                 wake_ids.end());
+
+  for (const uint32_t item_id : wake_ids) {
+    auto item_it = scene.items.find(item_id);
+    if (item_it == scene.items.end() || item_it->second.is_picked) {
       continue;
     }
+    ItemRuntime& item = item_it->second;
     for (auto& [_, player] : scene.players) {
       if (!player.state.is_alive()) {
         continue;
@@ -372,12 +448,12 @@ void GameManager::ProcessItems(Scene& scene, bool* has_dirty) {
       }
 
       item.is_picked = true;
+      scene.item_sleep->Remove(item.item_id, item.x, item.y);
       MarkItemDirty(scene, item.item_id, item);
       *has_dirty = true;
 
       if (item.effect_type == lawnmower::ITEM_EFFECT_HEAL) {
-        const ItemTypeConfig& type = ResolveItemType(item.type_id);
-        const int32_t heal_value = std::max<int32_t>(0, type.value);
+        const int32_t heal_value = ItemTypeRowAt(item.type_slot).heal_value;
         if (heal_value > 0) {
           const int32_t prev_hp = player.state.health();
           const int32_t max_hp = player.state.max_health();
@@ -63,6 +63,17 @@ bool GameManager::HandlePlayerInput(uint32_t player_id,
 
   PlayerRuntime& runtime = player_it->second;
 
+  // 确认基线与输入本身是否被受理无关，先于过期/序号检查记录
+  if (input.has_acked_sync_tick()) {
+    runtime.acked_delta = true;
+    const uint32_t acked = input.acked_sync_tick();
+    if (acked != 0 &&
+        (runtime.acked_sync_tick == 0 ||
+         static_cast<int32_t>(acked - runtime.acked_sync_tick) > 0)) {
+      runtime.acked_sync_tick = acked;
+    }
+  }
+
   const uint32_t input_tick = input.input_time().tick();
   if (input_tick > 0) {
     const uint64_t scene_tick = scene.tick;
@@ -165,6 +176,8 @@ bool GameManager::MarkPlayerDisconnected(uint32_t player_id) {
 bool GameManager::TryReconnectPlayer(uint32_t player_id, uint32_t room_id,
                                      uint32_t last_input_seq,
                                      uint32_t last_server_tick,
+                                     bool quantized_positions,
+                                     bool interest_filter,
                                      ReconnectSnapshot* out) {
   if (out == nullptr) {
     return false;
@@ -198,6 +211,14 @@ bool GameManager::TryReconnectPlayer(uint32_t player_id, uint32_t room_id,
   runtime.attack_cooldown_seconds = 0.0;
   runtime.last_input_seq = last_input_seq;
   runtime.last_sync_input_seq = last_input_seq;
+  // 重连客户端没有可用基线，等它重新声明后再按确认基线发增量
+  runtime.acked_delta = false;
+  runtime.acked_sync_tick = 0;
+  runtime.quantized_positions = quantized_positions;
+  // 客户端重建了场景，兴趣集清空后下次同步按进入重新下发完整敌人状态
+  runtime.interest_filter = interest_filter;
+  runtime.interest_enemy_ids.clear();
+  runtime.interest_resync.clear();
 
   out->room_id = mapping->second;
   out->server_tick = scene.tick;
@@ -234,6 +255,9 @@ void GameManager::RemovePlayer(uint32_t player_id) {
     auto player_it = scene_it->second.players.find(player_id);
     if (player_it != scene_it->second.players.end()) {
       player_it->second.dirty_queued = false;
+      if (player_it->second.state.is_alive()) {
+        AddAlivePlayerLocked(scene_it->second, -1);
+      }
       scene_it->second.players.erase(player_it);
     }
     if (scene_it->second.players.empty()) {
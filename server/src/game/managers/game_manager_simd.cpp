@@ -0,0 +1,62 @@
+#include "internal/game_manager_simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+using game_manager_simd::SimdLevel;
+
+SimdLevel DetectOnce() {
+#if LAWNMOWER_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return SimdLevel::kSse42;
+  }
+#endif
+  return SimdLevel::kScalar;
+}
+
+std::atomic<uint8_t>& ActiveLevelStorage() {
+  static std::atomic<uint8_t> level{
+      static_cast<uint8_t>(game_manager_simd::DetectSimdLevel())};
+  return level;
+}
+}  // namespace
+
+namespace game_manager_simd {
+
+SimdLevel DetectSimdLevel() {
+  static const SimdLevel detected = DetectOnce();
+  return detected;
+}
+
+SimdLevel ActiveSimdLevel() {
+  return static_cast<SimdLevel>(
+      ActiveLevelStorage().load(std::memory_order_relaxed));
+}
+
+void SetActiveSimdLevel(SimdLevel level) {
+  ActiveLevelStorage().store(static_cast<uint8_t>(ClampSimdLevel(level)),
+                             std::memory_order_relaxed);
+}
+
+SimdLevel ClampSimdLevel(SimdLevel level) {
+  return std::min(level, DetectSimdLevel());
+}
+
+const char* SimdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kSse42:
+      return "sse4.2";
+    case SimdLevel::kScalar:
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace game_manager_simd
@@ -0,0 +1,122 @@
+#include "internal/game_manager_sleep.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace game_manager_sleep {
+
+TickWheel::TickWheel(std::size_t slots)
+    : slots_(std::max<std::size_t>(1, slots)) {}
+
+void TickWheel::Schedule(uint64_t due_tick, uint32_t id) {
+  const uint64_t due = std::max(due_tick, cursor_);
+  slots_[static_cast<std::size_t>(due % slots_.size())].push_back(
+      Timer{due, id});
+  size_ += 1;
+}
+
+void TickWheel::PopDue(uint64_t now, std::vector<uint32_t>* out) {
+  if (out == nullptr || now < cursor_) {
+    return;
+  }
+  if (size_ == 0) {
+    cursor_ = now + 1;  // 空轮直接快进
+    return;
+  }
+  // 落后超过一圈时每个槽位只需扫一次
+  const uint64_t steps = std::min<uint64_t>(now - cursor_ + 1, slots_.size());
+  for (uint64_t k = 0; k < steps; ++k) {
+    auto& slot =
+        slots_[static_cast<std::size_t>((cursor_ + k) % slots_.size())];
+    std::size_t kept = 0;
+    for (const Timer& timer : slot) {
+      if (timer.due_tick <= now) {
+        out->push_back(timer.id);
+      } else {
+        slot[kept++] = timer;  // 下一圈才到期
+      }
+    }
+    size_ -= slot.size() - kept;
+    slot.resize(kept);
+  }
+  cursor_ = now + 1;
+}
+
+void TickWheel::Clear() {
+  for (auto& slot : slots_) {
+    slot.clear();
+  }
+  cursor_ = 0;
+  size_ = 0;
+}
+
+void SleepGrid::Reset(float width, float height, float cell_size) {
+  cell_size_ = cell_size > 0.0f ? cell_size : 100.0f;
+  cells_x_ = std::max(1, static_cast<int>(std::ceil(width / cell_size_)));
+  cells_y_ = std::max(1, static_cast<int>(std::ceil(height / cell_size_)));
+  cells_.assign(static_cast<std::size_t>(cells_x_ * cells_y_), {});
+  size_ = 0;
+}
+
+int SleepGrid::CellX(float x) const {
+  return std::clamp(static_cast<int>(std::floor(x / cell_size_)), 0,
+                    cells_x_ - 1);
+}
+
+int SleepGrid::CellY(float y) const {
+  return std::clamp(static_cast<int>(std::floor(y / cell_size_)), 0,
+                    cells_y_ - 1);
+}
+
+void SleepGrid::Insert(uint32_t id, float x, float y) {
+  if (cells_.empty()) {
+    // 未 Reset 过：退化为单格
+    cells_x_ = 1;
+    cells_y_ = 1;
+    cells_.resize(1);
+  }
+  cells_[static_cast<std::size_t>(CellY(y) * cells_x_ + CellX(x))].push_back(
+      id);
+  size_ += 1;
+}
+
+bool SleepGrid::Remove(uint32_t id, float x, float y) {
+  if (cells_.empty()) {
+    return false;
+  }
+  auto& cell = cells_[static_cast<std::size_t>(CellY(y) * cells_x_ + CellX(x))];
+  const auto it = std::find(cell.begin(), cell.end(), id);
+  if (it == cell.end()) {
+    return false;
+  }
+  *it = cell.back();
+  cell.pop_back();
+  size_ -= 1;
+  return true;
+}
+
+void SleepGrid::Query(float x, float y, float radius,
+                      std::vector<uint32_t>* out) const {
+  if (out == nullptr || size_ == 0) {
+    return;
+  }
+  const int x0 = CellX(x - radius);
+  const int x1 = CellX(x + radius);
+  const int y0 = CellY(y - radius);
+  const int y1 = CellY(y + radius);
+  for (int cy = y0; cy <= y1; ++cy) {
+    for (int cx = x0; cx <= x1; ++cx) {
+      const auto& cell = cells_[static_cast<std::size_t>(cy * cells_x_ + cx)];
+      out->insert(out->end(), cell.begin(), cell.end());
+    }
+  }
+}
+
+void SleepGrid::Clear() {
+  for (auto& cell : cells_) {
+    cell.clear();
+  }
+  size_ = 0;
+}
+
+}  // namespace game_manager_sleep
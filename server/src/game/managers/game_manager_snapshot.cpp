@@ -0,0 +1,528 @@
+#include "internal/game_manager_snapshot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+using game_manager_snapshot::EnemyEntry;
+using game_manager_snapshot::ItemEntry;
+using game_manager_snapshot::kPositionEpsilon;
+using game_manager_snapshot::PlayerEntry;
+
+bool Moved(float x, float y, float last_x, float last_y) {
+  return std::abs(x - last_x) > kPositionEpsilon ||
+         std::abs(y - last_y) > kPositionEpsilon;
+}
+
+// 两个按 id 升序的序列做归并：两边都有 / 只在 current / 只在 baseline
+template <typename T, typename IdFn, typename BothFn, typename AddedFn,
+          typename RemovedFn>
+void MergeById(const std::vector<T>& baseline, const std::vector<T>& current,
+               IdFn&& id_of, BothFn&& on_both, AddedFn&& on_added,
+               RemovedFn&& on_removed) {
+  std::size_t b = 0;
+  std::size_t c = 0;
+  while (b < baseline.size() || c < current.size()) {
+    if (c == current.size() ||
+        (b < baseline.size() && id_of(baseline[b]) < id_of(current[c]))) {
+      on_removed(baseline[b++]);
+    } else if (b == baseline.size() || id_of(current[c]) < id_of(baseline[b])) {
+      on_added(current[c++]);
+    } else {
+      on_both(baseline[b++], current[c++]);
+    }
+  }
+}
+
+template <typename T, typename IdFn>
+const T* FindById(const std::vector<T>& entries, uint32_t id, IdFn&& id_of) {
+  auto it = std::lower_bound(
+      entries.begin(), entries.end(), id,
+      [&id_of](const T& entry, uint32_t value) {
+        return id_of(entry) < value;
+      });
+  return it != entries.end() && id_of(*it) == id ? &*it : nullptr;
+}
+
+template <typename T, typename IdFn>
+T* FindById(std::vector<T>* entries, uint32_t id, IdFn&& id_of) {
+  return const_cast<T*>(FindById(std::as_const(*entries), id, id_of));
+}
+
+// 就地移除满足 pred 的条目（保持其余条目顺序）
+template <typename T, typename Pred>
+void EraseIf(google::protobuf::RepeatedPtrField<T>* field, Pred&& pred) {
+  int kept = 0;
+  for (int i = 0; i < field->size(); ++i) {
+    if (pred(field->Get(i))) {
+      continue;
+    }
+    if (kept != i) {
+      field->SwapElements(kept, i);
+    }
+    ++kept;
+  }
+  field->DeleteSubrange(kept, field->size() - kept);
+}
+
+// 位置改写为相对 (base_x, base_y) 的定点差值；差值为 0 时返回 false
+template <typename Delta>
+bool QuantizePosition(float base_x, float base_y, uint32_t scale,
+                      Delta* delta) {
+  using game_manager_snapshot::QuantizeCoord;
+  const int32_t qx = QuantizeCoord(delta->position().x(), scale) -
+                     QuantizeCoord(base_x, scale);
+  const int32_t qy = QuantizeCoord(delta->position().y(), scale) -
+                     QuantizeCoord(base_y, scale);
+  delta->clear_position();
+  if (qx == 0 && qy == 0) {
+    return false;
+  }
+  delta->set_qx(qx);
+  delta->set_qy(qy);
+  return true;
+}
+
+// 还原相对 (*x, *y) 的定点差值
+template <typename Delta>
+void DequantizePosition(const Delta& delta, uint32_t scale, float* x,
+                        float* y) {
+  using game_manager_snapshot::QuantizeCoord;
+  const float unit = 1.0f / static_cast<float>(scale);
+  *x = static_cast<float>(QuantizeCoord(*x, scale) + delta.qx()) * unit;
+  *y = static_cast<float>(QuantizeCoord(*y, scale) + delta.qy()) * unit;
+}
+
+template <typename T, typename IdFn>
+T* FindOrAppend(std::vector<T>* entries, std::size_t sorted_size, uint32_t id,
+                IdFn&& id_of) {
+  // 前 sorted_size 个有序，之后是本次新增（数量少，线性查找）
+  auto it = std::lower_bound(
+      entries->begin(), entries->begin() + sorted_size, id,
+      [&id_of](const T& entry, uint32_t value) {
+        return id_of(entry) < value;
+      });
+  if (it != entries->begin() + sorted_size && id_of(*it) == id) {
+    return &*it;
+  }
+  for (std::size_t i = sorted_size; i < entries->size(); ++i) {
+    if (id_of((*entries)[i]) == id) {
+      return &(*entries)[i];
+    }
+  }
+  entries->emplace_back();
+  return &entries->back();
+}
+
+constexpr auto kPlayerId = [](const PlayerEntry& e) { return e.player_id; };
+constexpr auto kEnemyId = [](const EnemyEntry& e) { return e.enemy_id; };
+constexpr auto kItemId = [](const ItemEntry& e) { return e.item_id; };
+}  // namespace
+
+namespace game_manager_snapshot {
+
+void Snapshot::Clear() {
+  tick = 0;
+  players.clear();
+  enemies.clear();
+  items.clear();
+}
+
+void Snapshot::SortById() {
+  const auto by = [](auto id_of) {
+    return [id_of](const auto& a, const auto& b) {
+      return id_of(a) < id_of(b);
+    };
+  };
+  std::sort(players.begin(), players.end(), by(kPlayerId));
+  std::sort(enemies.begin(), enemies.end(), by(kEnemyId));
+  std::sort(items.begin(), items.end(), by(kItemId));
+}
+
+SnapshotRing::SnapshotRing(std::size_t capacity)
+    : slots_(std::max<std::size_t>(1, capacity)) {}
+
+Snapshot* SnapshotRing::Record(uint32_t tick) {
+  if (size_ > 0) {
+    const std::size_t latest = (next_ + slots_.size() - 1) % slots_.size();
+    if (slots_[latest].tick == tick) {
+      slots_[latest].Clear();
+      slots_[latest].tick = tick;
+      return &slots_[latest];
+    }
+  }
+  Snapshot* slot = &slots_[next_];
+  slot->Clear();
+  slot->tick = tick;
+  next_ = (next_ + 1) % slots_.size();
+  size_ = std::min(size_ + 1, slots_.size());
+  return slot;
+}
+
+const Snapshot* SnapshotRing::Find(uint32_t tick) const {
+  for (std::size_t i = 0; i < size_; ++i) {
+    const std::size_t index = (next_ + slots_.size() - 1 - i) % slots_.size();
+    if (slots_[index].tick == tick) {
+      return &slots_[index];
+    }
+  }
+  return nullptr;
+}
+
+bool Diff(const Snapshot& baseline, const Snapshot& current,
+          lawnmower::S2C_GameStateDeltaSync* out, DiffFollowups* followups) {
+  if (out == nullptr || followups == nullptr) {
+    return false;
+  }
+
+  MergeById(
+      baseline.players, current.players, kPlayerId,
+      [&](const PlayerEntry& last, const PlayerEntry& now) {
+        if (now.full_version != last.full_version) {
+          followups->full_player_ids.push_back(now.player_id);
+          return;
+        }
+        uint32_t changed_mask = 0;
+        if (Moved(now.x, now.y, last.x, last.y)) {
+          changed_mask |= lawnmower::PLAYER_DELTA_POSITION;
+        }
+        if (std::abs(now.rotation - last.rotation) > kPositionEpsilon) {
+          changed_mask |= lawnmower::PLAYER_DELTA_ROTATION;
+        }
+        if (now.is_alive != last.is_alive) {
+          changed_mask |= lawnmower::PLAYER_DELTA_IS_ALIVE;
+        }
+        if (now.input_seq != last.input_seq) {
+          changed_mask |= lawnmower::PLAYER_DELTA_LAST_PROCESSED_INPUT_SEQ;
+        }
+        if (changed_mask == 0) {
+          return;
+        }
+        auto* delta = out->add_players();
+        delta->set_player_id(now.player_id);
+        delta->set_changed_mask(changed_mask);
+        if ((changed_mask & lawnmower::PLAYER_DELTA_POSITION) != 0) {
+          delta->mutable_position()->set_x(now.x);
+          delta->mutable_position()->set_y(now.y);
+        }
+        if ((changed_mask & lawnmower::PLAYER_DELTA_ROTATION) != 0) {
+          delta->set_rotation(now.rotation);
+        }
+        if ((changed_mask & lawnmower::PLAYER_DELTA_IS_ALIVE) != 0) {
+          delta->set_is_alive(now.is_alive);
+        }
+        if ((changed_mask &
+             lawnmower::PLAYER_DELTA_LAST_PROCESSED_INPUT_SEQ) != 0) {
+          delta->set_last_processed_input_seq(
+              static_cast<int32_t>(now.input_seq));
+        }
+      },
+      [&](const PlayerEntry& now) {
+        followups->full_player_ids.push_back(now.player_id);
+      },
+      [&](const PlayerEntry& last) {
+        out->add_removed_player_ids(last.player_id);
+      });
+
+  MergeById(
+      baseline.enemies, current.enemies, kEnemyId,
+      [&](const EnemyEntry& last, const EnemyEntry& now) {
+        uint32_t changed_mask = 0;
+        if (Moved(now.x, now.y, last.x, last.y)) {
+          changed_mask |= lawnmower::ENEMY_DELTA_POSITION;
+        }
+        if (now.health != last.health) {
+          changed_mask |= lawnmower::ENEMY_DELTA_HEALTH;
+        }
+        if (now.is_alive != last.is_alive) {
+          changed_mask |= lawnmower::ENEMY_DELTA_IS_ALIVE;
+        }
+        if (changed_mask == 0) {
+          return;
+        }
+        auto* delta = out->add_enemies();
+        delta->set_enemy_id(now.enemy_id);
+        delta->set_changed_mask(changed_mask);
+        if ((changed_mask & lawnmower::ENEMY_DELTA_POSITION) != 0) {
+          delta->mutable_position()->set_x(now.x);
+          delta->mutable_position()->set_y(now.y);
+        }
+        if ((changed_mask & lawnmower::ENEMY_DELTA_HEALTH) != 0) {
+          delta->set_health(now.health);
+        }
+        if ((changed_mask & lawnmower::ENEMY_DELTA_IS_ALIVE) != 0) {
+          delta->set_is_alive(now.is_alive);
+        }
+      },
+      [&](const EnemyEntry& now) {
+        followups->spawned_enemy_ids.push_back(now.enemy_id);
+      },
+      [&](const EnemyEntry& last) {
+        out->add_removed_enemy_ids(last.enemy_id);
+      });
+
+  MergeById(
+      baseline.items, current.items, kItemId,
+      [&](const ItemEntry& last, const ItemEntry& now) {
+        uint32_t changed_mask = 0;
+        if (Moved(now.x, now.y, last.x, last.y)) {
+          changed_mask |= lawnmower::ITEM_DELTA_POSITION;
+        }
+        if (now.type_id != last.type_id) {
+          changed_mask |= lawnmower::ITEM_DELTA_TYPE;
+        }
+        if (changed_mask == 0) {
+          return;
+        }
+        auto* delta = out->add_items();
+        delta->set_item_id(now.item_id);
+        delta->set_changed_mask(changed_mask);
+        if ((changed_mask & lawnmower::ITEM_DELTA_POSITION) != 0) {
+          delta->mutable_position()->set_x(now.x);
+          delta->mutable_position()->set_y(now.y);
+        }
+        if ((changed_mask & lawnmower::ITEM_DELTA_TYPE) != 0) {
+          delta->set_type_id(now.type_id);
+        }
+      },
+      [&](const ItemEntry& now) {
+        auto* delta = out->add_items();
+        delta->set_item_id(now.item_id);
+        delta->set_changed_mask(lawnmower::ITEM_DELTA_POSITION |
+                                lawnmower::ITEM_DELTA_IS_PICKED |
+                                lawnmower::ITEM_DELTA_TYPE);
+        delta->mutable_position()->set_x(now.x);
+        delta->mutable_position()->set_y(now.y);
+        delta->set_is_picked(false);
+        delta->set_type_id(now.type_id);
+      },
+      [&](const ItemEntry& last) { out->add_removed_item_ids(last.item_id); });
+
+  return out->players_size() > 0 || out->enemies_size() > 0 ||
+         out->items_size() > 0 || out->removed_player_ids_size() > 0 ||
+         out->removed_enemy_ids_size() > 0 ||
+         out->removed_item_ids_size() > 0 ||
+         !followups->full_player_ids.empty() ||
+         !followups->spawned_enemy_ids.empty();
+}
+
+int32_t QuantizeCoord(float value, uint32_t scale) {
+  return static_cast<int32_t>(std::lround(value * static_cast<float>(scale)));
+}
+
+uint32_t QuantizeRotation(float degrees, uint32_t bits) {
+  const int64_t steps = int64_t{1} << bits;
+  int64_t value = std::llround(degrees / 360.0f * static_cast<float>(steps));
+  value %= steps;
+  if (value < 0) {
+    value += steps;
+  }
+  return static_cast<uint32_t>(value);
+}
+
+float DequantizeRotation(uint32_t value, uint32_t bits) {
+  const uint32_t steps = 1u << bits;
+  return static_cast<float>(value % steps) * 360.0f /
+         static_cast<float>(steps);
+}
+
+void Quantize(const Snapshot& baseline, const QuantizeParams& params,
+              lawnmower::S2C_GameStateDeltaSync* delta) {
+  if (delta == nullptr) {
+    return;
+  }
+  const uint32_t scale = std::max<uint32_t>(1, params.position_scale);
+  const uint32_t bits =
+      std::clamp(params.rotation_bits, kMinRotationBits, kMaxRotationBits);
+  delta->set_position_scale(scale);
+  delta->set_rotation_bits(bits);
+
+  for (auto& player : *delta->mutable_players()) {
+    const PlayerEntry* last =
+        FindById(baseline.players, player.player_id(), kPlayerId);
+    if (last == nullptr) {
+      continue;
+    }
+    uint32_t mask = player.changed_mask();
+    if ((mask & lawnmower::PLAYER_DELTA_POSITION) != 0 &&
+        !QuantizePosition(last->x, last->y, scale, &player)) {
+      mask &= ~static_cast<uint32_t>(lawnmower::PLAYER_DELTA_POSITION);
+    }
+    if ((mask & lawnmower::PLAYER_DELTA_ROTATION) != 0) {
+      const uint32_t rotation = QuantizeRotation(player.rotation(), bits);
+      player.clear_rotation();
+      if (rotation == QuantizeRotation(last->rotation, bits)) {
+        mask &= ~static_cast<uint32_t>(lawnmower::PLAYER_DELTA_ROTATION);
+      } else {
+        player.set_qrotation(rotation);
+      }
+    }
+    player.set_changed_mask(mask);
+  }
+  EraseIf(delta->mutable_players(), [](const lawnmower::PlayerStateDelta& d) {
+    return d.changed_mask() == 0;
+  });
+
+  for (auto& enemy : *delta->mutable_enemies()) {
+    const EnemyEntry* last =
+        FindById(baseline.enemies, enemy.enemy_id(), kEnemyId);
+    if (last == nullptr ||
+        (enemy.changed_mask() & lawnmower::ENEMY_DELTA_POSITION) == 0) {
+      continue;
+    }
+    if (!QuantizePosition(last->x, last->y, scale, &enemy)) {
+      enemy.set_changed_mask(
+          enemy.changed_mask() &
+          ~static_cast<uint32_t>(lawnmower::ENEMY_DELTA_POSITION));
+    }
+  }
+  EraseIf(delta->mutable_enemies(), [](const lawnmower::EnemyStateDelta& d) {
+    return d.changed_mask() == 0;
+  });
+
+  for (auto& item : *delta->mutable_items()) {
+    if ((item.changed_mask() & lawnmower::ITEM_DELTA_POSITION) == 0) {
+      continue;
+    }
+    const ItemEntry* last = FindById(baseline.items, item.item_id(), kItemId);
+    // 新道具没有基线，写绝对定点坐标
+    if (!QuantizePosition(last != nullptr ? last->x : 0.0f,
+                          last != nullptr ? last->y : 0.0f, scale, &item) &&
+        last != nullptr) {
+      item.set_changed_mask(
+          item.changed_mask() &
+          ~static_cast<uint32_t>(lawnmower::ITEM_DELTA_POSITION));
+    }
+  }
+  EraseIf(delta->mutable_items(), [](const lawnmower::ItemStateDelta& d) {
+    return d.changed_mask() == 0;
+  });
+}
+
+void Apply(const Snapshot& baseline,
+           const lawnmower::S2C_GameStateDeltaSync& delta, Snapshot* out) {
+  if (out == nullptr || out == &baseline) {
+    return;
+  }
+  *out = baseline;
+  out->tick = delta.sync_time().tick();
+  const uint32_t scale = delta.position_scale();  // 0 表示浮点编码
+
+  for (const auto& player : delta.players()) {
+    PlayerEntry* entry = FindById(&out->players, player.player_id(), kPlayerId);
+    if (entry == nullptr) {
+      continue;
+    }
+    const uint32_t mask = player.changed_mask();
+    if ((mask & lawnmower::PLAYER_DELTA_POSITION) != 0) {
+      if (scale != 0) {
+        DequantizePosition(player, scale, &entry->x, &entry->y);
+      } else {
+        entry->x = player.position().x();
+        entry->y = player.position().y();
+      }
+    }
+    if ((mask & lawnmower::PLAYER_DELTA_ROTATION) != 0) {
+      entry->rotation =
+          scale != 0
+              ? DequantizeRotation(player.qrotation(), delta.rotation_bits())
+              : player.rotation();
+    }
+    if ((mask & lawnmower::PLAYER_DELTA_IS_ALIVE) != 0) {
+      entry->is_alive = player.is_alive();
+    }
+    if ((mask & lawnmower::PLAYER_DELTA_LAST_PROCESSED_INPUT_SEQ) != 0) {
+      entry->input_seq =
+          static_cast<uint32_t>(player.last_processed_input_seq());
+    }
+  }
+  const std::unordered_set<uint32_t> removed_players(
+      delta.removed_player_ids().begin(), delta.removed_player_ids().end());
+  std::erase_if(out->players, [&](const PlayerEntry& entry) {
+    return removed_players.contains(entry.player_id);
+  });
+  // 先应用字段增量（此时仍有序），再合入完整状态
+  const std::size_t sorted_players = out->players.size();
+  for (const auto& state : delta.full_players()) {
+    PlayerEntry* entry = FindOrAppend(&out->players, sorted_players,
+                                      state.player_id(), kPlayerId);
+    entry->player_id = state.player_id();
+    entry->x = state.position().x();
+    entry->y = state.position().y();
+    entry->rotation = state.rotation();
+    entry->is_alive = state.is_alive();
+    entry->input_seq = static_cast<uint32_t>(state.last_processed_input_seq());
+  }
+
+  for (const auto& enemy : delta.enemies()) {
+    EnemyEntry* entry = FindById(&out->enemies, enemy.enemy_id(), kEnemyId);
+    if (entry == nullptr) {
+      continue;
+    }
+    const uint32_t mask = enemy.changed_mask();
+    if ((mask & lawnmower::ENEMY_DELTA_POSITION) != 0) {
+      if (scale != 0) {
+        DequantizePosition(enemy, scale, &entry->x, &entry->y);
+      } else {
+        entry->x = enemy.position().x();
+        entry->y = enemy.position().y();
+      }
+    }
+    if ((mask & lawnmower::ENEMY_DELTA_HEALTH) != 0) {
+      entry->health = enemy.health();
+    }
+    if ((mask & lawnmower::ENEMY_DELTA_IS_ALIVE) != 0) {
+      entry->is_alive = enemy.is_alive();
+    }
+  }
+  const std::unordered_set<uint32_t> removed_enemies(
+      delta.removed_enemy_ids().begin(), delta.removed_enemy_ids().end());
+  std::erase_if(out->enemies, [&](const EnemyEntry& entry) {
+    return removed_enemies.contains(entry.enemy_id);
+  });
+  for (const auto& state : delta.spawned_enemies()) {
+    EnemyEntry entry;
+    entry.enemy_id = state.enemy_id();
+    entry.x = state.position().x();
+    entry.y = state.position().y();
+    entry.health = state.health();
+    entry.is_alive = state.is_alive();
+    out->enemies.push_back(entry);
+  }
+
+  const std::size_t sorted_items = out->items.size();
+  for (const auto& item : delta.items()) {
+    ItemEntry* entry =
+        FindOrAppend(&out->items, sorted_items, item.item_id(), kItemId);
+    const bool in_baseline =
+        static_cast<std::size_t>(entry - out->items.data()) < sorted_items;
+    entry->item_id = item.item_id();
+    const uint32_t mask = item.changed_mask();
+    if ((mask & lawnmower::ITEM_DELTA_POSITION) != 0) {
+      if (scale != 0) {
+        if (!in_baseline) {
+          entry->x = 0.0f;  // 新道具为绝对定点坐标
+          entry->y = 0.0f;
+        }
+        DequantizePosition(item, scale, &entry->x, &entry->y);
+      } else {
+        entry->x = item.position().x();
+        entry->y = item.position().y();
+      }
+    }
+    if ((mask & lawnmower::ITEM_DELTA_TYPE) != 0) {
+      entry->type_id = item.type_id();
+    }
+  }
+  const std::unordered_set<uint32_t> removed_items(
+      delta.removed_item_ids().begin(), delta.removed_item_ids().end());
+  std::erase_if(out->items, [&](const ItemEntry& entry) {
+    return removed_items.contains(entry.item_id);
+  });
+
+  out->SortById();
+}
+
+}  // namespace game_manager_snapshot
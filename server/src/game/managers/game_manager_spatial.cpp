@@ -0,0 +1,229 @@
+#include "internal/game_manager_spatial.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+using game_manager_spatial::SpatialHit;
+
+// 距离更近者优先，等距按 id
+bool Closer(const SpatialHit& a, const SpatialHit& b) {
+  return a.dist_sq < b.dist_sq || (a.dist_sq == b.dist_sq && a.id < b.id);
+}
+
+// 低 16 位的每一位之间插入一个 0 位
+uint32_t SpreadBits16(uint32_t v) {
+  v &= 0x0000ffffu;
+  v = (v | (v << 8)) & 0x00ff00ffu;
+  v = (v | (v << 4)) & 0x0f0f0f0fu;
+  v = (v | (v << 2)) & 0x33333333u;
+  v = (v | (v << 1)) & 0x55555555u;
+  return v;
+}
+}  // namespace
+
+namespace game_manager_spatial {
+
+uint32_t MortonCode(uint32_t cell_x, uint32_t cell_y) {
+  return SpreadBits16(cell_x) | (SpreadBits16(cell_y) << 1);
+}
+
+void SpatialIndex::Reset(float width, float height, float cell_size) {
+  cell_size_ = cell_size > 0.0f ? cell_size : 100.0f;
+  cells_x_ = std::max(1, static_cast<int>(std::ceil(width / cell_size_)));
+  cells_y_ = std::max(1, static_cast<int>(std::ceil(height / cell_size_)));
+  pending_.clear();
+  entries_.clear();
+  cell_start_.assign(static_cast<std::size_t>(cells_x_ * cells_y_) + 1, 0);
+}
+
+void SpatialIndex::Insert(uint32_t id, float x, float y) {
+  pending_.push_back(Entry{id, x, y});
+}
+
+int SpatialIndex::CellX(float x) const {
+  return std::clamp(static_cast<int>(std::floor(x / cell_size_)), 0,
+                    cells_x_ - 1);
+}
+
+int SpatialIndex::CellY(float y) const {
+  return std::clamp(static_cast<int>(std::floor(y / cell_size_)), 0,
+                    cells_y_ - 1);
+}
+
+void SpatialIndex::Build() {
+  if (cell_start_.empty()) {
+    // 未 Reset 过：退化为单格
+    cells_x_ = 1;
+    cells_y_ = 1;
+    cell_start_.assign(2, 0);
+  }
+  // 计数排序：统计每格条目数 -> 前缀和 -> 回填
+  std::fill(cell_start_.begin(), cell_start_.end(), 0u);
+  pending_cell_.resize(pending_.size());
+  for (std::size_t i = 0; i < pending_.size(); ++i) {
+    const uint32_t cell = static_cast<uint32_t>(
+        CellY(pending_[i].y) * cells_x_ + CellX(pending_[i].x));
+    pending_cell_[i] = cell;
+    cell_start_[cell + 1] += 1;
+  }
+  for (std::size_t c = 1; c < cell_start_.size(); ++c) {
+    cell_start_[c] += cell_start_[c - 1];
+  }
+  entries_.resize(pending_.size());
+  for (std::size_t i = 0; i < pending_.size(); ++i) {
+    // 借用 cell_start_[cell] 作为写游标，写完后整体右移一格
+    entries_[cell_start_[pending_cell_[i]]++] = pending_[i];
+  }
+  for (std::size_t c = cell_start_.size() - 1; c > 0; --c) {
+    cell_start_[c] = cell_start_[c - 1];
+  }
+  cell_start_[0] = 0;
+  pending_.clear();
+}
+
+template <typename Fn>
+void SpatialIndex::ForEachInRing(int qx, int qy, int ring, Fn&& fn) const {
+  auto visit_cell = [&](int cx, int cy) {
+    if (cx < 0 || cy < 0 || cx >= cells_x_ || cy >= cells_y_) {
+      return;
+    }
+    const std::size_t cell = static_cast<std::size_t>(cy * cells_x_ + cx);
+    for (uint32_t i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+      fn(entries_[i]);
+    }
+  };
+  if (ring == 0) {
+    visit_cell(qx, qy);
+    return;
+  }
+  for (int cx = qx - ring; cx <= qx + ring; ++cx) {
+    visit_cell(cx, qy - ring);
+    visit_cell(cx, qy + ring);
+  }
+  for (int cy = qy - ring + 1; cy <= qy + ring - 1; ++cy) {
+    visit_cell(qx - ring, cy);
+    visit_cell(qx + ring, cy);
+  }
+}
+
+bool SpatialIndex::Nearest(float x, float y, SpatialHit* out) const {
+  if (out == nullptr || entries_.empty()) {
+    return false;
+  }
+
+  SpatialHit best{0, 0.0f};
+  bool found = false;
+  auto consider = [&](const Entry& e) {
+    const float dx = e.x - x;
+    const float dy = e.y - y;
+    const SpatialHit hit{e.id, dx * dx + dy * dy};
+    if (!found || Closer(hit, best)) {
+      best = hit;
+      found = true;
+    }
+  };
+
+  if (entries_.size() <= kLinearScanMax) {
+    for (const auto& e : entries_) {
+      consider(e);
+    }
+    *out = best;
+    return true;
+  }
+
+  const int qx = CellX(x);
+  const int qy = CellY(y);
+  const int max_ring = std::max(std::max(qx, cells_x_ - 1 - qx),
+                                std::max(qy, cells_y_ - 1 - qy));
+  for (int ring = 0; ring <= max_ring; ++ring) {
+    ForEachInRing(qx, qy, ring, consider);
+    // 下一圈的点距离至少 ring * cell_size（查询点位于中心格内）
+    const float bound = static_cast<float>(ring) * cell_size_;
+    if (found && best.dist_sq < bound * bound) {
+      break;
+    }
+  }
+  *out = best;
+  return found;
+}
+
+std::size_t SpatialIndex::KNearest(float x, float y, std::size_t k,
+                                   std::vector<SpatialHit>* out) const {
+  if (out == nullptr) {
+    return 0;
+  }
+  out->clear();
+  if (k == 0 || entries_.empty()) {
+    return 0;
+  }
+
+  // out 作为大小不超过 k 的最大堆（堆顶为当前第 k 近）
+  auto consider = [&](const Entry& e) {
+    const float dx = e.x - x;
+    const float dy = e.y - y;
+    const SpatialHit hit{e.id, dx * dx + dy * dy};
+    if (out->size() < k) {
+      out->push_back(hit);
+      std::push_heap(out->begin(), out->end(), Closer);
+    } else if (Closer(hit, out->front())) {
+      std::pop_heap(out->begin(), out->end(), Closer);
+      out->back() = hit;
+      std::push_heap(out->begin(), out->end(), Closer);
+    }
+  };
+
+  if (entries_.size() <= kLinearScanMax) {
+    for (const auto& e : entries_) {
+      consider(e);
+    }
+  } else {
+    const int qx = CellX(x);
+    const int qy = CellY(y);
+    const int max_ring = std::max(std::max(qx, cells_x_ - 1 - qx),
+                                  std::max(qy, cells_y_ - 1 - qy));
+    for (int ring = 0; ring <= max_ring; ++ring) {
+      ForEachInRing(qx, qy, ring, consider);
+      const float bound = static_cast<float>(ring) * cell_size_;
+      if (out->size() == k && out->front().dist_sq < bound * bound) {
+        break;
+      }
+    }
+  }
+  std::sort_heap(out->begin(), out->end(), Closer);
+  return out->size();
+}
+
+std::size_t SpatialIndex::QueryRect(float min_x, float min_y, float max_x,
+                                    float max_y,
+                                    std::vector<uint32_t>* out) const {
+  if (out == nullptr) {
+    return 0;
+  }
+  out->clear();
+  if (entries_.empty() || min_x > max_x || min_y > max_y) {
+    return 0;
+  }
+
+  // 越界坐标会被夹到边缘格，格内仍逐点判断
+  const int cx0 = CellX(min_x);
+  const int cx1 = CellX(max_x);
+  const int cy0 = CellY(min_y);
+  const int cy1 = CellY(max_y);
+  for (int cy = cy0; cy <= cy1; ++cy) {
+    const std::size_t row = static_cast<std::size_t>(cy * cells_x_);
+    // 同一行相邻格在 CSR 中连续，整段一次扫描
+    const uint32_t begin = cell_start_[row + static_cast<std::size_t>(cx0)];
+    const uint32_t end = cell_start_[row + static_cast<std::size_t>(cx1) + 1];
+    for (uint32_t i = begin; i < end; ++i) {
+      const Entry& e = entries_[i];
+      if (e.x >= min_x && e.x <= max_x && e.y >= min_y && e.y <= max_y) {
+        out->push_back(e.id);
+      }
+    }
+  }
+  std::sort(out->begin(), out->end());
+  return out->size();
+}
+
+}  // namespace game_manager_spatial
@@ -0,0 +1,293 @@
+#include "internal/game_manager_steering.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "internal/game_manager_fastmath.hpp"
+
+#if LAWNMOWER_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// 说明：与碰撞内核相同，各档位按标量版本的运算顺序逐步计算（归一化用
+// fastmath 的 FastRsqrt 及其逐道版本，clamp 用 min(w, max(0, x))），
+// 不使用 FMA / 硬件 rsqrt 近似指令，保证各档位与标量版本逐位一致。
+
+namespace {
+using game_manager_steering::SteerParams;
+using game_manager_steering::SteeringBatch;
+using game_manager_steering::SimdLevel;
+
+constexpr float kMinSteerDistSq = 1e-6f;
+constexpr float kMovedEpsilon = 1e-4f;
+
+void NearestScalar(const float* player_xs, const float* player_ys,
+                   std::size_t player_count, const float* xs, const float* ys,
+                   std::size_t begin, std::size_t end, int32_t* out_index) {
+  for (std::size_t i = begin; i < end; ++i) {
+    float best = std::numeric_limits<float>::infinity();
+    int32_t best_index = -1;
+    for (std::size_t p = 0; p < player_count; ++p) {
+      const float dx = player_xs[p] - xs[i];
+      const float dy = player_ys[p] - ys[i];
+      const float d = dx * dx + dy * dy;
+      if (d < best) {
+        best = d;
+        best_index = static_cast<int32_t>(p);
+      }
+    }
+    out_index[i] = best_index;
+  }
+}
+
+void SteerScalar(const SteerParams& params, SteeringBatch* batch,
+                 std::size_t begin, std::size_t end) {
+  for (std::size_t i = begin; i < end; ++i) {
+    const float x = batch->xs[i];
+    const float y = batch->ys[i];
+    const float dx = batch->goal_xs[i] - x;
+    const float dy = batch->goal_ys[i] - y;
+    const float dist_sq = dx * dx + dy * dy;
+    float new_x = x;
+    float new_y = y;
+    bool moved = false;
+    if (dist_sq > kMinSteerDistSq) {
+      const float inv_len = game_manager_fastmath::FastRsqrt(dist_sq);
+      const float dir_x = dx * inv_len;
+      const float dir_y = dy * inv_len;
+      const float speed = batch->speeds[i];
+      const float dt = batch->dts[i];
+      new_x = std::clamp(x + dir_x * speed * dt, 0.0f, params.map_w);
+      new_y = std::clamp(y + dir_y * speed * dt, 0.0f, params.map_h);
+      moved = std::abs(new_x - x) > kMovedEpsilon ||
+              std::abs(new_y - y) > kMovedEpsilon;
+    }
+    batch->out_xs[i] = new_x;
+    batch->out_ys[i] = new_y;
+    batch->moved[i] = moved ? 1 : 0;
+  }
+}
+
+#if LAWNMOWER_X86_SIMD
+__attribute__((target("sse4.2"))) void NearestSse42(
+    const float* player_xs, const float* player_ys, std::size_t player_count,
+    const float* xs, const float* ys, std::size_t count, int32_t* out_index) {
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 ex = _mm_loadu_ps(xs + i);
+    const __m128 ey = _mm_loadu_ps(ys + i);
+    __m128 best = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128i best_index = _mm_set1_epi32(-1);
+    for (std::size_t p = 0; p < player_count; ++p) {
+      const __m128 dx = _mm_sub_ps(_mm_set1_ps(player_xs[p]), ex);
+      const __m128 dy = _mm_sub_ps(_mm_set1_ps(player_ys[p]), ey);
+      const __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+      const __m128 closer = _mm_cmplt_ps(d, best);
+      best = _mm_blendv_ps(best, d, closer);
+      best_index = _mm_castps_si128(_mm_blendv_ps(
+          _mm_castsi128_ps(best_index),
+          _mm_castsi128_ps(_mm_set1_epi32(static_cast<int32_t>(p))), closer));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_index + i), best_index);
+  }
+  NearestScalar(player_xs, player_ys, player_count, xs, ys, i, count,
+                out_index);
+}
+
+__attribute__((target("avx2"))) void NearestAvx2(
+    const float* player_xs, const float* player_ys, std::size_t player_count,
+    const float* xs, const float* ys, std::size_t count, int32_t* out_index) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 ex = _mm256_loadu_ps(xs + i);
+    const __m256 ey = _mm256_loadu_ps(ys + i);
+    __m256 best = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256i best_index = _mm256_set1_epi32(-1);
+    for (std::size_t p = 0; p < player_count; ++p) {
+      const __m256 dx = _mm256_sub_ps(_mm256_set1_ps(player_xs[p]), ex);
+      const __m256 dy = _mm256_sub_ps(_mm256_set1_ps(player_ys[p]), ey);
+      const __m256 d =
+          _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+      const __m256 closer = _mm256_cmp_ps(d, best, _CMP_LT_OQ);
+      best = _mm256_blendv_ps(best, d, closer);
+      best_index = _mm256_blendv_epi8(
+          best_index, _mm256_set1_epi32(static_cast<int32_t>(p)),
+          _mm256_castps_si256(closer));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_index + i),
+                        best_index);
+  }
+  // 回到非 VEX 编码的标量代码前清零上半部，避免 AVX/SSE 切换惩罚
+  _mm256_zeroupper();
+  NearestScalar(player_xs, player_ys, player_count, xs, ys, i, count,
+                out_index);
+}
+
+__attribute__((target("sse4.2"))) void SteerSse42(const SteerParams& params,
+                                                   SteeringBatch* batch) {
+  const std::size_t count = batch->xs.size();
+  const __m128 v_min_dist_sq = _mm_set1_ps(kMinSteerDistSq);
+  const __m128 v_eps = _mm_set1_ps(kMovedEpsilon);
+  const __m128 v_zero = _mm_setzero_ps();
+  const __m128 v_w = _mm_set1_ps(params.map_w);
+  const __m128 v_h = _mm_set1_ps(params.map_h);
+  const __m128 v_abs = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 x = _mm_loadu_ps(batch->xs.data() + i);
+    const __m128 y = _mm_loadu_ps(batch->ys.data() + i);
+    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(batch->goal_xs.data() + i), x);
+    const __m128 dy = _mm_sub_ps(_mm_loadu_ps(batch->goal_ys.data() + i), y);
+    const __m128 dist_sq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    const __m128 active = _mm_cmpgt_ps(dist_sq, v_min_dist_sq);
+    const __m128 inv_len = game_manager_fastmath::FastRsqrtSse42(dist_sq);
+    const __m128 speed = _mm_loadu_ps(batch->speeds.data() + i);
+    const __m128 v_dt = _mm_loadu_ps(batch->dts.data() + i);
+    const __m128 step_x =
+        _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(dx, inv_len), speed), v_dt);
+    const __m128 step_y =
+        _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(dy, inv_len), speed), v_dt);
+    const __m128 nx =
+        _mm_min_ps(v_w, _mm_max_ps(v_zero, _mm_add_ps(x, step_x)));
+    const __m128 ny =
+        _mm_min_ps(v_h, _mm_max_ps(v_zero, _mm_add_ps(y, step_y)));
+    const __m128 moved = _mm_and_ps(
+        active,
+        _mm_or_ps(_mm_cmpgt_ps(_mm_and_ps(_mm_sub_ps(nx, x), v_abs), v_eps),
+                  _mm_cmpgt_ps(_mm_and_ps(_mm_sub_ps(ny, y), v_abs), v_eps)));
+    _mm_storeu_ps(batch->out_xs.data() + i, _mm_blendv_ps(x, nx, active));
+    _mm_storeu_ps(batch->out_ys.data() + i, _mm_blendv_ps(y, ny, active));
+    const int mask = _mm_movemask_ps(moved);
+    for (int lane = 0; lane < 4; ++lane) {
+      batch->moved[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+    }
+  }
+  SteerScalar(params, batch, i, count);
+}
+
+__attribute__((target("avx2"))) void SteerAvx2(const SteerParams& params,
+                                               SteeringBatch* batch) {
+  const std::size_t count = batch->xs.size();
+  const __m256 v_min_dist_sq = _mm256_set1_ps(kMinSteerDistSq);
+  const __m256 v_eps = _mm256_set1_ps(kMovedEpsilon);
+  const __m256 v_zero = _mm256_setzero_ps();
+  const __m256 v_w = _mm256_set1_ps(params.map_w);
+  const __m256 v_h = _mm256_set1_ps(params.map_h);
+  const __m256 v_abs = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 x = _mm256_loadu_ps(batch->xs.data() + i);
+    const __m256 y = _mm256_loadu_ps(batch->ys.data() + i);
+    const __m256 dx =
+        _mm256_sub_ps(_mm256_loadu_ps(batch->goal_xs.data() + i), x);
+    const __m256 dy =
+        _mm256_sub_ps(_mm256_loadu_ps(batch->goal_ys.data() + i), y);
+    const __m256 dist_sq =
+        _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    const __m256 active = _mm256_cmp_ps(dist_sq, v_min_dist_sq, _CMP_GT_OQ);
+    const __m256 inv_len = game_manager_fastmath::FastRsqrtAvx2(dist_sq);
+    const __m256 speed = _mm256_loadu_ps(batch->speeds.data() + i);
+    const __m256 v_dt = _mm256_loadu_ps(batch->dts.data() + i);
+    const __m256 step_x = _mm256_mul_ps(
+        _mm256_mul_ps(_mm256_mul_ps(dx, inv_len), speed), v_dt);
+    const __m256 step_y = _mm256_mul_ps(
+        _mm256_mul_ps(_mm256_mul_ps(dy, inv_len), speed), v_dt);
+    const __m256 nx = _mm256_min_ps(
+        v_w, _mm256_max_ps(v_zero, _mm256_add_ps(x, step_x)));
+    const __m256 ny = _mm256_min_ps(
+        v_h, _mm256_max_ps(v_zero, _mm256_add_ps(y, step_y)));
+    const __m256 moved_x = _mm256_cmp_ps(
+        _mm256_and_ps(_mm256_sub_ps(nx, x), v_abs), v_eps, _CMP_GT_OQ);
+    const __m256 moved_y = _mm256_cmp_ps(
+        _mm256_and_ps(_mm256_sub_ps(ny, y), v_abs), v_eps, _CMP_GT_OQ);
+    const __m256 moved = _mm256_and_ps(active, _mm256_or_ps(moved_x, moved_y));
+    _mm256_storeu_ps(batch->out_xs.data() + i,
+                     _mm256_blendv_ps(x, nx, active));
+    _mm256_storeu_ps(batch->out_ys.data() + i,
+                     _mm256_blendv_ps(y, ny, active));
+    const int mask = _mm256_movemask_ps(moved);
+    for (int lane = 0; lane < 8; ++lane) {
+      batch->moved[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+    }
+  }
+  _mm256_zeroupper();
+  SteerScalar(params, batch, i, count);
+}
+#endif
+
+}  // namespace
+
+namespace game_manager_steering {
+
+void SteeringBatch::ResizeEnemies(std::size_t count) {
+  xs.resize(count);
+  ys.resize(count);
+  nearest_player.resize(count);
+  goal_xs.resize(count);
+  goal_ys.resize(count);
+  speeds.resize(count);
+  dts.resize(count);
+  out_xs.resize(count);
+  out_ys.resize(count);
+  moved.resize(count);
+}
+
+void NearestPlayers(const float* player_xs, const float* player_ys,
+                    std::size_t player_count, const float* xs,
+                    const float* ys, std::size_t count, int32_t* out_index) {
+  NearestPlayersAt(game_manager_simd::ActiveSimdLevel(), player_xs, player_ys,
+                   player_count, xs, ys, count, out_index);
+}
+
+void NearestPlayersAt(SimdLevel level, const float* player_xs,
+                      const float* player_ys, std::size_t player_count,
+                      const float* xs, const float* ys, std::size_t count,
+                      int32_t* out_index) {
+  if (xs == nullptr || ys == nullptr || out_index == nullptr || count == 0) {
+    return;
+  }
+  if (player_count == 0) {
+    std::fill(out_index, out_index + count, -1);
+    return;
+  }
+  level = game_manager_simd::ClampSimdLevel(level);
+#if LAWNMOWER_X86_SIMD
+  if (level == SimdLevel::kAvx2) {
+    NearestAvx2(player_xs, player_ys, player_count, xs, ys, count, out_index);
+    return;
+  }
+  if (level == SimdLevel::kSse42) {
+    NearestSse42(player_xs, player_ys, player_count, xs, ys, count,
+                 out_index);
+    return;
+  }
+#endif
+  NearestScalar(player_xs, player_ys, player_count, xs, ys, 0, count,
+                out_index);
+}
+
+void SteerTowardGoals(const SteerParams& params, SteeringBatch* batch) {
+  SteerTowardGoalsAt(game_manager_simd::ActiveSimdLevel(), params, batch);
+}
+
+void SteerTowardGoalsAt(SimdLevel level, const SteerParams& params,
+                        SteeringBatch* batch) {
+  if (batch == nullptr || batch->xs.empty()) {
+    return;
+  }
+  level = game_manager_simd::ClampSimdLevel(level);
+#if LAWNMOWER_X86_SIMD
+  if (level == SimdLevel::kAvx2) {
+    SteerAvx2(params, batch);
+    return;
+  }
+  if (level == SimdLevel::kSse42) {
+    SteerSse42(params, batch);
+    return;
+  }
+#endif
+  SteerScalar(params, batch, 0, batch->xs.size());
+}
+
+}  // namespace game_manager_steering
@@ -1,14 +1,61 @@
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "game/managers/game_manager.hpp"
+#include "internal/game_manager_interest.hpp"
 #include "internal/game_manager_internal_utils.hpp"
+#include "internal/game_manager_snapshot.hpp"
 
 namespace {
 using game_manager_internal::FillDeltaTiming;
 using game_manager_internal::FillSyncTiming;
+using game_manager_snapshot::Snapshot;
 
 constexpr float kDeltaPositionEpsilon = 1e-4f;  // delta 位置/朝向变化阈值
+
+// 复制共享 sync 的玩家/道具；敌人只保留兴趣集内且不是刚进入的
+// （刚进入的由调用方按当前完整状态补上）
+void CopyInterestSync(const lawnmower::S2C_GameStateSync& shared,
+                      const game_manager_interest::InterestUpdate& update,
+                      lawnmower::S2C_GameStateSync* out) {
+  *out->mutable_sync_time() = shared.sync_time();
+  out->set_room_id(shared.room_id());
+  out->set_is_full_snapshot(shared.is_full_snapshot());
+  *out->mutable_players() = shared.players();
+  *out->mutable_items() = shared.items();
+  for (const auto& enemy : shared.enemies()) {
+    if (std::binary_search(update.ids.begin(), update.ids.end(),
+                           enemy.enemy_id()) &&
+        !std::binary_search(update.entered.begin(), update.entered.end(),
+                            enemy.enemy_id())) {
+      *out->add_enemies() = enemy;
+    }
+  }
+}
+
+// 把刚进入敌人的位置/血量/存活补进增量：已有条目就补全字段，否则追加
+void AppendEnemyResync(const lawnmower::EnemyState& state,
+                       delta_wire::DeltaFrame* out) {
+  constexpr uint32_t kResyncMask = lawnmower::ENEMY_DELTA_POSITION |
+                                   lawnmower::ENEMY_DELTA_HEALTH |
+                                   lawnmower::ENEMY_DELTA_IS_ALIVE;
+  auto it = std::find_if(out->enemies.begin(), out->enemies.end(),
+                         [&state](const delta_wire::EnemyDelta& enemy) {
+                           return enemy.enemy_id == state.enemy_id();
+                         });
+  if (it == out->enemies.end()) {
+    it = out->enemies.insert(out->enemies.end(), delta_wire::EnemyDelta{});
+    it->enemy_id = state.enemy_id();
+  }
+  it->changed_mask |= kResyncMask;
+  it->x = state.position().x();
+  it->y = state.position().y();
+  it->health = state.health();
+  it->is_alive = state.is_alive();
+}
 }  // namespace
 
 void GameManager::FillPlayerHighFreq(const PlayerRuntime& runtime,
@@ -62,7 +109,8 @@ void GameManager::UpdatePlayerLastSync(PlayerRuntime& runtime) {
 }
 
 void GameManager::UpdateEnemyLastSync(EnemyRuntime& runtime) {
-  runtime.last_sync_position = runtime.state.position();
+  runtime.last_sync_x = runtime.state.position().x();
+  runtime.last_sync_y = runtime.state.position().y();
   runtime.last_sync_health = runtime.state.health();
   runtime.last_sync_is_alive = runtime.state.is_alive();
 }
@@ -78,6 +126,7 @@ void GameManager::MarkPlayerDirty(Scene& scene, uint32_t player_id,
                                   PlayerRuntime& runtime, bool low_freq) {
   if (low_freq) {
     runtime.low_freq_dirty = true;
+    runtime.full_sync_version += 1;
   }
   runtime.dirty = true;
   if (!runtime.dirty_queued) {
@@ -109,8 +158,8 @@ void GameManager::BuildSyncPayloadsLocked(
     const std::vector<uint32_t>& dirty_player_ids,
     const std::vector<uint32_t>& dirty_enemy_ids,
     const std::vector<uint32_t>& dirty_item_ids,
-    lawnmower::S2C_GameStateSync* sync,
-    lawnmower::S2C_GameStateDeltaSync* delta, bool* built_sync,
+    lawnmower::S2C_GameStateSync* sync, delta_wire::DeltaFrame* delta,
+    bool* built_sync,
     bool* built_delta, uint32_t* perf_delta_items_size,
     uint32_t* perf_sync_items_size) {
   if (sync == nullptr || delta == nullptr || built_sync == nullptr ||
@@ -182,15 +231,9 @@ void GameManager::BuildSyncPayloadsLocked(
   } else {
     bool sync_inited = false;
     bool delta_inited = false;
-    if (!scene.players.empty()) {
-      delta->mutable_players()->Reserve(static_cast<int>(scene.players.size()));
-    }
-    if (!scene.enemies.empty()) {
-      delta->mutable_enemies()->Reserve(static_cast<int>(scene.enemies.size()));
-    }
-    if (!scene.items.empty()) {
-      delta->mutable_items()->Reserve(static_cast<int>(scene.items.size()));
-    }
+    delta->players.reserve(dirty_player_ids.size());
+    delta->enemies.reserve(dirty_enemy_ids.size());
+    delta->items.reserve(dirty_item_ids.size());
 
     for (const auto player_id : dirty_player_ids) {
       auto it = scene.players.find(player_id);
@@ -238,23 +281,11 @@ void GameManager::BuildSyncPayloadsLocked(
         FillDeltaTiming(room_id, scene.tick, delta);
         delta_inited = true;
       }
-      auto* out = delta->add_players();
-      out->set_player_id(runtime.state.player_id());
-      out->set_changed_mask(changed_mask);
-      if ((changed_mask & lawnmower::PLAYER_DELTA_POSITION) != 0) {
-        *out->mutable_position() = position;
-      }
-      if ((changed_mask & lawnmower::PLAYER_DELTA_ROTATION) != 0) {
-        out->set_rotation(runtime.state.rotation());
-      }
-      if ((changed_mask & lawnmower::PLAYER_DELTA_IS_ALIVE) != 0) {
-        out->set_is_alive(runtime.state.is_alive());
-      }
-      if ((changed_mask & lawnmower::PLAYER_DELTA_LAST_PROCESSED_INPUT_SEQ) !=
-          0) {
-        out->set_last_processed_input_seq(
-            static_cast<int32_t>(runtime.last_input_seq));
-      }
+      // 未置位的字段编码时不会写出，直接整条记录
+      delta->players.push_back(delta_wire::PlayerDelta{
+          runtime.state.player_id(), changed_mask, position.x(), position.y(),
+          runtime.state.rotation(), runtime.state.is_alive(),
+          static_cast<int32_t>(runtime.last_input_seq)});
       *built_delta = true;
       UpdatePlayerLastSync(runtime);
       runtime.dirty = false;
@@ -290,7 +321,8 @@ void GameManager::BuildSyncPayloadsLocked(
       }
       uint32_t changed_mask = 0;
       const auto& position = enemy.state.position();
-      if (PositionChanged(position, enemy.last_sync_position)) {
+      if (PositionChanged(position.x(), position.y(), enemy.last_sync_x,
+                          enemy.last_sync_y)) {
         changed_mask |= lawnmower::ENEMY_DELTA_POSITION;
       }
       if (enemy.state.health() != enemy.last_sync_health) {
@@ -307,18 +339,9 @@ void GameManager::BuildSyncPayloadsLocked(
         FillDeltaTiming(room_id, scene.tick, delta);
         delta_inited = true;
       }
-      auto* out = delta->add_enemies();
-      out->set_enemy_id(enemy.state.enemy_id());
-      out->set_changed_mask(changed_mask);
-      if ((changed_mask & lawnmower::ENEMY_DELTA_POSITION) != 0) {
-        *out->mutable_position() = position;
-      }
-      if ((changed_mask & lawnmower::ENEMY_DELTA_HEALTH) != 0) {
-        out->set_health(enemy.state.health());
-      }
-      if ((changed_mask & lawnmower::ENEMY_DELTA_IS_ALIVE) != 0) {
-        out->set_is_alive(enemy.state.is_alive());
-      }
+      delta->enemies.push_back(delta_wire::EnemyDelta{
+          enemy.state.enemy_id(), changed_mask, position.x(), position.y(),
+          enemy.state.health(), enemy.state.is_alive()});
       *built_delta = true;
       UpdateEnemyLastSync(enemy);
       enemy.dirty = false;
@@ -359,19 +382,9 @@ void GameManager::BuildSyncPayloadsLocked(
         FillDeltaTiming(room_id, scene.tick, delta);
         delta_inited = true;
       }
-      auto* out = delta->add_items();
-      out->set_item_id(item.item_id);
-      out->set_changed_mask(changed_mask);
-      if ((changed_mask & lawnmower::ITEM_DELTA_POSITION) != 0) {
-        out->mutable_position()->set_x(item.x);
-        out->mutable_position()->set_y(item.y);
-      }
-      if ((changed_mask & lawnmower::ITEM_DELTA_IS_PICKED) != 0) {
-        out->set_is_picked(item.is_picked);
-      }
-      if ((changed_mask & lawnmower::ITEM_DELTA_TYPE) != 0) {
-        out->set_type_id(item.type_id);
-      }
+      delta->items.push_back(delta_wire::ItemDelta{
+          item.item_id, changed_mask, item.x, item.y, item.is_picked,
+          item.type_id});
       *built_delta = true;
       UpdateItemLastSync(item);
       item.dirty = false;
@@ -383,7 +396,7 @@ void GameManager::BuildSyncPayloadsLocked(
       }
     }
     if (delta_inited) {
-      *perf_delta_items_size = static_cast<uint32_t>(delta->items_size());
+      *perf_delta_items_size = static_cast<uint32_t>(delta->items.size());
     }
   }
 
@@ -404,3 +417,227 @@ void GameManager::BuildSyncPayloadsLocked(
     scene.dirty_enemy_ids.swap(next_dirty_enemy_ids);
   }
 }
+
+void GameManager::BuildAckedSyncPayloadsLocked(
+    uint32_t room_id, Scene& scene, std::vector<uint32_t>* acked_player_ids,
+    std::vector<AckedSyncGroup>* groups) {
+  if (acked_player_ids == nullptr || groups == nullptr) {
+    return;
+  }
+
+  for (const auto& [player_id, runtime] : scene.players) {
+    if (runtime.acked_delta) {
+      acked_player_ids->push_back(player_id);
+    }
+  }
+  if (acked_player_ids->empty()) {
+    return;
+  }
+  if (scene.sync_snapshots == nullptr) {
+    scene.sync_snapshots =
+        std::make_shared<game_manager_snapshot::SnapshotRing>();
+  }
+
+  const auto tick = static_cast<uint32_t>(scene.tick);
+  Snapshot* current = scene.sync_snapshots->Record(tick);
+  current->players.reserve(scene.players.size());
+  current->enemies.reserve(scene.enemies.size());
+  current->items.reserve(scene.items.size());
+  for (const auto& [player_id, runtime] : scene.players) {
+    current->players.push_back(game_manager_snapshot::PlayerEntry{
+        player_id, runtime.state.position().x(), runtime.state.position().y(),
+        runtime.state.rotation(), runtime.last_input_seq,
+        runtime.full_sync_version, runtime.state.is_alive()});
+  }
+  for (const auto& [enemy_id, enemy] : scene.enemies) {
+    current->enemies.push_back(game_manager_snapshot::EnemyEntry{
+        enemy_id, enemy.state.position().x(), enemy.state.position().y(),
+        enemy.state.health(), enemy.state.is_alive()});
+  }
+  for (const auto& [item_id, item] : scene.items) {
+    if (item.is_picked) {
+      continue;
+    }
+    current->items.push_back(game_manager_snapshot::ItemEntry{
+        item_id, item.x, item.y, item.type_id});
+  }
+  current->SortById();
+
+  // 找不到基线的玩家改收 TCP 全量快照；其余按基线分组，同组共享一份增量
+  std::vector<uint32_t> full_ids;
+  std::vector<std::pair<const Snapshot*, uint32_t>> by_baseline;
+  by_baseline.reserve(acked_player_ids->size());
+  for (const auto player_id : *acked_player_ids) {
+    PlayerRuntime& runtime = scene.players.find(player_id)->second;
+    const Snapshot* baseline =
+        runtime.acked_sync_tick != 0
+            ? scene.sync_snapshots->Find(runtime.acked_sync_tick)
+            : nullptr;
+    if (baseline == nullptr) {
+      full_ids.push_back(player_id);
+      // TCP 可靠送达，直接作为后续增量的基线
+      runtime.acked_sync_tick = tick;
+    } else {
+      by_baseline.emplace_back(baseline, player_id);
+    }
+  }
+
+  if (!full_ids.empty()) {
+    AckedSyncGroup& group = groups->emplace_back();
+    group.full_snapshot = true;
+    group.player_ids = std::move(full_ids);
+    FillFullStateLocked(room_id, scene, &group.sync);
+    group.sync.set_is_full_snapshot(true);
+  }
+
+  std::sort(by_baseline.begin(), by_baseline.end(),
+            [](const auto& a, const auto& b) {
+              return a.first->tick != b.first->tick
+                         ? a.first->tick < b.first->tick
+                         : a.second < b.second;
+            });
+  // 同一基线下再按是否定点编码拆成两组，定点组在浮点增量的副本上改写
+  const game_manager_snapshot::QuantizeParams quantize_params{
+      config_.delta_position_scale, config_.delta_rotation_bits};
+  std::vector<uint32_t> float_ids;
+  std::vector<uint32_t> quantized_ids;
+  for (std::size_t i = 0; i < by_baseline.size();) {
+    const Snapshot* baseline = by_baseline[i].first;
+    float_ids.clear();
+    quantized_ids.clear();
+    for (; i < by_baseline.size() && by_baseline[i].first == baseline; ++i) {
+      const uint32_t player_id = by_baseline[i].second;
+      if (scene.players.find(player_id)->second.quantized_positions) {
+        quantized_ids.push_back(player_id);
+      } else {
+        float_ids.push_back(player_id);
+      }
+    }
+    // 空增量也下发，客户端据此推进确认基线
+    lawnmower::S2C_GameStateDeltaSync delta;
+    game_manager_snapshot::DiffFollowups followups;
+    game_manager_snapshot::Diff(*baseline, *current, &delta, &followups);
+    FillDeltaTiming(room_id, scene.tick, &delta);
+    delta.set_baseline_tick(baseline->tick);
+    for (const auto full_id : followups.full_player_ids) {
+      const PlayerRuntime& runtime = scene.players.find(full_id)->second;
+      auto* out = delta.add_full_players();
+      *out = runtime.state;
+      out->set_last_processed_input_seq(
+          static_cast<int32_t>(runtime.last_input_seq));
+    }
+    for (const auto enemy_id : followups.spawned_enemy_ids) {
+      *delta.add_spawned_enemies() =
+          scene.enemies.find(enemy_id)->second.state;
+    }
+
+    if (!float_ids.empty()) {
+      AckedSyncGroup& group = groups->emplace_back();
+      group.player_ids = float_ids;
+      group.delta = delta;
+    }
+    if (!quantized_ids.empty()) {
+      AckedSyncGroup& group = groups->emplace_back();
+      group.player_ids = quantized_ids;
+      group.delta = std::move(delta);
+      game_manager_snapshot::Quantize(*baseline, quantize_params,
+                                      &group.delta);
+    }
+  }
+}
+
+void GameManager::BuildInterestSyncPayloadsLocked(
+    uint32_t room_id, Scene& scene, bool force_full_sync, bool built_sync,
+    const lawnmower::S2C_GameStateSync& sync,
+    const delta_wire::DeltaFrame& delta,
+    std::vector<uint32_t>* excluded_player_ids,
+    std::vector<InterestSyncTarget>* targets) {
+  if (excluded_player_ids == nullptr || targets == nullptr) {
+    return;
+  }
+
+  const game_manager_interest::InterestParams params{
+      config_.aoi_view_half_width, config_.aoi_view_half_height,
+      config_.aoi_margin};
+  // 全量快照整体替换客户端场景，离开的敌人无需再列出
+  const bool full_snapshot = force_full_sync && built_sync;
+  bool index_ready = false;
+  game_manager_interest::InterestUpdate update;
+  std::vector<uint32_t> resync_due;
+  for (auto& [player_id, runtime] : scene.players) {
+    // 按确认基线的增量自带完整实体集合，不叠加兴趣区域过滤
+    if (!runtime.interest_filter || runtime.acked_delta) {
+      continue;
+    }
+    if (!index_ready) {
+      // 移动阶段建好的索引标记为 tick + 1，同步调度推进 tick 后恰好等于
+      // 当前 tick；本帧没有重建过（如没有存活敌人移动）时补建
+      if (scene.enemy_spatial == nullptr ||
+          scene.enemy_spatial_tick != scene.tick) {
+        EnsureEnemySpatialIndexLocked(scene);
+      }
+      index_ready = true;
+    }
+
+    const auto& position = runtime.state.position();
+    game_manager_interest::UpdateInterestSet(
+        *scene.enemy_spatial, position.x(), position.y(), params,
+        runtime.interest_enemy_ids, &update);
+    // 索引建于战斗结算之前，期间死亡的敌人不再进入
+    std::erase_if(update.entered, [&scene, &update](uint32_t enemy_id) {
+      const auto it = scene.enemies.find(enemy_id);
+      if (it != scene.enemies.end() && it->second.state.is_alive()) {
+        return false;
+      }
+      update.ids.erase(
+          std::lower_bound(update.ids.begin(), update.ids.end(), enemy_id));
+      return true;
+    });
+    // 死亡的敌人客户端已按 is_alive=false / S2C_EnemyDied 处理，不算离开
+    std::erase_if(update.left, [&scene](uint32_t enemy_id) {
+      const auto it = scene.enemies.find(enemy_id);
+      return it == scene.enemies.end() || !it->second.state.is_alive();
+    });
+    game_manager_interest::AdvanceEnteredResync(
+        update, game_manager_interest::kEnteredResyncCount,
+        &runtime.interest_resync, &resync_due);
+
+    excluded_player_ids->push_back(player_id);
+    InterestSyncTarget& target = targets->emplace_back();
+    target.player_id = player_id;
+    if (built_sync) {
+      CopyInterestSync(sync, update, &target.sync);
+    } else {
+      FillSyncTiming(room_id, scene.tick, &target.sync);
+      target.sync.set_is_full_snapshot(false);
+    }
+    for (const auto enemy_id : update.entered) {
+      *target.sync.add_enemies() = scene.enemies.find(enemy_id)->second.state;
+    }
+    target.has_sync = target.sync.is_full_snapshot() ||
+                      target.sync.players_size() > 0 ||
+                      target.sync.enemies_size() > 0 ||
+                      target.sync.items_size() > 0;
+    if (!full_snapshot) {
+      game_manager_interest::FilterDeltaFrame(delta, update, &target.delta);
+      // 离开列表只通知一次，拆成单独的小增量走 TCP；位置增量仍走 UDP
+      if (!target.delta.removed_enemy_ids.empty()) {
+        target.leave.removed_enemy_ids.swap(target.delta.removed_enemy_ids);
+        FillDeltaTiming(room_id, scene.tick, &target.leave);
+      }
+      for (const auto enemy_id : resync_due) {
+        const auto it = scene.enemies.find(enemy_id);
+        if (it != scene.enemies.end()) {
+          AppendEnemyResync(it->second.state, &target.delta);
+        }
+      }
+      if (!target.delta.Empty()) {
+        FillDeltaTiming(room_id, scene.tick, &target.delta);
+      }
+    }
+    runtime.interest_enemy_ids.swap(update.ids);
+    if (!target.has_sync && target.delta.Empty() && target.leave.Empty()) {
+      targets->pop_back();
+    }
+  }
+}
@@ -1,12 +1,6 @@
 #include "internal/game_manager_sync_dispatch.hpp"
 
-#if defined(_WIN32)
-#include <winsock2.h>
-#else
-#include <arpa/inet.h>
-#endif
-
-#include <cstring>
+#include <array>
 #include <memory>
 #include <span>
 #include <spdlog/spdlog.h>
@@ -17,51 +11,16 @@
 #include "network/udp/udp_server.hpp"
 
 namespace {
-struct FramedPacket {
-  lawnmower::MessageType type = lawnmower::MessageType::MSG_UNKNOWN;
-  std::shared_ptr<const std::string> framed;
-  std::size_t payload_len = 0;
-  std::size_t body_len = 0;
-};
-
-FramedPacket BuildFramedPacket(lawnmower::MessageType type,
-                               const google::protobuf::Message& message) {
-  lawnmower::Packet packet;
-  packet.set_msg_type(type);
-  const std::string payload = message.SerializeAsString();
-  packet.set_payload(payload);
-  const std::string body = packet.SerializeAsString();
-  const uint32_t net_len = htonl(static_cast<uint32_t>(body.size()));
-  std::string framed;
-  framed.resize(sizeof(net_len) + body.size());
-  std::memcpy(framed.data(), &net_len, sizeof(net_len));
-  std::memcpy(framed.data() + sizeof(net_len), body.data(), body.size());
-  return {type, std::make_shared<std::string>(std::move(framed)),
-          payload.size(), body.size()};
-}
-
-void SendFramedToSessions(std::span<const std::weak_ptr<TcpSession>> sessions,
-                          const FramedPacket& packet) {
-  for (const auto& weak_session : sessions) {
-    if (auto session = weak_session.lock()) {
-      session->SendFramedPacket(packet.framed, packet.type, packet.payload_len,
-                                packet.body_len);
-    }
-  }
-}
-
 void SendSyncToSessions(std::span<const std::weak_ptr<TcpSession>> sessions,
                         const lawnmower::S2C_GameStateSync& sync) {
-  const auto packet =
-      BuildFramedPacket(lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC, sync);
-  SendFramedToSessions(sessions, packet);
+  TcpSession::Broadcast(sessions,
+                        lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC, sync);
 }
 
 void SendDeltaToSessions(std::span<const std::weak_ptr<TcpSession>> sessions,
                          const lawnmower::S2C_GameStateDeltaSync& sync) {
-  const auto packet = BuildFramedPacket(
-      lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC, sync);
-  SendFramedToSessions(sessions, packet);
+  TcpSession::Broadcast(
+      sessions, lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC, sync);
 }
 
 bool HasSyncPayload(bool built_sync, const lawnmower::S2C_GameStateSync& sync) {
@@ -69,20 +28,20 @@ bool HasSyncPayload(bool built_sync, const lawnmower::S2C_GameStateSync& sync) {
                         sync.items_size() > 0);
 }
 
-bool HasDeltaPayload(bool built_delta,
-                     const lawnmower::S2C_GameStateDeltaSync& delta) {
-  return built_delta && (delta.players_size() > 0 || delta.enemies_size() > 0 ||
-                         delta.items_size() > 0);
+bool HasDeltaPayload(bool built_delta, const delta_wire::DeltaFrame& delta) {
+  return built_delta && !delta.Empty();
 }
 
 struct RoomSessionCache {
   uint32_t room_id = 0;
+  std::span<const uint32_t> exclude_player_ids;
   bool ready = false;
   std::vector<std::weak_ptr<TcpSession>> sessions;
 
   const std::vector<std::weak_ptr<TcpSession>>& Get() {
     if (!ready) {
-      sessions = RoomManager::Instance().GetRoomSessions(room_id);
+      sessions =
+          RoomManager::Instance().GetRoomSessions(room_id, exclude_player_ids);
       ready = true;
     }
     return sessions;
@@ -90,7 +49,7 @@ struct RoomSessionCache {
 };
 
 void SendDeltaSyncWithFallback(uint32_t room_id, UdpServer* udp_server,
-                               const lawnmower::S2C_GameStateDeltaSync& delta,
+                               const delta_wire::DeltaFrame& delta,
                                RoomSessionCache* cache) {
   if (cache == nullptr) {
     return;
@@ -98,7 +57,9 @@ void SendDeltaSyncWithFallback(uint32_t room_id, UdpServer* udp_server,
 
   bool delta_sent_udp = false;
   if (udp_server != nullptr) {
-    delta_sent_udp = udp_server->BroadcastDeltaState(room_id, delta) > 0;
+    delta_sent_udp =
+        udp_server->BroadcastDeltaState(room_id, delta,
+                                        cache->exclude_player_ids) > 0;
   }
   if (delta_sent_udp) {
     return;
@@ -106,7 +67,12 @@ void SendDeltaSyncWithFallback(uint32_t room_id, UdpServer* udp_server,
 
   const auto& targets = cache->Get();
   if (!targets.empty()) {
-    SendDeltaToSessions(targets, delta);
+    const auto packet = delta_wire::EncodeFramed(delta);
+    if (packet.bytes == nullptr) {
+      spdlog::error("房间 {} 增量同步编码失败", room_id);
+      return;
+    }
+    TcpSession::BroadcastEncoded(targets, packet);
     return;
   }
   spdlog::debug("房间 {} 无可用会话，跳过 TCP 增量同步兜底", room_id);
@@ -125,7 +91,9 @@ void SendSyncWithFallback(uint32_t room_id, UdpServer* udp_server,
   // 若已发送增量，同一 tick 不再走 UDP，避免客户端判重丢包。
   const bool allow_udp_sync = !force_full_sync && !has_delta_payload;
   if (allow_udp_sync && udp_server != nullptr) {
-    sync_sent_udp = udp_server->BroadcastState(room_id, sync) > 0;
+    sync_sent_udp =
+        udp_server->BroadcastState(room_id, sync, cache->exclude_player_ids) >
+        0;
   }
   if (sync_sent_udp) {
     return;
@@ -142,18 +110,21 @@ void SendSyncWithFallback(uint32_t room_id, UdpServer* udp_server,
 
 namespace game_manager_sync_dispatch {
 
-void DispatchStateSyncPayloads(uint32_t room_id, UdpServer* udp_server,
-                               bool force_full_sync, bool built_sync,
-                               bool built_delta,
-                               const lawnmower::S2C_GameStateSync& sync,
-                               const lawnmower::S2C_GameStateDeltaSync& delta) {
+void DispatchStateSyncPayloads(
+    uint32_t room_id, UdpServer* udp_server, bool force_full_sync,
+    bool built_sync, bool built_delta, const lawnmower::S2C_GameStateSync& sync,
+    const delta_wire::DeltaFrame& delta,
+    std::span<const uint32_t> exclude_player_ids) {
   const bool has_sync_payload = HasSyncPayload(built_sync, sync);
   const bool has_delta_payload = HasDeltaPayload(built_delta, delta);
   if (!has_sync_payload && !has_delta_payload) {
     return;
   }
 
-  RoomSessionCache session_cache{.room_id = room_id};
+  RoomSessionCache session_cache{.room_id = room_id,
+                                 .exclude_player_ids = exclude_player_ids,
+                                 .ready = false,
+                                 .sessions = {}};
   // 优先尝试 UDP 发送增量；若无 UDP 则走 TCP 兜底。
   if (has_delta_payload) {
     SendDeltaSyncWithFallback(room_id, udp_server, delta, &session_cache);
@@ -164,4 +135,82 @@ void DispatchStateSyncPayloads(uint32_t room_id, UdpServer* udp_server,
   }
 }
 
+void DispatchAckedFullSync(uint32_t room_id,
+                           std::span<const uint32_t> player_ids,
+                           const lawnmower::S2C_GameStateSync& sync) {
+  const auto targets =
+      RoomManager::Instance().GetPlayerSessions(room_id, player_ids);
+  if (!targets.empty()) {
+    SendSyncToSessions(targets, sync);
+  }
+}
+
+void DispatchAckedDeltaSync(uint32_t room_id, UdpServer* udp_server,
+                            std::span<const uint32_t> player_ids,
+                            const lawnmower::S2C_GameStateDeltaSync& delta) {
+  std::vector<uint32_t> unreached;
+  if (udp_server != nullptr) {
+    udp_server->SendDeltaState(player_ids, delta, &unreached);
+  } else {
+    unreached.assign(player_ids.begin(), player_ids.end());
+  }
+  if (unreached.empty()) {
+    return;
+  }
+  const auto targets =
+      RoomManager::Instance().GetPlayerSessions(room_id, unreached);
+  if (!targets.empty()) {
+    SendDeltaToSessions(targets, delta);
+  }
+}
+
+void DispatchInterestSync(uint32_t room_id, UdpServer* udp_server,
+                          uint32_t player_id,
+                          const lawnmower::S2C_GameStateSync* sync,
+                          const delta_wire::DeltaFrame& delta,
+                          const delta_wire::DeltaFrame& leave) {
+  const std::array<uint32_t, 1> player_ids{player_id};
+  std::vector<uint32_t> unreached;
+  if (!delta.Empty()) {
+    if (udp_server != nullptr) {
+      udp_server->SendDeltaState(player_ids, delta, &unreached);
+    } else {
+      unreached.push_back(player_id);
+    }
+  }
+  if (unreached.empty() && leave.Empty() && sync == nullptr) {
+    return;
+  }
+
+  const auto targets =
+      RoomManager::Instance().GetPlayerSessions(room_id, player_ids);
+  if (targets.empty()) {
+    return;
+  }
+  const auto send_frame = [room_id,
+                           &targets](const delta_wire::DeltaFrame& frame) {
+    const auto packet = delta_wire::EncodeFramed(frame);
+    if (packet.bytes == nullptr) {
+      spdlog::error("房间 {} 增量同步编码失败", room_id);
+      return;
+    }
+    TcpSession::BroadcastEncoded(targets, packet);
+  };
+  if (!unreached.empty()) {
+    send_frame(delta);
+  }
+  if (!leave.Empty()) {
+    send_frame(leave);
+  }
+  if (sync != nullptr) {
+    SendSyncToSessions(targets, *sync);
+  }
+}
+
+void FlushReliableEvents(uint32_t room_id, UdpServer* udp_server) {
+  if (udp_server != nullptr) {
+    udp_server->FlushReliable(room_id);
+  }
+}
+
 }  // namespace game_manager_sync_dispatch
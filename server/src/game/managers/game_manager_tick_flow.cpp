@@ -8,6 +8,7 @@
 #include "internal/game_manager_event_dispatch.hpp"
 #include "internal/game_manager_misc_utils.hpp"
 #include "internal/game_manager_sync_dispatch.hpp"
+#include "internal/game_manager_tick_steps.hpp"
 
 namespace {
 constexpr float kDirectionEpsilonSq =
@@ -200,17 +201,29 @@ void GameManager::CaptureGameOverPerfLocked(
   *perf_to_save = std::move(scene.perf);
 }
 
-double GameManager::ComputeTickDeltaSecondsLocked(
-    Scene& scene, double tick_interval_seconds) const {
+uint32_t GameManager::ComputeTickStepsLocked(Scene& scene,
+                                             double tick_interval_seconds,
+                                             double* dt_seconds) const {
+  if (dt_seconds == nullptr) {
+    return 0;
+  }
+  using game_manager_tick_steps::SteadyDuration;
   const auto now = std::chrono::steady_clock::now();
-  const auto elapsed = scene.last_tick_time.time_since_epoch().count() == 0
-                           ? scene.tick_interval
-                           : now - scene.last_tick_time;
+  const SteadyDuration elapsed =
+      scene.last_tick_time.time_since_epoch().count() == 0
+          ? std::chrono::duration_cast<SteadyDuration>(scene.tick_interval)
+          : now - scene.last_tick_time;
   scene.last_tick_time = now;
-  const double elapsed_seconds =
-      std::clamp(std::chrono::duration<double>(elapsed).count(), 0.0,
-                 kMaxTickDeltaSeconds);
-  return elapsed_seconds > 0.0 ? elapsed_seconds : tick_interval_seconds;
+
+  game_manager_tick_steps::StepParams params;
+  params.tick_interval_seconds = tick_interval_seconds;
+  params.max_substeps = config_.max_substeps_per_tick;
+  params.max_delta_seconds = kMaxTickDeltaSeconds;
+  params.deterministic_replay = config_.deterministic_replay;
+  const auto result = game_manager_tick_steps::ComputeTickSteps(
+      params, elapsed, &scene.step_accumulator);
+  *dt_seconds = result.dt_seconds;
+  return result.steps;
 }
 
 void GameManager::SimulateSceneFrameLocked(Scene& scene,
@@ -221,6 +234,7 @@ void GameManager::SimulateSceneFrameLocked(Scene& scene,
     return;
   }
 
+  scene.sim_tick += 1;
   bool has_dirty = false;
   ProcessPlayerInputsLocked(scene, frame.tick_interval_seconds,
                             frame.dt_seconds, &has_dirty);
@@ -236,6 +250,7 @@ void GameManager::SimulateSceneFrameLocked(Scene& scene,
       &outputs->dropped_items, &has_dirty);
   TryBeginPendingUpgradeLocked(frame.room_id, scene, &outputs->upgrade_request);
   RecordPlayerHistoryLocked(scene);
+  VerifyAliveCountersLocked(scene);
 
   dirty_state->has_dirty_players = !scene.dirty_player_ids.empty();
   dirty_state->has_dirty_enemies = !scene.dirty_enemy_ids.empty();
@@ -258,8 +273,9 @@ void GameManager::BuildSceneSyncAndPerfLocked(Scene& scene,
       outputs->dropped_items, outputs->player_hurts,
       outputs->enemy_attack_states, outputs->enemy_dieds, outputs->level_ups,
       outputs->game_over, outputs->upgrade_request);
+  const double frame_seconds = frame.dt_seconds * frame.steps;
   UpdateSyncSchedulingLocked(
-      scene, frame.dt_seconds, frame.tick_interval_seconds, has_priority_events,
+      scene, frame_seconds, frame.tick_interval_seconds, has_priority_events,
       dirty_state.has_dirty_players, dirty_state.has_dirty_enemies,
       dirty_state.has_dirty_items, &outputs->should_sync,
       &outputs->force_full_sync);
@@ -273,12 +289,21 @@ void GameManager::BuildSceneSyncAndPerfLocked(Scene& scene,
         &outputs->delta, &outputs->built_sync, &outputs->built_delta,
         &outputs->perf_delta_items_size, &outputs->perf_sync_items_size);
   }
+  if (want_sync) {
+    BuildAckedSyncPayloadsLocked(frame.room_id, scene,
+                                 &outputs->excluded_player_ids,
+                                 &outputs->acked_sync);
+    BuildInterestSyncPayloadsLocked(
+        frame.room_id, scene, outputs->force_full_sync, outputs->built_sync,
+        outputs->sync, outputs->delta, &outputs->excluded_player_ids,
+        &outputs->interest_sync);
+  }
 
   const auto perf_end = std::chrono::steady_clock::now();
   const double perf_ms =
       std::chrono::duration<double, std::milli>(perf_end - frame.perf_start)
           .count();
-  RecordPerfSampleLocked(scene, perf_ms, frame.dt_seconds, false,
+  RecordPerfSampleLocked(scene, perf_ms, frame_seconds, false,
                          static_cast<uint32_t>(scene.dirty_player_ids.size()),
                          static_cast<uint32_t>(scene.dirty_enemy_ids.size()),
                          static_cast<uint32_t>(scene.dirty_item_ids.size()),
@@ -305,7 +330,17 @@ void GameManager::ProcessActiveSceneTickLocked(Scene& scene,
   }
 
   TickDirtyState dirty_state;
-  SimulateSceneFrameLocked(scene, frame, outputs, &dirty_state);
+  for (uint32_t step = 0; step < frame.steps; ++step) {
+    if (step > 0) {
+      // 每个子步都是一个逻辑帧；最后一步的 tick 由同步调度推进
+      scene.tick += 1;
+    }
+    SimulateSceneFrameLocked(scene, frame, outputs, &dirty_state);
+    // 结束或进入升级暂停后，剩余子步作废
+    if (outputs->game_over.has_value() || scene.is_paused) {
+      break;
+    }
+  }
   BuildSceneSyncAndPerfLocked(scene, frame, dirty_state, outputs);
 }
 
@@ -325,7 +360,10 @@ void GameManager::FinalizeSceneTick(
     uint32_t perf_sync_rate, double perf_elapsed_seconds, uint64_t event_tick,
     uint32_t event_wave_id, bool force_full_sync, bool built_sync,
     bool built_delta, const lawnmower::S2C_GameStateSync& sync,
-    const lawnmower::S2C_GameStateDeltaSync& delta) {
+    const delta_wire::DeltaFrame& delta,
+    const std::vector<uint32_t>& excluded_player_ids,
+    const std::vector<AckedSyncGroup>& acked_sync,
+    const std::vector<InterestSyncTarget>& interest_sync) {
   if (projectile_spawns == nullptr || projectile_despawns == nullptr ||
       perf_to_save == nullptr) {
     return;
@@ -334,6 +372,8 @@ void GameManager::FinalizeSceneTick(
   CleanupExpiredPlayers(expired_players);
 
   if (paused_only) {
+    // 暂停或不足一步的唤醒也推进可靠通道的超时重发
+    game_manager_sync_dispatch::FlushReliableEvents(room_id, udp_server_);
     return;
   }
 
@@ -341,7 +381,7 @@ void GameManager::FinalizeSceneTick(
   game_manager_misc_utils::DedupProjectileDespawns(projectile_despawns);
 
   game_manager_event_dispatch::DispatchTickEvents(
-      room_id, event_tick, event_wave_id, *projectile_spawns,
+      room_id, udp_server_, event_tick, event_wave_id, *projectile_spawns,
       *projectile_despawns, dropped_items, enemy_attack_states, player_hurts,
       enemy_dieds, level_ups, game_over, upgrade_request);
 
@@ -359,7 +399,23 @@ void GameManager::FinalizeSceneTick(
 
   game_manager_sync_dispatch::DispatchStateSyncPayloads(
       room_id, udp_server_, force_full_sync, built_sync, built_delta, sync,
-      delta);
+      delta, excluded_player_ids);
+  for (const auto& group : acked_sync) {
+    if (group.full_snapshot) {
+      game_manager_sync_dispatch::DispatchAckedFullSync(
+          room_id, group.player_ids, group.sync);
+    } else {
+      game_manager_sync_dispatch::DispatchAckedDeltaSync(
+          room_id, udp_server_, group.player_ids, group.delta);
+    }
+  }
+  for (const auto& target : interest_sync) {
+    game_manager_sync_dispatch::DispatchInterestSync(
+        room_id, udp_server_, target.player_id,
+        target.has_sync ? &target.sync : nullptr, target.delta,
+        target.leave);
+  }
+  game_manager_sync_dispatch::FlushReliableEvents(room_id, udp_server_);
 }
 
 // 进程场景计时器
@@ -392,8 +448,8 @@ void GameManager::ProcessSceneTick(uint32_t room_id,
       expired_players.reserve(scene.players.size());
     }
     frame.perf_start = std::chrono::steady_clock::now();
-    frame.dt_seconds =
-        ComputeTickDeltaSecondsLocked(scene, tick_interval_seconds);
+    frame.steps = ComputeTickStepsLocked(scene, tick_interval_seconds,
+                                         &frame.dt_seconds);
 
     const double grace_seconds =
         std::max(0.0, static_cast<double>(config_.reconnect_grace_seconds));
@@ -401,6 +457,9 @@ void GameManager::ProcessSceneTick(uint32_t room_id,
 
     if (HandlePausedTickLocked(scene, frame.dt_seconds, frame.perf_start)) {
       paused_only = true;
+    } else if (frame.steps == 0) {
+      // 唤醒时尚不足一步：不推进模拟，也没有需要下发的内容
+      paused_only = true;
     } else {
       ProcessActiveSceneTickLocked(scene, frame, &outputs);
     }
@@ -414,5 +473,6 @@ void GameManager::ProcessSceneTick(uint32_t room_id,
       &outputs.perf_to_save, outputs.perf_tick_rate, outputs.perf_sync_rate,
       outputs.perf_elapsed_seconds, outputs.event_tick, outputs.event_wave_id,
       outputs.force_full_sync, outputs.built_sync, outputs.built_delta,
-      outputs.sync, outputs.delta);
+      outputs.sync, outputs.delta, outputs.excluded_player_ids,
+      outputs.acked_sync, outputs.interest_sync);
 }
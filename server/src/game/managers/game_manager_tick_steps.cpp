@@ -0,0 +1,56 @@
+#include "internal/game_manager_tick_steps.hpp"
+
+#include <algorithm>
+
+namespace game_manager_tick_steps {
+namespace {
+// 固定步长模式下，累积时间差不足一步的 1/8 以内也推进一步
+constexpr int kStepEarlyWakeFraction = 8;
+}  // namespace
+
+StepResult ComputeTickSteps(const StepParams& params, SteadyDuration elapsed,
+                            SteadyDuration* accumulator) {
+  StepResult result;
+  if (accumulator == nullptr) {
+    return result;
+  }
+  if (params.deterministic_replay) {
+    // 回放模式每次唤醒固定推进一步，避免墙钟抖动影响模拟结果
+    result.steps = 1;
+    result.dt_seconds = params.tick_interval_seconds;
+    return result;
+  }
+  if (params.max_substeps == 0) {
+    const double elapsed_seconds =
+        std::clamp(std::chrono::duration<double>(elapsed).count(), 0.0,
+                   params.max_delta_seconds);
+    result.steps = 1;
+    result.dt_seconds = elapsed_seconds > 0.0 ? elapsed_seconds
+                                              : params.tick_interval_seconds;
+    return result;
+  }
+
+  // 固定步长：用整数时钟单位累积，长时间运行也不会漂移
+  result.dt_seconds = params.tick_interval_seconds;
+  const auto step = std::max(
+      SteadyDuration(1),
+      std::chrono::duration_cast<SteadyDuration>(
+          std::chrono::duration<double>(params.tick_interval_seconds)));
+  *accumulator += std::max(SteadyDuration::zero(), elapsed);
+  // 定时器略早唤醒时预支一步，避免抖动造成 0 步 / 2 步交替
+  const auto steps = static_cast<uint64_t>(
+      std::max<SteadyDuration::rep>(
+          0, (*accumulator + step / kStepEarlyWakeFraction).count()) /
+      step.count());
+  if (steps > params.max_substeps) {
+    // 积压超过上限（长时间卡顿）：丢弃多余时间，不做追赶
+    *accumulator = SteadyDuration::zero();
+    result.steps = params.max_substeps;
+    return result;
+  }
+  *accumulator -= step * static_cast<SteadyDuration::rep>(steps);
+  result.steps = static_cast<uint32_t>(steps);
+  return result;
+}
+
+}  // namespace game_manager_tick_steps
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "game/managers/game_manager.hpp"
+#include "internal/game_manager_alias.hpp"
+#include "internal/game_manager_misc_utils.hpp"
+
+namespace {
+constexpr float kDefaultEnemyMoveSpeed = 60.0f;
+
+// 按 type_id 升序编号，槽位与配置文件中的书写顺序无关
+template <typename Map>
+std::vector<uint32_t> SortedTypeIds(const Map& types) {
+  std::vector<uint32_t> ids;
+  ids.reserve(types.size());
+  for (const auto& [type_id, _] : types) {
+    ids.push_back(type_id);
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+std::shared_ptr<game_manager_alias::AliasTable> BuildAlias(
+    const std::vector<uint32_t>& weights) {
+  auto table = std::make_shared<game_manager_alias::AliasTable>();
+  table->Build(weights);
+  return table;
+}
+}  // namespace
+
+// 把敌人类型配置编译成稠密表；配置为空时只有一行后备类型
+void GameManager::RebuildEnemyTypeTable() {
+  enemy_type_rows_.clear();
+  enemy_type_slots_.clear();
+  std::vector<uint32_t> type_ids = SortedTypeIds(enemy_types_config_.enemies);
+  if (type_ids.empty()) {
+    type_ids.push_back(ResolveEnemyType(0).type_id);
+  }
+  enemy_type_rows_.reserve(type_ids.size());
+  for (const uint32_t type_id : type_ids) {
+    const EnemyTypeConfig& type = ResolveEnemyType(type_id);
+    EnemyTypeRow row;
+    row.type_id = type.type_id;
+    row.max_health = type.max_health;
+    row.move_speed =
+        type.move_speed > 0.0f ? type.move_speed : kDefaultEnemyMoveSpeed;
+    row.damage = std::max<int32_t>(0, type.damage);
+    row.exp_reward =
+        static_cast<uint32_t>(std::max<int32_t>(0, type.exp_reward));
+    row.drop_chance = std::min(type.drop_chance, 100u);
+    float enter_radius = 0.0f;
+    float exit_radius = 0.0f;
+    ResolveEnemyAttackRadiiForStage(type, &enter_radius, &exit_radius);
+    row.attack_enter_radius_sq = enter_radius * enter_radius;
+    row.attack_exit_radius_sq = exit_radius * exit_radius;
+    row.attack_interval_seconds = ResolveEnemyAttackIntervalForStage(type);
+    enemy_type_slots_.emplace(type_id,
+                              static_cast<uint16_t>(enemy_type_rows_.size()));
+    enemy_type_rows_.push_back(row);
+  }
+
+  // 刷怪候选沿用配置给出的有序列表，权重为 0 的类型不参与随机刷怪
+  enemy_spawn_type_ids_.clear();
+  std::vector<uint32_t> weights;
+  weights.reserve(enemy_types_config_.spawn_type_ids.size());
+  for (const uint32_t type_id : enemy_types_config_.spawn_type_ids) {
+    enemy_spawn_type_ids_.push_back(type_id);
+    weights.push_back(ResolveEnemyType(type_id).spawn_weight);
+  }
+  enemy_spawn_alias_ = BuildAlias(weights);
+}
+
+void GameManager::RebuildItemTypeTable() {
+  item_type_rows_.clear();
+  item_type_slots_.clear();
+  std::vector<uint32_t> type_ids = SortedTypeIds(items_config_.items);
+  if (type_ids.empty()) {
+    type_ids.push_back(ResolveItemType(0).type_id);
+  }
+  item_type_rows_.reserve(type_ids.size());
+  for (const uint32_t type_id : type_ids) {
+    const ItemTypeConfig& type = ResolveItemType(type_id);
+    ItemTypeRow row;
+    row.type_id = type.type_id;
+    row.heal_value = std::max<int32_t>(0, type.value);
+    row.drop_weight = type.drop_weight;
+    item_type_slots_.emplace(type_id,
+                             static_cast<uint16_t>(item_type_rows_.size()));
+    item_type_rows_.push_back(row);
+  }
+
+  // 掉落候选：仅配置中的回血道具（不含后备行），按 type_id 升序
+  item_drop_type_ids_.clear();
+  std::vector<uint32_t> weights;
+  for (const ItemTypeRow& row : item_type_rows_) {
+    const auto it = items_config_.items.find(row.type_id);
+    if (it == items_config_.items.end() || row.drop_weight == 0 ||
+        game_manager_misc_utils::ResolveItemEffectType(it->second.effect) !=
+            lawnmower::ITEM_EFFECT_HEAL) {
+      continue;
+    }
+    item_drop_type_ids_.push_back(row.type_id);
+    weights.push_back(row.drop_weight);
+  }
+  item_drop_alias_ = BuildAlias(weights);
+}
+
+// 升级效果权重至少为 1，与旧的逐次累加写法一致
+void GameManager::RebuildUpgradeTable() {
+  std::vector<uint32_t> weights;
+  weights.reserve(upgrade_config_.effects.size());
+  for (const auto& effect : upgrade_config_.effects) {
+    weights.push_back(std::max<uint32_t>(1, effect.weight));
+  }
+  upgrade_alias_ = BuildAlias(weights);
+}
+
+uint16_t GameManager::EnemyTypeSlot(uint32_t type_id) const {
+  auto it = enemy_type_slots_.find(type_id);
+  if (it == enemy_type_slots_.end()) {
+    it = enemy_type_slots_.find(ResolveEnemyType(type_id).type_id);
+  }
+  return it != enemy_type_slots_.end() ? it->second : 0;
+}
+
+uint16_t GameManager::ItemTypeSlot(uint32_t type_id) const {
+  auto it = item_type_slots_.find(type_id);
+  if (it == item_type_slots_.end()) {
+    it = item_type_slots_.find(ResolveItemType(type_id).type_id);
+  }
+  return it != item_type_slots_.end() ? it->second : 0;
+}
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -7,80 +8,88 @@
 
 #include "game/managers/game_manager.hpp"
 #include "game/managers/room_manager.hpp"
+#include "internal/game_manager_alias.hpp"
+#include "internal/game_manager_rng.hpp"
 #include "network/tcp/tcp_session.hpp"
 
 namespace {
 constexpr uint32_t kUpgradeOptionCount = 3;
+// 别名表抽到已选效果时的最大重抽次数
+constexpr uint32_t kUpgradeRejectAttempts = 8;
 
 template <typename TMessage>
 void BroadcastToRoom(uint32_t room_id, lawnmower::MessageType type,
                      const TMessage& message) {
-  const auto sessions = RoomManager::Instance().GetRoomSessions(room_id);
-  for (const auto& weak_session : sessions) {
-    if (auto session = weak_session.lock()) {
-      session->SendProto(type, message);
-    }
-  }
+  TcpSession::Broadcast(RoomManager::Instance().GetRoomSessions(room_id), type,
+                        message);
 }
 
 void SendFullSyncToRoom(uint32_t room_id,
                         const lawnmower::S2C_GameStateSync& sync) {
-  const auto sessions = RoomManager::Instance().GetRoomSessions(room_id);
-  for (const auto& weak_session : sessions) {
-    if (auto session = weak_session.lock()) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC, sync);
-    }
-  }
+  TcpSession::Broadcast(RoomManager::Instance().GetRoomSessions(room_id),
+                        lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC, sync);
 }
 }  // namespace
 
+// 不放回地抽取 kUpgradeOptionCount 个选项：先按别名表抽样，
+// 抽到已选中的效果就重抽（等价于在剩余效果上按权重抽样）；
+// 连续落空时改为在剩余效果上线性累加，避免某个权重独大时反复重抽。
+// 效果数少于选项数时，抽完一轮后全部放回。
 void GameManager::BuildUpgradeOptionsLocked(Scene& scene) {
   scene.upgrade_options.clear();
-  if (upgrade_config_.effects.empty()) {
+  const auto& effects = upgrade_config_.effects;
+  if (effects.empty() || upgrade_alias_ == nullptr ||
+      upgrade_alias_->Size() != effects.size()) {
     return;
   }
 
-  std::vector<std::size_t> candidates;
-  candidates.reserve(upgrade_config_.effects.size());
-  for (std::size_t i = 0; i < upgrade_config_.effects.size(); ++i) {
-    candidates.push_back(i);
-  }
+  // 升级选项可能在同一 tick 内多次刷新，随机流按抽取次数而非 tick 划分
+  game_manager_rng::RngStream rng(scene.rng_seed, scene.upgrade_rolls++,
+                                  game_manager_rng::RngStage::kUpgrade,
+                                  scene.upgrade_player_id);
+  std::array<std::size_t, kUpgradeOptionCount> drawn{};
+  std::size_t drawn_count = 0;
+  const auto is_drawn = [&drawn, &drawn_count](std::size_t idx) {
+    return std::find(drawn.begin(), drawn.begin() + drawn_count, idx) !=
+           drawn.begin() + drawn_count;
+  };
 
   for (uint32_t i = 0; i < kUpgradeOptionCount; ++i) {
-    if (candidates.empty()) {
-      for (std::size_t j = 0; j < upgrade_config_.effects.size(); ++j) {
-        candidates.push_back(j);
-      }
+    if (drawn_count == effects.size()) {
+      drawn_count = 0;
     }
 
-    uint64_t total_weight = 0;
-    for (std::size_t idx : candidates) {
-      total_weight +=
-          std::max<uint32_t>(1, upgrade_config_.effects[idx].weight);
-    }
-    if (total_weight == 0) {
-      break;
-    }
-
-    uint64_t roll = GameManager::NextRng(&scene.rng_state) % total_weight;
-    std::size_t chosen_pos = 0;
-    for (; chosen_pos < candidates.size(); ++chosen_pos) {
-      const auto idx = candidates[chosen_pos];
-      const uint64_t weight =
-          std::max<uint32_t>(1, upgrade_config_.effects[idx].weight);
-      if (roll < weight) {
+    std::size_t chosen = effects.size();
+    for (uint32_t attempt = 0; attempt < kUpgradeRejectAttempts; ++attempt) {
+      const std::size_t idx = upgrade_alias_->Sample(rng.NextU32());
+      if (!is_drawn(idx)) {
+        chosen = idx;
         break;
       }
-      roll -= weight;
     }
-    if (chosen_pos >= candidates.size()) {
-      chosen_pos = 0;
+    if (chosen == effects.size()) {
+      uint64_t total_weight = 0;
+      for (std::size_t idx = 0; idx < effects.size(); ++idx) {
+        if (!is_drawn(idx)) {
+          total_weight += std::max<uint32_t>(1, effects[idx].weight);
+        }
+      }
+      uint64_t roll = rng.NextU32() % total_weight;
+      for (std::size_t idx = 0; idx < effects.size(); ++idx) {
+        if (is_drawn(idx)) {
+          continue;
+        }
+        const uint64_t weight = std::max<uint32_t>(1, effects[idx].weight);
+        if (roll < weight) {
+          chosen = idx;
+          break;
+        }
+        roll -= weight;
+      }
     }
 
-    scene.upgrade_options.push_back(
-        upgrade_config_.effects[candidates[chosen_pos]]);
-    candidates.erase(candidates.begin() +
-                     static_cast<std::ptrdiff_t>(chosen_pos));
+    drawn[drawn_count++] = chosen;
+    scene.upgrade_options.push_back(effects[chosen]);
   }
 }
 
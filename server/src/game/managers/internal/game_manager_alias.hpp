@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game_manager_alias {
+
+// Walker/Vose 别名表：配置加载时按权重预编译，之后每次抽样 O(1)。
+// 抽样只消耗一个 32 位随机数（高位选列、低位做硬币），
+// 与此前「取模 + 累加」的写法消耗相同的随机数个数，随机流保持可复现。
+// 权重为 0 的条目永远不会被抽中；权重全为 0 或条目超过 65536 个时表为空。
+class AliasTable {
+ public:
+  void Build(const std::vector<uint32_t>& weights);
+  void Clear();
+
+  [[nodiscard]] bool Empty() const { return prob_.empty(); }
+  [[nodiscard]] std::size_t Size() const { return prob_.size(); }
+
+  // 返回 [0, Size()) 内的下标；调用方需保证表非空
+  [[nodiscard]] std::size_t Sample(uint32_t r) const {
+    const uint64_t scaled = static_cast<uint64_t>(r) * prob_.size();
+    const std::size_t column = static_cast<std::size_t>(scaled >> 32);
+    const uint32_t coin = static_cast<uint32_t>(scaled);
+    return coin < prob_[column] ? column : alias_[column];
+  }
+
+ private:
+  std::vector<uint32_t> prob_;   // 留在本列的阈值（按 2^32 定标）
+  std::vector<uint32_t> alias_;  // 硬币落空时跳转的列
+};
+
+}  // namespace game_manager_alias
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "game_manager_simd.hpp"
+
+namespace game_manager_collision {
+
+// 线段与圆是否相交（用于连续碰撞检测，避免高速穿透）；标量参考实现
+bool SegmentCircleOverlap(float ax, float ay, float bx, float by, float cx,
+                          float cy, float radius, float* out_t);
+
+struct Segment {
+  float ax = 0.0f;
+  float ay = 0.0f;
+  float bx = 0.0f;
+  float by = 0.0f;
+};
+
+using game_manager_simd::DetectSimdLevel;
+using game_manager_simd::SimdLevel;
+using game_manager_simd::SimdLevelName;
+
+// 一条线段对一段 SoA 圆心（xs/ys 连续存放）做批量检测，返回最早命中
+// （t 最小，t 相同取下标小者）的下标，未命中返回 -1。
+// 圆心为 NaN 的条目视为空位，永不命中。各档位结果与逐个调用
+// SegmentCircleOverlap 完全一致（含 t 的每一位）。
+std::ptrdiff_t EarliestSegmentCircleHit(const Segment& seg, const float* xs,
+                                        const float* ys, std::size_t count,
+                                        float radius, float* out_t);
+std::ptrdiff_t EarliestSegmentCircleHitAt(SimdLevel level, const Segment& seg,
+                                          const float* xs, const float* ys,
+                                          std::size_t count, float radius,
+                                          float* out_t);
+
+}  // namespace game_manager_collision
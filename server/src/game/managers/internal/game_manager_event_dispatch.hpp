@@ -1,15 +1,23 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <vector>
 
 #include "message.pb.h"
 
+class TcpSession;
+class UdpServer;
+
 namespace game_manager_event_dispatch {
 
+// udp_server 可为空；非空时协商了可靠通道且已登记 UDP 终端的玩家改走
+// UDP 可靠通道（随后由同步包捎带或 FlushReliable 发出）。这类玩家退回
+// TCP 时（终端失效、窗口满、含升级/结算）先经 TCP 补发未确认的可靠消息
 void DispatchTickEvents(
-    uint32_t room_id, uint64_t event_tick, uint32_t event_wave_id,
+    uint32_t room_id, UdpServer* udp_server, uint64_t event_tick,
+    uint32_t event_wave_id,
     const std::vector<lawnmower::ProjectileState>& projectile_spawns,
     const std::vector<lawnmower::ProjectileDespawn>& projectile_despawns,
     const std::vector<lawnmower::ItemState>& dropped_items,
@@ -20,4 +28,9 @@ void DispatchTickEvents(
     const std::optional<lawnmower::S2C_GameOver>& game_over,
     const std::optional<lawnmower::S2C_UpgradeRequest>& upgrade_request);
 
+// 玩家离开房间、会话关闭或宽限期超时移除时释放其可靠通道：session 非空时
+// 先经 TCP 补发未确认的可靠消息，再丢弃发送端
+void ReleaseReliableChannel(UdpServer* udp_server, uint32_t player_id,
+                            const std::shared_ptr<TcpSession>& session);
+
 }  // namespace game_manager_event_dispatch
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+#include "game_manager_simd.hpp"
+
+#if LAWNMOWER_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// 方向 / 朝向换算的快速近似，全部为 inline。供批量内核复用的逐道 FastRsqrt
+// 按标量的运算顺序逐步计算（不使用 FMA / 硬件 rsqrt 近似指令），结果与标量
+// 逐位一致，不依赖 CPU 型号。误差上界由单元测试全域扫描校验。
+namespace game_manager_fastmath {
+
+// FastRsqrt 相对误差上界（位运算初值 + 两次牛顿迭代，实测约 4.73e-6）；
+// 一次迭代的误差恒为低估（约 1.75e-3），会让归一化后的移动系统性偏慢
+inline constexpr float kRsqrtMaxRelError = 5e-6f;
+// FastAtan2Deg 绝对误差上界（11 次奇多项式，理论值约 1e-5 弧度）
+inline constexpr float kAtan2MaxErrorDeg = 1e-3f;
+// FastDirFromDeg 分量绝对误差上界（|deg| < kDirFromDegMaxInput 时）
+inline constexpr float kDirMaxError = 1e-6f;
+inline constexpr float kDirFromDegMaxInput = 1e6f;
+
+namespace detail {
+inline constexpr uint32_t kRsqrtMagic = 0x5f3759dfu;
+inline constexpr float kPi = 3.14159265358979f;
+inline constexpr float kHalfPi = 1.57079632679490f;
+inline constexpr float kRadToDeg = 57.2957795130823f;
+inline constexpr float kDegToRad = 0.0174532925199433f;
+// atan(z), z ∈ [0, 1] 的极小极大多项式系数（z 的 1、3、…、11 次项）
+inline constexpr float kAtanC0 = 0.99997726f;
+inline constexpr float kAtanC1 = -0.33262347f;
+inline constexpr float kAtanC2 = 0.19354346f;
+inline constexpr float kAtanC3 = -0.11643287f;
+inline constexpr float kAtanC4 = 0.05265332f;
+inline constexpr float kAtanC5 = -0.01172120f;
+// [-π/4, π/4] 上的 sin / cos 泰勒系数
+inline constexpr float kSinC3 = -1.0f / 6.0f;
+inline constexpr float kSinC5 = 1.0f / 120.0f;
+inline constexpr float kSinC7 = -1.0f / 5040.0f;
+inline constexpr float kCosC2 = -0.5f;
+inline constexpr float kCosC4 = 1.0f / 24.0f;
+inline constexpr float kCosC6 = -1.0f / 720.0f;
+inline constexpr float kCosC8 = 1.0f / 40320.0f;
+}  // namespace detail
+
+// 1/sqrt(x)，x 须为正的规格化浮点数
+inline float FastRsqrt(float x) {
+  const float y = std::bit_cast<float>(detail::kRsqrtMagic -
+                                       (std::bit_cast<uint32_t>(x) >> 1));
+  const float half = 0.5f * x;
+  const float y1 = y * (1.5f - half * y * y);
+  return y1 * (1.5f - half * y1 * y1);
+}
+
+// 与 std::atan2(y, x) 同象限的角度（度，范围 [-180, 180]）；零向量返回 0
+inline float FastAtan2Deg(float y, float x) {
+  const float ax = std::abs(x);
+  const float ay = std::abs(y);
+  const float hi = ax > ay ? ax : ay;
+  const float lo = ax > ay ? ay : ax;
+  if (hi == 0.0f) {
+    return 0.0f;
+  }
+  const float z = lo / hi;
+  const float z2 = z * z;
+  float r =
+      z * (detail::kAtanC0 +
+           z2 * (detail::kAtanC1 +
+                 z2 * (detail::kAtanC2 +
+                       z2 * (detail::kAtanC3 +
+                             z2 * (detail::kAtanC4 + z2 * detail::kAtanC5)))));
+  if (ay > ax) {
+    r = detail::kHalfPi - r;
+  }
+  if (x < 0.0f) {
+    r = detail::kPi - r;
+  }
+  return std::copysign(r * detail::kRadToDeg, y);
+}
+
+// 朝向角（度）对应的单位向量 {cos, sin}；先按 90° 取象限再在
+// [-45°, 45°] 上用泰勒多项式，超出输入范围或非有限值时退回 libm
+inline std::pair<float, float> FastDirFromDeg(float deg) {
+  if (!(std::abs(deg) < kDirFromDegMaxInput)) {
+    const float rad = deg * detail::kDegToRad;
+    return {std::cos(rad), std::sin(rad)};
+  }
+  const float q = std::nearbyint(deg * (1.0f / 90.0f));
+  const float r = (deg - q * 90.0f) * detail::kDegToRad;
+  const float r2 = r * r;
+  const float s =
+      r + r * r2 * (detail::kSinC3 +
+                    r2 * (detail::kSinC5 + r2 * detail::kSinC7));
+  const float c =
+      1.0f + r2 * (detail::kCosC2 +
+                   r2 * (detail::kCosC4 +
+                         r2 * (detail::kCosC6 + r2 * detail::kCosC8)));
+  switch (static_cast<int64_t>(q) & 3) {
+    case 0:
+      return {c, s};
+    case 1:
+      return {-s, c};
+    case 2:
+      return {-c, -s};
+    default:
+      return {s, -c};
+  }
+}
+
+#if LAWNMOWER_X86_SIMD
+// 供其他批量内核复用的逐道 FastRsqrt（与标量逐位一致）
+__attribute__((target("sse4.2"))) inline __m128 FastRsqrtSse42(__m128 x) {
+  const __m128 y = _mm_castsi128_ps(
+      _mm_sub_epi32(_mm_set1_epi32(static_cast<int32_t>(detail::kRsqrtMagic)),
+                    _mm_srli_epi32(_mm_castps_si128(x), 1)));
+  const __m128 half = _mm_mul_ps(_mm_set1_ps(0.5f), x);
+  const __m128 three_halves = _mm_set1_ps(1.5f);
+  const __m128 y1 = _mm_mul_ps(
+      y, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, y), y)));
+  return _mm_mul_ps(
+      y1, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, y1), y1)));
+}
+
+__attribute__((target("avx2"))) inline __m256 FastRsqrtAvx2(__m256 x) {
+  const __m256 y = _mm256_castsi256_ps(_mm256_sub_epi32(
+      _mm256_set1_epi32(static_cast<int32_t>(detail::kRsqrtMagic)),
+      _mm256_srli_epi32(_mm256_castps_si256(x), 1)));
+  const __m256 half = _mm256_mul_ps(_mm256_set1_ps(0.5f), x);
+  const __m256 three_halves = _mm256_set1_ps(1.5f);
+  const __m256 y1 = _mm256_mul_ps(
+      y, _mm256_sub_ps(three_halves, _mm256_mul_ps(_mm256_mul_ps(half, y), y)));
+  return _mm256_mul_ps(
+      y1,
+      _mm256_sub_ps(three_halves, _mm256_mul_ps(_mm256_mul_ps(half, y1), y1)));
+}
+#endif
+
+}  // namespace game_manager_fastmath
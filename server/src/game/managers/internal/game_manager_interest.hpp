@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "game_manager_spatial.hpp"
+#include "network/delta_wire.hpp"
+
+// 兴趣区域（AOI）：协商了 INTEREST_FILTER 的玩家只接收自身视野附近的敌人。
+// 兴趣集以玩家位置为中心的矩形从敌人空间索引中查出；进入用视野 + margin，
+// 离开用视野 + 2 * margin，两者之间的滞回带避免敌人在边界上反复进出。
+namespace game_manager_interest {
+
+// 进入的敌人完整状态走 TCP，可能晚于随后的 UDP 增量到达而使其被丢弃；
+// 进入后的这么多次同步里把它的位置/血量/存活补进增量
+inline constexpr uint32_t kEnteredResyncCount = 3;
+
+struct InterestParams {
+  float half_width = 640.0f;   // 视野矩形半宽
+  float half_height = 360.0f;  // 视野矩形半高
+  float margin = 128.0f;       // 视野外扩余量
+};
+
+// 一次兴趣集更新的结果，均为升序 id；缓冲在多次更新间复用
+struct InterestUpdate {
+  std::vector<uint32_t> ids;      // 新兴趣集
+  std::vector<uint32_t> entered;  // 本次进入（需下发完整状态）
+  std::vector<uint32_t> left;     // 本次离开（下发 removed_enemy_ids）
+  std::vector<uint32_t> inner;    // 进入矩形查询结果（暂存）
+  std::vector<uint32_t> outer;    // 离开矩形查询结果（暂存）
+};
+
+// previous 为上次的兴趣集（须升序）
+void UpdateInterestSet(const game_manager_spatial::SpatialIndex& index,
+                       float x, float y, const InterestParams& params,
+                       const std::vector<uint32_t>& previous,
+                       InterestUpdate* out);
+
+// 把共享增量过滤成单个玩家的增量：玩家/道具原样保留；敌人只保留兴趣集内、
+// 本次不是刚进入的（刚进入的另发完整状态）；离开的敌人写入 removed_enemy_ids
+void FilterDeltaFrame(const delta_wire::DeltaFrame& shared,
+                      const InterestUpdate& update,
+                      delta_wire::DeltaFrame* out);
+
+// 推进补发列表（(敌人 id, 剩余次数)，按 id 升序）：仍在兴趣集内的表项计入
+// due（升序）并减一次，用完或已离开的移除；本次进入的以 count 次加入
+void AdvanceEnteredResync(const InterestUpdate& update, uint32_t count,
+                          std::vector<std::pair<uint32_t, uint32_t>>* resync,
+                          std::vector<uint32_t>* due);
+
+}  // namespace game_manager_interest
@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include "message.pb.h"
+#include "network/delta_wire.hpp"
 
 namespace game_manager_internal {
 
@@ -17,5 +18,7 @@ void FillSyncTiming(uint32_t room_id, uint64_t tick,
 // 统一填充高频 delta 同步时间字段
 void FillDeltaTiming(uint32_t room_id, uint64_t tick,
                      lawnmower::S2C_GameStateDeltaSync* sync);
+void FillDeltaTiming(uint32_t room_id, uint64_t tick,
+                     delta_wire::DeltaFrame* frame);
 
 }  // namespace game_manager_internal
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+namespace game_manager_lod {
+
+// 敌人模拟 LOD 档位：按到最近玩家的距离划分，远处敌人降频更新
+enum class LodTier : uint8_t {
+  kNear = 0,  // 每 tick 完整模拟
+  kMid = 1,   // 每 mid_interval tick 更新一次
+  kFar = 2,   // 每 far_interval tick 更新一次
+};
+
+struct LodConfig {
+  float mid_distance_sq = 0.0f;  // 0 表示关闭 LOD（全部为 kNear）
+  float far_distance_sq = 0.0f;
+  uint32_t mid_interval = 1;
+  uint32_t far_interval = 1;
+};
+
+// 距离 <= 0 时关闭对应档位；间隔至少为 1，far 档距离不小于 mid 档
+LodConfig MakeLodConfig(float mid_distance, float far_distance,
+                        uint32_t mid_interval, uint32_t far_interval);
+
+// 以下两个判定每个敌人每 tick 都要调用，放在头文件里便于内联
+inline LodTier ClassifyLod(const LodConfig& config, float dist_sq) {
+  if (config.mid_distance_sq <= 0.0f || dist_sq < config.mid_distance_sq) {
+    return LodTier::kNear;
+  }
+  if (config.far_distance_sq > 0.0f && dist_sq >= config.far_distance_sq) {
+    return LodTier::kFar;
+  }
+  return LodTier::kMid;
+}
+
+// 本 tick 是否轮到该实体更新；按实体 id 错开，使降频实体均摊到各 tick。
+// 用 32 位取模（tick 截断只在回绕时改变一次相位），避免 64 位除法
+inline bool ShouldSimulate(const LodConfig& config, LodTier tier,
+                           uint64_t tick, uint32_t entity_id) {
+  uint32_t interval = 1;
+  if (tier == LodTier::kMid) {
+    interval = config.mid_interval;
+  } else if (tier == LodTier::kFar) {
+    interval = config.far_interval;
+  }
+  return interval <= 1 ||
+         (static_cast<uint32_t>(tick) + entity_id) % interval == 0;
+}
+
+}  // namespace game_manager_lod
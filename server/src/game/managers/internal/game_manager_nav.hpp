@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace game_manager_nav {
+
+using NavCell = std::pair<int, int>;
+
+struct NavGrid {
+  int cells_x = 0;
+  int cells_y = 0;
+  int cell_size = 0;
+};
+
+// A* 临时缓冲：使用代际标记避免每次全量清空数组。
+// 开放列表为按格子索引定位的二叉小根堆（支持 decrease-key），每格最多入堆一次，
+// 容量在 Reserve 时按格子总数预分配，寻路过程中不再分配内存。
+struct NavScratch {
+  std::vector<int> came_from;
+  std::vector<float> g_score;
+  std::vector<float> f_score;
+  std::vector<uint32_t> visit_epoch;
+  std::vector<uint32_t> closed_epoch;
+  std::vector<int> heap;      // 开放列表（存格子索引）
+  std::vector<int> heap_pos;  // 格子在堆中的下标（仅本代 visit 且未 close 时有效）
+  std::vector<NavCell> path_buffer;  // 同步寻路输出缓冲（写入路径缓存前暂存）
+  uint32_t epoch = 0;
+
+  void Reserve(std::size_t cells);
+};
+
+NavCell WorldToCell(const NavGrid& grid, float x, float y);
+
+std::pair<float, float> CellCenterWorld(const NavGrid& grid, int cx, int cy);
+
+// 8 邻接网格 A*；成功时 out_path 为 start -> goal（包含两端）
+bool FindPathAstar(const NavGrid& grid, const NavCell& start,
+                   const NavCell& goal, std::vector<NavCell>* out_path,
+                   NavScratch* scratch);
+
+}  // namespace game_manager_nav
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace game_manager_parallel {
+
+// 阻塞式并行 for：把 [0, count) 切成若干段，由 worker 与调用线程共同领取，
+// Run 返回时全部段已执行完。fn 只应读写属于自己区间的数据。
+// 同一时刻只执行一个 Run（多个调用方会排队）。
+class ParallelForPool {
+ public:
+  using RangeFn = std::function<void(std::size_t begin, std::size_t end)>;
+
+  explicit ParallelForPool(std::size_t thread_count);
+  ~ParallelForPool();
+
+  ParallelForPool(const ParallelForPool&) = delete;
+  ParallelForPool& operator=(const ParallelForPool&) = delete;
+
+  // 每段至少 min_chunk 个元素；count 不超过 min_chunk 时直接在调用线程执行
+  void Run(std::size_t count, std::size_t min_chunk, const RangeFn& fn);
+
+  [[nodiscard]] std::size_t ThreadCount() const { return workers_.size(); }
+
+ private:
+  void WorkerLoop();
+  void DrainChunks();
+
+  std::mutex run_mutex_;  // 串行化 Run
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  const RangeFn* fn_ = nullptr;
+  std::size_t count_ = 0;
+  std::size_t chunk_ = 1;
+  std::atomic<std::size_t> next_{0};
+  std::size_t busy_workers_ = 0;
+  uint64_t generation_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace game_manager_parallel
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "game_manager_nav.hpp"
+
+namespace game_manager_path_cache {
+
+using game_manager_nav::NavCell;
+using game_manager_nav::NavGrid;
+
+// 路径引用：arena 偏移 + 长度；generation 用于识别槽位已被淘汰复用
+struct PathRef {
+  uint32_t offset = 0;
+  uint32_t generation = 0;
+  uint16_t length = 0;
+};
+
+// 场景级 LRU 路径缓存，按 (start_cell, goal_cell) 索引。
+// 路径只在 arena 中存一份（格子索引；格子数超过 uint16 上限的大地图改用
+// uint32 存储），长路径的敌人通过 PathRef 引用；
+// 网格无障碍物，缓存无需失效，只在容量满时淘汰最久未用的槽位
+// （旧引用随 generation 变化自动失效）。敌人持有的引用须 Pin：被 Pin 的槽位
+// 移出 LRU 链表不参与淘汰，全部槽位都被 Pin 时按需扩容，至多扩到初始容量的
+// kMaxPinnedGrowthFactor 倍，之后写入失败（调用方按未找到路径处理）。
+// 仅供 tick 线程访问，不加锁。
+class PathCache {
+ public:
+  static constexpr std::size_t kMaxPinnedGrowthFactor = 2;
+
+  void Init(const NavGrid& grid, std::size_t capacity);
+
+  [[nodiscard]] bool Enabled() const { return capacity_ > 0; }
+  // 格子索引能否放进 uint16（敌人内联缓冲只接收这种路径）
+  [[nodiscard]] bool CompactCells() const { return !wide_; }
+
+  // 命中时写出引用并刷新 LRU
+  bool Lookup(const NavCell& start, const NavCell& goal, PathRef* out);
+
+  // 写入路径（满时覆盖最久未用槽位）；同 key 已存在时直接返回已有引用；
+  // 槽位全部被 Pin 且已扩到上限时返回 false
+  bool Insert(const NavCell& start, const NavCell& goal,
+              const std::vector<NavCell>& path, PathRef* out);
+
+  [[nodiscard]] bool IsLive(const PathRef& ref) const;
+
+  // 引用计数：Pin 住的槽位不会被淘汰；引用已失效时忽略
+  void Pin(const PathRef& ref);
+  void Unpin(const PathRef& ref);
+
+  // 调用方需保证 IsLive(ref) 且 index < ref.length
+  [[nodiscard]] NavCell CellAt(const PathRef& ref, std::size_t index) const;
+  [[nodiscard]] uint32_t CellIndexAt(const PathRef& ref,
+                                     std::size_t index) const {
+    const std::size_t pos = static_cast<std::size_t>(ref.offset) + index;
+    return wide_ ? wide_arena_[pos] : arena_[pos];
+  }
+
+  [[nodiscard]] std::size_t Size() const { return index_.size(); }
+  [[nodiscard]] std::size_t Capacity() const { return capacity_; }
+  [[nodiscard]] std::size_t ArenaBytes() const {
+    return arena_.size() * sizeof(uint16_t) +
+           wide_arena_.size() * sizeof(uint32_t);
+  }
+
+ private:
+  static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+  struct Slot {
+    uint64_t key = 0;
+    uint32_t generation = 0;
+    uint32_t prev = kNone;  // LRU 链表（head 为最近使用）
+    uint32_t next = kNone;
+    uint32_t pins = 0;  // 持有引用的敌人数（> 0 时不在 LRU 链表中）
+    uint16_t length = 0;
+    bool in_use = false;
+  };
+
+  [[nodiscard]] uint64_t MakeKey(const NavCell& start,
+                                 const NavCell& goal) const;
+  void Unlink(uint32_t slot);
+  void PushFront(uint32_t slot);
+  [[nodiscard]] PathRef RefOf(uint32_t slot) const;
+  [[nodiscard]] uint32_t AcquireSlot();
+  void ResizeArena();
+
+  NavGrid grid_;
+  std::size_t capacity_ = 0;
+  std::size_t max_capacity_ = 0;  // 全部被 Pin 时的扩容上限
+  std::size_t stride_ = 0;        // 每个槽位在 arena 中占用的格子数
+  bool wide_ = false;             // 格子索引是否需要 uint32
+  std::vector<uint16_t> arena_;   // 格子索引（y * cells_x + x）
+  std::vector<uint32_t> wide_arena_;  // 大地图时代替 arena_
+  std::vector<Slot> slots_;
+  std::unordered_map<uint64_t, uint32_t> index_;  // key -> slot
+  uint32_t head_ = kNone;
+  uint32_t tail_ = kNone;
+  uint32_t used_slots_ = 0;
+};
+
+}  // namespace game_manager_path_cache
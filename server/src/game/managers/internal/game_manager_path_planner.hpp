@@ -0,0 +1,91 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "game_manager_nav.hpp"
+
+namespace game_manager_path_planner {
+
+using game_manager_nav::NavCell;
+using game_manager_nav::NavGrid;
+
+struct PathRequest {
+  uint32_t enemy_id = 0;     // 发起寻路的敌人
+  uint32_t request_seq = 0;  // 敌人侧请求序号（过期结果直接丢弃）
+  uint64_t submit_tick = 0;  // 提交时的逻辑帧
+  uint64_t order = 0;        // 场景内提交顺序（由 channel 分配）
+  NavGrid grid;
+  NavCell start;
+  NavCell goal;
+};
+
+struct PathResult {
+  uint32_t enemy_id = 0;
+  uint32_t request_seq = 0;
+  uint64_t submit_tick = 0;
+  uint64_t order = 0;
+  NavCell start;
+  NavCell goal;
+  bool found = false;
+  std::vector<NavCell> path;  // start -> goal
+};
+
+// 单个场景的寻路结果通道：tick 线程提交/收取，worker 回填结果。
+// 场景销毁后 worker 仍持有 shared_ptr，结果写入后随之释放。
+class PathPlanChannel {
+ public:
+  // 收取已完成结果（按提交顺序排序）；wait_all 为 true 时阻塞到在途请求全部完成
+  void Collect(bool wait_all, std::vector<PathResult>* out);
+
+  [[nodiscard]] std::size_t InFlight() const;
+
+ private:
+  friend class PathPlannerPool;
+
+  void MarkSubmitted(PathRequest* request);
+  void Complete(PathResult result);
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<PathResult> completed_;
+  std::size_t in_flight_ = 0;
+  uint64_t next_order_ = 0;
+};
+
+// 寻路线程池：每个 worker 使用 thread_local A* 缓冲，不与场景共享状态
+class PathPlannerPool {
+ public:
+  explicit PathPlannerPool(std::size_t thread_count);
+  ~PathPlannerPool();
+
+  PathPlannerPool(const PathPlannerPool&) = delete;
+  PathPlannerPool& operator=(const PathPlannerPool&) = delete;
+
+  void Submit(const std::shared_ptr<PathPlanChannel>& channel,
+              PathRequest request);
+
+  [[nodiscard]] std::size_t ThreadCount() const { return workers_.size(); }
+
+ private:
+  struct Job {
+    std::shared_ptr<PathPlanChannel> channel;
+    PathRequest request;
+  };
+
+  void WorkerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Job> jobs_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace game_manager_path_planner
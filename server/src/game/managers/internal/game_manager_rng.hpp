@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace game_manager_rng {
+
+// 随机数用途：同一实体在不同阶段取到的随机序列互不相关
+enum class RngStage : uint8_t {
+  kEnemySpawn = 1,  // 刷怪：类型 + 出生边 + 边上位置
+  kEnemyDrop = 2,   // 击杀掉落：是否掉落 + 掉落类型
+  kPlayerCrit = 3,  // 射弹暴击
+  kUpgrade = 4,     // 升级选项
+};
+
+using PhiloxBlock = std::array<uint32_t, 4>;
+
+// Philox4x32-10（Salmon et al. 2011）：对 128 位计数器做 10 轮带密钥的
+// 乘法-异或置换，同一 (counter, key) 永远得到同一组 4 个 32 位随机数。
+PhiloxBlock Philox4x32(PhiloxBlock counter, uint64_t key);
+
+// 基于计数器的随机流：由 (场景种子, tick, 阶段, 实体 id) 唯一确定，
+// 与其他实体 / 阶段的取用顺序无关，可在并行阶段里各自独立抽取，结果逐位可复现。
+// 对非逐帧发生的事件（如升级刷新）可把 tick 换成该阶段自己的递增序号。
+// 单个流最多取 2^32 个块，远超任何实体单帧所需。
+class RngStream {
+ public:
+  RngStream(uint64_t seed, uint64_t tick, RngStage stage, uint32_t entity_id)
+      : key_(seed),
+        counter_{0, entity_id, static_cast<uint32_t>(tick),
+                 (static_cast<uint32_t>(stage) << 24) |
+                     (static_cast<uint32_t>(tick >> 32) & 0x00FFFFFFu)} {}
+
+  uint32_t NextU32() {
+    if (used_ == block_.size()) {
+      block_ = Philox4x32(counter_, key_);
+      counter_[0] += 1;
+      used_ = 0;
+    }
+    return block_[used_++];
+  }
+
+  // [0, 1) 浮点值，取高 24 位
+  float NextUnitFloat() {
+    return static_cast<float>(NextU32() >> 8) * (1.0f / 16777216.0f);
+  }
+
+ private:
+  uint64_t key_ = 0;
+  PhiloxBlock counter_{};
+  PhiloxBlock block_{};
+  std::size_t used_ = 4;  // 首次取用时生成第一块
+};
+
+}  // namespace game_manager_rng
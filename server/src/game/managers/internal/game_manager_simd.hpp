@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+// x86 + GCC/Clang 时可用按函数 target 属性编译的 SIMD 分支
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define LAWNMOWER_X86_SIMD 1
+#else
+#define LAWNMOWER_X86_SIMD 0
+#endif
+
+namespace game_manager_simd {
+
+enum class SimdLevel : uint8_t {
+  kScalar = 0,
+  kSse42 = 1,
+  kAvx2 = 2,
+};
+
+// 运行时检测 CPU 支持的最高档位（非 x86 平台恒为 kScalar）
+SimdLevel DetectSimdLevel();
+// 当前批量内核使用的档位（默认等于 DetectSimdLevel()）
+SimdLevel ActiveSimdLevel();
+// 测试/基准用：强制档位，超过 CPU 支持时降到支持的最高档
+void SetActiveSimdLevel(SimdLevel level);
+// 请求档位与 CPU 支持档位取较小者
+SimdLevel ClampSimdLevel(SimdLevel level);
+const char* SimdLevelName(SimdLevel level);
+
+}  // namespace game_manager_simd
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game_manager_sleep {
+
+// 按 tick 分桶的定时轮：延迟移除等「到点再处理」的实体挂在到期 tick 的
+// 槽位里，每 tick 只检查当前槽位，开销与到期数量相关而与等待总数无关。
+// 到期 tick 超出一圈时留在槽位中等下一圈；已过期的定时挂到下一个待处理槽位。
+// 仅供 tick 线程访问，不加锁。
+class TickWheel {
+ public:
+  explicit TickWheel(std::size_t slots = 256);
+
+  void Schedule(uint64_t due_tick, uint32_t id);
+
+  // 追加 due_tick <= now 的全部 id（按槽位顺序，同槽按调度顺序）
+  void PopDue(uint64_t now, std::vector<uint32_t>* out);
+
+  void Clear();
+  [[nodiscard]] std::size_t Size() const { return size_; }
+
+ private:
+  struct Timer {
+    uint64_t due_tick = 0;
+    uint32_t id = 0;
+  };
+
+  std::vector<std::vector<Timer>> slots_;
+  uint64_t cursor_ = 0;  // 下一个待处理的 tick
+  std::size_t size_ = 0;
+};
+
+// 静止实体的休眠集合：按格分桶存放，只有查询圆覆盖到的格子里的实体才会
+// 被唤醒检查（例如玩家拾取半径内的道具）。格内用 swap-and-pop 删除。
+class SleepGrid {
+ public:
+  void Reset(float width, float height, float cell_size);
+  void Insert(uint32_t id, float x, float y);
+  // 按插入时的坐标删除，不存在时返回 false
+  bool Remove(uint32_t id, float x, float y);
+
+  // 追加与圆 (x, y, radius) 的外接方框相交的格内全部 id
+  void Query(float x, float y, float radius, std::vector<uint32_t>* out) const;
+
+  void Clear();
+  [[nodiscard]] std::size_t Size() const { return size_; }
+
+ private:
+  [[nodiscard]] int CellX(float x) const;
+  [[nodiscard]] int CellY(float y) const;
+
+  float cell_size_ = 100.0f;
+  int cells_x_ = 0;
+  int cells_y_ = 0;
+  std::vector<std::vector<uint32_t>> cells_;
+  std::size_t size_ = 0;
+};
+
+}  // namespace game_manager_sleep
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "message.pb.h"
+
+namespace game_manager_snapshot {
+
+// 按客户端已确认快照计算增量：每个同步 tick 记录一份紧凑快照（各实体按
+// id 升序），对每个客户端以它最后确认的快照为基线做归并比对。丢包不再
+// 依赖周期全量或重复发送来修复，下一次增量会自然带上所有未确认的变化。
+// 仅供 tick 线程访问，不加锁。
+
+inline constexpr std::size_t kDefaultRingCapacity = 64;
+inline constexpr float kPositionEpsilon = 1e-4f;  // 与共享基线 delta 阈值一致
+inline constexpr uint32_t kDefaultPositionScale = 8;  // 定点精度 1/8 像素
+inline constexpr uint32_t kDefaultRotationBits = 10;
+inline constexpr uint32_t kMinRotationBits = 8;
+inline constexpr uint32_t kMaxRotationBits = 10;
+
+struct PlayerEntry {
+  uint32_t player_id = 0;
+  float x = 0.0f;
+  float y = 0.0f;
+  float rotation = 0.0f;
+  uint32_t input_seq = 0;
+  uint32_t full_version = 0;  // 低频字段版本号，变化时下发完整 PlayerState
+  bool is_alive = true;
+};
+
+struct EnemyEntry {
+  uint32_t enemy_id = 0;
+  float x = 0.0f;
+  float y = 0.0f;
+  int32_t health = 0;
+  bool is_alive = true;
+};
+
+struct ItemEntry {
+  uint32_t item_id = 0;
+  float x = 0.0f;
+  float y = 0.0f;
+  uint32_t type_id = 0;
+};
+
+struct Snapshot {
+  uint32_t tick = 0;
+  std::vector<PlayerEntry> players;  // 按 player_id 升序
+  std::vector<EnemyEntry> enemies;   // 按 enemy_id 升序
+  std::vector<ItemEntry> items;      // 按 item_id 升序（已拾取的不记录）
+
+  void Clear();
+  void SortById();
+};
+
+// 最近若干同步 tick 的快照环；槽位复用，容器保留容量
+class SnapshotRing {
+ public:
+  explicit SnapshotRing(std::size_t capacity = kDefaultRingCapacity);
+
+  // 取一个槽位记录 tick 的快照（覆盖最旧的；与最新 tick 相同时覆盖最新）
+  Snapshot* Record(uint32_t tick);
+  [[nodiscard]] const Snapshot* Find(uint32_t tick) const;
+  [[nodiscard]] std::size_t Size() const { return size_; }
+
+ private:
+  std::vector<Snapshot> slots_;
+  std::size_t next_ = 0;
+  std::size_t size_ = 0;
+};
+
+// 需由调用方补全完整状态的实体
+struct DiffFollowups {
+  std::vector<uint32_t> full_player_ids;    // 写入 full_players
+  std::vector<uint32_t> spawned_enemy_ids;  // 写入 spawned_enemies
+};
+
+// 把 current 相对 baseline 的变化写入 out 的实体列表（不写 sync_time /
+// room_id / baseline_tick）。新道具以全字段 ItemStateDelta 下发。
+// 返回是否有任何变化
+bool Diff(const Snapshot& baseline, const Snapshot& current,
+          lawnmower::S2C_GameStateDeltaSync* out, DiffFollowups* followups);
+
+// 定点编码参数（协议见 S2C_GameStateDeltaSync.position_scale）
+struct QuantizeParams {
+  uint32_t position_scale = kDefaultPositionScale;
+  uint32_t rotation_bits = kDefaultRotationBits;
+};
+
+int32_t QuantizeCoord(float value, uint32_t scale);
+uint32_t QuantizeRotation(float degrees, uint32_t bits);
+float DequantizeRotation(uint32_t value, uint32_t bits);
+
+// 把 Diff 写出的浮点位置/朝向就地改写为定点编码（qx/qy 相对 baseline，
+// 新道具为绝对值），定点后没有变化的字段位清掉，掩码为空的条目移除。
+// full_players / spawned_enemies 保持完整状态不变
+void Quantize(const Snapshot& baseline, const QuantizeParams& params,
+              lawnmower::S2C_GameStateDeltaSync* delta);
+
+// 客户端侧还原：在 baseline 副本上应用增量得到 out（out 不可与 baseline
+// 为同一对象），支持定点编码。服务器不调用，供测试与基准校验往返一致性
+void Apply(const Snapshot& baseline,
+           const lawnmower::S2C_GameStateDeltaSync& delta, Snapshot* out);
+
+}  // namespace game_manager_snapshot
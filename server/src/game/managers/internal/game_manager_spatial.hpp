@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game_manager_spatial {
+
+// 格坐标（各取低 16 位）按位交错得到 Z 序（Morton）键，x 占偶数位
+uint32_t MortonCode(uint32_t cell_x, uint32_t cell_y);
+
+struct SpatialHit {
+  uint32_t id = 0;
+  float dist_sq = 0.0f;
+};
+
+// 均匀网格空间索引（CSR 分桶）：每帧 Reset + Insert + Build，之后只读查询。
+// 最近邻 / k 近邻按查询点所在格向外逐圈扩展，命中后以圈半径下界提前结束；
+// 条目很少时直接线性扫描。等距时按 id 从小到大，结果与插入顺序无关。
+// 缓冲在多次重建间复用，预热后不再分配。仅供 tick 线程访问，不加锁。
+class SpatialIndex {
+ public:
+  void Reset(float width, float height, float cell_size);
+  void Insert(uint32_t id, float x, float y);
+  void Build();
+
+  // 无条目时返回 false
+  bool Nearest(float x, float y, SpatialHit* out) const;
+
+  // 按距离升序写出至多 k 个结果，返回写出个数
+  std::size_t KNearest(float x, float y, std::size_t k,
+                       std::vector<SpatialHit>* out) const;
+
+  // 写出落在闭矩形 [min_x, max_x] x [min_y, max_y] 内的条目 id（升序），
+  // 只遍历与矩形相交的格子，返回写出个数
+  std::size_t QueryRect(float min_x, float min_y, float max_x, float max_y,
+                        std::vector<uint32_t>* out) const;
+
+  [[nodiscard]] std::size_t Size() const { return entries_.size(); }
+  [[nodiscard]] int CellsX() const { return cells_x_; }
+  [[nodiscard]] int CellsY() const { return cells_y_; }
+
+ private:
+  struct Entry {
+    uint32_t id = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+  };
+
+  static constexpr std::size_t kLinearScanMax = 16;
+
+  [[nodiscard]] int CellX(float x) const;
+  [[nodiscard]] int CellY(float y) const;
+  // 遍历以 (qx, qy) 为中心、切比雪夫半径为 ring 的一圈格子
+  template <typename Fn>
+  void ForEachInRing(int qx, int qy, int ring, Fn&& fn) const;
+
+  float cell_size_ = 100.0f;
+  int cells_x_ = 0;
+  int cells_y_ = 0;
+  std::vector<Entry> pending_;          // Insert 暂存
+  std::vector<Entry> entries_;          // 按格子排序后的条目
+  std::vector<uint32_t> cell_start_;    // CSR 偏移，长度 cells + 1
+  std::vector<uint32_t> pending_cell_;  // 暂存条目所在格（计数排序用）
+};
+
+}  // namespace game_manager_spatial
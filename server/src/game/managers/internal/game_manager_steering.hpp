@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "game_manager_simd.hpp"
+
+namespace game_manager_steering {
+
+using game_manager_simd::SimdLevel;
+
+// 敌人转向批处理的 SoA 暂存（场景持有，跨帧复用，稳定后不再分配）
+struct SteeringBatch {
+  // 存活玩家（按 id 升序，广播给每个敌人块）
+  std::vector<uint32_t> player_ids;
+  std::vector<float> player_xs;
+  std::vector<float> player_ys;
+  // 存活敌人，下标与调用方收集的敌人顺序一致
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<int32_t> nearest_player;  // player_* 下标，-1 表示无玩家
+  std::vector<float> goal_xs;
+  std::vector<float> goal_ys;
+  std::vector<float> speeds;
+  std::vector<float> dts;  // 每个敌人本次前进的时长（LOD 降频时大于 tick 步长）
+  std::vector<float> out_xs;
+  std::vector<float> out_ys;
+  std::vector<uint8_t> moved;  // 任一轴位移超过阈值时为 1
+
+  // 调整敌人数组长度（只增不缩容量）
+  void ResizeEnemies(std::size_t count);
+};
+
+// 每个敌人找最近玩家，写入玩家下标。玩家须按 id 升序给出，
+// 等距时取下标小者（与 SpatialIndex::Nearest 的 id 规则一致）。
+void NearestPlayers(const float* player_xs, const float* player_ys,
+                    std::size_t player_count, const float* xs,
+                    const float* ys, std::size_t count, int32_t* out_index);
+void NearestPlayersAt(SimdLevel level, const float* player_xs,
+                      const float* player_ys, std::size_t player_count,
+                      const float* xs, const float* ys, std::size_t count,
+                      int32_t* out_index);
+
+// 朝目标点以 speed 前进 dt 秒并夹到地图 [0, w] x [0, h]；距离平方不超过
+// 1e-6 时原地不动。各档位结果与标量版本逐位一致。
+struct SteerParams {
+  float map_w = 0.0f;
+  float map_h = 0.0f;
+};
+void SteerTowardGoals(const SteerParams& params, SteeringBatch* batch);
+void SteerTowardGoalsAt(SimdLevel level, const SteerParams& params,
+                        SteeringBatch* batch);
+
+}  // namespace game_manager_steering
@@ -1,17 +1,42 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 
 #include "message.pb.h"
+#include "network/delta_wire.hpp"
 
 class UdpServer;
 
 namespace game_manager_sync_dispatch {
 
-void DispatchStateSyncPayloads(uint32_t room_id, UdpServer* udp_server,
-                               bool force_full_sync, bool built_sync,
-                               bool built_delta,
-                               const lawnmower::S2C_GameStateSync& sync,
-                               const lawnmower::S2C_GameStateDeltaSync& delta);
+// 共享基线同步；exclude_player_ids 为改收按确认基线增量或逐玩家兴趣区域
+// 过滤同步的玩家
+void DispatchStateSyncPayloads(
+    uint32_t room_id, UdpServer* udp_server, bool force_full_sync,
+    bool built_sync, bool built_delta, const lawnmower::S2C_GameStateSync& sync,
+    const delta_wire::DeltaFrame& delta,
+    std::span<const uint32_t> exclude_player_ids = {});
+
+// 按确认基线同步：全量快照走 TCP；增量优先 UDP，无终端的玩家退回 TCP
+void DispatchAckedFullSync(uint32_t room_id,
+                           std::span<const uint32_t> player_ids,
+                           const lawnmower::S2C_GameStateSync& sync);
+void DispatchAckedDeltaSync(uint32_t room_id, UdpServer* udp_server,
+                            std::span<const uint32_t> player_ids,
+                            const lawnmower::S2C_GameStateDeltaSync& delta);
+
+// 兴趣区域过滤后的单个玩家同步：位置增量优先 UDP；只含离开列表的 leave
+// 与补发进入敌人完整状态的 sync 只通知一次，丢失会让客户端残留或缺失敌人，
+// 走 TCP
+void DispatchInterestSync(uint32_t room_id, UdpServer* udp_server,
+                          uint32_t player_id,
+                          const lawnmower::S2C_GameStateSync* sync,
+                          const delta_wire::DeltaFrame& delta,
+                          const delta_wire::DeltaFrame& leave);
+
+// 可靠事件优先捎带在同步数据报里；本 tick 无同步包或需超时重发的在这里
+// 单独发出，须在本 tick 的同步包之后调用
+void FlushReliableEvents(uint32_t room_id, UdpServer* udp_server);
 
 }  // namespace game_manager_sync_dispatch
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// 每次唤醒推进几个逻辑帧：不读时钟、不碰场景，便于单测覆盖各种墙钟间隔
+namespace game_manager_tick_steps {
+
+using SteadyDuration = std::chrono::steady_clock::duration;
+
+struct StepParams {
+  double tick_interval_seconds = 1.0 / 60.0;
+  uint32_t max_substeps = 4;  // 0 表示变步长（每次唤醒一步，dt 取实际间隔）
+  double max_delta_seconds = 0.1;  // 变步长模式下 dt 的上限
+  bool deterministic_replay = false;  // 回放模式每次唤醒固定推进一步
+};
+
+struct StepResult {
+  uint32_t steps = 0;  // 0 表示尚不足一步，本次唤醒不推进模拟
+  double dt_seconds = 0.0;
+};
+
+// elapsed 为距上次唤醒的墙钟时间；accumulator 为固定步长模式下尚未模拟的
+// 时间（可为负：提前少量唤醒时预支一步），跨调用保存
+StepResult ComputeTickSteps(const StepParams& params, SteadyDuration elapsed,
+                            SteadyDuration* accumulator);
+
+}  // namespace game_manager_tick_steps
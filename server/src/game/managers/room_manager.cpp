@@ -1,12 +1,14 @@
 #include "game/managers/room_manager.hpp"
 
+#include <algorithm>
+
 RoomManager& RoomManager::Instance() {
   static RoomManager instance;
   return instance;
 }
 
 std::vector<std::weak_ptr<TcpSession>> RoomManager::GetRoomSessions(
-    uint32_t room_id) const {
+    uint32_t room_id, std::span<const uint32_t> exclude_player_ids) const {
   std::vector<std::weak_ptr<TcpSession>> sessions;
   std::lock_guard<std::mutex> lock(mutex_);
   const auto room_it = rooms_.find(room_id);
@@ -16,11 +18,34 @@ std::vector<std::weak_ptr<TcpSession>> RoomManager::GetRoomSessions(
 
   sessions.reserve(room_it->second.players.size());
   for (const auto& player : room_it->second.players) {
+    if (std::find(exclude_player_ids.begin(), exclude_player_ids.end(),
+                  player.player_id) != exclude_player_ids.end()) {
+      continue;
+    }
     sessions.push_back(player.session);
   }
   return sessions;
 }
 
+std::vector<std::weak_ptr<TcpSession>> RoomManager::GetPlayerSessions(
+    uint32_t room_id, std::span<const uint32_t> player_ids) const {
+  std::vector<std::weak_ptr<TcpSession>> sessions;
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto room_it = rooms_.find(room_id);
+  if (room_it == rooms_.end()) {
+    return sessions;
+  }
+
+  sessions.reserve(player_ids.size());
+  for (const auto player_id : player_ids) {
+    const RoomPlayer* player = FindRoomPlayerLocked(room_it->second, player_id);
+    if (player != nullptr) {
+      sessions.push_back(player->session);
+    }
+  }
+  return sessions;
+}
+
 std::optional<uint32_t> RoomManager::GetPlayerRoom(uint32_t player_id) const {
   std::lock_guard<std::mutex> lock(mutex_);
   const auto it = player_room_.find(player_id);
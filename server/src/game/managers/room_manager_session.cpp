@@ -106,12 +106,9 @@ RoomManager::RoomUpdate RoomManager::BuildRoomUpdateLocked(
 }
 
 void RoomManager::SendRoomUpdate(const RoomUpdate& update) {
-  for (const auto& weak_session : update.targets) {
-    if (auto session = weak_session.lock()) {
-      session->SendProto(lawnmower::MessageType::MSG_S2C_ROOM_UPDATE,
-                         update.message);
-    }
-  }
+  TcpSession::Broadcast(update.targets,
+                        lawnmower::MessageType::MSG_S2C_ROOM_UPDATE,
+                        update.message);
 }
 
 bool RoomManager::DetachPlayerLocked(uint32_t player_id, RoomUpdate* update) {
@@ -0,0 +1,363 @@
+#include "network/delta_wire.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "message.pb.h"
+
+namespace {
+using delta_wire::DeltaFrame;
+using delta_wire::EnemyDelta;
+using delta_wire::ItemDelta;
+using delta_wire::PlayerDelta;
+
+static_assert(std::endian::native == std::endian::little,
+              "fixed32 字段按小端直接拷贝");
+
+constexpr uint32_t kWireVarint = 0;
+constexpr uint32_t kWireLengthDelimited = 2;
+constexpr uint32_t kWireFixed32 = 5;
+
+enum class FieldKind : uint8_t {
+  kUint32,
+  kInt32,  // 负数按 64 位符号扩展写 10 字节 varint
+  kBool,
+  kFloat,
+  kVector2,  // 子消息 Vector2{x=1, y=2}，y 紧跟在 x 之后
+};
+
+struct FieldSpec {
+  uint32_t number = 0;
+  FieldKind kind = FieldKind::kUint32;
+  std::size_t offset = 0;
+  // 0：proto3 隐式字段，零值省略；否则 changed_mask 含该位时写出（零值也写）
+  uint32_t presence_bit = 0;
+};
+
+static_assert(offsetof(PlayerDelta, y) == offsetof(PlayerDelta, x) + 4);
+static_assert(offsetof(EnemyDelta, y) == offsetof(EnemyDelta, x) + 4);
+static_assert(offsetof(ItemDelta, y) == offsetof(ItemDelta, x) + 4);
+
+// 字段表按字段号升序，与 protobuf 生成代码的序列化顺序一致
+constexpr std::array kPlayerFields = {
+    FieldSpec{1, FieldKind::kUint32, offsetof(PlayerDelta, player_id), 0},
+    FieldSpec{2, FieldKind::kUint32, offsetof(PlayerDelta, changed_mask), 0},
+    FieldSpec{3, FieldKind::kVector2, offsetof(PlayerDelta, x),
+              lawnmower::PLAYER_DELTA_POSITION},
+    FieldSpec{4, FieldKind::kFloat, offsetof(PlayerDelta, rotation),
+              lawnmower::PLAYER_DELTA_ROTATION},
+    FieldSpec{5, FieldKind::kBool, offsetof(PlayerDelta, is_alive),
+              lawnmower::PLAYER_DELTA_IS_ALIVE},
+    FieldSpec{6, FieldKind::kInt32,
+              offsetof(PlayerDelta, last_processed_input_seq),
+              lawnmower::PLAYER_DELTA_LAST_PROCESSED_INPUT_SEQ},
+};
+
+constexpr std::array kEnemyFields = {
+    FieldSpec{1, FieldKind::kUint32, offsetof(EnemyDelta, enemy_id), 0},
+    FieldSpec{2, FieldKind::kUint32, offsetof(EnemyDelta, changed_mask), 0},
+    FieldSpec{3, FieldKind::kVector2, offsetof(EnemyDelta, x),
+              lawnmower::ENEMY_DELTA_POSITION},
+    FieldSpec{4, FieldKind::kInt32, offsetof(EnemyDelta, health),
+              lawnmower::ENEMY_DELTA_HEALTH},
+    FieldSpec{5, FieldKind::kBool, offsetof(EnemyDelta, is_alive),
+              lawnmower::ENEMY_DELTA_IS_ALIVE},
+};
+
+constexpr std::array kItemFields = {
+    FieldSpec{1, FieldKind::kUint32, offsetof(ItemDelta, item_id), 0},
+    FieldSpec{2, FieldKind::kUint32, offsetof(ItemDelta, changed_mask), 0},
+    FieldSpec{3, FieldKind::kVector2, offsetof(ItemDelta, x),
+              lawnmower::ITEM_DELTA_POSITION},
+    FieldSpec{4, FieldKind::kBool, offsetof(ItemDelta, is_picked),
+              lawnmower::ITEM_DELTA_IS_PICKED},
+    FieldSpec{5, FieldKind::kUint32, offsetof(ItemDelta, type_id),
+              lawnmower::ITEM_DELTA_TYPE},
+};
+
+// S2C_GameStateDeltaSync / Timestamp 字段号
+constexpr uint32_t kSyncTimeField = 1;
+constexpr uint32_t kRoomIdField = 2;
+constexpr uint32_t kPlayersField = 3;
+constexpr uint32_t kEnemiesField = 4;
+constexpr uint32_t kItemsField = 5;
+constexpr uint32_t kRemovedEnemyIdsField = 9;
+constexpr uint32_t kServerTimeField = 1;
+constexpr uint32_t kTickField = 2;
+constexpr uint32_t kVectorXField = 1;
+constexpr uint32_t kVectorYField = 2;
+
+constexpr std::size_t VarintSize(uint64_t value) {
+  std::size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+constexpr std::size_t TagSize(uint32_t number) {
+  return VarintSize(static_cast<uint64_t>(number) << 3);
+}
+
+uint8_t* WriteVarint(uint64_t value, uint8_t* target) {
+  while (value >= 0x80) {
+    *target++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *target++ = static_cast<uint8_t>(value);
+  return target;
+}
+
+uint8_t* WriteTag(uint32_t number, uint32_t wire_type, uint8_t* target) {
+  return WriteVarint((static_cast<uint64_t>(number) << 3) | wire_type, target);
+}
+
+template <typename T>
+T Load(const uint8_t* base, std::size_t offset) {
+  T value;
+  std::memcpy(&value, base + offset, sizeof(value));
+  return value;
+}
+
+// proto3 float 按位判零（-0.0 也会写出）
+bool FloatIsZero(float value) { return std::bit_cast<uint32_t>(value) == 0; }
+
+std::size_t Vector2BodySize(float x, float y) {
+  std::size_t size = 0;
+  if (!FloatIsZero(x)) {
+    size += TagSize(kVectorXField) + sizeof(float);
+  }
+  if (!FloatIsZero(y)) {
+    size += TagSize(kVectorYField) + sizeof(float);
+  }
+  return size;
+}
+
+// 以下按字段模板实例化：字段表是编译期常量，kind / 偏移 / 存在位都在编译期
+// 确定，每种实体展开成一段无分支表查找的直写代码
+template <FieldSpec kField>
+bool FieldPresent(const uint8_t* base, uint32_t changed_mask) {
+  if constexpr (kField.presence_bit != 0) {
+    return (changed_mask & kField.presence_bit) != 0;
+  } else if constexpr (kField.kind == FieldKind::kUint32) {
+    return Load<uint32_t>(base, kField.offset) != 0;
+  } else if constexpr (kField.kind == FieldKind::kInt32) {
+    return Load<int32_t>(base, kField.offset) != 0;
+  } else if constexpr (kField.kind == FieldKind::kBool) {
+    return Load<bool>(base, kField.offset);
+  } else if constexpr (kField.kind == FieldKind::kFloat) {
+    return !FloatIsZero(Load<float>(base, kField.offset));
+  } else {
+    static_assert(kField.kind != FieldKind::kVector2,
+                  "子消息只在显式设置时存在，须带 presence_bit");
+    return false;
+  }
+}
+
+template <FieldSpec kField>
+std::size_t FieldSize(const uint8_t* base) {
+  constexpr std::size_t kTag = TagSize(kField.number);
+  if constexpr (kField.kind == FieldKind::kUint32) {
+    return kTag + VarintSize(Load<uint32_t>(base, kField.offset));
+  } else if constexpr (kField.kind == FieldKind::kInt32) {
+    const int64_t value = Load<int32_t>(base, kField.offset);
+    return kTag + VarintSize(static_cast<uint64_t>(value));
+  } else if constexpr (kField.kind == FieldKind::kBool) {
+    return kTag + 1;
+  } else if constexpr (kField.kind == FieldKind::kFloat) {
+    return kTag + sizeof(float);
+  } else {
+    const std::size_t body =
+        Vector2BodySize(Load<float>(base, kField.offset),
+                        Load<float>(base, kField.offset + sizeof(float)));
+    return kTag + 1 + body;  // body 至多 10 字节，长度前缀恒为 1 字节
+  }
+}
+
+template <FieldSpec kField>
+uint8_t* WriteField(const uint8_t* base, uint8_t* target) {
+  if constexpr (kField.kind == FieldKind::kUint32) {
+    target = WriteTag(kField.number, kWireVarint, target);
+    return WriteVarint(Load<uint32_t>(base, kField.offset), target);
+  } else if constexpr (kField.kind == FieldKind::kInt32) {
+    const int64_t value = Load<int32_t>(base, kField.offset);
+    target = WriteTag(kField.number, kWireVarint, target);
+    return WriteVarint(static_cast<uint64_t>(value), target);
+  } else if constexpr (kField.kind == FieldKind::kBool) {
+    target = WriteTag(kField.number, kWireVarint, target);
+    *target++ = Load<bool>(base, kField.offset) ? 1 : 0;
+    return target;
+  } else if constexpr (kField.kind == FieldKind::kFloat) {
+    target = WriteTag(kField.number, kWireFixed32, target);
+    std::memcpy(target, base + kField.offset, sizeof(float));
+    return target + sizeof(float);
+  } else {
+    const float x = Load<float>(base, kField.offset);
+    const float y = Load<float>(base, kField.offset + sizeof(float));
+    target = WriteTag(kField.number, kWireLengthDelimited, target);
+    *target++ = static_cast<uint8_t>(Vector2BodySize(x, y));
+    if (!FloatIsZero(x)) {
+      target = WriteTag(kVectorXField, kWireFixed32, target);
+      std::memcpy(target, &x, sizeof(float));
+      target += sizeof(float);
+    }
+    if (!FloatIsZero(y)) {
+      target = WriteTag(kVectorYField, kWireFixed32, target);
+      std::memcpy(target, &y, sizeof(float));
+      target += sizeof(float);
+    }
+    return target;
+  }
+}
+
+// 对字段表的每一项以编译期常量调用 fn
+template <const auto& kFields, typename Fn>
+void ForEachField(Fn&& fn) {
+  [&fn]<std::size_t... I>(std::index_sequence<I...>) {
+    (fn(std::integral_constant<std::size_t, I>{}), ...);
+  }(std::make_index_sequence<kFields.size()>{});
+}
+
+template <const auto& kFields, typename Entity>
+std::size_t EntityBodySize(const Entity& entity) {
+  const auto* base = reinterpret_cast<const uint8_t*>(&entity);
+  std::size_t size = 0;
+  ForEachField<kFields>([&](auto index) {
+    constexpr FieldSpec kField = kFields[index];
+    if (FieldPresent<kField>(base, entity.changed_mask)) {
+      size += FieldSize<kField>(base);
+    }
+  });
+  return size;
+}
+
+template <const auto& kFields, typename Entity>
+std::size_t RepeatedSize(uint32_t number, const std::vector<Entity>& entities) {
+  std::size_t size = 0;
+  for (const auto& entity : entities) {
+    const std::size_t body = EntityBodySize<kFields>(entity);
+    size += TagSize(number) + VarintSize(body) + body;
+  }
+  return size;
+}
+
+template <const auto& kFields, typename Entity>
+uint8_t* WriteRepeated(uint32_t number, const std::vector<Entity>& entities,
+                       uint8_t* target) {
+  for (const auto& entity : entities) {
+    const auto* base = reinterpret_cast<const uint8_t*>(&entity);
+    target = WriteTag(number, kWireLengthDelimited, target);
+    target = WriteVarint(EntityBodySize<kFields>(entity), target);
+    ForEachField<kFields>([&](auto index) {
+      constexpr FieldSpec kField = kFields[index];
+      if (FieldPresent<kField>(base, entity.changed_mask)) {
+        target = WriteField<kField>(base, target);
+      }
+    });
+  }
+  return target;
+}
+
+std::size_t SyncTimeBodySize(const DeltaFrame& frame) {
+  std::size_t size = 0;
+  if (frame.server_time_ms != 0) {
+    size += TagSize(kServerTimeField) + VarintSize(frame.server_time_ms);
+  }
+  if (frame.tick != 0) {
+    size += TagSize(kTickField) + VarintSize(frame.tick);
+  }
+  return size;
+}
+
+// proto3 repeated 标量默认 packed：一个 tag + 长度前缀 + 连续 varint
+std::size_t PackedBodySize(const std::vector<uint32_t>& values) {
+  std::size_t size = 0;
+  for (const auto value : values) {
+    size += VarintSize(value);
+  }
+  return size;
+}
+}  // namespace
+
+namespace delta_wire {
+
+void DeltaFrame::Clear() {
+  has_sync_time = false;
+  server_time_ms = 0;
+  tick = 0;
+  room_id = 0;
+  players.clear();
+  enemies.clear();
+  items.clear();
+  removed_enemy_ids.clear();
+}
+
+std::size_t PayloadSize(const DeltaFrame& frame) {
+  std::size_t size = 0;
+  if (frame.has_sync_time) {
+    const std::size_t body = SyncTimeBodySize(frame);
+    size += TagSize(kSyncTimeField) + VarintSize(body) + body;
+  }
+  if (frame.room_id != 0) {
+    size += TagSize(kRoomIdField) + VarintSize(frame.room_id);
+  }
+  size += RepeatedSize<kPlayerFields>(kPlayersField, frame.players);
+  size += RepeatedSize<kEnemyFields>(kEnemiesField, frame.enemies);
+  size += RepeatedSize<kItemFields>(kItemsField, frame.items);
+  if (!frame.removed_enemy_ids.empty()) {
+    const std::size_t body = PackedBodySize(frame.removed_enemy_ids);
+    size += TagSize(kRemovedEnemyIdsField) + VarintSize(body) + body;
+  }
+  return size;
+}
+
+uint8_t* WritePayload(const DeltaFrame& frame, uint8_t* target) {
+  if (frame.has_sync_time) {
+    target = WriteTag(kSyncTimeField, kWireLengthDelimited, target);
+    target = WriteVarint(SyncTimeBodySize(frame), target);
+    if (frame.server_time_ms != 0) {
+      target = WriteTag(kServerTimeField, kWireVarint, target);
+      target = WriteVarint(frame.server_time_ms, target);
+    }
+    if (frame.tick != 0) {
+      target = WriteTag(kTickField, kWireVarint, target);
+      target = WriteVarint(frame.tick, target);
+    }
+  }
+  if (frame.room_id != 0) {
+    target = WriteTag(kRoomIdField, kWireVarint, target);
+    target = WriteVarint(frame.room_id, target);
+  }
+  target = WriteRepeated<kPlayerFields>(kPlayersField, frame.players, target);
+  target = WriteRepeated<kEnemyFields>(kEnemiesField, frame.enemies, target);
+  target = WriteRepeated<kItemFields>(kItemsField, frame.items, target);
+  if (!frame.removed_enemy_ids.empty()) {
+    target = WriteTag(kRemovedEnemyIdsField, kWireLengthDelimited, target);
+    target = WriteVarint(PackedBodySize(frame.removed_enemy_ids), target);
+    for (const auto enemy_id : frame.removed_enemy_ids) {
+      target = WriteVarint(enemy_id, target);
+    }
+  }
+  return target;
+}
+
+packet_codec::EncodedPacket EncodeDatagram(const DeltaFrame& frame) {
+  return packet_codec::EncodeDatagram(
+      lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC,
+      PayloadSize(frame),
+      [&frame](uint8_t* target) { return WritePayload(frame, target); });
+}
+
+packet_codec::EncodedPacket EncodeFramed(const DeltaFrame& frame) {
+  return packet_codec::EncodeFramed(
+      lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC,
+      PayloadSize(frame),
+      [&frame](uint8_t* target) { return WritePayload(frame, target); });
+}
+
+}  // namespace delta_wire
@@ -0,0 +1,118 @@
+#include "network/packet_codec.hpp"
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#endif
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+namespace {
+using google::protobuf::internal::WireFormatLite;
+
+constexpr std::size_t kLengthPrefixBytes = sizeof(uint32_t);
+
+packet_codec::EncodedPacket Encode(lawnmower::MessageType type,
+                                   std::size_t payload_len,
+                                   const packet_codec::PayloadWriter& write,
+                                   bool with_length_prefix) {
+  packet_codec::EncodedPacket out;
+  out.type = type;
+  if (payload_len > static_cast<std::size_t>(INT_MAX)) {
+    return out;
+  }
+
+  std::size_t body_len = 0;
+  if (type != lawnmower::MessageType::MSG_UNKNOWN) {
+    body_len +=
+        WireFormatLite::TagSize(lawnmower::Packet::kMsgTypeFieldNumber,
+                                WireFormatLite::TYPE_ENUM) +
+        WireFormatLite::EnumSize(static_cast<int>(type));
+  }
+  if (payload_len > 0) {
+    body_len += WireFormatLite::TagSize(lawnmower::Packet::kPayloadFieldNumber,
+                                        WireFormatLite::TYPE_BYTES) +
+                WireFormatLite::LengthDelimitedSize(payload_len);
+  }
+  if (body_len > static_cast<std::size_t>(UINT32_MAX)) {
+    return out;
+  }
+
+  const std::size_t prefix_len = with_length_prefix ? kLengthPrefixBytes : 0;
+  auto bytes = std::make_shared<std::string>();
+  bytes->resize(prefix_len + body_len);
+  auto* const begin = reinterpret_cast<uint8_t*>(bytes->data());
+  uint8_t* target = begin;
+  if (with_length_prefix) {
+    const uint32_t net_len = htonl(static_cast<uint32_t>(body_len));
+    std::memcpy(target, &net_len, sizeof(net_len));
+    target += sizeof(net_len);
+  }
+  if (type != lawnmower::MessageType::MSG_UNKNOWN) {
+    target = WireFormatLite::WriteEnumToArray(
+        lawnmower::Packet::kMsgTypeFieldNumber, static_cast<int>(type),
+        target);
+  }
+  if (payload_len > 0) {
+    target = WireFormatLite::WriteTagToArray(
+        lawnmower::Packet::kPayloadFieldNumber,
+        WireFormatLite::WIRETYPE_LENGTH_DELIMITED, target);
+    target = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+        static_cast<uint32_t>(payload_len), target);
+    target = write(target);
+  }
+  // 计算长度与写入之间消息被改动时长度对不上，宁可丢弃也不发错帧
+  if (target != begin + bytes->size()) {
+    return out;
+  }
+
+  out.bytes = std::move(bytes);
+  out.payload_len = payload_len;
+  out.body_len = body_len;
+  return out;
+}
+
+packet_codec::EncodedPacket Encode(lawnmower::MessageType type,
+                                   const google::protobuf::MessageLite& message,
+                                   bool with_length_prefix) {
+  // ByteSizeLong 同时缓存各层子消息长度，供 WithCachedSizes 写入使用
+  const std::size_t payload_len = message.ByteSizeLong();
+  return Encode(
+      type, payload_len,
+      [&message](uint8_t* target) {
+        return message.SerializeWithCachedSizesToArray(target);
+      },
+      with_length_prefix);
+}
+}  // namespace
+
+namespace packet_codec {
+
+EncodedPacket EncodeFramed(lawnmower::MessageType type,
+                           const google::protobuf::MessageLite& message) {
+  return Encode(type, message, true);
+}
+
+EncodedPacket EncodeDatagram(lawnmower::MessageType type,
+                             const google::protobuf::MessageLite& message) {
+  return Encode(type, message, false);
+}
+
+EncodedPacket EncodeFramed(lawnmower::MessageType type,
+                           std::size_t payload_len,
+                           const PayloadWriter& write) {
+  return Encode(type, payload_len, write, true);
+}
+
+EncodedPacket EncodeDatagram(lawnmower::MessageType type,
+                             std::size_t payload_len,
+                             const PayloadWriter& write) {
+  return Encode(type, payload_len, write, false);
+}
+
+}  // namespace packet_codec
@@ -9,6 +9,7 @@
 #include "game/managers/room_manager.hpp"
 #include "network/tcp/tcp_session.hpp"
 #include "network/tcp/tcp_session_internal.hpp"
+#include "network/udp/udp_server.hpp"
 
 // 生成Token
 std::string TcpSession::GenerateToken() {
@@ -72,6 +73,49 @@ bool TcpSession::ShouldLogPacketDebug() {
   return (index % stride) == 0;
 }
 
+uint32_t TcpSession::NegotiateFeatures(uint32_t client_features) {
+  uint32_t enabled = client_features & tcp_session_internal::kServerFeatures;
+  // UDP 可靠通道承载的是 S2C_TickEvents，未声明合包则一并关闭
+  if ((enabled & lawnmower::CLIENT_FEATURE_TICK_EVENTS) == 0) {
+    enabled &= ~static_cast<uint32_t>(lawnmower::CLIENT_FEATURE_UDP_RELIABLE);
+  }
+  enabled_features_.store(enabled, std::memory_order_relaxed);
+  // 启用可靠通道前事件一律走 TCP
+  reliable_udp_player_id_.store(0, std::memory_order_relaxed);
+  return enabled;
+}
+
+void TcpSession::ActivateReliableUdp(uint32_t player_id) {
+  if ((enabled_features_.load(std::memory_order_relaxed) &
+       lawnmower::CLIENT_FEATURE_UDP_RELIABLE) == 0) {
+    return;
+  }
+  // 序号从头开始，丢弃上一次连接遗留的通道
+  if (auto udp = GameManager::Instance().GetUdpServer()) {
+    udp->ResetReliable(player_id);
+  }
+  reliable_udp_player_id_.store(player_id, std::memory_order_relaxed);
+}
+
+bool TcpSession::SupportsTickEvents() const {
+  return (enabled_features_.load(std::memory_order_relaxed) &
+          lawnmower::CLIENT_FEATURE_TICK_EVENTS) != 0;
+}
+
+uint32_t TcpSession::ReliableUdpPlayerId() const {
+  return reliable_udp_player_id_.load(std::memory_order_relaxed);
+}
+
+bool TcpSession::SupportsQuantizedPositions() const {
+  return (enabled_features_.load(std::memory_order_relaxed) &
+          lawnmower::CLIENT_FEATURE_QUANTIZED_POSITIONS) != 0;
+}
+
+bool TcpSession::SupportsInterestFilter() const {
+  return (enabled_features_.load(std::memory_order_relaxed) &
+          lawnmower::CLIENT_FEATURE_INTEREST_FILTER) != 0;
+}
+
 // 处理登录请求
 void TcpSession::HandleLogin(const std::string& payload) {
   lawnmower::C2S_Login login;
@@ -104,6 +148,8 @@ void TcpSession::HandleLogin(const std::string& payload) {
   result.set_player_id(player_id_);
   result.set_message_login("login success");
   result.set_session_token(session_token_);
+  result.set_enabled_features(NegotiateFeatures(login.client_features()));
+  ActivateReliableUdp(player_id_);
 
   SendProto(lawnmower::MessageType::MSG_S2C_LOGIN_RESULT, result);
   spdlog::info("玩家登录: {} (id={})", player_name_, player_id_);
@@ -184,6 +230,11 @@ void TcpSession::HandleReconnectRequest(const std::string& payload) {
     return;
   }
 
+  // 挂回房间前协商，挂上后的第一帧事件即按新连接的能力下发；可靠通道
+  // 牵涉仍在线的旧通道，等挂回与场景重连都成功后再重置启用，期间事件走 TCP
+  const uint32_t enabled_features =
+      NegotiateFeatures(request.client_features());
+
   bool is_playing = false;
   std::string player_name;
   if (!RoomManager::Instance().AttachSession(request.player_id(),
@@ -200,7 +251,8 @@ void TcpSession::HandleReconnectRequest(const std::string& payload) {
     GameManager::ReconnectSnapshot snapshot;
     if (!GameManager::Instance().TryReconnectPlayer(
             request.player_id(), target_room_id, request.last_input_seq(),
-            request.last_server_tick(), &snapshot)) {
+            request.last_server_tick(), SupportsQuantizedPositions(),
+            SupportsInterestFilter(), &snapshot)) {
       RoomManager::Instance().MarkPlayerDisconnected(request.player_id());
       ack.set_success(false);
       ack.set_message("场景不存在");
@@ -215,6 +267,7 @@ void TcpSession::HandleReconnectRequest(const std::string& payload) {
     }
   }
 
+  ActivateReliableUdp(request.player_id());
   ack.set_room_id(target_room_id);
   ack.set_is_playing(is_playing);
 
@@ -225,6 +278,7 @@ void TcpSession::HandleReconnectRequest(const std::string& payload) {
   RegisterToken(request.player_id(), token);
   session_token_ = token;
   ack.set_session_token(token);
+  ack.set_enabled_features(enabled_features);
 
   player_id_ = request.player_id();
   if (!player_name.empty()) {
@@ -1,5 +1,6 @@
 #include <spdlog/spdlog.h>
 
+#include "game/managers/game_manager.hpp"
 #include "game/managers/room_manager.hpp"
 #include "network/tcp/tcp_session.hpp"
 #include "network/tcp/tcp_session_internal.hpp"
@@ -118,7 +119,12 @@ void TcpSession::HandleLeaveRoom(const std::string& payload) {
           FillLoginRequiredResult(&result);
           return result;
         }
-        return RoomManager::Instance().LeaveRoom(player_id_);
+        result = RoomManager::Instance().LeaveRoom(player_id_);
+        if (result.success()) {
+          GameManager::Instance().ReleaseReliableChannel(player_id_,
+                                                         shared_from_this());
+        }
+        return result;
       });
 }
 
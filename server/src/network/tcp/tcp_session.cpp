@@ -9,6 +9,7 @@
 
 #include "game/managers/game_manager.hpp"
 #include "game/managers/room_manager.hpp"
+#include "network/packet_codec.hpp"
 #include "network/tcp/tcp_session_internal.hpp"
 
 // 用于给 player 赋 id，next_player_id_ 是静态的
@@ -39,18 +40,28 @@ void TcpSession::SendProto(lawnmower::MessageType type,
   if (closed_) {
     return;
   }
-  lawnmower::Packet packet;
-  packet.set_msg_type(type);  // 设置包类型
-  packet.set_payload(
-      message.SerializeAsString());  // message 序列化为字符串并存至packet
-  send_packet(packet);               // 发包
+  // 包长 + Packet 信封 + message 一次写入同一块缓冲
+  auto encoded = packet_codec::EncodeFramed(type, message);
+  if (encoded.bytes == nullptr) {
+    spdlog::error("编码消息失败: {}",
+                  tcp_session_internal::MessageTypeToString(type));
+    return;
+  }
+  if (spdlog::should_log(spdlog::level::debug)) {
+    // 打印分层长度：payload（业务消息）/ Packet 序列化后（含 msg_type 等）/ 加
+    // 4 字节帧头后的总大小。
+    spdlog::debug(
+        "TCP发送包 {}，payload长度 {} bytes，序列化后长度 {} "
+        "bytes（含4字节包长总计 {} "
+        "bytes）",
+        tcp_session_internal::MessageTypeToString(type), encoded.payload_len,
+        encoded.body_len, encoded.body_len + sizeof(uint32_t));
+  }
+  send_framed(std::move(encoded.bytes));  // 发包
 }
 
-void TcpSession::SendFramedPacket(
-    const std::shared_ptr<const std::string>& framed,
-    lawnmower::MessageType type, std::size_t payload_len,
-    std::size_t body_len) {
-  if (closed_ || framed == nullptr) {
+void TcpSession::SendEncoded(const packet_codec::EncodedPacket& packet) {
+  if (closed_ || packet.bytes == nullptr) {
     return;
   }
 
@@ -59,20 +70,36 @@ void TcpSession::SendFramedPacket(
         "TCP发送包 {}，payload长度 {} bytes，序列化后长度 {} "
         "bytes（含4字节包长总计 {} "
         "bytes）",
-        tcp_session_internal::MessageTypeToString(type), payload_len, body_len,
-        body_len + sizeof(uint32_t));
+        tcp_session_internal::MessageTypeToString(packet.type),
+        packet.payload_len, packet.body_len,
+        packet.body_len + sizeof(uint32_t));
   }
 
-  const bool write_in_progress = !write_queue_.empty();
-  if (write_queue_.size() >= tcp_session_internal::kMaxWriteQueueSize) {
-    spdlog::warn("发送队列过长({})，断开玩家 {}", write_queue_.size(),
-                 player_id_);
-    handle_disconnect();
+  send_framed(packet.bytes);
+}
+
+void TcpSession::Broadcast(std::span<const std::weak_ptr<TcpSession>> sessions,
+                           lawnmower::MessageType type,
+                           const google::protobuf::Message& message) {
+  if (sessions.empty()) {
     return;
   }
-  write_queue_.push_back(framed);
-  if (!write_in_progress) {
-    do_write();
+  const auto packet = packet_codec::EncodeFramed(type, message);
+  if (packet.bytes == nullptr) {
+    spdlog::error("编码广播消息失败: {}",
+                  tcp_session_internal::MessageTypeToString(type));
+    return;
+  }
+  BroadcastEncoded(sessions, packet);
+}
+
+void TcpSession::BroadcastEncoded(
+    std::span<const std::weak_ptr<TcpSession>> sessions,
+    const packet_codec::EncodedPacket& packet) {
+  for (const auto& weak_session : sessions) {
+    if (auto session = weak_session.lock()) {
+      session->SendEncoded(packet);
+    }
   }
 }
 
@@ -101,6 +128,9 @@ void TcpSession::CloseSession(SessionCloseReason reason) {
     }
     GameManager::Instance().MarkPlayerDisconnected(player_id_);
     RoomManager::Instance().MarkPlayerDisconnected(player_id_);
+    // 重连会重建场景并从头开始序号，关闭前补发后即可丢弃通道
+    GameManager::Instance().ReleaseReliableChannel(player_id_,
+                                                   weak_from_this().lock());
   }
 
   // 标准断开连接
@@ -278,30 +308,8 @@ void TcpSession::handle_packet(const lawnmower::Packet& packet) {
                 tcp_session_internal::MessageTypeToString(packet.msg_type()));
 }
 
-// 发包
-void TcpSession::send_packet(const lawnmower::Packet& packet) {
-  const std::string data = packet.SerializeAsString();
-  const uint32_t net_len = htonl(static_cast<uint32_t>(data.size()));
-
-  if (spdlog::should_log(spdlog::level::debug)) {
-    const auto payload_len = packet.payload().size();
-    const auto body_len = data.size();
-    // 打印分层长度：payload（业务消息）/ Packet 序列化后（含 msg_type 等）/ 加
-    // 4 字节帧头后的总大小。
-    spdlog::debug(
-        "TCP发送包 {}，payload长度 {} bytes，序列化后长度 {} "
-        "bytes（含4字节包长总计 {} "
-        "bytes）",
-        tcp_session_internal::MessageTypeToString(packet.msg_type()),
-        payload_len, body_len, body_len + sizeof(net_len));
-  }
-
-  // 写内容
-  auto framed = std::make_shared<std::string>();
-  framed->resize(sizeof(net_len) + data.size());
-  std::memcpy(framed->data(), &net_len, sizeof(net_len));
-  std::memcpy(framed->data() + sizeof(net_len), data.data(), data.size());
-
+// 发包：framed 已含 4 字节包长
+void TcpSession::send_framed(std::shared_ptr<const std::string> framed) {
   // 记录当前写队列状态，若为空，则之后做写操作
   const bool write_in_progress = !write_queue_.empty();
   if (write_queue_.size() >= tcp_session_internal::kMaxWriteQueueSize) {
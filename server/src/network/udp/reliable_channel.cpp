@@ -0,0 +1,176 @@
+#include "network/udp/reliable_channel.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace reliable_channel {
+
+Sender::Sender(Options options) : options_(options) {
+  options_.window = std::max<std::size_t>(1, options_.window);
+}
+
+bool Sender::Enqueue(lawnmower::MessageType type,
+                     std::shared_ptr<const std::string> payload) {
+  if (pending_.size() >= options_.window) {
+    return false;
+  }
+  Pending message;
+  message.seq = next_seq_++;
+  message.type = type;
+  message.payload = std::move(payload);
+  pending_.push_back(std::move(message));
+  ++unacked_;
+  return true;
+}
+
+bool Sender::IsDue(const Pending& message, Clock::time_point now) const {
+  return !message.acked &&
+         (!message.sent || now - message.last_sent >= options_.resend_interval);
+}
+
+bool Sender::HasDue(Clock::time_point now) const {
+  return std::any_of(
+      pending_.begin(), pending_.end(),
+      [this, now](const Pending& message) { return IsDue(message, now); });
+}
+
+std::size_t Sender::CollectDue(Clock::time_point now,
+                               lawnmower::S2C_UdpReliable* out) {
+  if (out == nullptr) {
+    return 0;
+  }
+  std::size_t count = 0;
+  std::size_t bytes = 0;
+  for (auto& message : pending_) {
+    if (!IsDue(message, now)) {
+      continue;
+    }
+    const std::size_t size =
+        message.payload != nullptr ? message.payload->size() : 0;
+    // 首条总是带上，避免超大消息永远发不出去
+    if (count > 0 && bytes + size > options_.max_batch_bytes) {
+      break;
+    }
+    if (count == 0 && skip_through_ != 0) {
+      out->set_skip_through(skip_through_);
+    }
+    auto* entry = out->add_messages();
+    entry->set_seq(message.seq);
+    entry->set_msg_type(message.type);
+    if (message.payload != nullptr) {
+      entry->set_payload(*message.payload);
+    }
+    if (message.sent) {
+      ++resend_count_;
+    }
+    message.sent = true;
+    message.last_sent = now;
+    bytes += size;
+    ++count;
+  }
+  return count;
+}
+
+std::size_t Sender::OnAck(uint32_t ack, uint32_t ack_bits) {
+  const std::size_t before = unacked_;
+  // 累计确认：ack 及之前全部收到（pending_ 按 seq 升序）
+  while (!pending_.empty() && !SeqAfter(pending_.front().seq, ack)) {
+    if (!pending_.front().acked) {
+      --unacked_;
+    }
+    pending_.pop_front();
+  }
+  if (ack_bits != 0) {
+    for (auto& message : pending_) {
+      const uint32_t offset = message.seq - ack - 2;
+      if (!message.acked && offset < kAckBitsCount &&
+          (ack_bits & (1u << offset)) != 0) {
+        message.acked = true;
+        --unacked_;
+      }
+    }
+  }
+  return before - unacked_;
+}
+
+std::size_t Sender::Drain(std::vector<DrainedMessage>* out) {
+  if (out == nullptr || pending_.empty()) {
+    return 0;
+  }
+  // 被 ack_bits 确认的消息对端只是缓存着，跳过缺口时会被丢弃，一并补发
+  const std::size_t count = pending_.size();
+  out->reserve(out->size() + count);
+  for (auto& message : pending_) {
+    out->push_back(DrainedMessage{message.type, std::move(message.payload)});
+  }
+  skip_through_ = pending_.back().seq;
+  pending_.clear();
+  unacked_ = 0;
+  return count;
+}
+
+Receiver::Receiver(Options options) : options_(options) {
+  options_.window = std::max<std::size_t>(1, options_.window);
+}
+
+bool Receiver::OnMessage(const lawnmower::ReliableMessage& message,
+                         std::vector<lawnmower::ReliableMessage>* delivered) {
+  if (delivered == nullptr) {
+    return false;
+  }
+  const uint32_t seq = message.seq();
+  const uint32_t distance = seq - delivered_seq_;
+  if (!SeqAfter(seq, delivered_seq_) || distance > options_.window ||
+      buffered_.contains(seq)) {
+    return false;
+  }
+  if (distance > 1) {
+    buffered_.emplace(seq, message);
+    return true;
+  }
+
+  delivered->push_back(message);
+  delivered_seq_ = seq;
+  for (auto it = buffered_.find(delivered_seq_ + 1); it != buffered_.end();
+       it = buffered_.find(delivered_seq_ + 1)) {
+    delivered->push_back(std::move(it->second));
+    buffered_.erase(it);
+    ++delivered_seq_;
+  }
+  return true;
+}
+
+void Receiver::OnSkipThrough(
+    uint32_t seq, std::vector<lawnmower::ReliableMessage>* delivered) {
+  if (delivered == nullptr || !SeqAfter(seq, delivered_seq_)) {
+    return;
+  }
+  std::erase_if(buffered_, [seq](const auto& entry) {
+    return !SeqAfter(entry.first, seq);
+  });
+  delivered_seq_ = seq;
+  for (auto it = buffered_.find(delivered_seq_ + 1); it != buffered_.end();
+       it = buffered_.find(delivered_seq_ + 1)) {
+    delivered->push_back(std::move(it->second));
+    buffered_.erase(it);
+    ++delivered_seq_;
+  }
+}
+
+void Receiver::FillAck(uint32_t* ack, uint32_t* ack_bits) const {
+  if (ack == nullptr || ack_bits == nullptr) {
+    return;
+  }
+  *ack = delivered_seq_;
+  *ack_bits = 0;
+  if (buffered_.empty()) {
+    return;
+  }
+  for (uint32_t i = 0; i < kAckBitsCount; ++i) {
+    if (buffered_.contains(delivered_seq_ + 2 + i)) {
+      *ack_bits |= 1u << i;
+    }
+  }
+}
+
+}  // namespace reliable_channel
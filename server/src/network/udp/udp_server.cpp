@@ -3,9 +3,11 @@
 #include <algorithm>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <utility>
 
 #include "game/managers/game_manager.hpp"
 #include "game/managers/room_manager.hpp"
+#include "network/packet_codec.hpp"
 #include "network/tcp/tcp_session.hpp"
 
 namespace {
@@ -58,6 +60,9 @@ void UdpServer::HandlePacket(const lawnmower::Packet& packet,
     case MessageType::MSG_C2S_PLAYER_INPUT:
       HandlePlayerInput(packet, from);
       break;
+    case MessageType::MSG_C2S_UDP_ACK:
+      HandleUdpAck(packet, from);
+      break;
     default:
       spdlog::debug("UDP 收到未处理消息类型 {}",
                     static_cast<int>(packet.msg_type()));
@@ -74,108 +79,313 @@ void UdpServer::HandlePlayerInput(const lawnmower::Packet& packet,
   }
 
   const uint32_t player_id = input.player_id();
-  if (player_id == 0) {
-    spdlog::debug("UDP 输入缺少 player_id");
+  if (!TouchEndpoint(player_id, input.session_token(), from)) {
     return;
   }
 
-  if (input.session_token().empty() ||
-      !TcpSession::VerifyToken(player_id, input.session_token())) {
-    spdlog::debug("UDP 输入令牌校验失败 player_id={}", player_id);
-    return;
+  uint32_t room_id = 0;
+  if (!GameManager::Instance().HandlePlayerInput(player_id, input, &room_id)) {
+    spdlog::debug("UDP 输入: player {} 未被受理", player_id);
   }
+}
 
-  auto room_opt = RoomManager::Instance().GetPlayerRoom(player_id);
-  if (!room_opt.has_value()) {
-    spdlog::debug("UDP 输入: player {} 不在任何房间，丢弃", player_id);
+void UdpServer::HandleUdpAck(const lawnmower::Packet& packet,
+                             const udp::endpoint& from) {
+  lawnmower::C2S_UdpAck ack;
+  if (!ack.ParseFromString(packet.payload())) {
+    spdlog::debug("UDP 确认包解析失败");
+    return;
+  }
+  if (!TouchEndpoint(ack.player_id(), ack.session_token(), from)) {
     return;
   }
 
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    player_endpoints_[player_id] =
-        EndpointInfo{from, *room_opt, std::chrono::steady_clock::now()};
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = reliable_senders_.find(ack.player_id());
+  if (it != reliable_senders_.end()) {
+    it->second.OnAck(ack.ack(), ack.ack_bits());
   }
+}
 
-  uint32_t room_id = 0;
-  if (!GameManager::Instance().HandlePlayerInput(player_id, input, &room_id)) {
-    spdlog::debug("UDP 输入: player {} 未被受理", player_id);
+bool UdpServer::TouchEndpoint(uint32_t player_id,
+                              const std::string& session_token,
+                              const udp::endpoint& from) {
+  if (player_id == 0) {
+    spdlog::debug("UDP 包缺少 player_id");
+    return false;
+  }
+
+  if (session_token.empty() ||
+      !TcpSession::VerifyToken(player_id, session_token)) {
+    spdlog::debug("UDP 令牌校验失败 player_id={}", player_id);
+    return false;
   }
+
+  auto room_opt = RoomManager::Instance().GetPlayerRoom(player_id);
+  if (!room_opt.has_value()) {
+    spdlog::debug("UDP: player {} 不在任何房间，丢弃", player_id);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  player_endpoints_[player_id] =
+      EndpointInfo{from, *room_opt, std::chrono::steady_clock::now()};
+  return true;
 }
 
 // UDP广播
 std::size_t UdpServer::BroadcastState(
-    uint32_t room_id, const lawnmower::S2C_GameStateSync& sync) {
-  const auto targets = EndpointsForRoom(room_id);
+    uint32_t room_id, const lawnmower::S2C_GameStateSync& sync,
+    std::span<const uint32_t> exclude_player_ids) {
+  const auto targets = EndpointsForRoom(room_id, exclude_player_ids);
   if (targets.empty()) {
     return 0;
   }
 
-  lawnmower::Packet packet;
-  packet.set_msg_type(lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC);
-  packet.set_payload(sync.SerializeAsString());
-
+  // Packet 信封与 sync 一次写入同一块缓冲，房间内各端点共享
   std::shared_ptr<const std::string> data =
-      std::make_shared<std::string>(packet.SerializeAsString());
+      packet_codec::EncodeDatagram(
+          lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC, sync)
+          .bytes;
+  if (data == nullptr) {
+    spdlog::error("UDP 房间 {} 同步包编码失败", room_id);
+    return 0;
+  }
 
   if (spdlog::should_log(spdlog::level::debug)) {
     spdlog::debug("UDP 广播房间 {} 状态，players={} enemies={}，目标端点 {}",
                   room_id, sync.players_size(), sync.enemies_size(),
                   targets.size());
   }
-  for (const auto& endpoint : targets) {
-    SendPacket(data, endpoint);
-  }
-
+  SendToTargets(targets, data);
   return targets.size();
 }
 
 std::size_t UdpServer::BroadcastDeltaState(
-    uint32_t room_id, const lawnmower::S2C_GameStateDeltaSync& sync) {
-  const auto targets = EndpointsForRoom(room_id);
+    uint32_t room_id, const delta_wire::DeltaFrame& sync,
+    std::span<const uint32_t> exclude_player_ids) {
+  const auto targets = EndpointsForRoom(room_id, exclude_player_ids);
   if (targets.empty()) {
     return 0;
   }
 
-  lawnmower::Packet packet;
-  packet.set_msg_type(lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC);
-  packet.set_payload(sync.SerializeAsString());
-
+  // 增量记录直接写成 Packet 数据报，房间内各端点共享
   std::shared_ptr<const std::string> data =
-      std::make_shared<std::string>(packet.SerializeAsString());
+      delta_wire::EncodeDatagram(sync).bytes;
+  if (data == nullptr) {
+    spdlog::error("UDP 房间 {} 同步包编码失败", room_id);
+    return 0;
+  }
 
   if (spdlog::should_log(spdlog::level::debug)) {
     spdlog::debug(
         "UDP 广播房间 {} 状态增量，players={} enemies={} items={}，目标端点 {}",
-        room_id, sync.players_size(), sync.enemies_size(), sync.items_size(),
+        room_id, sync.players.size(), sync.enemies.size(), sync.items.size(),
         targets.size());
   }
-  for (const auto& endpoint : targets) {
-    SendPacket(data, endpoint);
+  SendToTargets(targets, data);
+  return targets.size();
+}
+
+std::size_t UdpServer::SendDeltaState(
+    std::span<const uint32_t> player_ids,
+    const lawnmower::S2C_GameStateDeltaSync& sync,
+    std::vector<uint32_t>* unreached) {
+  if (unreached == nullptr) {
+    return 0;
+  }
+
+  const auto targets = EndpointsForPlayers(player_ids, unreached);
+  if (targets.empty()) {
+    return 0;
+  }
+
+  std::shared_ptr<const std::string> data =
+      packet_codec::EncodeDatagram(
+          lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC, sync)
+          .bytes;
+  if (data == nullptr) {
+    spdlog::error("UDP 房间 {} 同步包编码失败", sync.room_id());
+    for (const auto& target : targets) {
+      unreached->push_back(target.player_id);
+    }
+    return 0;
+  }
+  SendToTargets(targets, data);
+  return targets.size();
+}
+
+std::size_t UdpServer::SendDeltaState(std::span<const uint32_t> player_ids,
+                                      const delta_wire::DeltaFrame& sync,
+                                      std::vector<uint32_t>* unreached) {
+  if (unreached == nullptr) {
+    return 0;
   }
 
+  const auto targets = EndpointsForPlayers(player_ids, unreached);
+  if (targets.empty()) {
+    return 0;
+  }
+
+  std::shared_ptr<const std::string> data =
+      delta_wire::EncodeDatagram(sync).bytes;
+  if (data == nullptr) {
+    spdlog::error("UDP 房间 {} 同步包编码失败", sync.room_id);
+    for (const auto& target : targets) {
+      unreached->push_back(target.player_id);
+    }
+    return 0;
+  }
+  SendToTargets(targets, data);
   return targets.size();
 }
 
-std::vector<udp::endpoint> UdpServer::EndpointsForRoom(uint32_t room_id) {
+std::vector<UdpServer::RoomTarget> UdpServer::EndpointsForPlayers(
+    std::span<const uint32_t> player_ids, std::vector<uint32_t>* unreached) {
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<RoomTarget> targets;
+  targets.reserve(player_ids.size());
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto player_id : player_ids) {
+    const auto it = player_endpoints_.find(player_id);
+    if (it == player_endpoints_.end() ||
+        (now - it->second.last_seen) > kEndpointTtl) {
+      unreached->push_back(player_id);
+      continue;
+    }
+    targets.push_back(RoomTarget{player_id, it->second.endpoint});
+  }
+  return targets;
+}
+
+bool UdpServer::HasEndpoint(uint32_t player_id) {
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = player_endpoints_.find(player_id);
+  return it != player_endpoints_.end() &&
+         (now - it->second.last_seen) <= kEndpointTtl;
+}
+
+bool UdpServer::QueueReliable(uint32_t player_id, lawnmower::MessageType type,
+                              std::shared_ptr<const std::string> payload) {
+  const auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = player_endpoints_.find(player_id);
+  if (it == player_endpoints_.end() ||
+      (now - it->second.last_seen) > kEndpointTtl) {
+    return false;
+  }
+  auto& sender = reliable_senders_[player_id];
+  if (!sender.Enqueue(type, std::move(payload))) {
+    spdlog::warn("UDP 可靠通道窗口已满 player_id={} pending={}", player_id,
+                 sender.pending());
+    return false;
+  }
+  return true;
+}
+
+std::size_t UdpServer::FlushReliable(uint32_t room_id) {
+  const auto targets = EndpointsForRoom(room_id);
+  if (targets.empty()) {
+    return 0;
+  }
+
+  const auto now = reliable_channel::Clock::now();
+  std::vector<std::pair<std::shared_ptr<const std::string>, udp::endpoint>>
+      outgoing;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& target : targets) {
+      auto data = BuildReliableDatagramLocked(target.player_id, now, nullptr);
+      if (data != nullptr) {
+        outgoing.emplace_back(std::move(data), target.endpoint);
+      }
+    }
+  }
+  for (const auto& [data, endpoint] : outgoing) {
+    SendPacket(data, endpoint);
+  }
+  return outgoing.size();
+}
+
+std::size_t UdpServer::DrainReliable(
+    uint32_t player_id, std::vector<reliable_channel::DrainedMessage>* out) {
+  if (out == nullptr) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = reliable_senders_.find(player_id);
+  if (it == reliable_senders_.end()) {
+    return 0;
+  }
+  return it->second.Drain(out);
+}
+
+void UdpServer::ResetReliable(uint32_t player_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  reliable_senders_.erase(player_id);
+}
+
+std::shared_ptr<const std::string> UdpServer::BuildReliableDatagramLocked(
+    uint32_t player_id, reliable_channel::Clock::time_point now,
+    const std::string* piggyback) {
+  auto it = reliable_senders_.find(player_id);
+  if (it == reliable_senders_.end() || !it->second.HasDue(now)) {
+    return nullptr;
+  }
+  lawnmower::S2C_UdpReliable reliable;
+  if (it->second.CollectDue(now, &reliable) == 0) {
+    return nullptr;
+  }
+  if (piggyback != nullptr) {
+    reliable.set_piggyback_packet(*piggyback);
+  }
+  auto data = packet_codec::EncodeDatagram(
+                  lawnmower::MessageType::MSG_S2C_UDP_RELIABLE, reliable)
+                  .bytes;
+  if (data == nullptr) {
+    spdlog::error("UDP 可靠消息编码失败 player_id={}", player_id);
+  }
+  return data;
+}
+
+void UdpServer::SendToTargets(const std::vector<RoomTarget>& targets,
+                              const std::shared_ptr<const std::string>& data) {
+  const auto now = reliable_channel::Clock::now();
+  for (const auto& target : targets) {
+    std::shared_ptr<const std::string> bundled;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      bundled = BuildReliableDatagramLocked(target.player_id, now, data.get());
+    }
+    SendPacket(bundled != nullptr ? bundled : data, target.endpoint);
+  }
+}
+
+std::vector<UdpServer::RoomTarget> UdpServer::EndpointsForRoom(
+    uint32_t room_id, std::span<const uint32_t> exclude_player_ids) {
   const auto now = std::chrono::steady_clock::now();
-  std::vector<udp::endpoint> endpoints;
+  std::vector<RoomTarget> targets;
 
   std::lock_guard<std::mutex> lock(mutex_);
-  endpoints.reserve(player_endpoints_.size());
+  targets.reserve(player_endpoints_.size());
   for (auto it = player_endpoints_.begin(); it != player_endpoints_.end();) {
     const bool expired = (now - it->second.last_seen) > kEndpointTtl;
     if (expired) {
+      // 发送端保留：终端恢复后继续重发；期间的事件退回 TCP 时先经
+      // DrainReliable 把未确认消息按序补发，直到 ResetReliable 才丢弃
       it = player_endpoints_.erase(it);
       continue;
     }
-    if (it->second.room_id == room_id) {
-      endpoints.push_back(it->second.endpoint);
+    if (it->second.room_id == room_id &&
+        std::find(exclude_player_ids.begin(), exclude_player_ids.end(),
+                  it->first) == exclude_player_ids.end()) {
+      targets.push_back(RoomTarget{it->first, it->second.endpoint});
     }
     ++it;
   }
 
-  return endpoints;
+  return targets;
 }
 
 void UdpServer::SendPacket(const std::shared_ptr<const std::string>& data,
@@ -0,0 +1,320 @@
+// 共享基线增量 + 周期全量 对比 按客户端确认基线的增量（丢包 0/5/20%）。
+// 旧路径：每个同步 tick 发相对上一同步 tick 的增量，丢包后靠每 180 tick
+// 的 TCP 全量修复；新路径：相对客户端最后确认的快照求差，确认包同样会丢、
+// 并有 3 个同步 tick 的回程延迟。统计每接收者字节/秒与客户端状态与服务器
+// 一致的同步 tick 占比，以及单次 Diff 耗时。
+// 用法: acked_delta_bench [sync_ticks]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include "internal/game_manager_snapshot.hpp"
+#include "message.pb.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using game_manager_snapshot::DiffFollowups;
+using game_manager_snapshot::Snapshot;
+
+constexpr double kSyncRate = 30.0;
+constexpr uint32_t kFullSyncEvery = 180;  // 旧路径周期全量（同步 tick 数）
+constexpr uint32_t kAckDelayTicks = 3;
+constexpr int kPlayers = 4;
+constexpr int kEnemies = 60;
+
+struct Rng {
+  uint64_t state;
+  uint32_t Next() {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(state >> 33);
+  }
+};
+
+std::size_t WireBytes(lawnmower::MessageType type,
+                      const google::protobuf::MessageLite& message) {
+  lawnmower::Packet packet;
+  packet.set_msg_type(type);
+  packet.set_payload(message.SerializeAsString());
+  return packet.ByteSizeLong();
+}
+
+void FillFollowups(const Snapshot& current, const DiffFollowups& followups,
+                   lawnmower::S2C_GameStateDeltaSync* delta) {
+  for (const auto id : followups.full_player_ids) {
+    for (const auto& entry : current.players) {
+      if (entry.player_id == id) {
+        auto* state = delta->add_full_players();
+        state->set_player_id(id);
+        state->mutable_position()->set_x(entry.x);
+        state->mutable_position()->set_y(entry.y);
+        state->set_rotation(entry.rotation);
+        state->set_health(100);
+        state->set_max_health(100);
+        state->set_level(3);
+        state->set_is_alive(entry.is_alive);
+        state->set_last_processed_input_seq(
+            static_cast<int32_t>(entry.input_seq));
+      }
+    }
+  }
+  for (const auto id : followups.spawned_enemy_ids) {
+    for (const auto& entry : current.enemies) {
+      if (entry.enemy_id == id) {
+        auto* state = delta->add_spawned_enemies();
+        state->set_enemy_id(id);
+        state->set_type_id(1);
+        state->mutable_position()->set_x(entry.x);
+        state->mutable_position()->set_y(entry.y);
+        state->set_health(entry.health);
+        state->set_max_health(30);
+        state->set_is_alive(entry.is_alive);
+      }
+    }
+  }
+}
+
+lawnmower::S2C_GameStateDeltaSync MakeDelta(const Snapshot& baseline,
+                                            const Snapshot& current,
+                                            uint32_t baseline_tick) {
+  lawnmower::S2C_GameStateDeltaSync delta;
+  DiffFollowups followups;
+  game_manager_snapshot::Diff(baseline, current, &delta, &followups);
+  FillFollowups(current, followups, &delta);
+  delta.set_room_id(1);
+  delta.mutable_sync_time()->set_server_time(1700000000000ULL);
+  delta.mutable_sync_time()->set_tick(current.tick);
+  delta.set_baseline_tick(baseline_tick);
+  return delta;
+}
+
+std::size_t FullSyncBytes(const Snapshot& world) {
+  lawnmower::S2C_GameStateSync sync;
+  sync.set_room_id(1);
+  sync.mutable_sync_time()->set_tick(world.tick);
+  sync.set_is_full_snapshot(true);
+  for (const auto& entry : world.players) {
+    auto* state = sync.add_players();
+    state->set_player_id(entry.player_id);
+    state->mutable_position()->set_x(entry.x);
+    state->mutable_position()->set_y(entry.y);
+    state->set_rotation(entry.rotation);
+    state->set_health(100);
+    state->set_max_health(100);
+    state->set_level(3);
+    state->set_is_alive(entry.is_alive);
+  }
+  for (const auto& entry : world.enemies) {
+    auto* state = sync.add_enemies();
+    state->set_enemy_id(entry.enemy_id);
+    state->set_type_id(1);
+    state->mutable_position()->set_x(entry.x);
+    state->mutable_position()->set_y(entry.y);
+    state->set_health(entry.health);
+    state->set_max_health(30);
+    state->set_is_alive(entry.is_alive);
+  }
+  for (const auto& entry : world.items) {
+    auto* state = sync.add_items();
+    state->set_item_id(entry.item_id);
+    state->set_type_id(entry.type_id);
+    state->mutable_position()->set_x(entry.x);
+    state->mutable_position()->set_y(entry.y);
+  }
+  // TCP 另有 4 字节包长
+  return WireBytes(lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC, sync) + 4;
+}
+
+bool SameState(const Snapshot& a, const Snapshot& b) {
+  if (a.players.size() != b.players.size() ||
+      a.enemies.size() != b.enemies.size() ||
+      a.items.size() != b.items.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.players.size(); ++i) {
+    if (a.players[i].player_id != b.players[i].player_id ||
+        a.players[i].x != b.players[i].x ||
+        a.players[i].input_seq != b.players[i].input_seq) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < a.enemies.size(); ++i) {
+    if (a.enemies[i].enemy_id != b.enemies[i].enemy_id ||
+        a.enemies[i].y != b.enemies[i].y ||
+        a.enemies[i].health != b.enemies[i].health) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < a.items.size(); ++i) {
+    if (a.items[i].item_id != b.items[i].item_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 推进一个同步 tick 的世界：玩家移动、敌人行进/受伤/死亡/刷新、道具掉落/拾取
+void StepWorld(Rng* rng, uint32_t* next_id, Snapshot* world) {
+  for (auto& player : world->players) {
+    player.x += static_cast<float>(rng->Next() % 5);
+    player.input_seq += 2;
+    if (rng->Next() % 90 == 0) {
+      player.full_version += 1;
+    }
+  }
+  for (auto& enemy : world->enemies) {
+    enemy.y -= 2.0f;
+    if (rng->Next() % 8 == 0) {
+      enemy.health -= 3;
+    }
+  }
+  while (world->enemies.size() > kEnemies / 2 && rng->Next() % 3 == 0) {
+    const auto victim = rng->Next() % world->enemies.size();
+    world->items.push_back({(*next_id)++, world->enemies[victim].x,
+                            world->enemies[victim].y, 1 + rng->Next() % 3});
+    world->enemies.erase(world->enemies.begin() +
+                         static_cast<std::ptrdiff_t>(victim));
+  }
+  while (world->enemies.size() < kEnemies && rng->Next() % 2 == 0) {
+    world->enemies.push_back(
+        {(*next_id)++, static_cast<float>(rng->Next() % 1300), 720.0f, 30,
+         true});
+  }
+  if (!world->items.empty() && rng->Next() % 4 == 0) {
+    world->items.erase(world->items.begin());
+  }
+  world->SortById();
+}
+
+struct Result {
+  std::size_t bytes = 0;
+  uint32_t consistent = 0;
+  uint32_t full_syncs = 0;
+};
+
+void Run(double loss, uint32_t sync_ticks) {
+  const auto lost = [loss](Rng* rng) {
+    return static_cast<double>(rng->Next() % 10000) < loss * 10000.0;
+  };
+
+  Snapshot world;
+  for (int i = 0; i < kPlayers; ++i) {
+    world.players.push_back({static_cast<uint32_t>(i + 1), 100.0f * i, 360.0f,
+                             0.0f, 0, 0, true});
+  }
+  uint32_t next_id = 100;
+  Rng world_rng{0x9E3779B97F4A7C15ULL};
+  Rng legacy_rng{0xD1B54A32D192ED03ULL};
+  Rng acked_rng{0xD1B54A32D192ED03ULL};
+  for (int i = 0; i < kEnemies; ++i) {
+    world.enemies.push_back({next_id++, static_cast<float>(i * 20), 700.0f,
+                             30, true});
+  }
+  world.SortById();
+
+  Result legacy;
+  Result acked;
+  Snapshot legacy_prev = world;
+  Snapshot legacy_client = world;
+  game_manager_snapshot::SnapshotRing ring;
+  std::vector<Snapshot> acked_client = {world};  // 客户端已还原的快照
+  uint32_t server_acked = world.tick;
+  *ring.Record(world.tick) = world;
+  std::deque<std::pair<uint32_t, uint32_t>> acks_in_flight;  // (到达, tick)
+  double diff_ns = 0.0;
+  uint32_t diffs = 0;
+
+  for (uint32_t tick = 1; tick <= sync_ticks; ++tick) {
+    world.tick = tick;
+    StepWorld(&world_rng, &next_id, &world);
+
+    // 旧路径
+    if (tick % kFullSyncEvery == 0) {
+      legacy.bytes += FullSyncBytes(world);
+      legacy_client = world;
+      ++legacy.full_syncs;
+    } else {
+      const auto delta = MakeDelta(legacy_prev, world, 0);
+      legacy.bytes +=
+          WireBytes(lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC,
+                    delta);
+      if (!lost(&legacy_rng)) {
+        Snapshot next;
+        game_manager_snapshot::Apply(legacy_client, delta, &next);
+        legacy_client = std::move(next);
+      }
+    }
+    legacy_prev = world;
+    legacy.consistent += SameState(legacy_client, world) ? 1 : 0;
+
+    // 新路径
+    *ring.Record(tick) = world;
+    while (!acks_in_flight.empty() && acks_in_flight.front().first <= tick) {
+      const uint32_t acked_tick = acks_in_flight.front().second;
+      acks_in_flight.pop_front();
+      server_acked = std::max(server_acked, acked_tick);
+    }
+    const Snapshot* baseline = ring.Find(server_acked);
+    if (baseline == nullptr) {
+      acked.bytes += FullSyncBytes(world);
+      ++acked.full_syncs;
+      acked_client.push_back(world);
+      server_acked = tick;
+      acked.consistent += 1;
+    } else {
+      const auto start = Clock::now();
+      const auto delta = MakeDelta(*baseline, world, baseline->tick);
+      diff_ns += std::chrono::duration<double, std::nano>(Clock::now() - start)
+                     .count();
+      ++diffs;
+      acked.bytes += WireBytes(
+          lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC, delta);
+      if (!lost(&acked_rng)) {
+        const auto base_it = std::find_if(
+            acked_client.begin(), acked_client.end(),
+            [&delta](const Snapshot& s) {
+              return s.tick == delta.baseline_tick();
+            });
+        if (base_it != acked_client.end()) {
+          Snapshot next;
+          game_manager_snapshot::Apply(*base_it, delta, &next);
+          acked.consistent += SameState(next, world) ? 1 : 0;
+          acked_client.push_back(std::move(next));
+          if (!lost(&acked_rng)) {
+            acks_in_flight.emplace_back(tick + kAckDelayTicks, tick);
+          }
+        }
+      }
+    }
+    if (acked_client.size() > 80) {
+      acked_client.erase(acked_client.begin());
+    }
+  }
+
+  const double seconds = static_cast<double>(sync_ticks) / kSyncRate;
+  std::printf(
+      "loss %4.1f%%  legacy: %7.0f B/s consistent %5.1f%% full=%u | "
+      "acked: %7.0f B/s consistent %5.1f%% full=%u  diff %.2f us\n",
+      loss * 100.0, static_cast<double>(legacy.bytes) / seconds,
+      100.0 * legacy.consistent / sync_ticks, legacy.full_syncs,
+      static_cast<double>(acked.bytes) / seconds,
+      100.0 * acked.consistent / sync_ticks, acked.full_syncs,
+      diffs > 0 ? diff_ns / diffs / 1000.0 : 0.0);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto sync_ticks = static_cast<uint32_t>(
+      argc > 1 ? std::max(1, std::atoi(argv[1])) : 18000);
+  std::printf(
+      "acked_delta_bench: %u sync ticks @ %.0f Hz, %d players, %d enemies, "
+      "per recipient\n",
+      sync_ticks, kSyncRate, kPlayers, kEnemies);
+  for (const double loss : {0.0, 0.05, 0.20}) {
+    Run(loss, sync_ticks);
+  }
+  return 0;
+}
@@ -0,0 +1,195 @@
+// 按确认基线的增量：浮点坐标 vs 定点绝对坐标 vs 定点相对基线坐标。
+// 敌人以 40~80 像素/秒朝随机方向移动（带亚像素），确认回程延迟 1/3 个同步
+// tick。统计每个敌人每次增量在 enemies 字段上占用的字节、整包字节，以及
+// Quantize 耗时。
+// 用法: delta_quantize_bench [sync_ticks]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+
+#include "internal/game_manager_snapshot.hpp"
+#include "message.pb.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using game_manager_snapshot::DiffFollowups;
+using game_manager_snapshot::QuantizeParams;
+using game_manager_snapshot::Snapshot;
+
+constexpr double kSyncRate = 30.0;
+constexpr int kPlayers = 4;
+constexpr int kEnemies = 200;
+
+struct Rng {
+  uint64_t state;
+  uint32_t Next() {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(state >> 33);
+  }
+  float Uniform(float lo, float hi) {
+    return lo + (hi - lo) * static_cast<float>(Next() % 10000) / 10000.0f;
+  }
+};
+
+struct Mover {
+  float vx = 0.0f;
+  float vy = 0.0f;
+};
+
+std::size_t EnemyBytes(const lawnmower::S2C_GameStateDeltaSync& delta) {
+  std::size_t bytes = 0;
+  for (const auto& enemy : delta.enemies()) {
+    const std::size_t size = enemy.ByteSizeLong();
+    bytes += 1 + (size < 128 ? 1 : 2) + size;  // 字段 tag + 长度前缀
+  }
+  return bytes;
+}
+
+// 定点但不做相对编码：qx/qy 直接写绝对定点坐标
+void QuantizeAbsolute(const QuantizeParams& params,
+                      lawnmower::S2C_GameStateDeltaSync* delta) {
+  using game_manager_snapshot::QuantizeCoord;
+  using game_manager_snapshot::QuantizeRotation;
+  delta->set_position_scale(params.position_scale);
+  delta->set_rotation_bits(params.rotation_bits);
+  for (auto& enemy : *delta->mutable_enemies()) {
+    if (!enemy.has_position()) {
+      continue;
+    }
+    enemy.set_qx(QuantizeCoord(enemy.position().x(), params.position_scale));
+    enemy.set_qy(QuantizeCoord(enemy.position().y(), params.position_scale));
+    enemy.clear_position();
+  }
+  for (auto& player : *delta->mutable_players()) {
+    if (player.has_position()) {
+      player.set_qx(
+          QuantizeCoord(player.position().x(), params.position_scale));
+      player.set_qy(
+          QuantizeCoord(player.position().y(), params.position_scale));
+      player.clear_position();
+    }
+    if (player.has_rotation()) {
+      player.set_qrotation(
+          QuantizeRotation(player.rotation(), params.rotation_bits));
+      player.clear_rotation();
+    }
+  }
+}
+
+void Run(uint32_t ack_delay, uint32_t sync_ticks) {
+  Rng rng{0x9E3779B97F4A7C15ULL + ack_delay};
+  const QuantizeParams params;
+  const float dt = static_cast<float>(1.0 / kSyncRate);
+
+  Snapshot world;
+  std::vector<Mover> movers(kEnemies);
+  for (int i = 0; i < kPlayers; ++i) {
+    world.players.push_back({static_cast<uint32_t>(i + 1),
+                             rng.Uniform(800.0f, 1200.0f),
+                             rng.Uniform(800.0f, 1200.0f), 0.0f, 0, 0, true});
+  }
+  for (int i = 0; i < kEnemies; ++i) {
+    world.enemies.push_back({static_cast<uint32_t>(1000 + i),
+                             rng.Uniform(0.0f, 2000.0f),
+                             rng.Uniform(0.0f, 2000.0f), 30, true});
+    const float speed = rng.Uniform(40.0f, 80.0f);
+    const float angle = rng.Uniform(0.0f, 6.2831853f);
+    movers[i] = {speed * std::cos(angle), speed * std::sin(angle)};
+  }
+
+  std::deque<Snapshot> history;
+  std::size_t float_bytes = 0;
+  std::size_t absolute_bytes = 0;
+  std::size_t relative_bytes = 0;
+  std::size_t float_packet = 0;
+  std::size_t relative_packet = 0;
+  std::size_t enemy_samples = 0;
+  double quantize_us = 0.0;
+  uint32_t deltas = 0;
+
+  for (uint32_t tick = 1; tick <= sync_ticks; ++tick) {
+    world.tick = tick;
+    for (auto& player : world.players) {
+      player.x += rng.Uniform(-3.0f, 3.0f);
+      player.y += rng.Uniform(-3.0f, 3.0f);
+      player.rotation = std::fmod(player.rotation + rng.Uniform(0.0f, 20.0f),
+                                  360.0f);
+      player.input_seq += 2;
+    }
+    for (std::size_t i = 0; i < world.enemies.size(); ++i) {
+      auto& enemy = world.enemies[i];
+      enemy.x = std::clamp(enemy.x + movers[i].vx * dt, 0.0f, 2000.0f);
+      enemy.y = std::clamp(enemy.y + movers[i].vy * dt, 0.0f, 2000.0f);
+      if (enemy.x <= 0.0f || enemy.x >= 2000.0f) {
+        movers[i].vx = -movers[i].vx;
+      }
+      if (enemy.y <= 0.0f || enemy.y >= 2000.0f) {
+        movers[i].vy = -movers[i].vy;
+      }
+    }
+    history.push_back(world);
+    if (history.size() <= ack_delay) {
+      continue;
+    }
+    const Snapshot& baseline = history.front();
+
+    lawnmower::S2C_GameStateDeltaSync delta;
+    DiffFollowups followups;
+    game_manager_snapshot::Diff(baseline, world, &delta, &followups);
+    delta.mutable_sync_time()->set_tick(tick);
+    delta.set_baseline_tick(baseline.tick);
+
+    lawnmower::S2C_GameStateDeltaSync absolute = delta;
+    QuantizeAbsolute(params, &absolute);
+    lawnmower::S2C_GameStateDeltaSync relative = delta;
+    const auto start = Clock::now();
+    game_manager_snapshot::Quantize(baseline, params, &relative);
+    quantize_us +=
+        std::chrono::duration<double, std::micro>(Clock::now() - start)
+            .count();
+
+    float_bytes += EnemyBytes(delta);
+    absolute_bytes += EnemyBytes(absolute);
+    relative_bytes += EnemyBytes(relative);
+    float_packet += delta.ByteSizeLong();
+    relative_packet += relative.ByteSizeLong();
+    enemy_samples += world.enemies.size();
+    ++deltas;
+    history.pop_front();
+  }
+
+  const auto per_enemy = [enemy_samples](std::size_t bytes) {
+    return static_cast<double>(bytes) / static_cast<double>(enemy_samples);
+  };
+  std::printf("ack_delay=%u sync ticks\n", ack_delay);
+  std::printf("  bytes/enemy/delta: float=%.2f quantized_abs=%.2f "
+              "quantized_rel=%.2f (%.1f%% of float)\n",
+              per_enemy(float_bytes), per_enemy(absolute_bytes),
+              per_enemy(relative_bytes),
+              100.0 * static_cast<double>(relative_bytes) /
+                  static_cast<double>(float_bytes));
+  std::printf("  packet bytes/delta: float=%.0f quantized_rel=%.0f\n",
+              static_cast<double>(float_packet) / deltas,
+              static_cast<double>(relative_packet) / deltas);
+  std::printf("  quantize: %.2f us/delta\n", quantize_us / deltas);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto sync_ticks = static_cast<uint32_t>(
+      argc > 1 ? std::max(1, std::atoi(argv[1])) : 3000);
+  std::printf(
+      "delta_quantize_bench: %u sync ticks @ %.0f Hz, %d players, "
+      "%d enemies, scale=%u rotation_bits=%u\n",
+      sync_ticks, kSyncRate, kPlayers, kEnemies,
+      game_manager_snapshot::kDefaultPositionScale,
+      game_manager_snapshot::kDefaultRotationBits);
+  for (const uint32_t ack_delay : {1u, 3u}) {
+    Run(ack_delay, sync_ticks);
+  }
+  return 0;
+}
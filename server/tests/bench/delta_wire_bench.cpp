@@ -0,0 +1,125 @@
+// 共享基线增量编码微基准：原 BuildSyncPayloadsLocked 写法（每个变化敌人
+// add_enemies + Vector2 子消息，随后 SerializeAsString / packet_codec 编码）
+// 对比 delta_wire 平铺记录 + 字段表直写。每轮从运行时 EnemyState 取字段
+// 重新构建一次，统计每个实体的构建+编码耗时（ns）。
+// 用法: delta_wire_bench [rounds]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "message.pb.h"
+#include "network/delta_wire.hpp"
+#include "network/packet_codec.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t kMask =
+    lawnmower::ENEMY_DELTA_POSITION | lawnmower::ENEMY_DELTA_HEALTH;
+
+std::vector<lawnmower::EnemyState> MakeEnemies(int count) {
+  std::vector<lawnmower::EnemyState> enemies(static_cast<std::size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    auto& enemy = enemies[static_cast<std::size_t>(i)];
+    enemy.set_enemy_id(static_cast<uint32_t>(1000 + i));
+    enemy.mutable_position()->set_x(100.0f + static_cast<float>(i) * 3.25f);
+    enemy.mutable_position()->set_y(900.0f - static_cast<float>(i) * 1.5f);
+    enemy.set_health(100 - i % 90);
+    enemy.set_is_alive(true);
+  }
+  return enemies;
+}
+
+void BuildMessage(const std::vector<lawnmower::EnemyState>& enemies,
+                  lawnmower::S2C_GameStateDeltaSync* delta) {
+  delta->set_room_id(1);
+  delta->mutable_sync_time()->set_server_time(1'700'000'000'000ULL);
+  delta->mutable_sync_time()->set_tick(1000);
+  delta->mutable_enemies()->Reserve(static_cast<int>(enemies.size()));
+  for (const auto& enemy : enemies) {
+    auto* out = delta->add_enemies();
+    out->set_enemy_id(enemy.enemy_id());
+    out->set_changed_mask(kMask);
+    *out->mutable_position() = enemy.position();
+    out->set_health(enemy.health());
+  }
+}
+
+void BuildFrame(const std::vector<lawnmower::EnemyState>& enemies,
+                delta_wire::DeltaFrame* frame) {
+  frame->room_id = 1;
+  frame->has_sync_time = true;
+  frame->server_time_ms = 1'700'000'000'000ULL;
+  frame->tick = 1000;
+  frame->enemies.reserve(enemies.size());
+  for (const auto& enemy : enemies) {
+    frame->enemies.push_back(delta_wire::EnemyDelta{
+        enemy.enemy_id(), kMask, enemy.position().x(), enemy.position().y(),
+        enemy.health(), enemy.is_alive()});
+  }
+}
+
+template <typename Fn>
+double NsPerEntity(int rounds, int entities, Fn&& fn) {
+  std::size_t sink = 0;
+  const auto start = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    sink += fn();
+  }
+  const double ns =
+      std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+  if (sink == 0) {
+    std::printf("unexpected empty output\n");
+  }
+  return ns / (static_cast<double>(rounds) * entities);
+}
+
+void Run(int entities, int rounds) {
+  const auto enemies = MakeEnemies(entities);
+  const auto type = lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC;
+
+  const double serialize = NsPerEntity(rounds, entities, [&]() {
+    lawnmower::S2C_GameStateDeltaSync delta;
+    BuildMessage(enemies, &delta);
+    return delta.SerializeAsString().size();
+  });
+  const double codec = NsPerEntity(rounds, entities, [&]() {
+    lawnmower::S2C_GameStateDeltaSync delta;
+    BuildMessage(enemies, &delta);
+    return packet_codec::EncodeDatagram(type, delta).bytes->size();
+  });
+  const double wire = NsPerEntity(rounds, entities, [&]() {
+    delta_wire::DeltaFrame frame;
+    BuildFrame(enemies, &frame);
+    return delta_wire::EncodeDatagram(frame).bytes->size();
+  });
+
+  lawnmower::S2C_GameStateDeltaSync delta;
+  BuildMessage(enemies, &delta);
+  delta_wire::DeltaFrame frame;
+  BuildFrame(enemies, &frame);
+  const bool same = *delta_wire::EncodeDatagram(frame).bytes ==
+                    *packet_codec::EncodeDatagram(type, delta).bytes;
+
+  std::printf(
+      "enemies=%4d  message+SerializeAsString=%6.1f ns  "
+      "message+packet_codec=%6.1f ns  delta_wire=%5.1f ns  (%.1fx, "
+      "bytes_identical=%s)\n",
+      entities, serialize, codec, wire, serialize / wire,
+      same ? "yes" : "NO");
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int rounds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+  std::printf("delta_wire_bench: %d rounds, ns per entity (build + encode)\n",
+              rounds);
+  for (const int entities : {16, 64, 256, 1024}) {
+    Run(entities, rounds);
+  }
+  return 0;
+}
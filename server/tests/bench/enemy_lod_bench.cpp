@@ -0,0 +1,243 @@
+// 敌人模拟 LOD 微基准：同一负载下对比「全部每 tick 更新」与「按距离分档
+// 降频」的每 tick 耗时。每 tick 模拟：最近玩家 + 标量阶段（周期重算路径、
+// 路点推进、按类型查速度）+ 转向内核 + 同步脏检查 + 近战扫描（按类型查
+// 攻击半径、遍历玩家表），查表方式与服务端一致（unordered_map）。
+// 玩家聚在地图中部，敌人散布全图，与实际对局中大量敌人在远处追赶的分布一致。
+// 用法: enemy_lod_bench [ticks]
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+#include "internal/game_manager_lod.hpp"
+#include "internal/game_manager_steering.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using game_manager_lod::LodConfig;
+using game_manager_lod::LodTier;
+using game_manager_steering::SteeringBatch;
+using game_manager_steering::SteerParams;
+
+constexpr float kMapW = 6000.0f;
+constexpr float kMapH = 6000.0f;
+constexpr float kCellSize = 100.0f;
+constexpr double kDt = 1.0 / 60.0;
+constexpr double kReplanSeconds = 0.5;
+constexpr std::size_t kPlayers = 4;
+constexpr std::size_t kPathCells = 12;
+constexpr uint32_t kEnemyTypes = 4;
+
+volatile uint64_t g_sink = 0;  // 防止计算被优化掉
+
+struct EnemyType {
+  float move_speed = 60.0f;
+  float attack_radius = 34.0f;
+};
+
+struct Player {
+  float x = 0.0f;
+  float y = 0.0f;
+  bool alive = true;
+};
+
+struct Enemy {
+  uint32_t id = 0;
+  uint32_t type_id = 1;
+  std::array<uint16_t, kPathCells> path{};
+  uint16_t path_length = 0;
+  uint16_t path_index = 0;
+  double replan_elapsed = 0.0;
+  double lod_elapsed = 0.0;
+  uint8_t lod_tier = 0;
+  bool attacking = false;
+  bool dirty = false;
+};
+
+float NextUnit(uint32_t* rng) {
+  *rng = *rng * 1664525u + 1013904223u;
+  return static_cast<float>(*rng >> 8) / static_cast<float>(1u << 24);
+}
+
+uint16_t CellOf(float x, float y) {
+  const int cx = std::clamp(static_cast<int>(x / kCellSize), 0, 59);
+  const int cy = std::clamp(static_cast<int>(y / kCellSize), 0, 59);
+  return static_cast<uint16_t>(cy * 60 + cx);
+}
+
+// 以直线格序列代替 A*，保留「重算路径」这一段标量开销
+void Replan(Enemy* e, float x, float y, float tx, float ty) {
+  e->path_length = 0;
+  e->path_index = 0;
+  for (std::size_t k = 1; k <= kPathCells; ++k) {
+    const float t = static_cast<float>(k) / static_cast<float>(kPathCells);
+    e->path[e->path_length++] = CellOf(x + (tx - x) * t, y + (ty - y) * t);
+  }
+}
+
+class World {
+ public:
+  World(std::size_t enemy_count, const LodConfig& lod) : lod_(lod) {
+    uint32_t rng = 11u;
+    for (uint32_t t = 1; t <= kEnemyTypes; ++t) {
+      types_[t] = EnemyType{40.0f + 20.0f * static_cast<float>(t),
+                            30.0f + 2.0f * static_cast<float>(t)};
+    }
+    for (std::size_t p = 0; p < kPlayers; ++p) {
+      const uint32_t player_id = static_cast<uint32_t>(p + 1);
+      const float x = kMapW * 0.5f + (NextUnit(&rng) - 0.5f) * 400.0f;
+      const float y = kMapH * 0.5f + (NextUnit(&rng) - 0.5f) * 400.0f;
+      players_[player_id] = Player{x, y, true};
+      batch_.player_ids.push_back(player_id);
+      batch_.player_xs.push_back(x);
+      batch_.player_ys.push_back(y);
+    }
+    enemies_.resize(enemy_count);
+    batch_.ResizeEnemies(enemy_count);
+    for (std::size_t i = 0; i < enemy_count; ++i) {
+      enemies_[i].id = static_cast<uint32_t>(i + 1);
+      enemies_[i].type_id = static_cast<uint32_t>(i % kEnemyTypes) + 1;
+      batch_.xs[i] = NextUnit(&rng) * kMapW;
+      batch_.ys[i] = NextUnit(&rng) * kMapH;
+    }
+  }
+
+  uint64_t Tick() {
+    const std::size_t count = enemies_.size();
+    game_manager_steering::NearestPlayers(
+        batch_.player_xs.data(), batch_.player_ys.data(), kPlayers,
+        batch_.xs.data(), batch_.ys.data(), count,
+        batch_.nearest_player.data());
+    for (std::size_t i = 0; i < count; ++i) {
+      Enemy& e = enemies_[i];
+      const float x = batch_.xs[i];
+      const float y = batch_.ys[i];
+      batch_.goal_xs[i] = x;
+      batch_.goal_ys[i] = y;
+      batch_.speeds[i] = 0.0f;
+      batch_.dts[i] = static_cast<float>(kDt);
+      const int32_t slot = batch_.nearest_player[i];
+      const float tx = batch_.player_xs[slot];
+      const float ty = batch_.player_ys[slot];
+      const float dx = tx - x;
+      const float dy = ty - y;
+      const LodTier tier =
+          game_manager_lod::ClassifyLod(lod_, dx * dx + dy * dy);
+      e.lod_tier = static_cast<uint8_t>(tier);
+      e.lod_elapsed += kDt;
+      if (!game_manager_lod::ShouldSimulate(lod_, tier, tick_, e.id)) {
+        batch_.nearest_player[i] = -1;
+        continue;
+      }
+      const double step = e.lod_elapsed;
+      e.lod_elapsed = 0.0;
+      batch_.dts[i] = static_cast<float>(step);
+      e.replan_elapsed += step;
+      if (e.replan_elapsed >= kReplanSeconds ||
+          e.path_index >= e.path_length) {
+        Replan(&e, x, y, tx, ty);
+        e.replan_elapsed = 0.0;
+      }
+      float gx = tx;
+      float gy = ty;
+      while (e.path_index < e.path_length) {
+        const uint16_t cell = e.path[e.path_index];
+        gx = (static_cast<float>(cell % 60) + 0.5f) * kCellSize;
+        gy = (static_cast<float>(cell / 60) + 0.5f) * kCellSize;
+        const float wx = gx - x;
+        const float wy = gy - y;
+        if (wx * wx + wy * wy > 24.0f * 24.0f) {
+          break;
+        }
+        e.path_index += 1;
+      }
+      batch_.goal_xs[i] = gx;
+      batch_.goal_ys[i] = gy;
+      batch_.speeds[i] = types_.find(e.type_id)->second.move_speed;
+    }
+    game_manager_steering::SteerTowardGoals(SteerParams{kMapW, kMapH},
+                                            &batch_);
+
+    uint64_t checksum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      Enemy& e = enemies_[i];
+      if (batch_.moved[i] != 0) {
+        batch_.xs[i] = batch_.out_xs[i];
+        batch_.ys[i] = batch_.out_ys[i];
+        e.dirty = true;
+      }
+      if (batch_.nearest_player[i] >= 0 && e.dirty) {
+        checksum += e.id;
+        e.dirty = false;
+      }
+    }
+    // 近战扫描：非近档且未在攻击的敌人跳过
+    for (std::size_t i = 0; i < count; ++i) {
+      Enemy& e = enemies_[i];
+      if (e.lod_tier != static_cast<uint8_t>(LodTier::kNear) && !e.attacking) {
+        continue;
+      }
+      const float radius = types_.find(e.type_id)->second.attack_radius;
+      bool in_range = false;
+      for (const auto& [_, player] : players_) {
+        if (!player.alive) {
+          continue;
+        }
+        const float dx = player.x - batch_.xs[i];
+        const float dy = player.y - batch_.ys[i];
+        in_range = in_range || dx * dx + dy * dy <= radius * radius;
+      }
+      e.attacking = in_range;
+      checksum += in_range ? 1u : 0u;
+    }
+    tick_ += 1;
+    return checksum;
+  }
+
+ private:
+  LodConfig lod_;
+  uint64_t tick_ = 0;
+  std::unordered_map<uint32_t, EnemyType> types_;
+  std::unordered_map<uint32_t, Player> players_;
+  std::vector<Enemy> enemies_;
+  SteeringBatch batch_;
+};
+
+double UsPerTick(std::size_t enemy_count, int ticks, const LodConfig& lod) {
+  World world(enemy_count, lod);
+  uint64_t checksum = 0;
+  const auto begin = Clock::now();
+  for (int t = 0; t < ticks; ++t) {
+    checksum += world.Tick();
+  }
+  const auto end = Clock::now();
+  g_sink = checksum;
+  return std::chrono::duration<double, std::micro>(end - begin).count() /
+         static_cast<double>(std::max(1, ticks));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int ticks = argc > 1 ? std::max(1, std::atoi(argv[1])) : 300;
+  const LodConfig off = game_manager_lod::MakeLodConfig(0.0f, 0.0f, 1, 1);
+  // 与 server_config.json 默认值一致
+  const LodConfig tiers =
+      game_manager_lod::MakeLodConfig(900.0f, 1600.0f, 2, 4);
+  std::printf(
+      "enemy_lod_bench: %d ticks, map %.0fx%.0f, lod mid=900/2 far=1600/4\n",
+      ticks, kMapW, kMapH);
+  for (const std::size_t count : {1024u, 4096u, 16384u, 65536u}) {
+    const double base = UsPerTick(count, ticks, off);
+    const double lod = UsPerTick(count, ticks, tiers);
+    std::printf(
+        "enemies=%6zu  no-lod=%8.1f us/tick  lod=%8.1f us/tick  "
+        "(%.0f%% saved)\n",
+        count, base, lod, base > 0.0 ? (1.0 - lod / base) * 100.0 : 0.0);
+  }
+  return 0;
+}
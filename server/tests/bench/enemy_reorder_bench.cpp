@@ -0,0 +1,317 @@
+// 敌人存储 Morton 重排微基准：同一负载下对比「从不重排」与「每 N tick
+// 按 Morton 序重排」的 tick 耗时与 cache miss。
+// 每 tick 模拟：移动（顺序遍历）+ 射弹按格查询命中（经格子指针访问敌人）
+// + 玩家近战扫描 + 构建同步（顺序遍历），并持续有敌人死亡/补刷打乱顺序。
+// cache miss 通过 perf_event_open 读取硬件计数器（与 `perf stat -e
+// cache-misses,cache-references` 相同来源）；无权限时只输出耗时，
+// 此时可改为 `perf stat -e cache-misses ./enemy_reorder_bench` 整体测量。
+// 用法: enemy_reorder_bench [ticks] [reorder_interval]
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "game/managers/dense_id_map.hpp"
+#include "internal/game_manager_spatial.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr float kMapW = 4000.0f;
+constexpr float kMapH = 4000.0f;
+constexpr float kCellSize = 100.0f;
+constexpr int kCellsX = 40;
+constexpr int kCellsY = 40;
+constexpr std::size_t kProjectiles = 512;
+constexpr std::size_t kPlayers = 4;
+
+volatile uint64_t g_sink = 0;  // 防止计算被优化掉
+
+// 与服务端 EnemyRuntime 大小相近（约 216 字节）
+struct FakeEnemy {
+  float x = 0.0f;
+  float y = 0.0f;
+  float vx = 0.0f;
+  float vy = 0.0f;
+  int32_t health = 100;
+  bool alive = true;
+  bool dirty = false;
+  std::array<uint8_t, 190> padding{};
+};
+
+uint32_t NextRng(uint32_t* rng) {
+  *rng = *rng * 1664525u + 1013904223u;
+  return *rng;
+}
+
+float NextUnit(uint32_t* rng) {
+  return static_cast<float>(NextRng(rng) >> 8) / static_cast<float>(1u << 24);
+}
+
+int CellOf(float v) {
+  return std::clamp(static_cast<int>(v / kCellSize), 0, kCellsX - 1);
+}
+
+#if defined(__linux__)
+class PerfCounter {
+ public:
+  explicit PerfCounter(uint64_t config) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+  ~PerfCounter() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+  bool ok() const { return fd_ >= 0; }
+  void Start() {
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+  uint64_t Stop() {
+    uint64_t value = 0;
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd_, &value, sizeof(value)) != sizeof(value)) {
+        value = 0;
+      }
+    }
+    return value;
+  }
+
+ private:
+  int fd_ = -1;
+};
+#else
+class PerfCounter {
+ public:
+  explicit PerfCounter(uint64_t) {}
+  bool ok() const { return false; }
+  void Start() {}
+  uint64_t Stop() { return 0; }
+};
+constexpr uint64_t PERF_COUNT_HW_CACHE_MISSES = 0;
+constexpr uint64_t PERF_COUNT_HW_CACHE_REFERENCES = 0;
+#endif
+
+class World {
+ public:
+  World(std::size_t enemy_count, uint32_t seed) : rng_(seed) {
+    enemies_.reserve(enemy_count);
+    for (std::size_t i = 0; i < enemy_count; ++i) {
+      Spawn();
+    }
+    for (std::size_t p = 0; p < kPlayers; ++p) {
+      players_[p] = {NextUnit(&rng_) * kMapW, NextUnit(&rng_) * kMapH};
+    }
+    cell_start_.resize(static_cast<std::size_t>(kCellsX * kCellsY) + 1);
+  }
+
+  void Reorder() {
+    enemies_.SortByKey([](uint32_t id, const FakeEnemy& e) -> uint64_t {
+      if (!e.alive) {
+        return (uint64_t{1} << 63) | id;
+      }
+      const uint32_t morton = game_manager_spatial::MortonCode(
+          static_cast<uint32_t>(CellOf(e.x)), static_cast<uint32_t>(CellOf(e.y)));
+      return (static_cast<uint64_t>(morton) << 32) | id;
+    });
+  }
+
+  uint64_t Tick() {
+    uint64_t checksum = 0;
+    // 死亡回收 + 补刷：模拟服务端的 erase / emplace 打乱存储顺序
+    for (auto it = enemies_.begin(); it != enemies_.end();) {
+      if (!it->second.alive) {
+        it = enemies_.erase(it);
+        continue;
+      }
+      ++it;
+    }
+    while (enemies_.size() < enemies_capacity_) {
+      Spawn();
+    }
+
+    // 移动
+    for (auto& [_, e] : enemies_) {
+      e.x = std::clamp(e.x + e.vx, 0.0f, kMapW - 1.0f);
+      e.y = std::clamp(e.y + e.vy, 0.0f, kMapH - 1.0f);
+      e.dirty = true;
+    }
+
+    // 射弹网格（计数排序分桶，存敌人指针）
+    std::fill(cell_start_.begin(), cell_start_.end(), 0u);
+    for (const auto& [_, e] : enemies_) {
+      cell_start_[static_cast<std::size_t>(CellOf(e.y) * kCellsX + CellOf(e.x)) +
+                  1] += 1;
+    }
+    for (std::size_t c = 1; c < cell_start_.size(); ++c) {
+      cell_start_[c] += cell_start_[c - 1];
+    }
+    cursor_.assign(cell_start_.begin(), cell_start_.end() - 1);
+    grid_.resize(enemies_.size());
+    for (auto& [_, e] : enemies_) {
+      grid_[cursor_[static_cast<std::size_t>(CellOf(e.y) * kCellsX +
+                                             CellOf(e.x))]++] = &e;
+    }
+
+    // 射弹命中：查询 3x3 邻域格内敌人，命中扣血
+    for (std::size_t p = 0; p < kProjectiles; ++p) {
+      const float px = NextUnit(&rng_) * kMapW;
+      const float py = NextUnit(&rng_) * kMapH;
+      const int cx = CellOf(px);
+      const int cy = CellOf(py);
+      for (int y = std::max(0, cy - 1); y <= std::min(kCellsY - 1, cy + 1);
+           ++y) {
+        for (int x = std::max(0, cx - 1); x <= std::min(kCellsX - 1, cx + 1);
+             ++x) {
+          const std::size_t cell = static_cast<std::size_t>(y * kCellsX + x);
+          for (uint32_t k = cell_start_[cell]; k < cell_start_[cell + 1]; ++k) {
+            FakeEnemy* e = grid_[k];
+            const float dx = e->x - px;
+            const float dy = e->y - py;
+            if (dx * dx + dy * dy < 22.0f * 22.0f) {
+              e->health -= 40;
+              if (e->health <= 0) {
+                e->alive = false;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    // 玩家近战：扫描玩家周围 5x5 格
+    for (const auto& [px, py] : players_) {
+      const int cx = CellOf(px);
+      const int cy = CellOf(py);
+      for (int y = std::max(0, cy - 2); y <= std::min(kCellsY - 1, cy + 2);
+           ++y) {
+        for (int x = std::max(0, cx - 2); x <= std::min(kCellsX - 1, cx + 2);
+             ++x) {
+          const std::size_t cell = static_cast<std::size_t>(y * kCellsX + x);
+          for (uint32_t k = cell_start_[cell]; k < cell_start_[cell + 1]; ++k) {
+            checksum += static_cast<uint64_t>(grid_[k]->health);
+          }
+        }
+      }
+    }
+
+    // 同步构建：顺序遍历脏敌人
+    for (auto& [id, e] : enemies_) {
+      if (e.dirty) {
+        checksum += id + static_cast<uint64_t>(e.x) + e.padding[0];
+        e.dirty = false;
+      }
+    }
+    return checksum;
+  }
+
+ private:
+  void Spawn() {
+    FakeEnemy e;
+    e.x = NextUnit(&rng_) * kMapW;
+    e.y = NextUnit(&rng_) * kMapH;
+    e.vx = (NextUnit(&rng_) - 0.5f) * 4.0f;
+    e.vy = (NextUnit(&rng_) - 0.5f) * 4.0f;
+    enemies_.emplace(next_id_++, std::move(e));
+    enemies_capacity_ = std::max(enemies_capacity_, enemies_.size());
+  }
+
+  uint32_t rng_ = 1;
+  uint32_t next_id_ = 1;
+  std::size_t enemies_capacity_ = 0;
+  DenseIdMap<FakeEnemy> enemies_;
+  std::array<std::pair<float, float>, kPlayers> players_{};
+  std::vector<uint32_t> cell_start_;
+  std::vector<uint32_t> cursor_;
+  std::vector<FakeEnemy*> grid_;
+};
+
+struct RunResult {
+  double us_per_tick = 0.0;    // 含重排开销
+  double reorder_us = 0.0;     // 单次重排耗时
+  uint64_t cache_misses = 0;
+  uint64_t cache_refs = 0;
+};
+
+RunResult Run(std::size_t enemy_count, int ticks, int reorder_interval) {
+  World world(enemy_count, 7u);
+  PerfCounter misses(PERF_COUNT_HW_CACHE_MISSES);
+  PerfCounter refs(PERF_COUNT_HW_CACHE_REFERENCES);
+  uint64_t checksum = 0;
+  misses.Start();
+  refs.Start();
+  Clock::duration reorder_time{};
+  int reorders = 0;
+  const auto begin = Clock::now();
+  for (int t = 0; t < ticks; ++t) {
+    if (reorder_interval > 0 && t % reorder_interval == 0) {
+      const auto reorder_begin = Clock::now();
+      world.Reorder();
+      reorder_time += Clock::now() - reorder_begin;
+      reorders += 1;
+    }
+    checksum += world.Tick();
+  }
+  const auto end = Clock::now();
+  RunResult result;
+  result.reorder_us =
+      reorders > 0
+          ? std::chrono::duration<double, std::micro>(reorder_time).count() /
+                reorders
+          : 0.0;
+  result.cache_misses = misses.Stop();
+  result.cache_refs = refs.Stop();
+  result.us_per_tick =
+      std::chrono::duration<double, std::micro>(end - begin).count() /
+      static_cast<double>(std::max(1, ticks));
+  g_sink = checksum;
+  return result;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int ticks = argc > 1 ? std::max(1, std::atoi(argv[1])) : 300;
+  const int interval = argc > 2 ? std::max(1, std::atoi(argv[2])) : 30;
+  const bool has_counters = PerfCounter(PERF_COUNT_HW_CACHE_MISSES).ok();
+  std::printf(
+      "enemy_reorder_bench: %d ticks, reorder every %d ticks, perf counters "
+      "%s\n",
+      ticks, interval, has_counters ? "on" : "unavailable");
+  for (const std::size_t count : {1024u, 8192u, 32768u, 65536u}) {
+    const RunResult base = Run(count, ticks, 0);
+    const RunResult sorted = Run(count, ticks, interval);
+    std::printf(
+        "enemies=%6zu  unsorted=%8.1f us/tick  morton=%8.1f us/tick "
+        "(reorder %7.1f us each)",
+        count, base.us_per_tick, sorted.us_per_tick, sorted.reorder_us);
+    if (has_counters) {
+      std::printf("  cache-misses/tick: %9.0f -> %9.0f",
+                  static_cast<double>(base.cache_misses) / ticks,
+                  static_cast<double>(sorted.cache_misses) / ticks);
+    }
+    std::printf("\n");
+  }
+  return 0;
+}
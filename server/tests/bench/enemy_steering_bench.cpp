@@ -0,0 +1,164 @@
+// 敌人转向微基准：逐个敌人的旧式循环（找最近玩家 + 归一化 + clamp +
+// 位移阈值判断）对比 SoA 批处理内核（标量 / SSE4.2 / AVX2）。
+// 只计算最近玩家与转向两步，路点推进等标量逻辑不在此计时。
+// 用法: enemy_steering_bench [frames]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "internal/game_manager_fastmath.hpp"
+#include "internal/game_manager_steering.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using game_manager_steering::SimdLevel;
+using game_manager_steering::SteeringBatch;
+using game_manager_steering::SteerParams;
+
+constexpr float kMapW = 2000.0f;
+constexpr float kMapH = 2000.0f;
+constexpr float kDt = 1.0f / 60.0f;
+constexpr std::size_t kPlayers = 4;
+
+struct Enemy {
+  float x = 0.0f;
+  float y = 0.0f;
+  float speed = 0.0f;
+};
+
+float NextUnit(uint32_t* rng) {
+  *rng = *rng * 1664525u + 1013904223u;
+  return static_cast<float>(*rng >> 8) / static_cast<float>(1u << 24);
+}
+
+// 旧实现：每个敌人依次找最近玩家并直接朝玩家前进
+uint64_t RunPerEnemy(std::vector<Enemy>* enemies, const float* pxs,
+                     const float* pys) {
+  uint64_t moved_count = 0;
+  for (Enemy& e : *enemies) {
+    float best = std::numeric_limits<float>::infinity();
+    std::size_t target = 0;
+    for (std::size_t p = 0; p < kPlayers; ++p) {
+      const float dx = pxs[p] - e.x;
+      const float dy = pys[p] - e.y;
+      const float d = dx * dx + dy * dy;
+      if (d < best) {
+        best = d;
+        target = p;
+      }
+    }
+    const float dx = pxs[target] - e.x;
+    const float dy = pys[target] - e.y;
+    const float dist_sq = dx * dx + dy * dy;
+    if (dist_sq > 1e-6f) {
+      const float inv_len = game_manager_fastmath::FastRsqrt(dist_sq);
+      const float new_x =
+          std::clamp(e.x + dx * inv_len * e.speed * kDt, 0.0f, kMapW);
+      const float new_y =
+          std::clamp(e.y + dy * inv_len * e.speed * kDt, 0.0f, kMapH);
+      if (std::abs(new_x - e.x) > 1e-4f || std::abs(new_y - e.y) > 1e-4f) {
+        e.x = new_x;
+        e.y = new_y;
+        moved_count += 1;
+      }
+    }
+  }
+  return moved_count;
+}
+
+uint64_t RunBatched(SimdLevel level, SteeringBatch* batch) {
+  const std::size_t count = batch->xs.size();
+  game_manager_steering::NearestPlayersAt(
+      level, batch->player_xs.data(), batch->player_ys.data(), kPlayers,
+      batch->xs.data(), batch->ys.data(), count, batch->nearest_player.data());
+  for (std::size_t i = 0; i < count; ++i) {
+    const int32_t p = batch->nearest_player[i];
+    batch->goal_xs[i] = batch->player_xs[p];
+    batch->goal_ys[i] = batch->player_ys[p];
+  }
+  game_manager_steering::SteerTowardGoalsAt(level, SteerParams{kMapW, kMapH},
+                                            batch);
+  uint64_t moved_count = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (batch->moved[i] != 0) {
+      batch->xs[i] = batch->out_xs[i];
+      batch->ys[i] = batch->out_ys[i];
+      moved_count += 1;
+    }
+  }
+  return moved_count;
+}
+
+double NsPerEnemy(Clock::duration d, std::size_t enemies, int frames) {
+  return std::chrono::duration<double, std::nano>(d).count() /
+         static_cast<double>(std::max<std::size_t>(1, enemies)) /
+         static_cast<double>(std::max(1, frames));
+}
+
+void Run(std::size_t enemy_count, int frames) {
+  uint32_t rng = 31u;
+  float pxs[kPlayers];
+  float pys[kPlayers];
+  for (std::size_t p = 0; p < kPlayers; ++p) {
+    pxs[p] = NextUnit(&rng) * kMapW;
+    pys[p] = NextUnit(&rng) * kMapH;
+  }
+  std::vector<Enemy> initial(enemy_count);
+  for (auto& e : initial) {
+    e.x = NextUnit(&rng) * kMapW;
+    e.y = NextUnit(&rng) * kMapH;
+    e.speed = 40.0f + NextUnit(&rng) * 80.0f;
+  }
+
+  std::vector<Enemy> enemies = initial;
+  uint64_t moved_old = 0;
+  const auto old_begin = Clock::now();
+  for (int f = 0; f < frames; ++f) {
+    moved_old += RunPerEnemy(&enemies, pxs, pys);
+  }
+  const auto old_end = Clock::now();
+
+  std::printf("enemies=%5zu  per-enemy=%5.2f ns", enemy_count,
+              NsPerEnemy(old_end - old_begin, enemy_count, frames));
+  for (const SimdLevel level :
+       {SimdLevel::kScalar, SimdLevel::kSse42, SimdLevel::kAvx2}) {
+    SteeringBatch batch;
+    batch.player_xs.assign(pxs, pxs + kPlayers);
+    batch.player_ys.assign(pys, pys + kPlayers);
+    batch.ResizeEnemies(enemy_count);
+    for (std::size_t i = 0; i < enemy_count; ++i) {
+      batch.xs[i] = initial[i].x;
+      batch.ys[i] = initial[i].y;
+      batch.speeds[i] = initial[i].speed;
+      batch.dts[i] = kDt;
+    }
+    uint64_t moved_new = 0;
+    const auto begin = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+      moved_new += RunBatched(level, &batch);
+    }
+    const auto end = Clock::now();
+    std::printf("  %s=%5.2f ns%s", game_manager_simd::SimdLevelName(level),
+                NsPerEnemy(end - begin, enemy_count, frames),
+                moved_new == moved_old ? "" : "(MISMATCH)");
+  }
+  std::printf("\n");
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 500;
+  std::printf("enemy_steering_bench: %d frames, %zu players, detected %s\n",
+              frames, kPlayers,
+              game_manager_simd::SimdLevelName(
+                  game_manager_simd::DetectSimdLevel()));
+  for (const std::size_t count : {64u, 256u, 1024u, 4096u}) {
+    Run(count, frames);
+  }
+  return 0;
+}
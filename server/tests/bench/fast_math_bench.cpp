@@ -0,0 +1,111 @@
+// 方向换算微基准：libm（atan2 / cos+sin / 1/sqrt）对比 fastmath 的标量近似。
+// 用法: fast_math_bench [rounds]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numbers>
+#include <vector>
+
+#include "internal/game_manager_fastmath.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kCount = 4096;
+
+float NextUnit(uint32_t* rng) {
+  *rng = *rng * 1664525u + 1013904223u;
+  return static_cast<float>(*rng >> 8) / static_cast<float>(1u << 24);
+}
+
+double NsPerItem(Clock::duration d, int rounds) {
+  return std::chrono::duration<double, std::nano>(d).count() /
+         static_cast<double>(kCount) / static_cast<double>(std::max(1, rounds));
+}
+
+// 防止结果被优化掉
+volatile float g_sink = 0.0f;
+
+template <typename Fn>
+double Time(int rounds, Fn&& fn) {
+  const auto begin = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    fn();
+  }
+  return NsPerItem(Clock::now() - begin, rounds);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int rounds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+  std::printf("fast_math_bench: %zu items x %d rounds\n", kCount, rounds);
+
+  uint32_t rng = 7u;
+  std::vector<float> xs(kCount);
+  std::vector<float> ys(kCount);
+  std::vector<float> degs(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    xs[i] = (NextUnit(&rng) * 2.0f - 1.0f) * 800.0f;
+    ys[i] = (NextUnit(&rng) * 2.0f - 1.0f) * 800.0f;
+    degs[i] = NextUnit(&rng) * 360.0f - 180.0f;
+  }
+  std::vector<float> out(kCount);
+
+  const double atan2_libm = Time(rounds, [&] {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = std::atan2(ys[i], xs[i]) * 180.0f / std::numbers::pi_v<float>;
+    }
+    g_sink = out[kCount / 2];
+  });
+  const double atan2_fast = Time(rounds, [&] {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      out[i] = game_manager_fastmath::FastAtan2Deg(ys[i], xs[i]);
+    }
+    g_sink = out[kCount / 2];
+  });
+  std::printf("atan2    libm=%5.2f ns  fast=%5.2f ns\n", atan2_libm,
+              atan2_fast);
+
+  const double dir_libm = Time(rounds, [&] {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      const float rad = degs[i] * std::numbers::pi_v<float> / 180.0f;
+      out[i] = std::cos(rad) + std::sin(rad);
+    }
+    g_sink = out[kCount / 2];
+  });
+  const double dir_fast = Time(rounds, [&] {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      const auto [c, s] = game_manager_fastmath::FastDirFromDeg(degs[i]);
+      out[i] = c + s;
+    }
+    g_sink = out[kCount / 2];
+  });
+  std::printf("cos/sin  libm=%5.2f ns  fast=%5.2f ns\n", dir_libm, dir_fast);
+
+  std::vector<float> nxs(kCount);
+  std::vector<float> nys(kCount);
+  const double norm_libm = Time(rounds, [&] {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      const float len_sq = xs[i] * xs[i] + ys[i] * ys[i];
+      const float inv_len = 1.0f / std::sqrt(len_sq);
+      nxs[i] = xs[i] * inv_len;
+      nys[i] = ys[i] * inv_len;
+    }
+    g_sink = nxs[kCount / 2];
+  });
+  const double norm_fast = Time(rounds, [&] {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      const float len_sq = xs[i] * xs[i] + ys[i] * ys[i];
+      const float inv_len = game_manager_fastmath::FastRsqrt(len_sq);
+      nxs[i] = xs[i] * inv_len;
+      nys[i] = ys[i] * inv_len;
+    }
+    g_sink = nxs[kCount / 2];
+  });
+  std::printf("normalize libm=%5.2f ns  fast=%5.2f ns\n", norm_libm,
+              norm_fast);
+  return 0;
+}
@@ -0,0 +1,197 @@
+// 兴趣区域过滤：共享基线增量（整房间一份）vs 逐玩家按视野 + 余量过滤。
+// 敌人均匀分布、每个同步 tick 全部移动；8 名玩家在地图内游走。两组场景：
+// 密度不变、地图与敌人总数同步放大；地图不变、敌人加密。统计每个客户端
+// 每次同步收到的字节，并按通道拆分：UDP 为位置增量数据报；TCP 为单独成包的
+// 离开列表与进入敌人的完整 EnemyState（另走 S2C_GameStateSync，按其序列化
+// 长度计入）。另统计进入/离开个数与每个客户端的兴趣集更新 + 过滤 + 编码耗时。
+// 用法: interest_filter_bench [sync_ticks]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "internal/game_manager_interest.hpp"
+#include "internal/game_manager_spatial.hpp"
+#include "message.pb.h"
+#include "network/delta_wire.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using game_manager_interest::InterestParams;
+using game_manager_interest::InterestUpdate;
+
+constexpr int kPlayers = 8;
+constexpr float kCellSize = 100.0f;
+constexpr float kEnemyStep = 3.0f;    // 每次同步的位移（像素）
+constexpr float kPlayerStep = 6.0f;
+
+struct Rng {
+  uint64_t state;
+  uint32_t Next() {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(state >> 33);
+  }
+  float Uniform(float lo, float hi) {
+    return lo + (hi - lo) * static_cast<float>(Next() % 10000) / 10000.0f;
+  }
+};
+
+struct Body {
+  float x = 0.0f;
+  float y = 0.0f;
+  float vx = 0.0f;
+  float vy = 0.0f;
+};
+
+void Move(float width, float height, Body* body) {
+  body->x += body->vx;
+  body->y += body->vy;
+  if (body->x < 0.0f || body->x > width) {
+    body->vx = -body->vx;
+    body->x = std::clamp(body->x, 0.0f, width);
+  }
+  if (body->y < 0.0f || body->y > height) {
+    body->vy = -body->vy;
+    body->y = std::clamp(body->y, 0.0f, height);
+  }
+}
+
+std::size_t EnteredStateBytes() {
+  lawnmower::EnemyState state;
+  state.set_enemy_id(12345);
+  state.set_type_id(2);
+  state.mutable_position()->set_x(1234.5f);
+  state.mutable_position()->set_y(678.25f);
+  state.set_health(80);
+  state.set_max_health(100);
+  state.set_is_alive(true);
+  state.set_wave_id(3);
+  return state.ByteSizeLong() + 2;  // 加上 repeated 字段 tag 与长度前缀
+}
+
+void Run(float width, float height, int enemies, int ticks) {
+  Rng rng{0x2545F4914F6CDD1DULL ^ static_cast<uint64_t>(enemies)};
+  const auto make_body = [&](float speed) {
+    Body body{rng.Uniform(0.0f, width), rng.Uniform(0.0f, height), 0.0f, 0.0f};
+    body.vx = rng.Uniform(-speed, speed);
+    body.vy = rng.Uniform(-speed, speed);
+    return body;
+  };
+  std::vector<Body> enemy_bodies;
+  for (int i = 0; i < enemies; ++i) {
+    enemy_bodies.push_back(make_body(kEnemyStep));
+  }
+  std::vector<Body> players;
+  for (int i = 0; i < kPlayers; ++i) {
+    players.push_back(make_body(kPlayerStep));
+  }
+
+  const InterestParams params{640.0f, 360.0f, 128.0f};
+  const std::size_t entered_bytes = EnteredStateBytes();
+  game_manager_spatial::SpatialIndex index;
+  InterestUpdate update;
+  std::vector<std::vector<uint32_t>> interest(kPlayers);
+  delta_wire::DeltaFrame shared;
+  delta_wire::DeltaFrame filtered;
+  delta_wire::DeltaFrame leave;
+
+  double shared_bytes = 0.0;
+  double udp_bytes = 0.0;
+  double tcp_bytes = 0.0;
+  double entered = 0.0;
+  double left = 0.0;
+  double interest_size = 0.0;
+  double client_ns = 0.0;
+  int samples = 0;
+  for (int tick = 1; tick <= ticks; ++tick) {
+    index.Reset(width, height, kCellSize);
+    shared.Clear();
+    shared.has_sync_time = true;
+    shared.server_time_ms = 1'700'000'000'000ULL + tick * 33ULL;
+    shared.tick = static_cast<uint32_t>(tick);
+    shared.room_id = 1;
+    for (int i = 0; i < enemies; ++i) {
+      Body& body = enemy_bodies[static_cast<std::size_t>(i)];
+      Move(width, height, &body);
+      const auto enemy_id = static_cast<uint32_t>(1000 + i);
+      index.Insert(enemy_id, body.x, body.y);
+      shared.enemies.push_back({enemy_id, lawnmower::ENEMY_DELTA_POSITION,
+                                body.x, body.y, 0, true});
+    }
+    index.Build();
+    const std::size_t shared_size =
+        delta_wire::EncodeDatagram(shared).bytes->size();
+
+    for (int p = 0; p < kPlayers; ++p) {
+      Body& player = players[static_cast<std::size_t>(p)];
+      Move(width, height, &player);
+      auto& ids = interest[static_cast<std::size_t>(p)];
+      const auto start = Clock::now();
+      game_manager_interest::UpdateInterestSet(index, player.x, player.y,
+                                               params, ids, &update);
+      game_manager_interest::FilterDeltaFrame(shared, update, &filtered);
+      // 与服务端一致：离开列表拆成只含该字段的 TCP 增量
+      leave.Clear();
+      std::size_t leave_size = 0;
+      if (!filtered.removed_enemy_ids.empty()) {
+        leave.removed_enemy_ids.swap(filtered.removed_enemy_ids);
+        leave.has_sync_time = true;
+        leave.server_time_ms = shared.server_time_ms;
+        leave.tick = shared.tick;
+        leave.room_id = shared.room_id;
+        leave_size = delta_wire::EncodeFramed(leave).bytes->size();
+      }
+      const std::size_t size =
+          delta_wire::EncodeDatagram(filtered).bytes->size();
+      const auto end = Clock::now();
+      ids.swap(update.ids);
+      // 首个 tick 全部是进入，不计入稳态统计
+      if (tick == 1) {
+        continue;
+      }
+      client_ns += std::chrono::duration<double, std::nano>(end - start)
+                       .count();
+      shared_bytes += static_cast<double>(shared_size);
+      udp_bytes += static_cast<double>(size);
+      tcp_bytes += static_cast<double>(leave_size +
+                                       update.entered.size() * entered_bytes);
+      entered += static_cast<double>(update.entered.size());
+      left += static_cast<double>(update.left.size());
+      interest_size += static_cast<double>(ids.size());
+      ++samples;
+    }
+  }
+
+  const double n = std::max(1, samples);
+  std::printf(
+      "map=%5.0fx%-5.0f enemies=%6d  shared=%8.0f B  filtered=%6.0f B "
+      "(%5.1f%%, udp=%6.0f tcp=%5.0f)  interest=%5.1f  "
+      "enter/leave=%4.2f/%4.2f  client=%6.1f us\n",
+      width, height, enemies, shared_bytes / n, (udp_bytes + tcp_bytes) / n,
+      100.0 * (udp_bytes + tcp_bytes) / std::max(1.0, shared_bytes),
+      udp_bytes / n, tcp_bytes / n,
+      interest_size / n, entered / n, left / n, client_ns / n / 1000.0);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int ticks = argc > 1 ? std::max(2, std::atoi(argv[1])) : 200;
+  std::printf(
+      "interest_filter_bench: %d sync ticks, %d clients, per-client bytes "
+      "per sync\n",
+      ticks, kPlayers);
+  std::printf("-- 密度不变（每 100x100 像素 2 个敌人），地图放大\n");
+  for (const float scale : {1.0f, 2.0f, 4.0f, 8.0f}) {
+    const float width = 1280.0f * scale;
+    const float height = 720.0f * scale;
+    const int enemies = static_cast<int>(width * height / 5000.0f);
+    Run(width, height, enemies, ticks);
+  }
+  std::printf("-- 地图不变（5120x2880），敌人加密\n");
+  for (const int enemies : {500, 1000, 2000, 4000}) {
+    Run(5120.0f, 2880.0f, enemies, ticks);
+  }
+  return 0;
+}
@@ -0,0 +1,228 @@
+// 网格 A* 开放列表微基准：旧实现（每次新建 std::priority_queue，允许重复入堆）
+// 对比当前实现（NavScratch 内预分配的索引二叉堆 + decrease-key）。
+// 用法: nav_astar_bench [queries_per_grid]
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <numbers>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_nav.hpp"
+
+namespace {
+using game_manager_nav::NavCell;
+using game_manager_nav::NavGrid;
+using Clock = std::chrono::steady_clock;
+
+float Heuristic(const NavCell& a, const NavCell& b) {
+  const float dx = static_cast<float>(a.first - b.first);
+  const float dy = static_cast<float>(a.second - b.second);
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+// 旧实现原样保留，作为对照组
+struct LegacyScratch {
+  std::vector<int> came_from;
+  std::vector<float> g_score;
+  std::vector<uint32_t> visit_epoch;
+  std::vector<uint32_t> closed_epoch;
+  uint32_t epoch = 0;
+};
+
+bool LegacyFindPathAstar(const NavGrid& grid, const NavCell& start,
+                         const NavCell& goal, std::vector<NavCell>* out_path,
+                         LegacyScratch* s) {
+  out_path->clear();
+  const int total = grid.cells_x * grid.cells_y;
+  const std::size_t total_size = static_cast<std::size_t>(total);
+  if (s->came_from.size() != total_size) {
+    s->came_from.assign(total_size, -1);
+    s->g_score.assign(total_size, std::numeric_limits<float>::infinity());
+    s->visit_epoch.assign(total_size, 0);
+    s->closed_epoch.assign(total_size, 0);
+  }
+  const uint32_t epoch = ++s->epoch;
+  const int start_idx = start.second * grid.cells_x + start.first;
+  const int goal_idx = goal.second * grid.cells_x + goal.first;
+
+  struct OpenNode {
+    int idx = 0;
+    float f = 0.0f;
+    float g = 0.0f;
+  };
+  auto cmp = [](const OpenNode& a, const OpenNode& b) { return a.f > b.f; };
+  std::priority_queue<OpenNode, std::vector<OpenNode>, decltype(cmp)> open(cmp);
+
+  s->visit_epoch[static_cast<std::size_t>(start_idx)] = epoch;
+  s->came_from[static_cast<std::size_t>(start_idx)] = -1;
+  s->g_score[static_cast<std::size_t>(start_idx)] = 0.0f;
+  open.push(OpenNode{start_idx, Heuristic(start, goal), 0.0f});
+
+  constexpr std::array<std::pair<int, int>, 8> kDirs = {
+      {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+  bool found = false;
+  while (!open.empty()) {
+    const OpenNode cur = open.top();
+    open.pop();
+    if (cur.idx == goal_idx) {
+      found = true;
+      break;
+    }
+    const std::size_t ci = static_cast<std::size_t>(cur.idx);
+    if (s->closed_epoch[ci] == epoch || s->visit_epoch[ci] != epoch ||
+        cur.g > s->g_score[ci]) {
+      continue;
+    }
+    s->closed_epoch[ci] = epoch;
+    const int cx = cur.idx % grid.cells_x;
+    const int cy = cur.idx / grid.cells_x;
+    for (const auto& [dx, dy] : kDirs) {
+      const int nx = cx + dx;
+      const int ny = cy + dy;
+      if (nx < 0 || ny < 0 || nx >= grid.cells_x || ny >= grid.cells_y) {
+        continue;
+      }
+      const int nidx = ny * grid.cells_x + nx;
+      const std::size_t ni = static_cast<std::size_t>(nidx);
+      if (s->closed_epoch[ni] == epoch) {
+        continue;
+      }
+      const float step =
+          (dx == 0 || dy == 0) ? 1.0f : std::numbers::sqrt2_v<float>;
+      const float tentative_g = s->g_score[ci] + step;
+      const bool visited = s->visit_epoch[ni] == epoch;
+      if (!visited || tentative_g < s->g_score[ni]) {
+        s->visit_epoch[ni] = epoch;
+        s->came_from[ni] = cur.idx;
+        s->g_score[ni] = tentative_g;
+        open.push(OpenNode{nidx, tentative_g + Heuristic({nx, ny}, goal),
+                           tentative_g});
+      }
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  std::vector<int> rev;
+  rev.reserve(32);
+  int cur = goal_idx;
+  while (cur >= 0) {
+    rev.push_back(cur);
+    if (cur == start_idx) {
+      break;
+    }
+    cur = s->came_from[static_cast<std::size_t>(cur)];
+  }
+  for (auto it = rev.rbegin(); it != rev.rend(); ++it) {
+    out_path->push_back({*it % grid.cells_x, *it / grid.cells_x});
+  }
+  return true;
+}
+
+float PathCost(const std::vector<NavCell>& path) {
+  float cost = 0.0f;
+  for (std::size_t i = 1; i < path.size(); ++i) {
+    const bool straight = path[i].first == path[i - 1].first ||
+                          path[i].second == path[i - 1].second;
+    cost += straight ? 1.0f : std::numbers::sqrt2_v<float>;
+  }
+  return cost;
+}
+
+std::vector<std::pair<NavCell, NavCell>> BuildQueries(const NavGrid& grid,
+                                                      int count) {
+  // 模拟刷怪：起点在地图边缘，终点在地图中部附近（玩家位置）
+  std::vector<std::pair<NavCell, NavCell>> queries;
+  queries.reserve(static_cast<std::size_t>(count));
+  uint32_t rng = 12345u;
+  auto next = [&rng](int mod) {
+    rng = rng * 1664525u + 1013904223u;
+    return static_cast<int>((rng >> 8) % static_cast<uint32_t>(mod));
+  };
+  for (int i = 0; i < count; ++i) {
+    NavCell start;
+    switch (next(4)) {
+      case 0:
+        start = {0, next(grid.cells_y)};
+        break;
+      case 1:
+        start = {grid.cells_x - 1, next(grid.cells_y)};
+        break;
+      case 2:
+        start = {next(grid.cells_x), 0};
+        break;
+      default:
+        start = {next(grid.cells_x), grid.cells_y - 1};
+        break;
+    }
+    const NavCell goal{grid.cells_x / 4 + next(std::max(1, grid.cells_x / 2)),
+                       grid.cells_y / 4 + next(std::max(1, grid.cells_y / 2))};
+    queries.push_back({start, goal});
+  }
+  return queries;
+}
+
+void RunGrid(const char* label, const NavGrid& grid, int query_count) {
+  const auto queries = BuildQueries(grid, query_count);
+  std::vector<NavCell> path;
+  path.reserve(static_cast<std::size_t>(grid.cells_x + grid.cells_y));
+
+  LegacyScratch legacy;
+  game_manager_nav::NavScratch scratch;
+  // 预热（分配缓冲）
+  LegacyFindPathAstar(grid, queries.front().first, queries.front().second,
+                      &path, &legacy);
+  game_manager_nav::FindPathAstar(grid, queries.front().first,
+                                  queries.front().second, &path, &scratch);
+
+  double legacy_cost = 0.0;
+  const auto legacy_begin = Clock::now();
+  for (const auto& [start, goal] : queries) {
+    LegacyFindPathAstar(grid, start, goal, &path, &legacy);
+    legacy_cost += PathCost(path);
+  }
+  const auto legacy_end = Clock::now();
+
+  double heap_cost = 0.0;
+  const auto heap_begin = Clock::now();
+  for (const auto& [start, goal] : queries) {
+    game_manager_nav::FindPathAstar(grid, start, goal, &path, &scratch);
+    heap_cost += PathCost(path);
+  }
+  const auto heap_end = Clock::now();
+
+  const double legacy_ns =
+      std::chrono::duration<double, std::nano>(legacy_end - legacy_begin)
+          .count() /
+      query_count;
+  const double heap_ns =
+      std::chrono::duration<double, std::nano>(heap_end - heap_begin).count() /
+      query_count;
+  std::printf(
+      "%-22s cells=%6d  legacy_pq=%9.0f ns/query  indexed_heap=%9.0f "
+      "ns/query  speedup=%.2fx  cost_diff=%.3f\n",
+      label, grid.cells_x * grid.cells_y, legacy_ns, heap_ns,
+      heap_ns > 0.0 ? legacy_ns / heap_ns : 0.0,
+      std::fabs(legacy_cost - heap_cost));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int query_count = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+  std::printf("nav_astar_bench: %d queries per grid\n", query_count);
+  RunGrid("1280x720 (13x8)", NavGrid{13, 8, 100}, query_count);
+  RunGrid("2000x2000 (20x20)", NavGrid{20, 20, 100}, query_count);
+  RunGrid("6400x6400 (64x64)", NavGrid{64, 64, 100}, query_count);
+  RunGrid("12800x12800 (128x128)", NavGrid{128, 128, 100},
+          std::max(1, query_count / 10));
+  return 0;
+}
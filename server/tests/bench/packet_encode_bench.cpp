@@ -0,0 +1,93 @@
+// 出站包编码微基准：旧写法（message 序列化 -> Packet.payload -> Packet
+// 再序列化 -> 拷进带包长的帧）对比 packet_codec 单次写入。
+// 用法: packet_encode_bench [rounds]
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "message.pb.h"
+#include "network/packet_codec.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+std::shared_ptr<const std::string> LegacyFramed(
+    lawnmower::MessageType type, const google::protobuf::Message& message) {
+  lawnmower::Packet packet;
+  packet.set_msg_type(type);
+  const std::string payload = message.SerializeAsString();
+  packet.set_payload(payload);
+  const std::string body = packet.SerializeAsString();
+  const uint32_t net_len = htonl(static_cast<uint32_t>(body.size()));
+  std::string framed;
+  framed.resize(sizeof(net_len) + body.size());
+  std::memcpy(framed.data(), &net_len, sizeof(net_len));
+  std::memcpy(framed.data() + sizeof(net_len), body.data(), body.size());
+  return std::make_shared<std::string>(std::move(framed));
+}
+
+lawnmower::S2C_GameStateSync BuildSync(int enemies) {
+  lawnmower::S2C_GameStateSync sync;
+  sync.set_room_id(1);
+  sync.mutable_sync_time()->set_tick(1000);
+  for (int i = 0; i < enemies; ++i) {
+    auto* enemy = sync.add_enemies();
+    enemy->set_enemy_id(static_cast<uint32_t>(i + 1));
+    enemy->set_type_id(static_cast<uint32_t>(i % 4));
+    enemy->mutable_position()->set_x(static_cast<float>(i % 97) * 13.0f);
+    enemy->mutable_position()->set_y(static_cast<float>(i % 89) * 11.0f);
+    enemy->set_health(50 + i % 50);
+    enemy->set_max_health(100);
+    enemy->set_is_alive(true);
+    enemy->set_wave_id(static_cast<uint32_t>(i / 64));
+  }
+  return sync;
+}
+
+double NsPerPacket(Clock::duration d, int rounds) {
+  return std::chrono::duration<double, std::nano>(d).count() /
+         static_cast<double>(std::max(1, rounds));
+}
+
+void Run(int enemies, int rounds) {
+  const auto sync = BuildSync(enemies);
+  constexpr auto kType = lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC;
+  std::size_t sink = 0;
+
+  const auto legacy_begin = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    sink += LegacyFramed(kType, sync)->size();
+  }
+  const auto legacy_end = Clock::now();
+
+  const auto codec_begin = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    sink += packet_codec::EncodeFramed(kType, sync).bytes->size();
+  }
+  const auto codec_end = Clock::now();
+
+  const bool same = *LegacyFramed(kType, sync) ==
+                    *packet_codec::EncodeFramed(kType, sync).bytes;
+  std::printf("enemies=%5d  bytes=%7zu  legacy=%9.0f ns  codec=%9.0f ns%s\n",
+              enemies, sink / (2 * static_cast<std::size_t>(rounds)),
+              NsPerPacket(legacy_end - legacy_begin, rounds),
+              NsPerPacket(codec_end - codec_begin, rounds),
+              same ? "" : "  (MISMATCH)");
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int rounds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+  std::printf("packet_encode_bench: %d rounds\n", rounds);
+  for (const int enemies : {16, 128, 512, 2048}) {
+    Run(enemies, rounds);
+  }
+  return 0;
+}
@@ -0,0 +1,182 @@
+// 射弹命中检测微基准：模拟射弹阶段第一步（逐发推进 + 对 CSR 敌人网格求
+// 最早命中），对比串行与 ParallelForPool 不同 worker 数的每 tick 耗时。
+// 网格与查询方式与服务端一致（按行批量调用 EarliestSegmentCircleHit）。
+// 用法: projectile_hit_bench [ticks]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "internal/game_manager_collision.hpp"
+#include "internal/game_manager_parallel.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using game_manager_collision::Segment;
+using game_manager_parallel::ParallelForPool;
+
+constexpr float kMapW = 4000.0f;
+constexpr float kMapH = 4000.0f;
+constexpr float kCellSize = 100.0f;
+constexpr float kRadius = 22.0f;  // 射弹半径 + 敌人碰撞半径
+constexpr float kStep = 420.0f / 60.0f;
+constexpr std::size_t kEnemies = 4096;
+constexpr std::size_t kChunk = 32;
+
+volatile uint64_t g_sink = 0;  // 防止计算被优化掉
+
+struct Grid {
+  int cells_x = 0;
+  int cells_y = 0;
+  std::vector<uint32_t> cell_start;
+  std::vector<float> xs;
+  std::vector<float> ys;
+};
+
+struct Shot {
+  float x = 0.0f;
+  float y = 0.0f;
+  float dir_x = 1.0f;
+  float dir_y = 0.0f;
+  int32_t hit = -1;
+  float hit_t = 0.0f;
+};
+
+uint32_t NextRng(uint32_t* state) {
+  *state = (*state * 1664525u) + 1013904223u;
+  return *state;
+}
+
+float NextUnit(uint32_t* state) {
+  return static_cast<float>(NextRng(state) >> 8) / 16777216.0f;
+}
+
+int CellOf(float v, int cells) {
+  return std::clamp(static_cast<int>(std::floor(v / kCellSize)), 0, cells - 1);
+}
+
+Grid BuildGrid(uint32_t* rng) {
+  Grid grid;
+  grid.cells_x = static_cast<int>(std::ceil(kMapW / kCellSize));
+  grid.cells_y = static_cast<int>(std::ceil(kMapH / kCellSize));
+  const std::size_t cells =
+      static_cast<std::size_t>(grid.cells_x * grid.cells_y);
+  std::vector<float> xs(kEnemies);
+  std::vector<float> ys(kEnemies);
+  std::vector<uint32_t> cell_of(kEnemies);
+  grid.cell_start.assign(cells + 1, 0);
+  for (std::size_t i = 0; i < kEnemies; ++i) {
+    xs[i] = NextUnit(rng) * kMapW;
+    ys[i] = NextUnit(rng) * kMapH;
+    cell_of[i] = static_cast<uint32_t>(
+        CellOf(ys[i], grid.cells_y) * grid.cells_x +
+        CellOf(xs[i], grid.cells_x));
+    grid.cell_start[cell_of[i] + 1] += 1;
+  }
+  for (std::size_t c = 1; c <= cells; ++c) {
+    grid.cell_start[c] += grid.cell_start[c - 1];
+  }
+  std::vector<uint32_t> cursor(grid.cell_start.begin(),
+                               grid.cell_start.end() - 1);
+  grid.xs.resize(kEnemies);
+  grid.ys.resize(kEnemies);
+  for (std::size_t i = 0; i < kEnemies; ++i) {
+    const uint32_t slot = cursor[cell_of[i]]++;
+    grid.xs[slot] = xs[i];
+    grid.ys[slot] = ys[i];
+  }
+  return grid;
+}
+
+void StepShot(const Grid& grid, Shot* shot) {
+  const Segment seg{shot->x, shot->y, shot->x + shot->dir_x * kStep,
+                    shot->y + shot->dir_y * kStep};
+  shot->x = seg.bx;
+  shot->y = seg.by;
+  const int x0 = CellOf(std::min(seg.ax, seg.bx) - kRadius, grid.cells_x);
+  const int x1 = CellOf(std::max(seg.ax, seg.bx) + kRadius, grid.cells_x);
+  const int y0 = CellOf(std::min(seg.ay, seg.by) - kRadius, grid.cells_y);
+  const int y1 = CellOf(std::max(seg.ay, seg.by) + kRadius, grid.cells_y);
+  float best_t = std::numeric_limits<float>::infinity();
+  shot->hit = -1;
+  for (int cy = y0; cy <= y1; ++cy) {
+    const std::size_t row = static_cast<std::size_t>(cy * grid.cells_x);
+    const std::size_t begin =
+        grid.cell_start[row + static_cast<std::size_t>(x0)];
+    const std::size_t end =
+        grid.cell_start[row + static_cast<std::size_t>(x1) + 1];
+    float t = 0.0f;
+    const std::ptrdiff_t idx = game_manager_collision::EarliestSegmentCircleHit(
+        seg, grid.xs.data() + begin, grid.ys.data() + begin, end - begin,
+        kRadius, &t);
+    if (idx >= 0 && t < best_t) {
+      best_t = t;
+      shot->hit = static_cast<int32_t>(begin + static_cast<std::size_t>(idx));
+    }
+  }
+  shot->hit_t = best_t;
+}
+
+std::vector<Shot> MakeShots(std::size_t count, uint32_t* rng) {
+  std::vector<Shot> shots(count);
+  for (auto& shot : shots) {
+    shot.x = NextUnit(rng) * kMapW;
+    shot.y = NextUnit(rng) * kMapH;
+    const float angle = NextUnit(rng) * 6.2831853f;
+    shot.dir_x = std::cos(angle);
+    shot.dir_y = std::sin(angle);
+  }
+  return shots;
+}
+
+double UsPerTick(const Grid& grid, std::size_t count, int ticks,
+                 ParallelForPool* pool) {
+  uint32_t rng = 7;
+  std::vector<Shot> shots = MakeShots(count, &rng);
+  auto run = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      StepShot(grid, &shots[i]);
+    }
+  };
+  const auto begin = Clock::now();
+  for (int t = 0; t < ticks; ++t) {
+    if (pool != nullptr) {
+      pool->Run(shots.size(), kChunk, run);
+    } else {
+      run(0, shots.size());
+    }
+  }
+  const auto end = Clock::now();
+  uint64_t hits = 0;
+  for (const auto& shot : shots) {
+    hits += shot.hit >= 0 ? 1u : 0u;
+  }
+  g_sink = g_sink + hits;
+  return std::chrono::duration<double, std::micro>(end - begin).count() / ticks;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int ticks = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+  uint32_t rng = 1;
+  const Grid grid = BuildGrid(&rng);
+  ParallelForPool pool1(1);
+  ParallelForPool pool3(3);
+  std::printf("projectile_hit_bench: %d ticks, %zu enemies, hw threads=%u\n",
+              ticks, kEnemies, std::thread::hardware_concurrency());
+  for (const std::size_t count : {128u, 512u, 2048u, 8192u}) {
+    const double serial = UsPerTick(grid, count, ticks, nullptr);
+    const double two = UsPerTick(grid, count, ticks, &pool1);
+    const double four = UsPerTick(grid, count, ticks, &pool3);
+    std::printf(
+        "projectiles=%5zu  serial=%8.1f us  2 threads=%8.1f us  "
+        "4 threads=%8.1f us\n",
+        count, serial, two, four);
+  }
+  return 0;
+}
@@ -0,0 +1,109 @@
+// 房间广播微基准：逐会话 SendProto（每个接收者各编码一次）对比
+// 编码一次、各会话写队列共享同一块帧缓冲。写队列用 deque 模拟，
+// 只计 CPU（编码 + 入队），不含 socket 写。
+// 用法: room_broadcast_bench [rounds]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "message.pb.h"
+#include "network/packet_codec.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using WriteQueue = std::deque<std::shared_ptr<const std::string>>;
+
+lawnmower::S2C_EnemyDied BuildEnemyDied() {
+  lawnmower::S2C_EnemyDied died;
+  died.set_enemy_id(4242);
+  died.set_killer_player_id(3);
+  died.mutable_position()->set_x(640.0f);
+  died.mutable_position()->set_y(360.0f);
+  return died;
+}
+
+lawnmower::S2C_GameStateSync BuildSync(int enemies) {
+  lawnmower::S2C_GameStateSync sync;
+  sync.set_room_id(1);
+  sync.set_is_full_snapshot(true);
+  sync.mutable_sync_time()->set_tick(1000);
+  for (int i = 0; i < enemies; ++i) {
+    auto* enemy = sync.add_enemies();
+    enemy->set_enemy_id(static_cast<uint32_t>(i + 1));
+    enemy->set_type_id(static_cast<uint32_t>(i % 4));
+    enemy->mutable_position()->set_x(static_cast<float>(i % 97) * 13.0f);
+    enemy->mutable_position()->set_y(static_cast<float>(i % 89) * 11.0f);
+    enemy->set_health(50 + i % 50);
+    enemy->set_max_health(100);
+    enemy->set_is_alive(true);
+  }
+  return sync;
+}
+
+// 旧路径：每个接收者各自编码
+void PerSession(std::vector<WriteQueue>* queues, lawnmower::MessageType type,
+                const google::protobuf::Message& message) {
+  for (auto& queue : *queues) {
+    queue.push_back(packet_codec::EncodeFramed(type, message).bytes);
+  }
+}
+
+// 新路径：编码一次，共享缓冲
+void EncodeOnce(std::vector<WriteQueue>* queues, lawnmower::MessageType type,
+                const google::protobuf::Message& message) {
+  const auto packet = packet_codec::EncodeFramed(type, message);
+  for (auto& queue : *queues) {
+    queue.push_back(packet.bytes);
+  }
+}
+
+template <typename Fn>
+double NsPerBroadcast(std::size_t recipients, int rounds, Fn&& fn) {
+  std::vector<WriteQueue> queues(recipients);
+  const auto begin = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    fn(&queues);
+    // 模拟写完成出队，队列长度保持稳定
+    for (auto& queue : queues) {
+      queue.pop_front();
+    }
+  }
+  return std::chrono::duration<double, std::nano>(Clock::now() - begin)
+             .count() /
+         static_cast<double>(std::max(1, rounds));
+}
+
+void Run(const char* label, lawnmower::MessageType type,
+         const google::protobuf::Message& message, int rounds) {
+  for (const std::size_t recipients : {4u, 64u}) {
+    const double legacy =
+        NsPerBroadcast(recipients, rounds, [&](std::vector<WriteQueue>* q) {
+          PerSession(q, type, message);
+        });
+    const double once =
+        NsPerBroadcast(recipients, rounds, [&](std::vector<WriteQueue>* q) {
+          EncodeOnce(q, type, message);
+        });
+    std::printf("%-12s bytes=%6zu recipients=%2zu  per-session=%9.0f ns  "
+                "encode-once=%9.0f ns  (%.1fx)\n",
+                label, message.ByteSizeLong(), recipients, legacy, once,
+                once > 0.0 ? legacy / once : 0.0);
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int rounds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+  std::printf("room_broadcast_bench: %d rounds\n", rounds);
+  Run("enemy_died", lawnmower::MessageType::MSG_S2C_ENEMY_DIED,
+      BuildEnemyDied(), rounds);
+  Run("sync_256", lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC,
+      BuildSync(256), rounds);
+  return 0;
+}
@@ -0,0 +1,152 @@
+// 最近邻目标获取微基准：旧实现（遍历 unordered_map 全部敌人）
+// 对比 SpatialIndex（每帧重建一次 + 逐圈扩展查询）。
+// 场景：N 个敌人 + 4 名玩家；玩家找最近敌人，敌人找最近玩家。
+// 用法: spatial_query_bench [frames]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "internal/game_manager_spatial.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using game_manager_spatial::SpatialHit;
+using game_manager_spatial::SpatialIndex;
+
+struct Pos {
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+constexpr float kMapW = 2000.0f;
+constexpr float kMapH = 2000.0f;
+constexpr float kCellSize = 100.0f;
+constexpr std::size_t kPlayers = 4;
+
+std::unordered_map<uint32_t, Pos> BuildEntities(std::size_t count,
+                                                uint32_t seed) {
+  std::unordered_map<uint32_t, Pos> out;
+  out.reserve(count);
+  uint32_t rng = seed;
+  auto next_unit = [&rng]() {
+    rng = rng * 1664525u + 1013904223u;
+    return static_cast<float>(rng >> 8) / static_cast<float>(1u << 24);
+  };
+  for (std::size_t i = 0; i < count; ++i) {
+    out.emplace(static_cast<uint32_t>(i + 1),
+                Pos{next_unit() * kMapW, next_unit() * kMapH});
+  }
+  return out;
+}
+
+uint32_t LinearNearest(const std::unordered_map<uint32_t, Pos>& entities,
+                       float x, float y) {
+  float best = std::numeric_limits<float>::infinity();
+  uint32_t best_id = 0;
+  for (const auto& [id, p] : entities) {
+    const float dx = p.x - x;
+    const float dy = p.y - y;
+    const float d = dx * dx + dy * dy;
+    if (d < best) {
+      best = d;
+      best_id = id;
+    }
+  }
+  return best_id;
+}
+
+void RebuildIndex(const std::unordered_map<uint32_t, Pos>& entities,
+                  SpatialIndex* index) {
+  index->Reset(kMapW, kMapH, kCellSize);
+  for (const auto& [id, p] : entities) {
+    index->Insert(id, p.x, p.y);
+  }
+  index->Build();
+}
+
+double NsPer(Clock::duration d, std::size_t n) {
+  return std::chrono::duration<double, std::nano>(d).count() /
+         static_cast<double>(std::max<std::size_t>(1, n));
+}
+
+void Run(std::size_t enemy_count, int frames) {
+  const auto enemies = BuildEntities(enemy_count, 17u);
+  const auto players = BuildEntities(kPlayers, 91u);
+  SpatialIndex enemy_index;
+  SpatialIndex player_index;
+  uint64_t checksum_linear = 0;
+  uint64_t checksum_index = 0;
+
+  // 玩家 -> 最近敌人
+  const auto p_lin_begin = Clock::now();
+  for (int f = 0; f < frames; ++f) {
+    for (const auto& [_, p] : players) {
+      checksum_linear += LinearNearest(enemies, p.x, p.y);
+    }
+  }
+  const auto p_lin_end = Clock::now();
+  // 重建：服务端在敌人移动循环中顺带 Insert，这里单独计时 Reset+Insert+Build
+  const auto build_begin = Clock::now();
+  for (int f = 0; f < frames; ++f) {
+    RebuildIndex(enemies, &enemy_index);
+  }
+  const auto build_end = Clock::now();
+  const auto p_idx_begin = Clock::now();
+  for (int f = 0; f < frames; ++f) {
+    for (const auto& [_, p] : players) {
+      SpatialHit hit;
+      enemy_index.Nearest(p.x, p.y, &hit);
+      checksum_index += hit.id;
+    }
+  }
+  const auto p_idx_end = Clock::now();
+
+  // 敌人 -> 最近玩家
+  const auto e_lin_begin = Clock::now();
+  for (int f = 0; f < frames; ++f) {
+    for (const auto& [_, e] : enemies) {
+      checksum_linear += LinearNearest(players, e.x, e.y);
+    }
+  }
+  const auto e_lin_end = Clock::now();
+  const auto e_idx_begin = Clock::now();
+  for (int f = 0; f < frames; ++f) {
+    RebuildIndex(players, &player_index);
+    for (const auto& [_, e] : enemies) {
+      SpatialHit hit;
+      player_index.Nearest(e.x, e.y, &hit);
+      checksum_index += hit.id;
+    }
+  }
+  const auto e_idx_end = Clock::now();
+
+  const std::size_t player_queries = static_cast<std::size_t>(frames) * kPlayers;
+  const std::size_t enemy_queries =
+      static_cast<std::size_t>(frames) * enemy_count;
+  std::printf(
+      "enemies=%5zu  rebuild=%8.0f ns/frame | player->enemy: linear=%8.0f "
+      "ns/query  index=%6.0f ns/query | enemy->player: linear=%6.1f "
+      "ns/query  index=%6.1f ns/query  match=%s\n",
+      enemy_count, NsPer(build_end - build_begin, frames),
+      NsPer(p_lin_end - p_lin_begin, player_queries),
+      NsPer(p_idx_end - p_idx_begin, player_queries),
+      NsPer(e_lin_end - e_lin_begin, enemy_queries),
+      NsPer(e_idx_end - e_idx_begin, enemy_queries),
+      checksum_linear == checksum_index ? "yes" : "NO");
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+  std::printf("spatial_query_bench: %d frames, %zu players, map %.0fx%.0f\n",
+              frames, kPlayers, kMapW, kMapH);
+  for (const std::size_t count : {256u, 2048u, 4096u, 8192u}) {
+    Run(count, frames);
+  }
+  return 0;
+}
@@ -0,0 +1,280 @@
+// 单 tick 事件下发对比：旧路径逐条发送（射弹/掉落/攻击态/受伤/死亡/升级
+// 各一条 Packet）对比 S2C_TickEvents 合包。按 60Hz、每接收者统计
+// 消息数/秒、字节数/秒（含 4 字节包长），并给出单 tick 编码耗时。
+// 用法: tick_events_bench [rounds]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "message.pb.h"
+#include "network/packet_codec.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr double kTickRate = 60.0;
+
+struct TickScenario {
+  const char* label;
+  int projectile_spawns;
+  int projectile_despawns;
+  int dropped_items;
+  int attack_states;
+  int player_hurts;
+  int enemy_dieds;
+  int level_ups;
+};
+
+struct TickCost {
+  std::size_t messages = 0;
+  std::size_t bytes = 0;
+};
+
+void FillSyncTime(lawnmower::Timestamp* ts) {
+  ts->set_server_time(1700000000000ULL);
+  ts->set_tick(36000);
+}
+
+lawnmower::ProjectileState BuildSpawn(int i) {
+  lawnmower::ProjectileState spawn;
+  spawn.set_projectile_id(static_cast<uint32_t>(10000 + i));
+  spawn.set_owner_player_id(static_cast<uint32_t>(1 + i % 4));
+  spawn.mutable_position()->set_x(400.0f + static_cast<float>(i) * 3.5f);
+  spawn.mutable_position()->set_y(300.0f - static_cast<float>(i) * 2.25f);
+  spawn.set_rotation(static_cast<float>(i * 37 % 360));
+  spawn.set_ttl_ms(1500);
+  spawn.mutable_projectile()->set_speed(600);
+  spawn.mutable_projectile()->set_is_friendly(true);
+  spawn.mutable_projectile()->set_damage(12);
+  return spawn;
+}
+
+lawnmower::ProjectileDespawn BuildDespawn(int i) {
+  lawnmower::ProjectileDespawn despawn;
+  despawn.set_projectile_id(static_cast<uint32_t>(9000 + i));
+  despawn.set_reason(lawnmower::PROJECTILE_DESPAWN_HIT);
+  despawn.set_hit_enemy_id(static_cast<uint32_t>(500 + i));
+  despawn.mutable_position()->set_x(700.0f + static_cast<float>(i));
+  despawn.mutable_position()->set_y(200.0f + static_cast<float>(i));
+  return despawn;
+}
+
+lawnmower::ItemState BuildItem(int i) {
+  lawnmower::ItemState item;
+  item.set_item_id(static_cast<uint32_t>(300 + i));
+  item.set_type_id(static_cast<uint32_t>(1 + i % 3));
+  item.mutable_position()->set_x(512.0f + static_cast<float>(i) * 8.0f);
+  item.mutable_position()->set_y(256.0f);
+  return item;
+}
+
+lawnmower::EnemyAttackStateDelta BuildAttack(int i) {
+  lawnmower::EnemyAttackStateDelta delta;
+  delta.set_enemy_id(static_cast<uint32_t>(600 + i));
+  delta.set_is_attacking(i % 2 == 0);
+  delta.set_target_player_id(static_cast<uint32_t>(1 + i % 4));
+  return delta;
+}
+
+lawnmower::S2C_PlayerHurt BuildHurt(int i) {
+  lawnmower::S2C_PlayerHurt hurt;
+  hurt.set_player_id(static_cast<uint32_t>(1 + i % 4));
+  hurt.set_damage(7);
+  hurt.set_remaining_health(80 - i);
+  hurt.set_source_id(static_cast<uint32_t>(600 + i));
+  return hurt;
+}
+
+lawnmower::S2C_EnemyDied BuildDied(int i) {
+  lawnmower::S2C_EnemyDied died;
+  died.set_enemy_id(static_cast<uint32_t>(500 + i));
+  died.set_killer_player_id(static_cast<uint32_t>(1 + i % 4));
+  died.set_wave_id(3);
+  died.mutable_position()->set_x(700.0f + static_cast<float>(i));
+  died.mutable_position()->set_y(200.0f + static_cast<float>(i));
+  return died;
+}
+
+lawnmower::S2C_PlayerLevelUp BuildLevelUp(int i) {
+  lawnmower::S2C_PlayerLevelUp level_up;
+  level_up.set_player_id(static_cast<uint32_t>(1 + i % 4));
+  level_up.set_new_level(5);
+  level_up.set_exp_to_next(240);
+  return level_up;
+}
+
+template <typename T, typename Builder>
+std::vector<T> BuildMany(int count, Builder&& build) {
+  std::vector<T> out;
+  out.reserve(static_cast<std::size_t>(std::max(0, count)));
+  for (int i = 0; i < count; ++i) {
+    out.push_back(build(i));
+  }
+  return out;
+}
+
+struct TickInput {
+  std::vector<lawnmower::ProjectileState> spawns;
+  std::vector<lawnmower::ProjectileDespawn> despawns;
+  std::vector<lawnmower::ItemState> items;
+  std::vector<lawnmower::EnemyAttackStateDelta> attacks;
+  std::vector<lawnmower::S2C_PlayerHurt> hurts;
+  std::vector<lawnmower::S2C_EnemyDied> dieds;
+  std::vector<lawnmower::S2C_PlayerLevelUp> level_ups;
+};
+
+TickInput BuildInput(const TickScenario& s) {
+  TickInput in;
+  in.spawns = BuildMany<lawnmower::ProjectileState>(s.projectile_spawns,
+                                                    BuildSpawn);
+  in.despawns = BuildMany<lawnmower::ProjectileDespawn>(s.projectile_despawns,
+                                                        BuildDespawn);
+  in.items = BuildMany<lawnmower::ItemState>(s.dropped_items, BuildItem);
+  in.attacks = BuildMany<lawnmower::EnemyAttackStateDelta>(s.attack_states,
+                                                           BuildAttack);
+  in.hurts = BuildMany<lawnmower::S2C_PlayerHurt>(s.player_hurts, BuildHurt);
+  in.dieds = BuildMany<lawnmower::S2C_EnemyDied>(s.enemy_dieds, BuildDied);
+  in.level_ups =
+      BuildMany<lawnmower::S2C_PlayerLevelUp>(s.level_ups, BuildLevelUp);
+  return in;
+}
+
+void Add(TickCost* cost, lawnmower::MessageType type,
+         const google::protobuf::MessageLite& message) {
+  const auto packet = packet_codec::EncodeFramed(type, message);
+  if (packet.bytes == nullptr) {
+    return;
+  }
+  ++cost->messages;
+  cost->bytes += packet.bytes->size();
+}
+
+// 旧路径：与 event_dispatch 逐条发送时的消息组织方式一致
+TickCost Legacy(const TickInput& in) {
+  TickCost cost;
+  if (!in.spawns.empty()) {
+    lawnmower::S2C_ProjectileSpawn msg;
+    msg.set_room_id(1);
+    FillSyncTime(msg.mutable_sync_time());
+    for (const auto& spawn : in.spawns) {
+      *msg.add_projectiles() = spawn;
+    }
+    Add(&cost, lawnmower::MessageType::MSG_S2C_PROJECTILE_SPAWN, msg);
+  }
+  if (!in.despawns.empty()) {
+    lawnmower::S2C_ProjectileDespawn msg;
+    msg.set_room_id(1);
+    FillSyncTime(msg.mutable_sync_time());
+    for (const auto& despawn : in.despawns) {
+      *msg.add_projectiles() = despawn;
+    }
+    Add(&cost, lawnmower::MessageType::MSG_S2C_PROJECTILE_DESPAWN, msg);
+  }
+  if (!in.items.empty()) {
+    lawnmower::S2C_DroppedItem msg;
+    msg.set_room_id(1);
+    FillSyncTime(msg.mutable_sync_time());
+    msg.set_wave_id(3);
+    for (const auto& item : in.items) {
+      *msg.add_items() = item;
+    }
+    Add(&cost, lawnmower::MessageType::MSG_S2C_DROPPED_ITEM, msg);
+  }
+  if (!in.attacks.empty()) {
+    lawnmower::S2C_EnemyAttackStateSync msg;
+    msg.set_room_id(1);
+    FillSyncTime(msg.mutable_sync_time());
+    for (const auto& delta : in.attacks) {
+      *msg.add_enemies() = delta;
+    }
+    Add(&cost, lawnmower::MessageType::MSG_S2C_ENEMY_ATTACK_STATE_SYNC, msg);
+  }
+  for (const auto& hurt : in.hurts) {
+    Add(&cost, lawnmower::MessageType::MSG_S2C_PLAYER_HURT, hurt);
+  }
+  for (const auto& died : in.dieds) {
+    Add(&cost, lawnmower::MessageType::MSG_S2C_ENEMY_DIED, died);
+  }
+  for (const auto& level_up : in.level_ups) {
+    Add(&cost, lawnmower::MessageType::MSG_S2C_PLAYER_LEVEL_UP, level_up);
+  }
+  return cost;
+}
+
+TickCost Envelope(const TickInput& in) {
+  lawnmower::S2C_TickEvents msg;
+  msg.set_room_id(1);
+  FillSyncTime(msg.mutable_sync_time());
+  if (!in.items.empty()) {
+    msg.set_wave_id(3);
+  }
+  for (const auto& spawn : in.spawns) {
+    *msg.add_projectile_spawns() = spawn;
+  }
+  for (const auto& despawn : in.despawns) {
+    *msg.add_projectile_despawns() = despawn;
+  }
+  for (const auto& item : in.items) {
+    *msg.add_dropped_items() = item;
+  }
+  for (const auto& delta : in.attacks) {
+    *msg.add_enemy_attack_states() = delta;
+  }
+  for (const auto& hurt : in.hurts) {
+    *msg.add_player_hurts() = hurt;
+  }
+  for (const auto& died : in.dieds) {
+    *msg.add_enemy_dieds() = died;
+  }
+  for (const auto& level_up : in.level_ups) {
+    *msg.add_level_ups() = level_up;
+  }
+  TickCost cost;
+  Add(&cost, lawnmower::MessageType::MSG_S2C_TICK_EVENTS, msg);
+  return cost;
+}
+
+template <typename Fn>
+double NsPerTick(const TickInput& in, int rounds, Fn&& fn) {
+  std::size_t sink = 0;
+  const auto begin = Clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    sink += fn(in).bytes;
+  }
+  const double ns =
+      std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+  return sink > 0 ? ns / static_cast<double>(std::max(1, rounds)) : 0.0;
+}
+
+void Run(const TickScenario& scenario, int rounds) {
+  const TickInput in = BuildInput(scenario);
+  const TickCost legacy = Legacy(in);
+  const TickCost envelope = Envelope(in);
+  std::printf("%-8s legacy:   %6.0f msg/s %9.0f B/s  %7.0f ns/tick\n",
+              scenario.label, static_cast<double>(legacy.messages) * kTickRate,
+              static_cast<double>(legacy.bytes) * kTickRate,
+              NsPerTick(in, rounds, Legacy));
+  std::printf("%-8s envelope: %6.0f msg/s %9.0f B/s  %7.0f ns/tick\n", "",
+              static_cast<double>(envelope.messages) * kTickRate,
+              static_cast<double>(envelope.bytes) * kTickRate,
+              NsPerTick(in, rounds, Envelope));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int rounds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+  std::printf("tick_events_bench: %d rounds, %.0f Hz, per recipient\n", rounds,
+              kTickRate);
+  const TickScenario scenarios[] = {
+      {"quiet", 1, 1, 0, 0, 0, 0, 0},
+      {"combat", 4, 4, 1, 2, 1, 3, 0},
+      {"busy", 12, 10, 4, 6, 3, 8, 1},
+  };
+  for (const auto& scenario : scenarios) {
+    Run(scenario, rounds);
+  }
+  return 0;
+}
@@ -0,0 +1,148 @@
+// 加权抽样微基准：对比旧写法（每次重建候选表 + 取模累加查找；升级选项
+// 用 erase 做不放回抽取）与预编译别名表（O(1) 抽样、重抽去重）的单次耗时。
+// 随机数生成器与服务端一致（LCG）。
+// 用法: weighted_pick_bench [draws]
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_alias.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using game_manager_alias::AliasTable;
+
+constexpr std::size_t kUpgradeOptions = 3;
+
+volatile uint64_t g_sink = 0;  // 防止计算被优化掉
+
+uint32_t NextRng(uint32_t* state) {
+  *state = (*state * 1664525u) + 1013904223u;
+  return *state;
+}
+
+std::vector<uint32_t> MakeWeights(std::size_t count) {
+  std::vector<uint32_t> weights(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    weights[i] = 1 + static_cast<uint32_t>((i * 37) % 50);
+  }
+  return weights;
+}
+
+template <typename Fn>
+double NsPerDraw(int draws, Fn&& fn) {
+  const auto begin = Clock::now();
+  for (int i = 0; i < draws; ++i) {
+    fn();
+  }
+  const auto end = Clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() / draws;
+}
+
+// 旧掉落写法：每次从类型表重建 (type_id, weight) 列表后累加查找
+double LegacyDrop(const std::unordered_map<uint32_t, uint32_t>& types,
+                  int draws) {
+  uint32_t rng = 1;
+  return NsPerDraw(draws, [&] {
+    std::vector<std::pair<uint32_t, uint32_t>> candidates;
+    candidates.reserve(types.size());
+    uint32_t total = 0;
+    for (const auto& [type_id, weight] : types) {
+      candidates.emplace_back(type_id, weight);
+      total += weight;
+    }
+    const uint32_t roll = NextRng(&rng) % total;
+    uint32_t accum = 0;
+    for (const auto& [type_id, weight] : candidates) {
+      accum += weight;
+      if (roll < accum) {
+        g_sink = g_sink + type_id;
+        return;
+      }
+    }
+  });
+}
+
+double AliasDrop(const AliasTable& table, const std::vector<uint32_t>& ids,
+                 int draws) {
+  uint32_t rng = 1;
+  return NsPerDraw(draws, [&] {
+    g_sink = g_sink + ids[table.Sample(NextRng(&rng))];
+  });
+}
+
+// 旧升级写法：候选下标表 + 每次重算总权重 + erase
+double LegacyUpgrade(const std::vector<uint32_t>& weights, int draws) {
+  uint32_t rng = 1;
+  return NsPerDraw(draws, [&] {
+    std::vector<std::size_t> candidates(weights.size());
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+      candidates[i] = i;
+    }
+    for (std::size_t n = 0; n < kUpgradeOptions; ++n) {
+      uint64_t total = 0;
+      for (const std::size_t idx : candidates) {
+        total += weights[idx];
+      }
+      uint64_t roll = NextRng(&rng) % total;
+      std::size_t pos = 0;
+      for (; pos + 1 < candidates.size(); ++pos) {
+        if (roll < weights[candidates[pos]]) {
+          break;
+        }
+        roll -= weights[candidates[pos]];
+      }
+      g_sink = g_sink + candidates[pos];
+      candidates.erase(candidates.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+  });
+}
+
+double AliasUpgrade(const AliasTable& table, int draws) {
+  uint32_t rng = 1;
+  return NsPerDraw(draws, [&] {
+    std::array<std::size_t, kUpgradeOptions> drawn{};
+    std::size_t count = 0;
+    while (count < kUpgradeOptions) {
+      const std::size_t idx = table.Sample(NextRng(&rng));
+      if (std::find(drawn.begin(), drawn.begin() + count, idx) ==
+          drawn.begin() + count) {
+        drawn[count++] = idx;
+      }
+    }
+    g_sink = g_sink + drawn[0] + drawn[1] + drawn[2];
+  });
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int draws = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000000;
+  std::printf("weighted_pick_bench: %d draws\n", draws);
+  for (const std::size_t count : {4u, 16u, 64u}) {
+    const std::vector<uint32_t> weights = MakeWeights(count);
+    std::unordered_map<uint32_t, uint32_t> types;
+    std::vector<uint32_t> ids(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      ids[i] = static_cast<uint32_t>(i + 1);
+      types.emplace(ids[i], weights[i]);
+    }
+    AliasTable table;
+    table.Build(weights);
+
+    const double drop_old = LegacyDrop(types, draws);
+    const double drop_new = AliasDrop(table, ids, draws);
+    const double up_old = LegacyUpgrade(weights, draws);
+    const double up_new = AliasUpgrade(table, draws);
+    std::printf(
+        "types=%3zu  drop: cumulative=%6.1f ns  alias=%5.1f ns  |  "
+        "upgrade x3: erase=%6.1f ns  alias=%5.1f ns\n",
+        count, drop_old, drop_new, up_old, up_new);
+  }
+  return 0;
+}
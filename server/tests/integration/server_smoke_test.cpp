@@ -347,6 +347,195 @@ void ExpectLoginRequiredFailure(TcpClient& client,
           scenario + " 未登录提示不正确: " + message);
 }
 
+// 逐条事件与合包按同一顺序展开成事件键，便于对比两条流的内容
+std::string TickKey(const char* kind, const lawnmower::Timestamp& sync_time,
+                    uint32_t id) {
+  return std::string(kind) + ":" + std::to_string(sync_time.tick()) + ":" +
+         std::to_string(id);
+}
+
+std::string HurtKey(const lawnmower::S2C_PlayerHurt& hurt) {
+  return "hurt:" + std::to_string(hurt.player_id()) + ":" +
+         std::to_string(hurt.damage()) + ":" +
+         std::to_string(hurt.remaining_health());
+}
+
+std::string DiedKey(const lawnmower::S2C_EnemyDied& died) {
+  return "died:" + std::to_string(died.enemy_id()) + ":" +
+         std::to_string(died.killer_player_id());
+}
+
+std::string LevelUpKey(const lawnmower::S2C_PlayerLevelUp& level_up) {
+  return "level_up:" + std::to_string(level_up.player_id()) + ":" +
+         std::to_string(level_up.new_level());
+}
+
+// 旧客户端收到的逐条事件消息；非事件消息返回 false
+bool AppendLegacyEventKeys(const lawnmower::Packet& packet,
+                           std::vector<std::string>* keys) {
+  switch (packet.msg_type()) {
+    case lawnmower::MSG_S2C_PROJECTILE_SPAWN: {
+      const auto msg = ParsePayload<lawnmower::S2C_ProjectileSpawn>(packet);
+      for (const auto& projectile : msg.projectiles()) {
+        keys->push_back(
+            TickKey("spawn", msg.sync_time(), projectile.projectile_id()));
+      }
+      return true;
+    }
+    case lawnmower::MSG_S2C_PROJECTILE_DESPAWN: {
+      const auto msg = ParsePayload<lawnmower::S2C_ProjectileDespawn>(packet);
+      for (const auto& projectile : msg.projectiles()) {
+        keys->push_back(
+            TickKey("despawn", msg.sync_time(), projectile.projectile_id()));
+      }
+      return true;
+    }
+    case lawnmower::MSG_S2C_DROPPED_ITEM: {
+      const auto msg = ParsePayload<lawnmower::S2C_DroppedItem>(packet);
+      for (const auto& item : msg.items()) {
+        keys->push_back(TickKey("drop", msg.sync_time(), item.item_id()));
+      }
+      return true;
+    }
+    case lawnmower::MSG_S2C_ENEMY_ATTACK_STATE_SYNC: {
+      const auto msg =
+          ParsePayload<lawnmower::S2C_EnemyAttackStateSync>(packet);
+      for (const auto& enemy : msg.enemies()) {
+        keys->push_back(TickKey(enemy.is_attacking() ? "attack" : "idle",
+                                msg.sync_time(), enemy.enemy_id()));
+      }
+      return true;
+    }
+    case lawnmower::MSG_S2C_PLAYER_HURT:
+      keys->push_back(
+          HurtKey(ParsePayload<lawnmower::S2C_PlayerHurt>(packet)));
+      return true;
+    case lawnmower::MSG_S2C_ENEMY_DIED:
+      keys->push_back(
+          DiedKey(ParsePayload<lawnmower::S2C_EnemyDied>(packet)));
+      return true;
+    case lawnmower::MSG_S2C_PLAYER_LEVEL_UP:
+      keys->push_back(
+          LevelUpKey(ParsePayload<lawnmower::S2C_PlayerLevelUp>(packet)));
+      return true;
+    case lawnmower::MSG_S2C_UPGRADE_REQUEST:
+      keys->push_back("upgrade_request");
+      return true;
+    case lawnmower::MSG_S2C_GAME_OVER:
+      keys->push_back("game_over");
+      return true;
+    default:
+      return false;
+  }
+}
+
+void AppendTickEventsKeys(const lawnmower::S2C_TickEvents& events,
+                          std::vector<std::string>* keys) {
+  for (const auto& projectile : events.projectile_spawns()) {
+    keys->push_back(
+        TickKey("spawn", events.sync_time(), projectile.projectile_id()));
+  }
+  for (const auto& projectile : events.projectile_despawns()) {
+    keys->push_back(
+        TickKey("despawn", events.sync_time(), projectile.projectile_id()));
+  }
+  for (const auto& item : events.dropped_items()) {
+    keys->push_back(TickKey("drop", events.sync_time(), item.item_id()));
+  }
+  for (const auto& enemy : events.enemy_attack_states()) {
+    keys->push_back(TickKey(enemy.is_attacking() ? "attack" : "idle",
+                            events.sync_time(), enemy.enemy_id()));
+  }
+  for (const auto& hurt : events.player_hurts()) {
+    keys->push_back(HurtKey(hurt));
+  }
+  for (const auto& died : events.enemy_dieds()) {
+    keys->push_back(DiedKey(died));
+  }
+  for (const auto& level_up : events.level_ups()) {
+    keys->push_back(LevelUpKey(level_up));
+  }
+  if (events.has_upgrade_request()) {
+    keys->push_back("upgrade_request");
+  }
+  if (events.has_game_over()) {
+    keys->push_back("game_over");
+  }
+}
+
+bool HasKeyPrefix(const std::vector<std::string>& keys, std::size_t count,
+                  const std::string& prefix) {
+  for (std::size_t i = 0; i < count && i < keys.size(); ++i) {
+    if (keys[i].rfind(prefix, 0) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// 房主（旧客户端）开火，两名玩家同处一个房间：访客只能经 TCP 收到
+// S2C_TickEvents，且展开后的事件序列与房主收到的逐条消息一致
+void ExpectTickEventsMatchLegacyStream(TcpClient& legacy, TcpClient& envelope,
+                                       uint32_t legacy_player_id,
+                                       uint32_t room_id) {
+  lawnmower::C2S_PlayerInput fire;
+  fire.set_player_id(legacy_player_id);
+  fire.set_is_attacking(true);
+  fire.set_input_seq(1);
+  legacy.Send(lawnmower::MSG_C2S_PLAYER_INPUT, fire);
+
+  constexpr std::size_t kMinCommonEvents = 6;
+  std::vector<std::string> legacy_keys;
+  std::vector<std::string> envelope_keys;
+  uint32_t envelope_count = 0;
+  const auto deadline = Clock::now() + std::chrono::seconds(8);
+  while (Clock::now() < deadline &&
+         std::min(legacy_keys.size(), envelope_keys.size()) <
+             kMinCommonEvents) {
+    if (auto packet = legacy.ReceiveOnce(50); packet.has_value()) {
+      Require(packet->msg_type() != lawnmower::MSG_S2C_TICK_EVENTS,
+              "旧客户端不应收到 S2C_TickEvents");
+      AppendLegacyEventKeys(*packet, &legacy_keys);
+    }
+    if (auto packet = envelope.ReceiveOnce(50); packet.has_value()) {
+      if (packet->msg_type() == lawnmower::MSG_S2C_TICK_EVENTS) {
+        const auto events = ParsePayload<lawnmower::S2C_TickEvents>(*packet);
+        Require(events.room_id() == room_id,
+                "S2C_TickEvents 房间号不匹配");
+        Require(events.sync_time().tick() > 0,
+                "S2C_TickEvents 缺少 sync_time.tick");
+        const std::size_t before = envelope_keys.size();
+        AppendTickEventsKeys(events, &envelope_keys);
+        Require(envelope_keys.size() > before, "S2C_TickEvents 不应为空包");
+        envelope_count += 1;
+      } else {
+        std::vector<std::string> unexpected;
+        Require(!AppendLegacyEventKeys(*packet, &unexpected),
+                "合包客户端不应收到逐条事件消息: " +
+                    lawnmower::MessageType_Name(packet->msg_type()));
+      }
+    }
+  }
+
+  const std::size_t common = std::min(legacy_keys.size(), envelope_keys.size());
+  Require(envelope_count > 0, "访客未经 TCP 收到 S2C_TickEvents");
+  Require(common >= kMinCommonEvents,
+          "事件数量不足，无法对比合包与逐条消息: legacy=" +
+              std::to_string(legacy_keys.size()) +
+              " envelope=" + std::to_string(envelope_keys.size()));
+  for (std::size_t i = 0; i < common; ++i) {
+    Require(legacy_keys[i] == envelope_keys[i],
+            "合包事件与逐条消息不一致 #" + std::to_string(i) + ": " +
+                envelope_keys[i] + " != " + legacy_keys[i]);
+  }
+  Require(HasKeyPrefix(envelope_keys, common, "spawn:"),
+          "对比窗口内未包含射弹生成事件");
+
+  fire.set_is_attacking(false);
+  fire.set_input_seq(2);
+  legacy.Send(lawnmower::MSG_C2S_PLAYER_INPUT, fire);
+}
+
 void RunSmoke(const std::string& server_binary) {
   const uint16_t tcp_port = ReservePort(SOCK_STREAM);
   const uint16_t udp_port = ReservePort(SOCK_DGRAM);
@@ -415,6 +604,8 @@ void RunSmoke(const std::string& server_binary) {
   Require(host_login_result.player_id() > 0, "房主 player_id 非法");
   Require(!host_login_result.session_token().empty(),
           "房主 session_token 为空");
+  Require(host_login_result.enabled_features() == 0,
+          "未声明特性的旧客户端不应启用任何特性");
 
   lawnmower::C2S_CreateRoom create_room;
   create_room.set_room_name("smoke_room");
@@ -432,6 +623,7 @@ void RunSmoke(const std::string& server_binary) {
   TcpClient guest("127.0.0.1", tcp_port, 5000);
   lawnmower::C2S_Login guest_login;
   guest_login.set_player_name("smoke_guest");
+  guest_login.set_client_features(lawnmower::CLIENT_FEATURE_TICK_EVENTS);
   guest.Send(lawnmower::MSG_C2S_LOGIN, guest_login);
   const auto guest_login_packet =
       guest.ReceiveUntil(lawnmower::MSG_S2C_LOGIN_RESULT, 3000);
@@ -440,6 +632,9 @@ void RunSmoke(const std::string& server_binary) {
   Require(guest_login_result.success(), "访客登录失败");
   Require(!guest_login_result.session_token().empty(),
           "访客 session_token 为空");
+  Require(guest_login_result.enabled_features() ==
+              lawnmower::CLIENT_FEATURE_TICK_EVENTS,
+          "访客应协商启用 TickEvents 合包");
 
   lawnmower::C2S_GetRoomList room_list_req;
   guest.Send(lawnmower::MSG_C2S_GET_ROOM_LIST, room_list_req);
@@ -535,6 +730,8 @@ void RunSmoke(const std::string& server_binary) {
   Require(guest_game_start.room_id() == room_id,
           "访客收到 game_start 房间号不匹配");
 
+  ExpectTickEventsMatchLegacyStream(host, guest, host_player_id, room_id);
+
   TcpClient observer("127.0.0.1", tcp_port, 5000);
   lawnmower::C2S_Login observer_login;
   observer_login.set_player_name("smoke_observer");
@@ -582,6 +779,9 @@ void RunSmoke(const std::string& server_binary) {
   reconnect.set_session_token(host_login_result.session_token());
   reconnect.set_last_input_seq(0);
   reconnect.set_last_server_tick(0);
+  // 未知特性位应被忽略
+  reconnect.set_client_features(lawnmower::CLIENT_FEATURE_TICK_EVENTS |
+                                (1u << 30));
   reconnect_client.Send(lawnmower::MSG_C2S_RECONNECT_REQUEST, reconnect);
   const auto reconnect_packet =
       reconnect_client.ReceiveUntil(lawnmower::MSG_S2C_RECONNECT_ACK, 3000);
@@ -593,6 +793,9 @@ void RunSmoke(const std::string& server_binary) {
   Require(reconnect_ack.room_id() == room_id, "重连 room_id 不匹配");
   Require(!reconnect_ack.session_token().empty(),
           "重连 ACK session_token 为空");
+  Require(reconnect_ack.enabled_features() ==
+              lawnmower::CLIENT_FEATURE_TICK_EVENTS,
+          "重连应按新连接重新协商特性");
 
   guest.Close();
   std::this_thread::sleep_for(std::chrono::milliseconds(2200));
@@ -2,6 +2,7 @@
 #include <arpa/inet.h>
 #include <cerrno>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -19,6 +20,8 @@
 #include <thread>
 #include <unistd.h>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "message.pb.h"
@@ -84,8 +87,10 @@ void WriteTextFile(const fs::path& path, const std::string& content) {
   out << content;
 }
 
+// extra_server_config 为追加到 server_config.json 的若干 "key": value 行
 void WriteTestConfigs(const fs::path& workspace, uint16_t tcp_port,
-                      uint16_t udp_port) {
+                      uint16_t udp_port,
+                      const std::string& extra_server_config = "") {
   const fs::path cfg_dir = workspace / "game_config";
   std::error_code ec;
   fs::create_directories(cfg_dir, ec);
@@ -111,7 +116,8 @@ void WriteTestConfigs(const fs::path& workspace, uint16_t tcp_port,
                     "  \"enemy_spawn_wave_growth_per_second\": 0,\n"
                     "  \"max_enemies_alive\": 8,\n"
                     "  \"projectile_attack_min_interval_seconds\": 0.05,\n"
-                    "  \"projectile_attack_max_interval_seconds\": 0.2,\n"
+                    "  \"projectile_attack_max_interval_seconds\": 0.2,\n" +
+                    extra_server_config +
                     "  \"log_level\": \"warn\"\n"
                     "}\n");
 
@@ -485,7 +491,9 @@ struct ItemObserveState {
   bool picked = false;
 };
 
-void RunUdpSyncSmoke(const std::string& server_binary) {
+// reliable_udp=true 时协商 UDP 可靠通道：事件经 S2C_UdpReliable 下发，
+// 增量同步可能被捎带在同一数据报里
+void RunUdpSyncSmoke(const std::string& server_binary, bool reliable_udp) {
   const uint16_t tcp_port = ReservePort(SOCK_STREAM);
   const uint16_t udp_port = ReservePort(SOCK_DGRAM);
   const fs::path workspace = CreateTempWorkspace();
@@ -497,6 +505,10 @@ void RunUdpSyncSmoke(const std::string& server_binary) {
   TcpClient host("127.0.0.1", tcp_port, 5000);
   lawnmower::C2S_Login login;
   login.set_player_name("udp_smoke_host");
+  if (reliable_udp) {
+    login.set_client_features(lawnmower::CLIENT_FEATURE_TICK_EVENTS |
+                              lawnmower::CLIENT_FEATURE_UDP_RELIABLE);
+  }
   host.Send(lawnmower::MSG_C2S_LOGIN, login);
   const auto login_packet =
       host.ReceiveUntil(lawnmower::MSG_S2C_LOGIN_RESULT, 3000);
@@ -507,6 +519,12 @@ void RunUdpSyncSmoke(const std::string& server_binary) {
   Require(!login_result.session_token().empty(),
           "UDP smoke: session_token 为空");
   const uint32_t host_player_id = login_result.player_id();
+  if (reliable_udp) {
+    Require(login_result.enabled_features() ==
+                (lawnmower::CLIENT_FEATURE_TICK_EVENTS |
+                 lawnmower::CLIENT_FEATURE_UDP_RELIABLE),
+            "UDP smoke: 可靠通道协商失败");
+  }
 
   lawnmower::C2S_CreateRoom create_room;
   create_room.set_room_name("udp_smoke_room");
@@ -549,6 +567,9 @@ void RunUdpSyncSmoke(const std::string& server_binary) {
   uint32_t delta_tick_advances = 0;
   bool has_last_tick = false;
   uint32_t last_tick = 0;
+  uint32_t reliable_delivered_seq = 0;
+  uint32_t reliable_tick_events = 0;
+  uint32_t piggybacked_deltas = 0;
 
   auto deadline = Clock::now() + std::chrono::seconds(15);
   auto next_send = Clock::now();
@@ -564,6 +585,44 @@ void RunUdpSyncSmoke(const std::string& server_binary) {
     if (!packet.has_value()) {
       continue;
     }
+    if (packet->msg_type() == lawnmower::MSG_S2C_UDP_RELIABLE) {
+      Require(reliable_udp, "未协商可靠通道却收到 S2C_UdpReliable");
+      const auto reliable =
+          ParsePayload<lawnmower::S2C_UdpReliable>(*packet);
+      // 本地回环几乎不丢包，只按连续 seq 推进即可；已改经 TCP 补发的
+      // 消息由 skip_through 跳过
+      if (static_cast<int32_t>(reliable.skip_through() -
+                               reliable_delivered_seq) > 0) {
+        reliable_delivered_seq = reliable.skip_through();
+      }
+      for (const auto& message : reliable.messages()) {
+        if (message.seq() != reliable_delivered_seq + 1) {
+          continue;
+        }
+        reliable_delivered_seq = message.seq();
+        Require(message.msg_type() == lawnmower::MSG_S2C_TICK_EVENTS,
+                "可靠通道消息类型应为 S2C_TickEvents");
+        lawnmower::S2C_TickEvents events;
+        Require(events.ParseFromString(message.payload()),
+                "解析 S2C_TickEvents 失败");
+        Require(events.room_id() == room_id, "TickEvents room_id 不匹配");
+        reliable_tick_events += 1;
+      }
+      lawnmower::C2S_UdpAck ack;
+      ack.set_player_id(host_player_id);
+      ack.set_session_token(login_result.session_token());
+      ack.set_ack(reliable_delivered_seq);
+      udp.Send(lawnmower::MSG_C2S_UDP_ACK, ack);
+
+      if (reliable.piggyback_packet().empty()) {
+        continue;
+      }
+      lawnmower::Packet inner;
+      Require(inner.ParseFromString(reliable.piggyback_packet()),
+              "解析捎带 Packet 失败");
+      piggybacked_deltas += 1;
+      packet = std::move(inner);
+    }
     if (packet->msg_type() != lawnmower::MSG_S2C_GAME_STATE_DELTA_SYNC) {
       continue;
     }
@@ -611,7 +670,7 @@ void RunUdpSyncSmoke(const std::string& server_binary) {
     }
 
     if (delta_packet_count >= 8 && delta_tick_advances >= 5 && saw_item_delta &&
-        saw_item_picked_true) {
+        saw_item_picked_true && (!reliable_udp || reliable_tick_events >= 3)) {
       break;
     }
   }
@@ -620,6 +679,341 @@ void RunUdpSyncSmoke(const std::string& server_binary) {
   Require(delta_tick_advances >= 3, "UDP delta tick 连续性不足");
   Require(saw_item_delta, "未观察到任何道具 delta");
   Require(saw_item_picked_true, "未观察到道具收敛到 is_picked=true");
+  if (reliable_udp) {
+    Require(reliable_tick_events >= 3, "可靠通道收到的 TickEvents 过少");
+    std::cout << "reliable udp: tick_events=" << reliable_tick_events
+              << " piggybacked_deltas=" << piggybacked_deltas << "\n";
+  }
+
+  server.Stop();
+  std::error_code ec;
+  fs::remove_all(workspace, ec);
+}
+
+// 按确认基线增量：输入里带上已还原的最新同步 tick，服务器先经 TCP 下发全量
+// 快照，之后的 UDP 增量都以客户端确认过的快照为基线，不再收到共享基线增量
+void RunAckedDeltaSmoke(const std::string& server_binary) {
+  const uint16_t tcp_port = ReservePort(SOCK_STREAM);
+  const uint16_t udp_port = ReservePort(SOCK_DGRAM);
+  const fs::path workspace = CreateTempWorkspace();
+  WriteTestConfigs(workspace, tcp_port, udp_port);
+
+  ServerProcess server(server_binary, workspace);
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+  TcpClient host("127.0.0.1", tcp_port, 5000);
+  lawnmower::C2S_Login login;
+  login.set_player_name("acked_smoke_host");
+  login.set_client_features(lawnmower::CLIENT_FEATURE_QUANTIZED_POSITIONS);
+  host.Send(lawnmower::MSG_C2S_LOGIN, login);
+  const auto login_result = ParsePayload<lawnmower::S2C_LoginResult>(
+      host.ReceiveUntil(lawnmower::MSG_S2C_LOGIN_RESULT, 3000));
+  Require(login_result.success(), "acked smoke: 登录失败");
+  Require(login_result.enabled_features() ==
+              lawnmower::CLIENT_FEATURE_QUANTIZED_POSITIONS,
+          "acked smoke: 定点坐标特性协商结果不正确");
+  const uint32_t host_player_id = login_result.player_id();
+
+  lawnmower::C2S_CreateRoom create_room;
+  create_room.set_room_name("acked_smoke_room");
+  create_room.set_max_players(1);
+  host.Send(lawnmower::MSG_C2S_CREATE_ROOM, create_room);
+  const auto create_result = ParsePayload<lawnmower::S2C_CreateRoomResult>(
+      host.ReceiveUntil(lawnmower::MSG_S2C_CREATE_ROOM_RESULT, 3000));
+  Require(create_result.success(), "acked smoke: 建房失败");
+
+  host.Send(lawnmower::MSG_C2S_START_GAME, lawnmower::C2S_StartGame{});
+  const auto game_start = ParsePayload<lawnmower::S2C_GameStart>(
+      host.ReceiveUntil(lawnmower::MSG_S2C_GAME_START, 3000));
+  Require(game_start.success(), "acked smoke: 开局失败");
+
+  UdpClient udp("127.0.0.1", udp_port);
+  std::unordered_set<uint32_t> known_ticks;  // 客户端可作基线的快照
+  uint32_t acked_tick = 0;
+  uint32_t input_seq = 1;
+  uint32_t full_snapshots = 0;
+  uint32_t acked_deltas = 0;
+  uint32_t baseline_advances = 0;
+  uint32_t last_baseline = 0;
+  uint32_t quantized_moves = 0;  // 以 qx/qy 下发的玩家位置变化
+
+  auto deadline = Clock::now() + std::chrono::seconds(10);
+  auto next_send = Clock::now();
+  while (Clock::now() < deadline) {
+    if (Clock::now() >= next_send) {
+      lawnmower::C2S_PlayerInput input;
+      input.set_player_id(host_player_id);
+      input.mutable_move_direction()->set_x(input_seq % 2 == 0 ? 1.0f : -1.0f);
+      input.set_input_seq(input_seq++);
+      input.set_delta_ms(40);
+      input.set_session_token(login_result.session_token());
+      input.set_acked_sync_tick(acked_tick);
+      udp.Send(lawnmower::MSG_C2S_PLAYER_INPUT, input);
+      next_send += std::chrono::milliseconds(40);
+    }
+
+    while (auto tcp_packet = host.ReceiveOnce(1)) {
+      if (tcp_packet->msg_type() != lawnmower::MSG_S2C_GAME_STATE_SYNC) {
+        continue;
+      }
+      const auto sync =
+          ParsePayload<lawnmower::S2C_GameStateSync>(*tcp_packet);
+      if (sync.is_full_snapshot()) {
+        known_ticks.insert(sync.sync_time().tick());
+        acked_tick = std::max(acked_tick, sync.sync_time().tick());
+        full_snapshots += 1;
+      }
+    }
+
+    auto packet = udp.ReceiveOnce(40);
+    if (!packet.has_value() ||
+        packet->msg_type() != lawnmower::MSG_S2C_GAME_STATE_DELTA_SYNC) {
+      continue;
+    }
+    const auto delta = ParsePayload<lawnmower::S2C_GameStateDeltaSync>(*packet);
+    if (delta.baseline_tick() == 0) {
+      Require(acked_deltas == 0, "改收确认基线增量后仍收到共享基线增量");
+      continue;
+    }
+    Require(known_ticks.contains(delta.baseline_tick()),
+            "增量基线不是客户端确认过的快照: " +
+                std::to_string(delta.baseline_tick()));
+    Require(delta.sync_time().tick() > delta.baseline_tick(),
+            "增量 tick 应晚于基线");
+    Require(delta.position_scale() != 0, "协商后确认基线增量应为定点编码");
+    for (const auto& player : delta.players()) {
+      Require(!player.has_position() && !player.has_rotation(),
+              "定点增量不应再带浮点坐标/朝向");
+      if (player.has_qx() || player.has_qy()) {
+        quantized_moves += 1;
+      }
+    }
+    known_ticks.insert(delta.sync_time().tick());
+    acked_tick = std::max(acked_tick, delta.sync_time().tick());
+    acked_deltas += 1;
+    if (delta.baseline_tick() > last_baseline) {
+      if (last_baseline != 0) {
+        baseline_advances += 1;
+      }
+      last_baseline = delta.baseline_tick();
+    }
+    if (acked_deltas >= 10 && baseline_advances >= 5 &&
+        quantized_moves >= 1) {
+      break;
+    }
+  }
+
+  Require(full_snapshots >= 1, "acked smoke: 未收到 TCP 全量快照");
+  Require(acked_deltas >= 10, "acked smoke: 确认基线增量过少");
+  Require(baseline_advances >= 5, "acked smoke: 基线未随确认推进");
+  Require(quantized_moves >= 1, "acked smoke: 未收到定点坐标的位置变化");
+  std::cout << "acked delta: full_snapshots=" << full_snapshots
+            << " deltas=" << acked_deltas
+            << " baseline_advances=" << baseline_advances
+            << " quantized_moves=" << quantized_moves << "\n";
+
+  server.Stop();
+  std::error_code ec;
+  fs::remove_all(workspace, ec);
+}
+
+// 兴趣区域过滤：视野只覆盖玩家上下各 40 像素的横条，敌人从四边刷出且不移动。
+// 客户端按收到的 sync 敌人维护已知集合、按 removed_enemy_ids 移除；增量里
+// 只应出现已知敌人，进入的敌人应落在进入矩形内。先原地开火击杀（死亡的敌人
+// 不应列入离开列表），再停火攒怪、纵向走出横条，敌人经单独的 TCP 离开列表移除
+void RunInterestFilterSmoke(const std::string& server_binary) {
+  const uint16_t tcp_port = ReservePort(SOCK_STREAM);
+  const uint16_t udp_port = ReservePort(SOCK_DGRAM);
+  const fs::path workspace = CreateTempWorkspace();
+  WriteTestConfigs(workspace, tcp_port, udp_port,
+                   "  \"aoi_view_half_width\": 400,\n"
+                   "  \"aoi_view_half_height\": 16,\n"
+                   "  \"aoi_margin\": 24,\n");
+  constexpr float kEnterHalfHeight = 16.0f + 24.0f;
+  constexpr float kMapCenterY = 120.0f;
+
+  ServerProcess server(server_binary, workspace);
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+  TcpClient host("127.0.0.1", tcp_port, 5000);
+  lawnmower::C2S_Login login;
+  login.set_player_name("aoi_smoke_host");
+  login.set_client_features(lawnmower::CLIENT_FEATURE_INTEREST_FILTER);
+  host.Send(lawnmower::MSG_C2S_LOGIN, login);
+  const auto login_result = ParsePayload<lawnmower::S2C_LoginResult>(
+      host.ReceiveUntil(lawnmower::MSG_S2C_LOGIN_RESULT, 3000));
+  Require(login_result.success(), "aoi smoke: 登录失败");
+  Require(login_result.enabled_features() ==
+              lawnmower::CLIENT_FEATURE_INTEREST_FILTER,
+          "aoi smoke: 兴趣区域过滤特性协商结果不正确");
+  const uint32_t host_player_id = login_result.player_id();
+
+  lawnmower::C2S_CreateRoom create_room;
+  create_room.set_room_name("aoi_smoke_room");
+  create_room.set_max_players(1);
+  host.Send(lawnmower::MSG_C2S_CREATE_ROOM, create_room);
+  const auto create_result = ParsePayload<lawnmower::S2C_CreateRoomResult>(
+      host.ReceiveUntil(lawnmower::MSG_S2C_CREATE_ROOM_RESULT, 3000));
+  Require(create_result.success(), "aoi smoke: 建房失败");
+
+  host.Send(lawnmower::MSG_C2S_START_GAME, lawnmower::C2S_StartGame{});
+  const auto game_start = ParsePayload<lawnmower::S2C_GameStart>(
+      host.ReceiveUntil(lawnmower::MSG_S2C_GAME_START, 3000));
+  Require(game_start.success(), "aoi smoke: 开局失败");
+
+  // 原地开火 -> 停火攒怪 -> 纵向走出横条
+  enum class Phase { kFire, kGather, kLeave };
+  Phase phase = Phase::kFire;
+  UdpClient udp("127.0.0.1", udp_port);
+  std::unordered_set<uint32_t> known_enemies;
+  std::unordered_set<uint32_t> dead_enemies;
+  std::vector<float> entered_ys;  // 走出横条前玩家只左右移动，y 不变
+  bool has_player_y = false;
+  float player_y = 0.0f;
+  float band_y = 0.0f;
+  uint32_t known_dead = 0;
+  uint32_t removed = 0;
+  uint32_t deltas = 0;
+  uint32_t input_seq = 1;
+
+  const auto mark_dead = [&](uint32_t enemy_id) {
+    if (dead_enemies.insert(enemy_id).second &&
+        known_enemies.contains(enemy_id)) {
+      known_dead += 1;
+    }
+  };
+  const auto apply_sync = [&](const lawnmower::S2C_GameStateSync& sync) {
+    if (sync.is_full_snapshot()) {
+      known_enemies.clear();
+    }
+    for (const auto& player : sync.players()) {
+      if (player.player_id() == host_player_id) {
+        has_player_y = true;
+        player_y = player.position().y();
+      }
+    }
+    // 开局的房间级全量（及其重发）不做兴趣过滤，收到几帧增量后再统计进入
+    const bool count_entered =
+        !sync.is_full_snapshot() && deltas >= 3 && phase != Phase::kLeave;
+    for (const auto& enemy : sync.enemies()) {
+      if (known_enemies.insert(enemy.enemy_id()).second && count_entered) {
+        entered_ys.push_back(enemy.position().y());
+      }
+      if (!enemy.is_alive()) {
+        mark_dead(enemy.enemy_id());
+      }
+    }
+  };
+  const auto apply_delta = [&](const lawnmower::S2C_GameStateDeltaSync& delta) {
+    Require(delta.baseline_tick() == 0, "aoi smoke: 不应收到确认基线增量");
+    for (const auto& player : delta.players()) {
+      if (player.player_id() == host_player_id && player.has_position()) {
+        has_player_y = true;
+        player_y = player.position().y();
+      }
+    }
+    for (const auto& enemy : delta.enemies()) {
+      Require(known_enemies.contains(enemy.enemy_id()),
+              "aoi smoke: 增量里出现未进入兴趣区域的敌人 " +
+                  std::to_string(enemy.enemy_id()));
+      if ((enemy.changed_mask() & lawnmower::ENEMY_DELTA_IS_ALIVE) != 0 &&
+          !enemy.is_alive()) {
+        mark_dead(enemy.enemy_id());
+      }
+    }
+    for (const auto enemy_id : delta.removed_enemy_ids()) {
+      Require(!dead_enemies.contains(enemy_id),
+              "aoi smoke: 死亡的敌人不应列入离开列表 " +
+                  std::to_string(enemy_id));
+      known_enemies.erase(enemy_id);
+      removed += 1;
+    }
+    deltas += 1;
+  };
+
+  auto phase_deadline = Clock::now() + std::chrono::seconds(10);
+  auto next_send = Clock::now();
+  while (true) {
+    const auto now = Clock::now();
+    if (phase == Phase::kFire &&
+        ((deltas >= 10 && entered_ys.size() >= 2 && known_dead >= 1) ||
+         now >= phase_deadline)) {
+      phase = Phase::kGather;
+      phase_deadline = now + std::chrono::milliseconds(1500);
+    } else if (phase == Phase::kGather && now >= phase_deadline) {
+      phase = Phase::kLeave;
+      band_y = player_y;
+      phase_deadline = now + std::chrono::seconds(3);
+    } else if (phase == Phase::kLeave &&
+               (removed >= 1 || now >= phase_deadline)) {
+      break;
+    }
+
+    if (now >= next_send) {
+      lawnmower::C2S_PlayerInput input;
+      input.set_player_id(host_player_id);
+      if (phase == Phase::kLeave) {
+        input.mutable_move_direction()->set_y(band_y < kMapCenterY ? 1.0f
+                                                                   : -1.0f);
+      } else {
+        // 左右各走约 0.5 秒，避免最近目标恰在枪口偏移内而一直打不中
+        input.mutable_move_direction()->set_x(
+            (input_seq / 12) % 2 == 0 ? 1.0f : -1.0f);
+      }
+      input.set_is_attacking(phase == Phase::kFire);
+      input.set_input_seq(input_seq++);
+      input.set_delta_ms(40);
+      input.set_session_token(login_result.session_token());
+      udp.Send(lawnmower::MSG_C2S_PLAYER_INPUT, input);
+      next_send += std::chrono::milliseconds(40);
+    }
+
+    // 先处理 TCP：进入的敌人、离开列表与死亡广播都走 TCP
+    while (auto tcp_packet = host.ReceiveOnce(1)) {
+      if (tcp_packet->msg_type() == lawnmower::MSG_S2C_GAME_STATE_SYNC) {
+        apply_sync(ParsePayload<lawnmower::S2C_GameStateSync>(*tcp_packet));
+      } else if (tcp_packet->msg_type() ==
+                 lawnmower::MSG_S2C_GAME_STATE_DELTA_SYNC) {
+        const auto delta =
+            ParsePayload<lawnmower::S2C_GameStateDeltaSync>(*tcp_packet);
+        if (delta.removed_enemy_ids_size() > 0) {
+          Require(delta.players_size() == 0 && delta.enemies_size() == 0 &&
+                      delta.items_size() == 0,
+                  "aoi smoke: 离开列表应单独成包");
+        }
+        apply_delta(delta);
+      } else if (tcp_packet->msg_type() == lawnmower::MSG_S2C_ENEMY_DIED) {
+        mark_dead(
+            ParsePayload<lawnmower::S2C_EnemyDied>(*tcp_packet).enemy_id());
+      }
+    }
+
+    auto packet = udp.ReceiveOnce(40);
+    if (packet.has_value()) {
+      if (packet->msg_type() == lawnmower::MSG_S2C_GAME_STATE_DELTA_SYNC) {
+        const auto delta =
+            ParsePayload<lawnmower::S2C_GameStateDeltaSync>(*packet);
+        Require(delta.removed_enemy_ids_size() == 0,
+                "aoi smoke: 离开列表应走 TCP");
+        apply_delta(delta);
+      } else if (packet->msg_type() == lawnmower::MSG_S2C_GAME_STATE_SYNC) {
+        apply_sync(ParsePayload<lawnmower::S2C_GameStateSync>(*packet));
+      }
+    }
+  }
+
+  Require(deltas >= 10, "aoi smoke: 增量过少");
+  Require(!entered_ys.empty(), "aoi smoke: 未观察到敌人进入兴趣区域");
+  Require(known_dead >= 1, "aoi smoke: 未观察到兴趣区域内的敌人死亡");
+  Require(removed >= 1, "aoi smoke: 未观察到敌人离开兴趣区域");
+  Require(has_player_y, "aoi smoke: 未收到玩家位置");
+  for (const float y : entered_ys) {
+    Require(std::abs(y - band_y) <= kEnterHalfHeight + 0.5f,
+            "aoi smoke: 进入的敌人不在进入矩形内");
+  }
+  std::cout << "interest filter: deltas=" << deltas
+            << " entered=" << entered_ys.size() << " dead=" << known_dead
+            << " removed=" << removed << "\n";
 
   server.Stop();
   std::error_code ec;
@@ -634,7 +1028,10 @@ int main(int argc, char** argv) {
   }
 
   try {
-    RunUdpSyncSmoke(argv[1]);
+    RunUdpSyncSmoke(argv[1], false);
+    RunUdpSyncSmoke(argv[1], true);
+    RunAckedDeltaSmoke(argv[1]);
+    RunInterestFilterSmoke(argv[1]);
     std::cout << "udp_sync_smoke_test: PASS\n";
     return 0;
   } catch (const std::exception& ex) {
@@ -0,0 +1,117 @@
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_alias.hpp"
+
+namespace {
+using game_manager_alias::AliasTable;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 等距扫过 32 位随机数空间，统计每个下标被抽中的次数
+std::vector<uint64_t> SweepCounts(const AliasTable& table, uint32_t samples) {
+  std::vector<uint64_t> counts(table.Size(), 0);
+  const uint64_t step = (uint64_t{1} << 32) / samples;
+  for (uint64_t k = 0; k < samples; ++k) {
+    counts[table.Sample(static_cast<uint32_t>(k * step))] += 1;
+  }
+  return counts;
+}
+
+void TestMatchesWeights() {
+  const std::vector<uint32_t> weights = {1, 2, 3, 4, 0, 10};
+  AliasTable table;
+  table.Build(weights);
+  Expect(table.Size() == weights.size(), "表大小应与权重数一致");
+
+  constexpr uint32_t kSamples = 1u << 20;
+  const std::vector<uint64_t> counts = SweepCounts(table, kSamples);
+  const double total = 20.0;
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    const double expected = kSamples * (weights[i] / total);
+    const double error = std::abs(static_cast<double>(counts[i]) - expected);
+    Expect(error <= kSamples * 1e-4,
+           "下标 " + std::to_string(i) + " 的抽中比例与权重不符");
+  }
+  Expect(counts[4] == 0, "权重为 0 的条目不应被抽中");
+}
+
+void TestUniformAndSingle() {
+  AliasTable uniform;
+  uniform.Build({5, 5, 5, 5});
+  const std::vector<uint64_t> counts = SweepCounts(uniform, 1u << 16);
+  for (const uint64_t count : counts) {
+    Expect(count == (1u << 14), "等权重时每列应恰好各占四分之一");
+  }
+
+  AliasTable single;
+  single.Build({7});
+  Expect(single.Sample(0) == 0 && single.Sample(0xFFFFFFFFu) == 0,
+         "单条目时应总是返回 0");
+}
+
+void TestEmptyAndRebuild() {
+  AliasTable table;
+  Expect(table.Empty(), "默认构造应为空");
+  table.Build({});
+  Expect(table.Empty(), "无权重时应为空");
+  table.Build({0, 0, 0});
+  Expect(table.Empty(), "权重全为 0 时应为空");
+  table.Build({0, 3});
+  Expect(!table.Empty() && table.Size() == 2, "重建后应非空");
+  for (uint32_t r = 0; r < 1000; ++r) {
+    Expect(table.Sample(r * 4294967u) == 1, "只应抽中非零权重的条目");
+  }
+}
+
+void TestDeterministicStream() {
+  AliasTable a;
+  AliasTable b;
+  a.Build({3, 1, 4, 1, 5, 9, 2, 6});
+  b.Build({3, 1, 4, 1, 5, 9, 2, 6});
+  uint32_t state = 12345u;
+  for (int i = 0; i < 10000; ++i) {
+    state = state * 1664525u + 1013904223u;
+    Expect(a.Sample(state) == b.Sample(state), "相同权重与随机数应得到相同结果");
+  }
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"matches_weights", TestMatchesWeights},
+      {"uniform_and_single", TestUniformAndSingle},
+      {"empty_and_rebuild", TestEmptyAndRebuild},
+      {"deterministic_stream", TestDeterministicStream},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "alias_table_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "alias_table_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,195 @@
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "game/managers/alive_counters.hpp"
+
+namespace {
+// 模拟场景中的一个实体：与 RecountAliveLocked 读取的字段一致
+struct Entity {
+  bool is_player = false;
+  bool alive = true;
+  uint32_t type_id = 0;
+  uint32_t wave_id = 0;
+};
+
+using World = std::map<uint32_t, Entity>;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 全量重算：逐个实体统计存活数
+AliveCounters Recount(const World& world) {
+  AliveCounters counters;
+  for (const auto& [_, entity] : world) {
+    if (!entity.alive) {
+      continue;
+    }
+    if (entity.is_player) {
+      counters.players += 1;
+      continue;
+    }
+    counters.enemies += 1;
+    counters.enemies_by_type[entity.type_id] += 1;
+    counters.enemies_by_wave[entity.wave_id] += 1;
+  }
+  return counters;
+}
+
+void ExpectMatches(const AliveCounters& counters, const World& world,
+                   const std::string& where) {
+  const AliveCounters recount = Recount(world);
+  Expect(counters.players == recount.players, where + ": 玩家数不一致");
+  Expect(counters.enemies == recount.enemies, where + ": 敌人数不一致");
+  Expect(counters.enemies_by_type == recount.enemies_by_type,
+         where + ": 按类型计数不一致");
+  Expect(counters.enemies_by_wave == recount.enemies_by_wave,
+         where + ": 按波次计数不一致");
+}
+
+// 出生：加入场景并计数 +1
+void Spawn(World* world, AliveCounters* counters, uint32_t id,
+           const Entity& entity) {
+  (*world)[id] = entity;
+  if (entity.is_player) {
+    counters->AddPlayers(1);
+  } else {
+    counters->AddEnemies(entity.type_id, entity.wave_id, 1);
+  }
+}
+
+// 死亡：仍留在场景中，计数 -1
+void Kill(World* world, AliveCounters* counters, uint32_t id) {
+  Entity& entity = world->at(id);
+  if (!entity.alive) {
+    return;
+  }
+  entity.alive = false;
+  if (entity.is_player) {
+    counters->AddPlayers(-1);
+  } else {
+    counters->AddEnemies(entity.type_id, entity.wave_id, -1);
+  }
+}
+
+// 移除：存活玩家离开时计数 -1；死亡敌人回收时已不计入，不再调用
+void Remove(World* world, AliveCounters* counters, uint32_t id) {
+  const Entity entity = world->at(id);
+  world->erase(id);
+  if (entity.is_player && entity.alive) {
+    counters->AddPlayers(-1);
+  }
+}
+
+void TestSpawnDeathRemoval() {
+  World world;
+  AliveCounters counters;
+  Spawn(&world, &counters, 1, {.is_player = true});
+  Spawn(&world, &counters, 2, {.is_player = true});
+  Spawn(&world, &counters, 10, {.type_id = 1, .wave_id = 1});
+  Spawn(&world, &counters, 11, {.type_id = 2, .wave_id = 1});
+  Spawn(&world, &counters, 12, {.type_id = 1, .wave_id = 2});
+  ExpectMatches(counters, world, "spawn");
+  Expect(counters.players == 2 && counters.enemies == 3, "出生后计数不正确");
+
+  Kill(&world, &counters, 11);
+  Kill(&world, &counters, 1);
+  ExpectMatches(counters, world, "death");
+  Expect(counters.enemies_by_type.count(2) == 0, "类型计数归零后应删除条目");
+
+  Remove(&world, &counters, 11);  // 回收死亡敌人
+  Remove(&world, &counters, 2);   // 存活玩家离开
+  Remove(&world, &counters, 1);   // 死亡玩家离开
+  ExpectMatches(counters, world, "removal");
+  Expect(counters.players == 0, "玩家全部离开后计数应为 0");
+
+  Kill(&world, &counters, 10);
+  Kill(&world, &counters, 12);
+  ExpectMatches(counters, world, "all_dead");
+  Expect(counters.enemies_by_type.empty() && counters.enemies_by_wave.empty(),
+         "无存活敌人时分组表应为空");
+}
+
+void TestNegativeDeltaClampsAtZero() {
+  AliveCounters counters;
+  counters.AddPlayers(-1);
+  counters.AddEnemies(3, 4, -1);
+  Expect(counters.players == 0 && counters.enemies == 0, "减到负数应钳制为 0");
+  Expect(counters.enemies_by_type.empty() && counters.enemies_by_wave.empty(),
+         "钳制后不应留下空条目");
+  counters.AddEnemies(3, 4, 0);
+  Expect(counters.enemies_by_type.empty(), "delta 为 0 不应插入条目");
+}
+
+void TestRandomOpsMatchRecount() {
+  uint32_t state = 12345u;
+  const auto next = [&state](uint32_t bound) {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) % bound;
+  };
+
+  World world;
+  AliveCounters counters;
+  uint32_t next_id = 1;
+  for (int step = 0; step < 5000; ++step) {
+    const uint32_t op = next(4);
+    if (op == 0 || world.empty()) {
+      Entity entity;
+      entity.is_player = next(4) == 0;
+      entity.type_id = next(5);
+      entity.wave_id = next(7);
+      Spawn(&world, &counters, next_id++, entity);
+    } else {
+      auto it = world.begin();
+      std::advance(it, next(static_cast<uint32_t>(world.size())));
+      if (op == 3) {
+        // 敌人只在死亡后回收
+        if (!it->second.is_player) {
+          Kill(&world, &counters, it->first);
+        }
+        Remove(&world, &counters, it->first);
+      } else {
+        Kill(&world, &counters, it->first);
+      }
+    }
+    ExpectMatches(counters, world, "step " + std::to_string(step));
+  }
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"spawn_death_removal", TestSpawnDeathRemoval},
+      {"negative_delta_clamps_at_zero", TestNegativeDeltaClampsAtZero},
+      {"random_ops_match_recount", TestRandomOpsMatchRecount},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "alive_counters_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "alive_counters_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
@@ -100,7 +100,8 @@ void TestServerConfigTypeAndRangeGuards() {
   "udp_port": -1,
   "state_sync_rate": 29.5,
   "move_speed": 123.5,
-  "reconnect_grace_seconds": 9999
+  "reconnect_grace_seconds": 9999,
+  "max_substeps_per_tick": 100
 })json");
 
   ServerConfig cfg;
@@ -112,6 +113,8 @@ void TestServerConfigTypeAndRangeGuards() {
   ExpectNear(cfg.move_speed, 123.5f, 1e-4f, "move_speed 应按配置生效");
   ExpectNear(cfg.reconnect_grace_seconds, 600.0f, 1e-4f,
              "reconnect_grace_seconds 应被 clamp 到 600");
+  Expect(cfg.max_substeps_per_tick == 16,
+         "max_substeps_per_tick 应被 clamp 到 16");
 }
 
 void TestServerConfigInvalidJsonFallback() {
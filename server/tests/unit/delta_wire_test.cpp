@@ -0,0 +1,244 @@
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "message.pb.h"
+#include "network/delta_wire.hpp"
+#include "network/packet_codec.hpp"
+
+namespace {
+
+using delta_wire::DeltaFrame;
+using delta_wire::EnemyDelta;
+using delta_wire::ItemDelta;
+using delta_wire::PlayerDelta;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 参照实现：与原 BuildSyncPayloadsLocked 相同的按掩码填充消息
+lawnmower::S2C_GameStateDeltaSync ToMessage(const DeltaFrame& frame) {
+  lawnmower::S2C_GameStateDeltaSync delta;
+  if (frame.has_sync_time) {
+    auto* ts = delta.mutable_sync_time();
+    ts->set_server_time(frame.server_time_ms);
+    ts->set_tick(frame.tick);
+  }
+  delta.set_room_id(frame.room_id);
+  for (const auto& player : frame.players) {
+    auto* out = delta.add_players();
+    const uint32_t mask = player.changed_mask;
+    out->set_player_id(player.player_id);
+    out->set_changed_mask(mask);
+    if ((mask & lawnmower::PLAYER_DELTA_POSITION) != 0) {
+      out->mutable_position()->set_x(player.x);
+      out->mutable_position()->set_y(player.y);
+    }
+    if ((mask & lawnmower::PLAYER_DELTA_ROTATION) != 0) {
+      out->set_rotation(player.rotation);
+    }
+    if ((mask & lawnmower::PLAYER_DELTA_IS_ALIVE) != 0) {
+      out->set_is_alive(player.is_alive);
+    }
+    if ((mask & lawnmower::PLAYER_DELTA_LAST_PROCESSED_INPUT_SEQ) != 0) {
+      out->set_last_processed_input_seq(player.last_processed_input_seq);
+    }
+  }
+  for (const auto& enemy : frame.enemies) {
+    auto* out = delta.add_enemies();
+    const uint32_t mask = enemy.changed_mask;
+    out->set_enemy_id(enemy.enemy_id);
+    out->set_changed_mask(mask);
+    if ((mask & lawnmower::ENEMY_DELTA_POSITION) != 0) {
+      out->mutable_position()->set_x(enemy.x);
+      out->mutable_position()->set_y(enemy.y);
+    }
+    if ((mask & lawnmower::ENEMY_DELTA_HEALTH) != 0) {
+      out->set_health(enemy.health);
+    }
+    if ((mask & lawnmower::ENEMY_DELTA_IS_ALIVE) != 0) {
+      out->set_is_alive(enemy.is_alive);
+    }
+  }
+  for (const auto& item : frame.items) {
+    auto* out = delta.add_items();
+    const uint32_t mask = item.changed_mask;
+    out->set_item_id(item.item_id);
+    out->set_changed_mask(mask);
+    if ((mask & lawnmower::ITEM_DELTA_POSITION) != 0) {
+      out->mutable_position()->set_x(item.x);
+      out->mutable_position()->set_y(item.y);
+    }
+    if ((mask & lawnmower::ITEM_DELTA_IS_PICKED) != 0) {
+      out->set_is_picked(item.is_picked);
+    }
+    if ((mask & lawnmower::ITEM_DELTA_TYPE) != 0) {
+      out->set_type_id(item.type_id);
+    }
+  }
+  for (const auto enemy_id : frame.removed_enemy_ids) {
+    delta.add_removed_enemy_ids(enemy_id);
+  }
+  return delta;
+}
+
+void ExpectSameAsMessage(const DeltaFrame& frame, const std::string& label) {
+  const auto message = ToMessage(frame);
+  const std::string expected = message.SerializeAsString();
+  Expect(delta_wire::PayloadSize(frame) == expected.size(),
+         label + ": payload 长度不一致");
+
+  std::string payload(expected.size(), '\0');
+  auto* begin = reinterpret_cast<uint8_t*>(payload.data());
+  Expect(delta_wire::WritePayload(frame, begin) == begin + payload.size(),
+         label + ": 写入长度与计算长度不一致");
+  Expect(payload == expected, label + ": payload 字节与 protobuf 不一致");
+
+  const auto type = lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC;
+  const auto datagram = delta_wire::EncodeDatagram(frame);
+  Expect(datagram.bytes != nullptr &&
+             *datagram.bytes ==
+                 *packet_codec::EncodeDatagram(type, message).bytes,
+         label + ": UDP 数据报不一致");
+  const auto framed = delta_wire::EncodeFramed(frame);
+  Expect(framed.bytes != nullptr &&
+             *framed.bytes == *packet_codec::EncodeFramed(type, message).bytes,
+         label + ": TCP 帧不一致");
+}
+
+void TestEmptyFrame() {
+  DeltaFrame frame;
+  ExpectSameAsMessage(frame, "empty");
+  frame.has_sync_time = true;  // 只有空 Timestamp 子消息
+  ExpectSameAsMessage(frame, "empty_timestamp");
+}
+
+void TestFieldPresence() {
+  DeltaFrame frame;
+  frame.has_sync_time = true;
+  frame.server_time_ms = 1'700'000'000'123ULL;
+  frame.tick = 300;
+  frame.room_id = 9;
+  // optional 字段置位时零值也写出；未置位字段的非零值不写出
+  constexpr uint32_t kScalarBits =
+      lawnmower::PLAYER_DELTA_ROTATION | lawnmower::PLAYER_DELTA_IS_ALIVE |
+      lawnmower::PLAYER_DELTA_LAST_PROCESSED_INPUT_SEQ;
+  frame.players.push_back({1, kScalarBits, 5.0f, 6.0f, 0.0f, false, 0});
+  frame.players.push_back({2, lawnmower::PLAYER_DELTA_POSITION, 0.0f, -0.0f,
+                           45.0f, true, 7});
+  frame.enemies.push_back({3, lawnmower::ENEMY_DELTA_HEALTH, 1.0f, 2.0f, -5,
+                           true});
+  frame.enemies.push_back({4, 0, 1.0f, 2.0f, 10, true});
+  frame.enemies.push_back(
+      {std::numeric_limits<uint32_t>::max(),
+       lawnmower::ENEMY_DELTA_POSITION | lawnmower::ENEMY_DELTA_IS_ALIVE,
+       -123.5f, 1e-30f, 0, false});
+  frame.items.push_back({5,
+                         lawnmower::ITEM_DELTA_POSITION |
+                             lawnmower::ITEM_DELTA_IS_PICKED |
+                             lawnmower::ITEM_DELTA_TYPE,
+                         10.0f, 20.0f, false, 0});
+  frame.items.push_back({0, lawnmower::ITEM_DELTA_TYPE, 0.0f, 0.0f, true,
+                         300});
+  ExpectSameAsMessage(frame, "presence");
+}
+
+void TestRemovedEnemyIds() {
+  DeltaFrame frame;
+  frame.room_id = 2;
+  // 只有移除列表时也不算空帧；id 0 在 packed 字段里同样写出
+  frame.removed_enemy_ids = {7, 0, 300, std::numeric_limits<uint32_t>::max()};
+  Expect(!frame.Empty(), "只有移除列表的帧不应视为空");
+  ExpectSameAsMessage(frame, "removed_only");
+  frame.enemies.push_back({8, lawnmower::ENEMY_DELTA_POSITION, 1.0f, 2.0f, 0,
+                           true});
+  ExpectSameAsMessage(frame, "removed_with_enemies");
+  frame.Clear();
+  Expect(frame.Empty(), "Clear 后应为空帧");
+}
+
+void TestRandomFrames() {
+  uint64_t state = 0x853C49E6748FEA9BULL;
+  const auto next = [&state]() {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(state >> 33);
+  };
+  const auto coord = [&next]() {
+    return static_cast<float>(next() % 400000) / 100.0f - 1000.0f;
+  };
+
+  for (int round = 0; round < 200; ++round) {
+    DeltaFrame frame;
+    frame.has_sync_time = next() % 8 != 0;
+    frame.server_time_ms = next() * 1000ULL;
+    frame.tick = next() % 4 == 0 ? 0 : next();
+    frame.room_id = next() % 100;
+    for (uint32_t i = next() % 5; i > 0; --i) {
+      frame.players.push_back({next() % 8, next() % 16, coord(), coord(),
+                               coord(), next() % 2 == 0,
+                               static_cast<int32_t>(next()) - (1 << 30)});
+    }
+    for (uint32_t i = next() % 60; i > 0; --i) {
+      frame.enemies.push_back({next(), next() % 8, coord(), coord(),
+                               static_cast<int32_t>(next() % 300) - 50,
+                               next() % 2 == 0});
+    }
+    for (uint32_t i = next() % 10; i > 0; --i) {
+      frame.items.push_back({next() % 1000, next() % 16, coord(), coord(),
+                             next() % 2 == 0, next() % 5});
+    }
+    for (uint32_t i = next() % 4 == 0 ? next() % 20 : 0; i > 0; --i) {
+      const uint32_t shift = next() % 31;  // 覆盖 1~5 字节的 varint
+      frame.removed_enemy_ids.push_back(next() >> shift);
+    }
+    ExpectSameAsMessage(frame, "random#" + std::to_string(round));
+
+    lawnmower::Packet packet;
+    lawnmower::S2C_GameStateDeltaSync parsed;
+    Expect(packet.ParseFromString(*delta_wire::EncodeDatagram(frame).bytes) &&
+               parsed.ParseFromString(packet.payload()) &&
+               parsed.enemies_size() ==
+                   static_cast<int>(frame.enemies.size()) &&
+               parsed.removed_enemy_ids_size() ==
+                   static_cast<int>(frame.removed_enemy_ids.size()),
+           "数据报应能按 protobuf 解析");
+  }
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"empty_frame", TestEmptyFrame},
+      {"field_presence", TestFieldPresence},
+      {"removed_enemy_ids", TestRemovedEnemyIds},
+      {"random_frames", TestRandomFrames},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "delta_wire_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "delta_wire_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
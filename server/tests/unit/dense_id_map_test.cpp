@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "game/managers/dense_id_map.hpp"
+
+namespace {
+struct Value {
+  int32_t hp = 0;
+  std::vector<int> payload;  // 检查移动后内容完整
+};
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 每个 id 都能 find 到自身，且槽位内容与 id 对应
+void ExpectConsistent(const DenseIdMap<Value>& map, const std::string& label) {
+  for (const auto& [id, value] : map) {
+    const auto it = map.find(id);
+    Expect(it != map.end() && it->first == id,
+           label + ": id -> 槽位映射与存储不一致");
+    Expect(value.hp == static_cast<int32_t>(id) * 10 &&
+               value.payload.size() == 1 &&
+               value.payload[0] == static_cast<int>(id),
+           label + ": 槽位内容与 id 不对应");
+  }
+}
+
+Value MakeValue(uint32_t id) {
+  return Value{static_cast<int32_t>(id) * 10, {static_cast<int>(id)}};
+}
+
+void TestEmplaceFindErase() {
+  DenseIdMap<Value> map;
+  map.reserve(8);
+  for (uint32_t id = 1; id <= 20; ++id) {
+    Expect(map.emplace(id, MakeValue(id)).second, "新 id 应插入成功");
+  }
+  Expect(!map.emplace(5, MakeValue(99)).second, "重复 id 不应插入");
+  Expect(map.find(5)->second.hp == 50, "重复插入不应覆盖原值");
+  Expect(map.find(21) == map.end(), "不存在的 id 应返回 end");
+  ExpectConsistent(map, "after_emplace");
+
+  // `it = erase(it)` 遍历删除偶数 id，不应漏掉被搬入当前槽位的元素
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->first % 2 == 0) {
+      it = map.erase(it);
+      continue;
+    }
+    ++it;
+  }
+  Expect(map.size() == 10, "应删除全部偶数 id");
+  for (uint32_t id = 1; id <= 20; ++id) {
+    Expect((map.find(id) != map.end()) == (id % 2 == 1),
+           "删除后查找结果不正确");
+  }
+  ExpectConsistent(map, "after_erase");
+}
+
+void TestSortByKeyFixesSlots() {
+  DenseIdMap<Value> map;
+  const std::vector<uint32_t> ids = {17, 3, 42, 8, 25, 1, 30};
+  for (const uint32_t id : ids) {
+    map.emplace(id, MakeValue(id));
+  }
+  // 按 id 降序重排
+  map.SortByKey([](uint32_t id, const Value&) {
+    return static_cast<uint64_t>(1000 - id);
+  });
+  std::vector<uint32_t> order;
+  for (const auto& [id, _] : map) {
+    order.push_back(id);
+  }
+  std::vector<uint32_t> expected = ids;
+  std::sort(expected.begin(), expected.end(), std::greater<uint32_t>());
+  Expect(order == expected, "重排后遍历顺序应与键顺序一致");
+  ExpectConsistent(map, "after_sort");
+
+  // 重排后继续增删，映射仍正确
+  map.erase(map.find(42));
+  map.emplace(7, MakeValue(7));
+  ExpectConsistent(map, "after_sort_mutation");
+
+  // 键相同保持原槽位顺序
+  std::vector<uint32_t> before;
+  for (const auto& [id, _] : map) {
+    before.push_back(id);
+  }
+  map.SortByKey([](uint32_t, const Value&) { return uint64_t{0}; });
+  std::vector<uint32_t> after;
+  for (const auto& [id, _] : map) {
+    after.push_back(id);
+  }
+  Expect(after == before, "键相同时应保持原顺序");
+  ExpectConsistent(map, "after_equal_keys");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"emplace_find_erase", TestEmplaceFindErase},
+      {"sort_by_key_fixes_slots", TestSortByKeyFixesSlots},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "dense_id_map_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "dense_id_map_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,231 @@
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_lod.hpp"
+#include "internal/game_manager_steering.hpp"
+
+namespace {
+using game_manager_steering::SimdLevel;
+using game_manager_steering::SteeringBatch;
+using game_manager_steering::SteerParams;
+
+constexpr SimdLevel kLevels[] = {SimdLevel::kScalar, SimdLevel::kSse42,
+                                 SimdLevel::kAvx2};
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+bool SameBits(float a, float b) {
+  uint32_t ua = 0;
+  uint32_t ub = 0;
+  std::memcpy(&ua, &a, sizeof(a));
+  std::memcpy(&ub, &b, sizeof(b));
+  return ua == ub;
+}
+
+struct Rng {
+  uint32_t state = 1;
+  float NextUnit() {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+  }
+};
+
+void FillRandomBatch(std::size_t count, float map_w, float map_h, Rng* rng,
+                     SteeringBatch* batch) {
+  batch->ResizeEnemies(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    batch->xs[i] = rng->NextUnit() * map_w;
+    batch->ys[i] = rng->NextUnit() * map_h;
+    // 目标点可能在地图外或与自身重合，覆盖 clamp 与原地不动
+    const float r = rng->NextUnit();
+    if (r < 0.1f) {
+      batch->goal_xs[i] = batch->xs[i];
+      batch->goal_ys[i] = batch->ys[i];
+    } else {
+      batch->goal_xs[i] = (rng->NextUnit() * 1.2f - 0.1f) * map_w;
+      batch->goal_ys[i] = (rng->NextUnit() * 1.2f - 0.1f) * map_h;
+    }
+    batch->speeds[i] = r < 0.2f ? 4000.0f : 30.0f + rng->NextUnit() * 90.0f;
+    // LOD 降频的敌人按累积时长前进
+    batch->dts[i] = (rng->NextUnit() < 0.5f ? 1.0f : 4.0f) / 60.0f;
+  }
+}
+
+void TestSteerMatchesScalar() {
+  Rng rng{77u};
+  const SteerParams params{1280.0f, 720.0f};
+  SteeringBatch reference;
+  SteeringBatch batch;
+  for (int round = 0; round < 300; ++round) {
+    const std::size_t count = static_cast<std::size_t>(round % 41);
+    FillRandomBatch(count, params.map_w, params.map_h, &rng, &reference);
+    game_manager_steering::SteerTowardGoalsAt(SimdLevel::kScalar, params,
+                                              &reference);
+    for (const SimdLevel level : kLevels) {
+      batch = reference;
+      game_manager_steering::SteerTowardGoalsAt(level, params, &batch);
+      const std::string where =
+          "round#" + std::to_string(round) + " level=" +
+          game_manager_simd::SimdLevelName(level);
+      for (std::size_t i = 0; i < count; ++i) {
+        Expect(SameBits(batch.out_xs[i], reference.out_xs[i]) &&
+                   SameBits(batch.out_ys[i], reference.out_ys[i]),
+               where + ": 位置与标量版本不逐位一致");
+        Expect(batch.moved[i] == reference.moved[i],
+               where + ": moved 标记与标量版本不一致");
+      }
+    }
+  }
+}
+
+void TestSteerEdgeCases() {
+  const SteerParams params{100.0f, 100.0f};
+  SteeringBatch batch;
+  batch.ResizeEnemies(3);
+  // 0: 与目标重合；1: 冲出右边界被夹住；2: 位移小于阈值
+  batch.xs = {10.0f, 99.0f, 50.0f};
+  batch.ys = {10.0f, 50.0f, 50.0f};
+  batch.goal_xs = {10.0f, 500.0f, 60.0f};
+  batch.goal_ys = {10.0f, 50.0f, 50.0f};
+  batch.speeds = {60.0f, 60.0f, 1e-5f};
+  batch.dts = {0.5f, 0.5f, 0.5f};
+  for (const SimdLevel level : kLevels) {
+    game_manager_steering::SteerTowardGoalsAt(level, params, &batch);
+    Expect(batch.moved[0] == 0 && batch.out_xs[0] == 10.0f,
+           "与目标重合时不应移动");
+    Expect(batch.moved[1] == 1 && batch.out_xs[1] == 100.0f,
+           "越界位置应夹到地图边缘");
+    Expect(batch.moved[2] == 0, "位移小于阈值时不应标记移动");
+  }
+}
+
+void TestNearestPlayersMatchScalar() {
+  Rng rng{5u};
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<int32_t> reference;
+  std::vector<int32_t> out;
+  for (int round = 0; round < 200; ++round) {
+    const std::size_t players = static_cast<std::size_t>(round % 5);
+    const std::size_t count = static_cast<std::size_t>(round % 29);
+    std::vector<float> pxs(players);
+    std::vector<float> pys(players);
+    for (std::size_t p = 0; p < players; ++p) {
+      pxs[p] = rng.NextUnit() * 1000.0f;
+      pys[p] = rng.NextUnit() * 1000.0f;
+    }
+    xs.resize(count);
+    ys.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      xs[i] = rng.NextUnit() * 1000.0f;
+      ys[i] = rng.NextUnit() * 1000.0f;
+    }
+    reference.assign(count, -2);
+    game_manager_steering::NearestPlayersAt(
+        SimdLevel::kScalar, pxs.data(), pys.data(), players, xs.data(),
+        ys.data(), count, reference.data());
+    for (const SimdLevel level : kLevels) {
+      out.assign(count, -2);
+      game_manager_steering::NearestPlayersAt(level, pxs.data(), pys.data(),
+                                              players, xs.data(), ys.data(),
+                                              count, out.data());
+      Expect(out == reference, "最近玩家下标与标量版本不一致");
+    }
+    if (players == 0) {
+      for (const int32_t index : reference) {
+        Expect(index == -1, "无玩家时下标应为 -1");
+      }
+    }
+  }
+
+  // 等距时取下标小者（调用方按 id 升序排列玩家）
+  const std::vector<float> pxs = {0.0f, 20.0f, 10.0f};
+  const std::vector<float> pys = {0.0f, 0.0f, 10.0f};
+  const std::vector<float> ex(9, 10.0f);
+  const std::vector<float> ey(9, 0.0f);
+  for (const SimdLevel level : kLevels) {
+    out.assign(ex.size(), -2);
+    game_manager_steering::NearestPlayersAt(level, pxs.data(), pys.data(),
+                                            pxs.size(), ex.data(), ey.data(),
+                                            ex.size(), out.data());
+    for (const int32_t index : out) {
+      Expect(index == 0, "等距时应取下标较小的玩家");
+    }
+  }
+}
+
+void TestLodTiersAndStagger() {
+  using game_manager_lod::LodTier;
+  const auto lod = game_manager_lod::MakeLodConfig(100.0f, 300.0f, 2, 4);
+  Expect(game_manager_lod::ClassifyLod(lod, 99.0f * 99.0f) == LodTier::kNear,
+         "近距离应为 near 档");
+  Expect(game_manager_lod::ClassifyLod(lod, 100.0f * 100.0f) == LodTier::kMid,
+         "达到 mid 距离应为 mid 档");
+  Expect(game_manager_lod::ClassifyLod(lod, 300.0f * 300.0f) == LodTier::kFar,
+         "达到 far 距离应为 far 档");
+
+  // 每个实体在间隔内恰好更新一次，且不同 id 错开到不同 tick
+  for (const auto& [tier, interval] :
+       {std::pair{LodTier::kNear, 1u}, std::pair{LodTier::kMid, 2u},
+        std::pair{LodTier::kFar, 4u}}) {
+    std::vector<uint32_t> per_tick(interval, 0);
+    for (uint32_t id = 1; id <= 64; ++id) {
+      uint32_t updates = 0;
+      for (uint64_t tick = 0; tick < interval; ++tick) {
+        if (game_manager_lod::ShouldSimulate(lod, tier, tick, id)) {
+          updates += 1;
+          per_tick[tick] += 1;
+        }
+      }
+      Expect(updates == 1, "间隔内应恰好更新一次");
+    }
+    for (const uint32_t n : per_tick) {
+      Expect(n == 64 / interval, "降频更新应均摊到各 tick");
+    }
+  }
+
+  // 距离 <= 0 时关闭 LOD
+  const auto off = game_manager_lod::MakeLodConfig(0.0f, 300.0f, 2, 4);
+  Expect(game_manager_lod::ClassifyLod(off, 1e12f) == LodTier::kNear,
+         "关闭 LOD 时应全部为 near 档");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"steer_matches_scalar", TestSteerMatchesScalar},
+      {"steer_edge_cases", TestSteerEdgeCases},
+      {"nearest_players_match_scalar", TestNearestPlayersMatchScalar},
+      {"lod_tiers_and_stagger", TestLodTiersAndStagger},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "enemy_steering_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "enemy_steering_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
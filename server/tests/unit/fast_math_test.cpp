@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_fastmath.hpp"
+
+namespace {
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 角度差折回 [-180, 180]（±180 视为同一朝向）
+double WrapDeg(double d) {
+  while (d > 180.0) {
+    d -= 360.0;
+  }
+  while (d < -180.0) {
+    d += 360.0;
+  }
+  return d;
+}
+
+void TestRsqrtErrorBound() {
+  // 逐个遍历 [1, 4) 内全部 float：初值的误差只与尾数和指数奇偶有关
+  double worst = 0.0;
+  uint32_t bits = 0x3f800000u;  // 1.0f
+  const uint32_t end = 0x40800000u;  // 4.0f
+  for (; bits < end; ++bits) {
+    float x = 0.0f;
+    std::memcpy(&x, &bits, sizeof(x));
+    const double exact = 1.0 / std::sqrt(static_cast<double>(x));
+    const double rel =
+        std::abs(game_manager_fastmath::FastRsqrt(x) - exact) / exact;
+    worst = std::max(worst, rel);
+  }
+  Expect(worst < game_manager_fastmath::kRsqrtMaxRelError,
+         "FastRsqrt 相对误差超出上界: " + std::to_string(worst));
+
+  // 其余量级抽查
+  for (float x = 1e-6f; x < 1e12f; x *= 1.37f) {
+    const double exact = 1.0 / std::sqrt(static_cast<double>(x));
+    const double rel =
+        std::abs(game_manager_fastmath::FastRsqrt(x) - exact) / exact;
+    Expect(rel < game_manager_fastmath::kRsqrtMaxRelError,
+           "FastRsqrt 大跨度量级误差超出上界");
+  }
+}
+
+void TestAtan2ErrorBound() {
+  double worst = 0.0;
+  constexpr int kSteps = 720000;
+  for (const float radius : {1e-3f, 1.0f, 37.5f, 4096.0f}) {
+    for (int i = 0; i < kSteps; ++i) {
+      const double a = 2.0 * std::numbers::pi * i / kSteps - std::numbers::pi;
+      const float x = static_cast<float>(std::cos(a)) * radius;
+      const float y = static_cast<float>(std::sin(a)) * radius;
+      const double exact = std::atan2(static_cast<double>(y),
+                                      static_cast<double>(x)) *
+                           180.0 / std::numbers::pi;
+      const double err =
+          std::abs(WrapDeg(game_manager_fastmath::FastAtan2Deg(y, x) - exact));
+      worst = std::max(worst, err);
+    }
+  }
+  Expect(worst < game_manager_fastmath::kAtan2MaxErrorDeg,
+         "FastAtan2Deg 误差超出上界: " + std::to_string(worst));
+
+  // 坐标轴与零向量
+  Expect(game_manager_fastmath::FastAtan2Deg(0.0f, 1.0f) == 0.0f,
+         "+x 轴应为 0°");
+  Expect(std::abs(game_manager_fastmath::FastAtan2Deg(1.0f, 0.0f) - 90.0f) <
+             1e-4f,
+         "+y 轴应为 90°");
+  Expect(std::abs(game_manager_fastmath::FastAtan2Deg(-1.0f, 0.0f) + 90.0f) <
+             1e-4f,
+         "-y 轴应为 -90°");
+  Expect(std::abs(game_manager_fastmath::FastAtan2Deg(0.0f, -1.0f) - 180.0f) <
+             1e-4f,
+         "-x 轴应为 180°");
+  Expect(game_manager_fastmath::FastAtan2Deg(0.0f, 0.0f) == 0.0f,
+         "零向量应为 0°");
+}
+
+void TestDirFromDegErrorBound() {
+  double worst = 0.0;
+  for (int i = -720000; i <= 720000; ++i) {
+    const float deg = static_cast<float>(i) * 0.001f;
+    const double rad = static_cast<double>(deg) * std::numbers::pi / 180.0;
+    const auto [c, s] = game_manager_fastmath::FastDirFromDeg(deg);
+    worst = std::max(worst, std::abs(c - std::cos(rad)));
+    worst = std::max(worst, std::abs(s - std::sin(rad)));
+  }
+  Expect(worst < game_manager_fastmath::kDirMaxError,
+         "FastDirFromDeg 误差超出上界: " + std::to_string(worst));
+
+  const auto [c90, s90] = game_manager_fastmath::FastDirFromDeg(90.0f);
+  Expect(c90 == 0.0f && s90 == 1.0f, "90° 应精确落在 +y 轴");
+  const auto [c_inf, s_inf] = game_manager_fastmath::FastDirFromDeg(
+      std::numeric_limits<float>::infinity());
+  Expect(std::isnan(c_inf) && std::isnan(s_inf), "非有限输入应退回 libm");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"rsqrt_error_bound", TestRsqrtErrorBound},
+      {"atan2_error_bound", TestAtan2ErrorBound},
+      {"dir_from_deg_error_bound", TestDirFromDegErrorBound},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "fast_math_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "fast_math_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_interest.hpp"
+#include "internal/game_manager_spatial.hpp"
+#include "message.pb.h"
+
+namespace {
+using game_manager_interest::InterestParams;
+using game_manager_interest::InterestUpdate;
+using game_manager_spatial::SpatialIndex;
+
+struct Point {
+  uint32_t id = 0;
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+void BuildIndex(const std::vector<Point>& points, SpatialIndex* index) {
+  index->Reset(4000.0f, 3000.0f, 100.0f);
+  for (const auto& p : points) {
+    index->Insert(p.id, p.x, p.y);
+  }
+  index->Build();
+}
+
+bool InRect(const Point& p, float x, float y, float half_w, float half_h) {
+  return p.x >= x - half_w && p.x <= x + half_w && p.y >= y - half_h &&
+         p.y <= y + half_h;
+}
+
+void TestEnterAndLeaveWithHysteresis() {
+  const InterestParams params{300.0f, 200.0f, 50.0f};
+  // 视野 300x200，进入边界 350x250，离开边界 400x300
+  std::vector<Point> points = {
+      {1, 1000.0f, 1000.0f},  // 视野内
+      {2, 1340.0f, 1000.0f},  // 进入余量内
+      {3, 1380.0f, 1000.0f},  // 滞回带内，尚未进入
+      {4, 3000.0f, 2500.0f},  // 远处
+  };
+  SpatialIndex index;
+  BuildIndex(points, &index);
+  InterestUpdate update;
+  std::vector<uint32_t> previous;
+  game_manager_interest::UpdateInterestSet(index, 1000.0f, 1000.0f, params,
+                                           previous, &update);
+  Expect(update.ids == std::vector<uint32_t>({1, 2}), "首次兴趣集不正确");
+  Expect(update.entered == update.ids && update.left.empty(),
+         "首次应全部为进入");
+  previous = update.ids;
+
+  // 2 移到滞回带：留在集合里；3 移进余量：进入
+  points[1].x = 1390.0f;
+  points[2].x = 1300.0f;
+  BuildIndex(points, &index);
+  game_manager_interest::UpdateInterestSet(index, 1000.0f, 1000.0f, params,
+                                           previous, &update);
+  Expect(update.ids == std::vector<uint32_t>({1, 2, 3}), "滞回带内应保留");
+  Expect(update.entered == std::vector<uint32_t>({3}) && update.left.empty(),
+         "只有 3 应为进入");
+  previous = update.ids;
+
+  // 2 超出离开边界、1 从索引中消失（死亡）：都算离开
+  points[1].y = 1301.0f;
+  points.erase(points.begin());
+  BuildIndex(points, &index);
+  game_manager_interest::UpdateInterestSet(index, 1000.0f, 1000.0f, params,
+                                           previous, &update);
+  Expect(update.ids == std::vector<uint32_t>({3}), "超出离开边界应移出");
+  Expect(update.entered.empty() && update.left == std::vector<uint32_t>({1, 2}),
+         "1、2 应为离开");
+}
+
+void TestRandomWalkInvariants() {
+  const InterestParams params{400.0f, 250.0f, 80.0f};
+  std::vector<Point> points;
+  uint32_t rng = 12345u;
+  const auto next_unit = [&rng]() {
+    rng = rng * 1664525u + 1013904223u;
+    return static_cast<float>(rng >> 8) / static_cast<float>(1u << 24);
+  };
+  for (uint32_t id = 1; id <= 800; ++id) {
+    points.push_back({id, next_unit() * 4000.0f, next_unit() * 3000.0f});
+  }
+
+  SpatialIndex index;
+  InterestUpdate update;
+  std::vector<uint32_t> previous;
+  float cx = 2000.0f;
+  float cy = 1500.0f;
+  std::vector<uint32_t> expected;
+  for (int step = 0; step < 200; ++step) {
+    for (auto& p : points) {
+      p.x += (next_unit() - 0.5f) * 60.0f;
+      p.y += (next_unit() - 0.5f) * 60.0f;
+    }
+    cx += (next_unit() - 0.5f) * 120.0f;
+    cy += (next_unit() - 0.5f) * 120.0f;
+    BuildIndex(points, &index);
+    game_manager_interest::UpdateInterestSet(index, cx, cy, params, previous,
+                                             &update);
+
+    // 对照：进入矩形内的全部 + 离开矩形内且原本在集合里的
+    expected.clear();
+    for (const auto& p : points) {
+      const float enter_w = params.half_width + params.margin;
+      const float enter_h = params.half_height + params.margin;
+      const bool inner = InRect(p, cx, cy, enter_w, enter_h);
+      const bool outer = InRect(p, cx, cy, enter_w + params.margin,
+                                enter_h + params.margin);
+      if (inner || (outer && std::binary_search(previous.begin(),
+                                                previous.end(), p.id))) {
+        expected.push_back(p.id);
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+    Expect(update.ids == expected, "兴趣集应与暴力结果一致");
+
+    std::vector<uint32_t> entered;
+    std::set_difference(expected.begin(), expected.end(), previous.begin(),
+                        previous.end(), std::back_inserter(entered));
+    std::vector<uint32_t> left;
+    std::set_difference(previous.begin(), previous.end(), expected.begin(),
+                        expected.end(), std::back_inserter(left));
+    Expect(update.entered == entered && update.left == left,
+           "进入/离开应为前后集合之差");
+    previous = update.ids;
+  }
+}
+
+void TestFilterDeltaFrame() {
+  delta_wire::DeltaFrame shared;
+  shared.has_sync_time = true;
+  shared.tick = 42;
+  shared.room_id = 3;
+  shared.players.push_back({1, lawnmower::PLAYER_DELTA_POSITION, 1.0f, 2.0f,
+                            0.0f, true, 0});
+  shared.items.push_back({5, lawnmower::ITEM_DELTA_IS_PICKED, 0.0f, 0.0f,
+                          true, 1});
+  for (const uint32_t enemy_id : {10u, 11u, 12u, 13u}) {
+    shared.enemies.push_back({enemy_id, lawnmower::ENEMY_DELTA_HEALTH, 0.0f,
+                              0.0f, 5, true});
+  }
+
+  InterestUpdate update;
+  update.ids = {11, 12, 20};
+  update.entered = {12, 20};  // 12 刚进入，另发完整状态
+  update.left = {10, 30};
+  delta_wire::DeltaFrame out;
+  out.enemies.push_back({99, 0, 0.0f, 0.0f, 0, true});  // 旧内容应被覆盖
+  game_manager_interest::FilterDeltaFrame(shared, update, &out);
+  Expect(out.has_sync_time && out.tick == 42 && out.room_id == 3,
+         "帧头应沿用共享增量");
+  Expect(out.players.size() == 1 && out.items.size() == 1,
+         "玩家与道具不参与过滤");
+  Expect(out.enemies.size() == 1 && out.enemies.front().enemy_id == 11,
+         "只保留兴趣集内且非刚进入的敌人");
+  Expect(out.removed_enemy_ids == std::vector<uint32_t>({10, 30}),
+         "离开的敌人应写入移除列表");
+}
+
+void TestEnteredResync() {
+  using Resync = std::vector<std::pair<uint32_t, uint32_t>>;
+  Resync resync;
+  std::vector<uint32_t> due = {77};  // 旧内容应被清空
+  InterestUpdate update;
+  update.ids = {5, 7};
+  update.entered = {7, 5};
+  game_manager_interest::AdvanceEnteredResync(update, 2, &resync, &due);
+  Expect(due.empty(), "刚进入的敌人本次已发完整状态，不应补发");
+  Expect(resync == Resync({{5, 2}, {7, 2}}), "进入的敌人应按 id 升序加入");
+
+  update.ids = {3, 5, 7};
+  update.entered = {3};
+  game_manager_interest::AdvanceEnteredResync(update, 2, &resync, &due);
+  Expect(due == std::vector<uint32_t>({5, 7}), "上次进入的敌人应补发");
+  Expect(resync == Resync({{3, 2}, {5, 1}, {7, 1}}), "补发后次数减一");
+
+  // 7 离开兴趣集，不再补发；5 补满次数后移除
+  update.ids = {3, 5};
+  update.entered.clear();
+  game_manager_interest::AdvanceEnteredResync(update, 2, &resync, &due);
+  Expect(due == std::vector<uint32_t>({3, 5}), "只补发仍在兴趣集内的敌人");
+  Expect(resync == Resync({{3, 1}}), "用完次数或已离开的应移除");
+
+  game_manager_interest::AdvanceEnteredResync(update, 2, &resync, &due);
+  Expect(due == std::vector<uint32_t>({3}) && resync.empty(),
+         "补发次数用完后列表应清空");
+  game_manager_interest::AdvanceEnteredResync(update, 2, &resync, &due);
+  Expect(due.empty(), "列表为空时不应补发");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"enter_and_leave_with_hysteresis", TestEnterAndLeaveWithHysteresis},
+      {"random_walk_invariants", TestRandomWalkInvariants},
+      {"filter_delta_frame", TestFilterDeltaFrame},
+      {"entered_resync", TestEnteredResync},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "interest_filter_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "interest_filter_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_nav.hpp"
+#include "internal/game_manager_path_cache.hpp"
+#include "internal/game_manager_path_planner.hpp"
+
+namespace {
+using game_manager_nav::NavCell;
+using game_manager_nav::NavGrid;
+using game_manager_nav::NavScratch;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+void TestAstarBasicPath() {
+  const NavGrid grid{13, 8, 100};
+  NavScratch scratch;
+  std::vector<NavCell> path;
+  const bool found = game_manager_nav::FindPathAstar(grid, {0, 0}, {12, 7},
+                                                     &path, &scratch);
+  Expect(found, "开阔网格应能找到路径");
+  Expect(path.front() == NavCell(0, 0), "路径应以起点开始");
+  Expect(path.back() == NavCell(12, 7), "路径应以终点结束");
+  // 8 邻接下步数 = max(dx, dy) + 1
+  Expect(path.size() == 13, "路径长度应为切比雪夫距离+1");
+
+  const bool out_of_range = game_manager_nav::FindPathAstar(
+      grid, {0, 0}, {13, 0}, &path, &scratch);
+  Expect(!out_of_range && path.empty(), "越界终点应失败并清空输出");
+}
+
+// 开阔网格上最优代价为 octile 距离；用来校验索引堆 decrease-key 的正确性
+void TestAstarOptimalCostWithReusedScratch() {
+  const NavGrid grid{64, 48, 100};
+  NavScratch scratch;
+  std::vector<NavCell> path;
+  for (int i = 0; i < 200; ++i) {
+    const NavCell start{(i * 17) % 64, (i * 5) % 48};
+    const NavCell goal{(i * 29 + 3) % 64, (i * 11 + 7) % 48};
+    if (start == goal) {
+      continue;
+    }
+    Expect(game_manager_nav::FindPathAstar(grid, start, goal, &path, &scratch),
+           "开阔网格应能找到路径");
+    float cost = 0.0f;
+    for (std::size_t k = 1; k < path.size(); ++k) {
+      const bool straight = path[k].first == path[k - 1].first ||
+                            path[k].second == path[k - 1].second;
+      cost += straight ? 1.0f : std::numbers::sqrt2_v<float>;
+    }
+    const float dx = static_cast<float>(std::abs(goal.first - start.first));
+    const float dy = static_cast<float>(std::abs(goal.second - start.second));
+    const float diag_extra = std::numbers::sqrt2_v<float> - 1.0f;
+    const float optimal = std::max(dx, dy) + diag_extra * std::min(dx, dy);
+    Expect(std::fabs(cost - optimal) < 1e-3f, "路径代价应为最优 octile 距离");
+  }
+  Expect(scratch.heap.capacity() >= 64u * 48u, "开放列表应按格子数预分配");
+}
+
+void TestPlannerMatchesSyncAndKeepsOrder() {
+  const NavGrid grid{40, 30, 100};
+  game_manager_path_planner::PathPlannerPool pool(3);
+  auto channel = std::make_shared<game_manager_path_planner::PathPlanChannel>();
+
+  std::vector<std::pair<NavCell, NavCell>> queries;
+  for (int i = 0; i < 64; ++i) {
+    queries.push_back({{i % 40, (i * 7) % 30}, {(i * 13) % 40, (i * 3) % 30}});
+  }
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    game_manager_path_planner::PathRequest request;
+    request.enemy_id = static_cast<uint32_t>(i + 1);
+    request.request_seq = 1;
+    request.grid = grid;
+    request.start = queries[i].first;
+    request.goal = queries[i].second;
+    pool.Submit(channel, request);
+  }
+
+  std::vector<game_manager_path_planner::PathResult> results;
+  channel->Collect(true, &results);
+  Expect(results.size() == queries.size(), "wait_all 后应收齐全部结果");
+  Expect(channel->InFlight() == 0, "收齐后不应有在途请求");
+
+  NavScratch scratch;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const auto& result = results[i];
+    Expect(result.order == i, "结果应按提交顺序排序");
+    Expect(result.enemy_id == i + 1, "结果应携带原始 enemy_id");
+    std::vector<NavCell> expected;
+    const bool found = game_manager_nav::FindPathAstar(
+        grid, queries[i].first, queries[i].second, &expected, &scratch);
+    const bool expected_found = found && expected.size() > 1;
+    Expect(result.found == expected_found, "异步结果与同步寻路是否成功不一致");
+    if (expected_found) {
+      Expect(result.path == expected, "异步路径应与同步寻路逐格一致");
+    }
+  }
+}
+
+void TestPathCacheLruEvictionInvalidatesRefs() {
+  const NavGrid grid{13, 8, 100};
+  game_manager_path_cache::PathCache cache;
+  cache.Init(grid, 2);
+  NavScratch scratch;
+  std::vector<NavCell> path;
+
+  auto insert = [&](const NavCell& start, const NavCell& goal) {
+    Expect(game_manager_nav::FindPathAstar(grid, start, goal, &path, &scratch),
+           "开阔网格应能找到路径");
+    game_manager_path_cache::PathRef ref;
+    Expect(cache.Insert(start, goal, path, &ref), "写入缓存应成功");
+    return ref;
+  };
+
+  const auto ref_a = insert({0, 0}, {12, 7});
+  Expect(cache.IsLive(ref_a) && ref_a.length == path.size(), "引用应有效");
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    Expect(cache.CellAt(ref_a, i) == path[i], "缓存路径应与原路径逐格一致");
+  }
+  const auto ref_b = insert({0, 7}, {6, 3});
+
+  game_manager_path_cache::PathRef hit;
+  Expect(cache.Lookup({0, 0}, {12, 7}, &hit), "已写入的起终点应命中");
+  Expect(hit.offset == ref_a.offset && hit.generation == ref_a.generation,
+         "命中应返回同一份路径");
+
+  // 容量为 2：刚命中的 A 是最近使用，写入 C 时应淘汰 B
+  const auto ref_c = insert({12, 0}, {3, 5});
+  Expect(cache.IsLive(ref_a), "最近使用的条目不应被淘汰");
+  Expect(!cache.IsLive(ref_b), "被淘汰槽位的旧引用应失效");
+  Expect(cache.IsLive(ref_c) && cache.Size() == 2, "缓存条目数应受容量限制");
+  Expect(!cache.Lookup({0, 7}, {6, 3}, &hit), "被淘汰的起终点不应命中");
+}
+
+void TestPathCachePinnedEntriesSurviveEviction() {
+  const NavGrid grid{13, 8, 100};
+  game_manager_path_cache::PathCache cache;
+  cache.Init(grid, 2);
+  NavScratch scratch;
+  std::vector<NavCell> path;
+
+  auto insert = [&](const NavCell& start, const NavCell& goal) {
+    Expect(game_manager_nav::FindPathAstar(grid, start, goal, &path, &scratch),
+           "开阔网格应能找到路径");
+    game_manager_path_cache::PathRef ref;
+    Expect(cache.Insert(start, goal, path, &ref), "写入缓存应成功");
+    return ref;
+  };
+
+  // A 被敌人引用：即使最久未用也不能被淘汰
+  const auto ref_a = insert({0, 0}, {12, 7});
+  const std::vector<NavCell> path_a = path;
+  cache.Pin(ref_a);
+  const auto ref_b = insert({0, 7}, {6, 3});
+  const auto ref_c = insert({12, 0}, {3, 5});
+  Expect(cache.IsLive(ref_a), "被 Pin 的条目不应被淘汰");
+  Expect(!cache.IsLive(ref_b) && cache.IsLive(ref_c), "应淘汰未被引用的 B");
+
+  // 两个槽位都被引用时扩容，而不是写入失败
+  cache.Pin(ref_c);
+  const auto ref_d = insert({6, 0}, {6, 7});
+  Expect(cache.IsLive(ref_a) && cache.IsLive(ref_c) && cache.IsLive(ref_d),
+         "全部被引用时应扩容保留所有条目");
+  Expect(cache.Capacity() == 3 && cache.Size() == 3, "应只扩容一个槽位");
+  for (std::size_t i = 0; i < path_a.size(); ++i) {
+    Expect(cache.CellAt(ref_a, i) == path_a[i], "扩容后旧引用的路径应保持不变");
+  }
+
+  // 扩容以初始容量的两倍为上限，之后全部被引用时写入失败
+  cache.Pin(ref_d);
+  const auto ref_e = insert({0, 5}, {12, 2});
+  cache.Pin(ref_e);
+  Expect(cache.Capacity() == 4, "扩容应止于上限");
+  Expect(game_manager_nav::FindPathAstar(grid, {3, 0}, {9, 7}, &path,
+                                         &scratch),
+         "开阔网格应能找到路径");
+  game_manager_path_cache::PathRef overflow;
+  Expect(!cache.Insert({3, 0}, {9, 7}, path, &overflow),
+         "扩到上限且全部被引用时写入应失败");
+  Expect(cache.Capacity() == 4 && cache.Size() == 4 &&
+             cache.IsLive(ref_a) && cache.IsLive(ref_e),
+         "写入失败不应影响已有条目");
+
+  // Unpin 后重新参与 LRU：刷新 D、C 后 A 最久未用，下一次写入淘汰 A
+  cache.Unpin(ref_a);
+  cache.Unpin(ref_c);
+  game_manager_path_cache::PathRef hit;
+  Expect(cache.Lookup({6, 0}, {6, 7}, &hit) &&
+             cache.Lookup({12, 0}, {3, 5}, &hit),
+         "D、C 应命中");
+  insert({0, 3}, {12, 3});
+  Expect(!cache.IsLive(ref_a) && cache.IsLive(ref_c),
+         "Unpin 后应按 LRU 正常淘汰");
+}
+
+void TestPathCacheWideGrid() {
+  // 400x300 = 120000 格，超过 uint16 索引上限：缓存改用 uint32 存储而不是禁用
+  const NavGrid grid{400, 300, 100};
+  game_manager_path_cache::PathCache cache;
+  cache.Init(grid, 4);
+  Expect(cache.Enabled() && !cache.CompactCells(), "大网格应启用宽索引缓存");
+  NavScratch scratch;
+  std::vector<NavCell> path;
+  Expect(game_manager_nav::FindPathAstar(grid, {0, 0}, {399, 299}, &path,
+                                         &scratch),
+         "大网格应能找到路径");
+  game_manager_path_cache::PathRef ref;
+  Expect(cache.Insert({0, 0}, {399, 299}, path, &ref), "大网格写入缓存应成功");
+  Expect(cache.IsLive(ref) && ref.length == path.size(), "引用应有效");
+  for (std::size_t i = 0; i < path.size(); ++i) {
+    Expect(cache.CellAt(ref, i) == path[i], "宽索引路径应与原路径逐格一致");
+  }
+  Expect(cache.CellIndexAt(ref, path.size() - 1) == 299u * 400u + 399u,
+         "终点格索引应超过 uint16 范围且保持不变");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"astar_basic_path", TestAstarBasicPath},
+      {"astar_optimal_cost_with_reused_scratch",
+       TestAstarOptimalCostWithReusedScratch},
+      {"planner_matches_sync_and_keeps_order",
+       TestPlannerMatchesSyncAndKeepsOrder},
+      {"path_cache_lru_eviction_invalidates_refs",
+       TestPathCacheLruEvictionInvalidatesRefs},
+      {"path_cache_pinned_entries_survive_eviction",
+       TestPathCachePinnedEntriesSurviveEviction},
+      {"path_cache_wide_grid", TestPathCacheWideGrid},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "nav_path_planner_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "nav_path_planner_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
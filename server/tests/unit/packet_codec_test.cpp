@@ -0,0 +1,150 @@
+#include <arpa/inet.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "message.pb.h"
+#include "network/packet_codec.hpp"
+
+namespace {
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 旧写法：message 序列化 -> Packet.payload -> Packet 再序列化
+std::string LegacyBody(lawnmower::MessageType type,
+                       const google::protobuf::Message& message) {
+  lawnmower::Packet packet;
+  packet.set_msg_type(type);
+  packet.set_payload(message.SerializeAsString());
+  return packet.SerializeAsString();
+}
+
+std::string LegacyFramed(lawnmower::MessageType type,
+                         const google::protobuf::Message& message) {
+  const std::string body = LegacyBody(type, message);
+  const uint32_t net_len = htonl(static_cast<uint32_t>(body.size()));
+  std::string framed(sizeof(net_len), '\0');
+  std::memcpy(framed.data(), &net_len, sizeof(net_len));
+  return framed + body;
+}
+
+void ExpectSameAsLegacy(lawnmower::MessageType type,
+                        const google::protobuf::Message& message,
+                        const std::string& label) {
+  const auto framed = packet_codec::EncodeFramed(type, message);
+  Expect(framed.bytes != nullptr, label + ": 编码不应失败");
+  Expect(*framed.bytes == LegacyFramed(type, message),
+         label + ": TCP 帧与旧写法不一致");
+  Expect(framed.payload_len == message.ByteSizeLong(),
+         label + ": payload 长度不正确");
+  Expect(framed.body_len + sizeof(uint32_t) == framed.bytes->size(),
+         label + ": body 长度不正确");
+
+  const auto datagram = packet_codec::EncodeDatagram(type, message);
+  Expect(datagram.bytes != nullptr, label + ": 编码不应失败");
+  Expect(*datagram.bytes == LegacyBody(type, message),
+         label + ": UDP 数据报与旧写法不一致");
+  Expect(datagram.body_len == datagram.bytes->size(),
+         label + ": 数据报 body 长度不正确");
+
+  lawnmower::Packet parsed;
+  Expect(parsed.ParseFromString(*datagram.bytes),
+         label + ": 数据报应能解析为 Packet");
+  Expect(parsed.msg_type() == type &&
+             parsed.payload() == message.SerializeAsString(),
+         label + ": 解析后的 Packet 内容不一致");
+}
+
+lawnmower::S2C_GameStateSync BuildSync(int enemies) {
+  lawnmower::S2C_GameStateSync sync;
+  sync.set_room_id(7);
+  sync.set_is_full_snapshot(true);
+  sync.mutable_sync_time()->set_tick(123456);
+  for (int i = 0; i < enemies; ++i) {
+    auto* enemy = sync.add_enemies();
+    enemy->set_enemy_id(static_cast<uint32_t>(i + 1));
+    enemy->set_type_id(static_cast<uint32_t>(i % 3));
+    enemy->mutable_position()->set_x(static_cast<float>(i) * 1.5f);
+    enemy->mutable_position()->set_y(static_cast<float>(i) * -0.5f);
+    enemy->set_health(100 - i);
+    enemy->set_max_health(100);
+    enemy->set_is_alive(i % 5 != 0);
+  }
+  return sync;
+}
+
+void TestMatchesLegacyEncoding() {
+  // payload 长度跨越 1 / 2 / 3 字节 varint
+  for (const int enemies : {0, 1, 4, 40, 2000}) {
+    ExpectSameAsLegacy(lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC,
+                       BuildSync(enemies),
+                       "sync enemies=" + std::to_string(enemies));
+  }
+
+  lawnmower::S2C_GameStateDeltaSync delta;
+  delta.set_room_id(3);
+  auto* enemy = delta.add_enemies();
+  enemy->set_enemy_id(9);
+  enemy->set_health(0);  // optional 字段显式写 0 也要保留
+  ExpectSameAsLegacy(lawnmower::MessageType::MSG_S2C_GAME_STATE_DELTA_SYNC,
+                     delta, "delta");
+}
+
+void TestDefaultFieldsOmitted() {
+  // 空消息：payload 字段省略，只剩 msg_type
+  lawnmower::S2C_GameStateSync empty;
+  ExpectSameAsLegacy(lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC, empty,
+                     "empty message");
+  const auto encoded = packet_codec::EncodeDatagram(
+      lawnmower::MessageType::MSG_S2C_GAME_STATE_SYNC, empty);
+  Expect(encoded.payload_len == 0 && encoded.bytes->size() == 2,
+         "空消息应只编码 msg_type 字段");
+
+  // MSG_UNKNOWN(0)：msg_type 字段省略
+  ExpectSameAsLegacy(lawnmower::MessageType::MSG_UNKNOWN, BuildSync(2),
+                     "unknown type");
+  ExpectSameAsLegacy(lawnmower::MessageType::MSG_UNKNOWN, empty,
+                     "unknown type + empty");
+  const auto framed = packet_codec::EncodeFramed(
+      lawnmower::MessageType::MSG_UNKNOWN, empty);
+  Expect(framed.bytes->size() == sizeof(uint32_t) && framed.body_len == 0,
+         "全默认值时只剩 4 字节包长");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"matches_legacy_encoding", TestMatchesLegacyEncoding},
+      {"default_fields_omitted", TestDefaultFieldsOmitted},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "packet_codec_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "packet_codec_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,117 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_parallel.hpp"
+
+namespace {
+using game_manager_parallel::ParallelForPool;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 每个下标恰好被处理一次
+void ExpectCoversOnce(ParallelForPool* pool, std::size_t count,
+                      std::size_t min_chunk) {
+  std::vector<uint32_t> hits(count, 0);
+  pool->Run(count, min_chunk, [&hits](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      hits[i] += 1;
+    }
+  });
+  for (std::size_t i = 0; i < count; ++i) {
+    Expect(hits[i] == 1, "count=" + std::to_string(count) + " 下标 " +
+                             std::to_string(i) + " 处理次数不为 1");
+  }
+}
+
+void TestCoversEveryIndexOnce() {
+  ParallelForPool pool(3);
+  Expect(pool.ThreadCount() == 3, "线程数不正确");
+  for (const std::size_t count : {0u, 1u, 31u, 32u, 33u, 1000u, 4097u}) {
+    ExpectCoversOnce(&pool, count, 32);
+  }
+  // 反复调用：worker 需要逐轮正确唤醒与收尾
+  for (int round = 0; round < 200; ++round) {
+    ExpectCoversOnce(&pool, 517, 8);
+  }
+}
+
+void TestSmallRunsStayOnCaller() {
+  ParallelForPool pool(2);
+  const std::thread::id caller = std::this_thread::get_id();
+  bool on_caller = true;
+  pool.Run(16, 32, [&](std::size_t, std::size_t) {
+    on_caller = on_caller && std::this_thread::get_id() == caller;
+  });
+  Expect(on_caller, "不超过 min_chunk 时应在调用线程执行");
+}
+
+void TestZeroThreadsRunsSerially() {
+  ParallelForPool pool(0);
+  Expect(pool.ThreadCount() == 0, "零线程池不应创建 worker");
+  std::size_t calls = 0;
+  pool.Run(1000, 1, [&calls](std::size_t begin, std::size_t end) {
+    calls += 1;
+    Expect(begin == 0 && end == 1000, "零线程时应整段执行");
+  });
+  Expect(calls == 1, "零线程时应只调用一次");
+}
+
+void TestConcurrentCallersAreSerialized() {
+  ParallelForPool pool(2);
+  std::atomic<uint64_t> total{0};
+  std::vector<std::thread> callers;
+  for (int t = 0; t < 4; ++t) {
+    callers.emplace_back([&pool, &total] {
+      for (int round = 0; round < 50; ++round) {
+        pool.Run(256, 16, [&total](std::size_t begin, std::size_t end) {
+          total.fetch_add(end - begin, std::memory_order_relaxed);
+        });
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  Expect(total.load() == 4u * 50u * 256u, "多个调用方排队执行时总数不正确");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"covers_every_index_once", TestCoversEveryIndexOnce},
+      {"small_runs_stay_on_caller", TestSmallRunsStayOnCaller},
+      {"zero_threads_runs_serially", TestZeroThreadsRunsSerially},
+      {"concurrent_callers_are_serialized", TestConcurrentCallersAreSerialized},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "parallel_for_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "parallel_for_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
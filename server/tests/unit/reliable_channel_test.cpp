@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "message.pb.h"
+#include "network/udp/reliable_channel.hpp"
+
+namespace {
+
+using reliable_channel::Clock;
+using namespace std::chrono_literals;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+std::shared_ptr<const std::string> Payload(const std::string& text) {
+  return std::make_shared<const std::string>(text);
+}
+
+constexpr auto kType = lawnmower::MessageType::MSG_S2C_TICK_EVENTS;
+
+void TestInOrderDelivery() {
+  reliable_channel::Sender sender;
+  reliable_channel::Receiver receiver;
+  const auto now = Clock::now();
+  for (const char* text : {"a", "b", "c"}) {
+    Expect(sender.Enqueue(kType, Payload(text)), "入队不应失败");
+  }
+  Expect(sender.HasDue(now), "新消息应立即到期");
+
+  lawnmower::S2C_UdpReliable datagram;
+  Expect(sender.CollectDue(now, &datagram) == 3, "应一次取出 3 条");
+  std::vector<lawnmower::ReliableMessage> delivered;
+  for (const auto& message : datagram.messages()) {
+    Expect(receiver.OnMessage(message, &delivered), "按序消息应被接收");
+  }
+  Expect(delivered.size() == 3 && delivered[0].payload() == "a" &&
+             delivered[2].payload() == "c" && delivered[1].seq() == 2,
+         "投递顺序或内容不正确");
+  Expect(!sender.HasDue(now + 1ms), "重发间隔内不应到期");
+
+  uint32_t ack = 0;
+  uint32_t ack_bits = 0;
+  receiver.FillAck(&ack, &ack_bits);
+  Expect(ack == 3 && ack_bits == 0, "回执应为 ack=3 bits=0");
+  Expect(sender.OnAck(ack, ack_bits) == 3 && sender.pending() == 0,
+         "确认后应清空待确认队列");
+
+  // 重复到达的消息丢弃
+  Expect(!receiver.OnMessage(datagram.messages(1), &delivered),
+         "重复消息应被丢弃");
+  Expect(delivered.size() == 3, "重复消息不应再次投递");
+}
+
+void TestSelectiveAck() {
+  reliable_channel::Sender sender;
+  reliable_channel::Receiver receiver;
+  const auto now = Clock::now();
+  for (int i = 0; i < 4; ++i) {
+    sender.Enqueue(kType, Payload(std::to_string(i + 1)));
+  }
+  lawnmower::S2C_UdpReliable datagram;
+  sender.CollectDue(now, &datagram);
+
+  // seq 2 丢失：1 投递，3/4 缓存
+  std::vector<lawnmower::ReliableMessage> delivered;
+  receiver.OnMessage(datagram.messages(0), &delivered);
+  receiver.OnMessage(datagram.messages(3), &delivered);
+  receiver.OnMessage(datagram.messages(2), &delivered);
+  Expect(delivered.size() == 1 && receiver.buffered() == 2,
+         "缺口之后的消息应缓存而不投递");
+
+  uint32_t ack = 0;
+  uint32_t ack_bits = 0;
+  receiver.FillAck(&ack, &ack_bits);
+  Expect(ack == 1 && ack_bits == 0b11, "回执应为 ack=1 bits=0b11");
+  Expect(sender.OnAck(ack, ack_bits) == 3 && sender.pending() == 1,
+         "只剩 seq 2 待确认");
+
+  Expect(!sender.HasDue(now + 50ms), "未到重发间隔");
+  lawnmower::S2C_UdpReliable resend;
+  Expect(sender.CollectDue(now + reliable_channel::kDefaultResendInterval,
+                           &resend) == 1 &&
+             resend.messages(0).seq() == 2,
+         "应只重发 seq 2");
+  Expect(sender.resend_count() == 1, "重发计数不正确");
+
+  receiver.OnMessage(resend.messages(0), &delivered);
+  Expect(delivered.size() == 4 && delivered[1].payload() == "2" &&
+             delivered[3].payload() == "4" && receiver.buffered() == 0,
+         "补齐缺口后应连续投递缓存消息");
+}
+
+void TestWindowAndBatchLimits() {
+  reliable_channel::Options options;
+  options.window = 4;
+  options.max_batch_bytes = 100;
+  reliable_channel::Sender sender(options);
+  for (int i = 0; i < 4; ++i) {
+    Expect(sender.Enqueue(kType, Payload(std::string(60, 'x'))),
+           "窗口内入队不应失败");
+  }
+  Expect(!sender.Enqueue(kType, Payload("overflow")), "窗口已满应拒收");
+
+  const auto now = Clock::now();
+  lawnmower::S2C_UdpReliable first;
+  Expect(sender.CollectDue(now, &first) == 1, "字节预算内只放得下 1 条");
+  lawnmower::S2C_UdpReliable second;
+  Expect(sender.CollectDue(now, &second) == 1 &&
+             second.messages(0).seq() == 2,
+         "下一批应从 seq 2 开始");
+
+  sender.OnAck(1, 0);
+  Expect(sender.Enqueue(kType, Payload("after ack")), "确认后应腾出窗口");
+
+  reliable_channel::Receiver receiver(options);
+  std::vector<lawnmower::ReliableMessage> delivered;
+  lawnmower::ReliableMessage far;
+  far.set_seq(options.window + 1);
+  Expect(!receiver.OnMessage(far, &delivered), "超出接收窗口应丢弃");
+}
+
+// 终端失效时仍有在途消息：seq 2 丢失、3 已被 ack_bits 确认但卡在缺口后，
+// Drain 按序取出 2..4 经 TCP 补发；之后的数据报带 skip_through，接收端丢弃
+// 缓存的 3 并从新消息继续投递，不重复也不停滞
+void TestDrainInFlightMessages() {
+  reliable_channel::Sender sender;
+  reliable_channel::Receiver receiver;
+  auto now = Clock::now();
+  for (int i = 0; i < 4; ++i) {
+    sender.Enqueue(kType, Payload(std::to_string(i + 1)));
+  }
+  lawnmower::S2C_UdpReliable datagram;
+  sender.CollectDue(now, &datagram);
+  std::vector<lawnmower::ReliableMessage> delivered;
+  receiver.OnMessage(datagram.messages(0), &delivered);
+  receiver.OnMessage(datagram.messages(2), &delivered);
+  uint32_t ack = 0;
+  uint32_t ack_bits = 0;
+  receiver.FillAck(&ack, &ack_bits);
+  Expect(sender.OnAck(ack, ack_bits) == 2 && sender.pending() == 2,
+         "seq 1 与 3 已确认，剩 2/4 待确认");
+
+  std::vector<reliable_channel::DrainedMessage> drained;
+  Expect(sender.Drain(&drained) == 3, "应取出累计确认之后的 3 条");
+  Expect(drained[0].payload != nullptr && *drained[0].payload == "2" &&
+             *drained[1].payload == "3" && *drained[2].payload == "4",
+         "取出的消息应按 seq 升序");
+  Expect(sender.pending() == 0 && !sender.HasDue(now + 1s),
+         "取出后不应再重发旧消息");
+
+  now += 1s;
+  Expect(sender.Enqueue(kType, Payload("5")), "取出后应可继续入队");
+  lawnmower::S2C_UdpReliable next;
+  Expect(sender.CollectDue(now, &next) == 1 && next.messages(0).seq() == 5 &&
+             next.skip_through() == 4,
+         "新消息序号应延续并携带 skip_through=4");
+
+  // 即使新消息先于 skip_through 处理，也只会缓存等待
+  Expect(receiver.OnMessage(next.messages(0), &delivered),
+         "跳号消息应缓存");
+  receiver.OnSkipThrough(next.skip_through(), &delivered);
+  Expect(delivered.size() == 2 && delivered[1].payload() == "5" &&
+             receiver.delivered_seq() == 5 && receiver.buffered() == 0,
+         "跳过空洞后应丢弃缓存的 3 并投递 5");
+  receiver.OnSkipThrough(next.skip_through(), &delivered);
+  Expect(delivered.size() == 2, "重复的 skip_through 不应有影响");
+  receiver.FillAck(&ack, &ack_bits);
+  Expect(sender.OnAck(ack, ack_bits) == 1 && sender.pending() == 0,
+         "确认新消息后应清空");
+}
+
+void TestSeqWraparound() {
+  Expect(reliable_channel::SeqAfter(1, 0xFFFFFFFFu), "回绕后 1 在 MAX 之后");
+  Expect(!reliable_channel::SeqAfter(0xFFFFFFFFu, 1), "MAX 不在 1 之后");
+  Expect(!reliable_channel::SeqAfter(5, 5), "相同序号不算之后");
+}
+
+// 有损链路：双向 30% 丢包 + 数据报乱序，所有消息最终按序、恰好投递一次
+void TestLossyLinkDelivery() {
+  uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+  const auto next_rand = [&rng_state]() {
+    rng_state = rng_state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(rng_state >> 33);
+  };
+  const auto lost = [&next_rand]() { return next_rand() % 100 < 30; };
+
+  reliable_channel::Options options;
+  options.window = 32;
+  reliable_channel::Sender sender(options);
+  reliable_channel::Receiver receiver(options);
+  std::vector<lawnmower::ReliableMessage> delivered;
+
+  constexpr int kMessages = 400;
+  int enqueued = 0;
+  auto now = Clock::now();
+  std::vector<lawnmower::S2C_UdpReliable> in_flight;
+  for (int tick = 0; tick < 20000 && delivered.size() < kMessages; ++tick) {
+    now += 16ms;
+    for (int burst = 0; burst < 3 && enqueued < kMessages; ++burst) {
+      if (!sender.Enqueue(kType, Payload(std::to_string(enqueued)))) {
+        break;
+      }
+      ++enqueued;
+    }
+    if (sender.HasDue(now)) {
+      lawnmower::S2C_UdpReliable datagram;
+      sender.CollectDue(now, &datagram);
+      if (!lost()) {
+        in_flight.push_back(std::move(datagram));
+      }
+    }
+    // 每 tick 随机交付一个在途数据报，制造乱序
+    if (!in_flight.empty()) {
+      const std::size_t pick = next_rand() % in_flight.size();
+      for (const auto& message : in_flight[pick].messages()) {
+        receiver.OnMessage(message, &delivered);
+      }
+      in_flight.erase(in_flight.begin() + static_cast<std::ptrdiff_t>(pick));
+      uint32_t ack = 0;
+      uint32_t ack_bits = 0;
+      receiver.FillAck(&ack, &ack_bits);
+      if (!lost()) {
+        sender.OnAck(ack, ack_bits);
+      }
+    }
+  }
+
+  Expect(delivered.size() == kMessages,
+         "有损链路下应全部送达，实际 " + std::to_string(delivered.size()));
+  for (int i = 0; i < kMessages; ++i) {
+    Expect(delivered[static_cast<std::size_t>(i)].payload() ==
+               std::to_string(i),
+           "投递顺序错误 index=" + std::to_string(i));
+  }
+  Expect(sender.resend_count() > 0, "有丢包时应发生重发");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"in_order_delivery", TestInOrderDelivery},
+      {"selective_ack", TestSelectiveAck},
+      {"window_and_batch_limits", TestWindowAndBatchLimits},
+      {"drain_in_flight_messages", TestDrainInFlightMessages},
+      {"seq_wraparound", TestSeqWraparound},
+      {"lossy_link_delivery", TestLossyLinkDelivery},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "reliable_channel_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "reliable_channel_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_rng.hpp"
+
+namespace {
+using game_manager_rng::Philox4x32;
+using game_manager_rng::PhiloxBlock;
+using game_manager_rng::RngStage;
+using game_manager_rng::RngStream;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+std::vector<uint32_t> Draw(RngStream rng, std::size_t count) {
+  std::vector<uint32_t> out;
+  out.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    out.push_back(rng.NextU32());
+  }
+  return out;
+}
+
+// Random123 发布的 Philox4x32-10 已知答案向量
+void TestPhiloxKnownAnswers() {
+  Expect(Philox4x32({0, 0, 0, 0}, 0) ==
+             PhiloxBlock{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u},
+         "全零输入的结果不正确");
+  Expect(Philox4x32({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+                    0xffffffffffffffffull) ==
+             PhiloxBlock{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu},
+         "全一输入的结果不正确");
+  Expect(Philox4x32({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+                    0x299f31d0a4093822ull) ==
+             PhiloxBlock{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u},
+         "pi 输入的结果不正确");
+}
+
+void TestStreamsAreReproducible() {
+  const RngStream a(42, 100, RngStage::kEnemyDrop, 7);
+  const RngStream b(42, 100, RngStage::kEnemyDrop, 7);
+  // 跨多个块，覆盖块边界
+  Expect(Draw(a, 13) == Draw(b, 13), "相同键的随机流应逐位一致");
+
+  // 取用顺序无关：先取别的流不影响本流
+  RngStream other(42, 100, RngStage::kEnemyDrop, 8);
+  for (int i = 0; i < 5; ++i) {
+    other.NextU32();
+  }
+  Expect(Draw(RngStream(42, 100, RngStage::kEnemyDrop, 7), 13) == Draw(a, 13),
+         "随机流不应受其他流取用的影响");
+}
+
+void TestStreamsAreIndependent() {
+  const std::vector<uint32_t> base =
+      Draw(RngStream(42, 100, RngStage::kEnemyDrop, 7), 8);
+  const std::vector<RngStream> variants = {
+      RngStream(43, 100, RngStage::kEnemyDrop, 7),
+      RngStream(42, 101, RngStage::kEnemyDrop, 7),
+      RngStream(42, 100, RngStage::kEnemySpawn, 7),
+      RngStream(42, 100, RngStage::kEnemyDrop, 8),
+      RngStream(42, 100 + (uint64_t{1} << 32), RngStage::kEnemyDrop, 7),
+  };
+  for (std::size_t i = 0; i < variants.size(); ++i) {
+    Expect(Draw(variants[i], 8) != base,
+           "键的任一维度不同应得到不同的随机流 #" + std::to_string(i));
+  }
+}
+
+void TestUnitFloatRangeAndMean() {
+  RngStream rng(1, 0, RngStage::kPlayerCrit, 1);
+  double sum = 0.0;
+  constexpr int kSamples = 100000;
+  for (int i = 0; i < kSamples; ++i) {
+    const float value = rng.NextUnitFloat();
+    Expect(value >= 0.0f && value < 1.0f, "NextUnitFloat 应落在 [0, 1)");
+    sum += value;
+  }
+  const double mean = sum / kSamples;
+  Expect(mean > 0.49 && mean < 0.51, "NextUnitFloat 均值应接近 0.5");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"philox_known_answers", TestPhiloxKnownAnswers},
+      {"streams_are_reproducible", TestStreamsAreReproducible},
+      {"streams_are_independent", TestStreamsAreIndependent},
+      {"unit_float_range_and_mean", TestUnitFloatRangeAndMean},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "rng_stream_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "rng_stream_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
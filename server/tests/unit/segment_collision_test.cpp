@@ -0,0 +1,155 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_collision.hpp"
+
+namespace {
+using game_manager_collision::Segment;
+using game_manager_collision::SimdLevel;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 逐个调用标量参考实现，作为对照
+std::ptrdiff_t ReferenceEarliest(const Segment& seg,
+                                 const std::vector<float>& xs,
+                                 const std::vector<float>& ys, float radius,
+                                 float* out_t) {
+  std::ptrdiff_t best = -1;
+  float best_t = std::numeric_limits<float>::infinity();
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    float t = 0.0f;
+    if (game_manager_collision::SegmentCircleOverlap(
+            seg.ax, seg.ay, seg.bx, seg.by, xs[i], ys[i], radius, &t) &&
+        t < best_t) {
+      best_t = t;
+      best = static_cast<std::ptrdiff_t>(i);
+    }
+  }
+  *out_t = best_t;
+  return best;
+}
+
+bool SameBits(float a, float b) {
+  uint32_t ua = 0;
+  uint32_t ub = 0;
+  std::memcpy(&ua, &a, sizeof(a));
+  std::memcpy(&ub, &b, sizeof(b));
+  return ua == ub;
+}
+
+void ExpectAllLevelsMatch(const Segment& seg, const std::vector<float>& xs,
+                          const std::vector<float>& ys, float radius,
+                          const std::string& label) {
+  float ref_t = 0.0f;
+  const std::ptrdiff_t ref = ReferenceEarliest(seg, xs, ys, radius, &ref_t);
+  for (const SimdLevel level :
+       {SimdLevel::kScalar, SimdLevel::kSse42, SimdLevel::kAvx2}) {
+    float t = -1.0f;
+    const std::ptrdiff_t idx =
+        game_manager_collision::EarliestSegmentCircleHitAt(
+            level, seg, xs.data(), ys.data(), xs.size(), radius, &t);
+    const std::string where =
+        label + " level=" + game_manager_collision::SimdLevelName(level);
+    Expect(idx == ref, where + ": 命中下标与标量版本不一致");
+    if (ref >= 0) {
+      Expect(SameBits(t, ref_t), where + ": 命中 t 与标量版本不逐位一致");
+    }
+  }
+}
+
+void TestRandomBlocksMatchScalar() {
+  uint32_t rng = 2024u;
+  auto next_unit = [&rng]() {
+    rng = rng * 1664525u + 1013904223u;
+    return static_cast<float>(rng >> 8) / static_cast<float>(1u << 24);
+  };
+  std::vector<float> xs;
+  std::vector<float> ys;
+  for (int round = 0; round < 2000; ++round) {
+    // 覆盖 8/16 的整倍数与各种尾部长度
+    const std::size_t count = static_cast<std::size_t>(round % 37);
+    xs.resize(count);
+    ys.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      xs[i] = next_unit() * 400.0f;
+      ys[i] = next_unit() * 400.0f;
+    }
+    Segment seg{next_unit() * 400.0f, next_unit() * 400.0f, 0.0f, 0.0f};
+    seg.bx = seg.ax + (next_unit() - 0.5f) * 60.0f;
+    seg.by = seg.ay + (next_unit() - 0.5f) * 60.0f;
+    ExpectAllLevelsMatch(seg, xs, ys, 10.0f + next_unit() * 30.0f,
+                         "random#" + std::to_string(round));
+  }
+}
+
+void TestEdgeCasesMatchScalar() {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  // 零长度线段、t 夹到两端、圆恰好相切、等 t 多个命中、NaN 空位
+  const std::vector<float> xs = {100.0f, 90.0f,  130.0f, 110.0f, nan,
+                                 115.0f, 115.0f, 100.0f, 100.0f, 90.0f};
+  const std::vector<float> ys = {100.0f, 100.0f, 100.0f, 110.0f, nan,
+                                 90.0f,  110.0f, 100.0f, 120.0f, 100.0f};
+  ExpectAllLevelsMatch({100.0f, 100.0f, 100.0f, 100.0f}, xs, ys, 10.0f,
+                       "zero_length");
+  ExpectAllLevelsMatch({95.0f, 100.0f, 120.0f, 100.0f}, xs, ys, 10.0f,
+                       "clamped_ends");
+  ExpectAllLevelsMatch({80.0f, 90.0f, 140.0f, 90.0f}, xs, ys, 10.0f,
+                       "tangent");
+  ExpectAllLevelsMatch({100.0f, 50.0f, 100.0f, 150.0f}, xs, ys, 5.0f,
+                       "equal_t_ties");
+
+  // 全部为 NaN 空位时任何档位都不应命中
+  const std::vector<float> holes(19, nan);
+  for (const SimdLevel level :
+       {SimdLevel::kScalar, SimdLevel::kSse42, SimdLevel::kAvx2}) {
+    float t = 0.0f;
+    Expect(game_manager_collision::EarliestSegmentCircleHitAt(
+               level, {0.0f, 0.0f, 10.0f, 10.0f}, holes.data(), holes.data(),
+               holes.size(), 50.0f, &t) < 0,
+           "NaN 空位不应命中");
+  }
+}
+
+void RunAll() {
+  std::cout << "detected simd level: "
+            << game_manager_collision::SimdLevelName(
+                   game_manager_collision::DetectSimdLevel())
+            << "\n";
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"random_blocks_match_scalar", TestRandomBlocksMatchScalar},
+      {"edge_cases_match_scalar", TestEdgeCasesMatchScalar},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "segment_collision_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "segment_collision_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
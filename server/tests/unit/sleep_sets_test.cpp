@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_sleep.hpp"
+
+namespace {
+using game_manager_sleep::SleepGrid;
+using game_manager_sleep::TickWheel;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+std::vector<uint32_t> PopAt(TickWheel* wheel, uint64_t now) {
+  std::vector<uint32_t> out;
+  wheel->PopDue(now, &out);
+  return out;
+}
+
+void TestWheelPopsAtDueTick() {
+  TickWheel wheel(8);
+  wheel.Schedule(3, 1);
+  wheel.Schedule(5, 2);
+  wheel.Schedule(3, 3);
+  // 超出一圈：与 tick 4 同槽，需等到第二圈
+  wheel.Schedule(12, 4);
+  Expect(wheel.Size() == 4, "调度后数量不正确");
+
+  for (uint64_t tick = 0; tick < 3; ++tick) {
+    Expect(PopAt(&wheel, tick).empty(), "未到期的定时不应弹出");
+  }
+  Expect(PopAt(&wheel, 3) == std::vector<uint32_t>({1, 3}),
+         "同 tick 到期应按调度顺序弹出");
+  Expect(PopAt(&wheel, 4).empty(), "跨圈定时不应提前弹出");
+  Expect(PopAt(&wheel, 5) == std::vector<uint32_t>({2}), "tick 5 应弹出 2");
+  for (uint64_t tick = 6; tick < 12; ++tick) {
+    Expect(PopAt(&wheel, tick).empty(), "跨圈定时不应提前弹出");
+  }
+  Expect(PopAt(&wheel, 12) == std::vector<uint32_t>({4}), "tick 12 应弹出 4");
+  Expect(wheel.Size() == 0, "全部弹出后应为空");
+}
+
+void TestWheelCatchesUpAndReschedules() {
+  TickWheel wheel(4);
+  for (uint32_t id = 1; id <= 10; ++id) {
+    wheel.Schedule(id, id);
+  }
+  // 一次跳过多圈：所有已到期的都应弹出
+  std::vector<uint32_t> out = PopAt(&wheel, 7);
+  std::sort(out.begin(), out.end());
+  Expect(out == std::vector<uint32_t>({1, 2, 3, 4, 5, 6, 7}),
+         "跳过多圈时应弹出全部已到期定时");
+  Expect(wheel.Size() == 3, "未到期的定时应保留");
+
+  // 已过期的定时挂到下一个待处理 tick
+  wheel.Schedule(2, 42);
+  Expect(PopAt(&wheel, 8) == std::vector<uint32_t>({8, 42}),
+         "过期定时应在下一次处理时弹出");
+
+  // 回退的 tick 不处理
+  Expect(PopAt(&wheel, 3).empty(), "早于游标的 tick 不应弹出");
+  wheel.Clear();
+  Expect(wheel.Size() == 0 && PopAt(&wheel, 100).empty(), "Clear 后应为空");
+}
+
+void TestSleepGridWakesNearbyCellsOnly() {
+  SleepGrid grid;
+  grid.Reset(1000.0f, 1000.0f, 100.0f);
+  grid.Insert(1, 50.0f, 50.0f);
+  grid.Insert(2, 150.0f, 50.0f);
+  grid.Insert(3, 950.0f, 950.0f);
+  grid.Insert(4, 55.0f, 60.0f);
+  // 越界坐标夹到边缘格
+  grid.Insert(5, -20.0f, 5000.0f);
+  Expect(grid.Size() == 5, "插入后数量不正确");
+
+  std::vector<uint32_t> out;
+  grid.Query(40.0f, 40.0f, 24.0f, &out);
+  std::sort(out.begin(), out.end());
+  Expect(out == std::vector<uint32_t>({1, 4}), "只应唤醒查询圆覆盖的格子");
+
+  out.clear();
+  grid.Query(95.0f, 50.0f, 24.0f, &out);
+  std::sort(out.begin(), out.end());
+  Expect(out == std::vector<uint32_t>({1, 2, 4}), "跨格查询应覆盖相邻格");
+
+  out.clear();
+  grid.Query(10.0f, 990.0f, 24.0f, &out);
+  Expect(out == std::vector<uint32_t>({5}), "越界插入应落在边缘格");
+
+  Expect(grid.Remove(1, 50.0f, 50.0f), "存在的 id 应删除成功");
+  Expect(!grid.Remove(1, 50.0f, 50.0f), "重复删除应返回 false");
+  Expect(!grid.Remove(3, 50.0f, 50.0f), "坐标不在同格时应删除失败");
+  out.clear();
+  grid.Query(40.0f, 40.0f, 24.0f, &out);
+  Expect(out == std::vector<uint32_t>({4}), "删除后不应再被唤醒");
+  Expect(grid.Size() == 4, "删除后数量不正确");
+
+  grid.Clear();
+  out.clear();
+  grid.Query(500.0f, 500.0f, 1000.0f, &out);
+  Expect(grid.Size() == 0 && out.empty(), "Clear 后应为空");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"wheel_pops_at_due_tick", TestWheelPopsAtDueTick},
+      {"wheel_catches_up_and_reschedules", TestWheelCatchesUpAndReschedules},
+      {"sleep_grid_wakes_nearby_cells_only", TestSleepGridWakesNearbyCellsOnly},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "sleep_sets_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "sleep_sets_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
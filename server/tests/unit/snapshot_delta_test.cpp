@@ -0,0 +1,431 @@
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_snapshot.hpp"
+#include "message.pb.h"
+
+namespace {
+
+using game_manager_snapshot::DiffFollowups;
+using game_manager_snapshot::EnemyEntry;
+using game_manager_snapshot::ItemEntry;
+using game_manager_snapshot::PlayerEntry;
+using game_manager_snapshot::QuantizeParams;
+using game_manager_snapshot::Snapshot;
+using game_manager_snapshot::SnapshotRing;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 与服务器一致：按 followups 从 current 补全完整状态
+void FillFollowups(const Snapshot& current, const DiffFollowups& followups,
+                   lawnmower::S2C_GameStateDeltaSync* delta) {
+  for (const auto player_id : followups.full_player_ids) {
+    for (const auto& entry : current.players) {
+      if (entry.player_id != player_id) {
+        continue;
+      }
+      auto* state = delta->add_full_players();
+      state->set_player_id(entry.player_id);
+      state->mutable_position()->set_x(entry.x);
+      state->mutable_position()->set_y(entry.y);
+      state->set_rotation(entry.rotation);
+      state->set_is_alive(entry.is_alive);
+      state->set_last_processed_input_seq(
+          static_cast<int32_t>(entry.input_seq));
+    }
+  }
+  for (const auto enemy_id : followups.spawned_enemy_ids) {
+    for (const auto& entry : current.enemies) {
+      if (entry.enemy_id != enemy_id) {
+        continue;
+      }
+      auto* state = delta->add_spawned_enemies();
+      state->set_enemy_id(entry.enemy_id);
+      state->mutable_position()->set_x(entry.x);
+      state->mutable_position()->set_y(entry.y);
+      state->set_health(entry.health);
+      state->set_is_alive(entry.is_alive);
+    }
+  }
+}
+
+lawnmower::S2C_GameStateDeltaSync MakeDelta(const Snapshot& baseline,
+                                            const Snapshot& current) {
+  lawnmower::S2C_GameStateDeltaSync delta;
+  DiffFollowups followups;
+  game_manager_snapshot::Diff(baseline, current, &delta, &followups);
+  FillFollowups(current, followups, &delta);
+  delta.mutable_sync_time()->set_tick(current.tick);
+  delta.set_baseline_tick(baseline.tick);
+  return delta;
+}
+
+// 比较客户端可见字段（full_version 只在服务器侧有意义）
+bool SameState(const Snapshot& a, const Snapshot& b) {
+  if (a.tick != b.tick || a.players.size() != b.players.size() ||
+      a.enemies.size() != b.enemies.size() ||
+      a.items.size() != b.items.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.players.size(); ++i) {
+    const PlayerEntry& x = a.players[i];
+    const PlayerEntry& y = b.players[i];
+    if (x.player_id != y.player_id || x.x != y.x || x.y != y.y ||
+        x.rotation != y.rotation || x.input_seq != y.input_seq ||
+        x.is_alive != y.is_alive) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < a.enemies.size(); ++i) {
+    const EnemyEntry& x = a.enemies[i];
+    const EnemyEntry& y = b.enemies[i];
+    if (x.enemy_id != y.enemy_id || x.x != y.x || x.y != y.y ||
+        x.health != y.health || x.is_alive != y.is_alive) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < a.items.size(); ++i) {
+    const ItemEntry& x = a.items[i];
+    const ItemEntry& y = b.items[i];
+    if (x.item_id != y.item_id || x.x != y.x || x.y != y.y ||
+        x.type_id != y.type_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 定点编码下位置误差不超过半个定点单位，朝向不超过半个刻度
+bool NearState(const Snapshot& a, const Snapshot& b,
+               const QuantizeParams& params) {
+  if (a.tick != b.tick || a.players.size() != b.players.size() ||
+      a.enemies.size() != b.enemies.size() ||
+      a.items.size() != b.items.size()) {
+    return false;
+  }
+  const float pos_tol = 0.5f / static_cast<float>(params.position_scale) +
+                        1e-3f;
+  const float rot_tol =
+      180.0f / static_cast<float>(1u << params.rotation_bits) + 1e-3f;
+  const auto near = [pos_tol](float x0, float y0, float x1, float y1) {
+    return std::abs(x0 - x1) <= pos_tol && std::abs(y0 - y1) <= pos_tol;
+  };
+  for (std::size_t i = 0; i < a.players.size(); ++i) {
+    const PlayerEntry& x = a.players[i];
+    const PlayerEntry& y = b.players[i];
+    float rot_diff = std::abs(x.rotation - y.rotation);
+    rot_diff = std::min(rot_diff, 360.0f - rot_diff);
+    if (x.player_id != y.player_id || !near(x.x, x.y, y.x, y.y) ||
+        rot_diff > rot_tol || x.input_seq != y.input_seq ||
+        x.is_alive != y.is_alive) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < a.enemies.size(); ++i) {
+    const EnemyEntry& x = a.enemies[i];
+    const EnemyEntry& y = b.enemies[i];
+    if (x.enemy_id != y.enemy_id || !near(x.x, x.y, y.x, y.y) ||
+        x.health != y.health || x.is_alive != y.is_alive) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < a.items.size(); ++i) {
+    const ItemEntry& x = a.items[i];
+    const ItemEntry& y = b.items[i];
+    if (x.item_id != y.item_id || !near(x.x, x.y, y.x, y.y) ||
+        x.type_id != y.type_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Snapshot MakeBaseline() {
+  Snapshot snapshot;
+  snapshot.tick = 10;
+  snapshot.players = {{1, 100.0f, 100.0f, 0.0f, 5, 0, true},
+                      {2, 200.0f, 120.0f, 90.0f, 7, 0, true}};
+  snapshot.enemies = {{11, 500.0f, 300.0f, 30, true},
+                      {12, 520.0f, 310.0f, 30, true},
+                      {13, 540.0f, 320.0f, 30, true}};
+  snapshot.items = {{21, 50.0f, 60.0f, 1}, {22, 70.0f, 80.0f, 2}};
+  return snapshot;
+}
+
+void TestRingRecordAndFind() {
+  SnapshotRing ring(3);
+  for (uint32_t tick = 1; tick <= 5; ++tick) {
+    ring.Record(tick)->players.push_back({tick, 0.0f, 0.0f, 0.0f, 0, 0, true});
+  }
+  Expect(ring.Size() == 3, "环容量应为 3");
+  Expect(ring.Find(2) == nullptr, "最旧快照应被覆盖");
+  const Snapshot* latest = ring.Find(5);
+  Expect(latest != nullptr && latest->players.size() == 1 &&
+             latest->players[0].player_id == 5,
+         "应能找到最新快照");
+
+  // 同一 tick 再次记录覆盖最新槽位而非占用新槽位
+  ring.Record(5);
+  Expect(ring.Find(3) != nullptr && ring.Find(5)->players.empty(),
+         "同 tick 记录应覆盖最新槽位");
+}
+
+void TestDiffApplyRoundTrip() {
+  const Snapshot baseline = MakeBaseline();
+  Snapshot current = baseline;
+  current.tick = 14;
+  current.players[0].x = 110.0f;        // 移动
+  current.players[0].input_seq = 9;     // 确认序号推进
+  current.players[1].full_version = 1;  // 低频字段变化
+  current.players.push_back({3, 10.0f, 10.0f, 0.0f, 0, 0, true});
+  current.enemies[0].health = 12;  // 受伤
+  current.enemies.erase(current.enemies.begin() + 1);
+  current.enemies.push_back({14, 600.0f, 100.0f, 40, true});
+  current.items[1].x = 75.0f;
+  current.items.erase(current.items.begin());
+  current.items.push_back({23, 90.0f, 95.0f, 3});
+  current.SortById();
+
+  const auto delta = MakeDelta(baseline, current);
+  Expect(delta.players_size() == 1 && delta.players(0).player_id() == 1,
+         "只有玩家 1 应走字段增量");
+  Expect(delta.players(0).changed_mask() ==
+             (lawnmower::PLAYER_DELTA_POSITION |
+              lawnmower::PLAYER_DELTA_LAST_PROCESSED_INPUT_SEQ),
+         "玩家 1 的变化掩码不正确");
+  Expect(delta.full_players_size() == 2, "玩家 2/3 应下发完整状态");
+  Expect(delta.enemies_size() == 1 && delta.spawned_enemies_size() == 1 &&
+             delta.removed_enemy_ids_size() == 1 &&
+             delta.removed_enemy_ids(0) == 12,
+         "敌人增量不正确");
+  Expect(delta.items_size() == 2 && delta.removed_item_ids_size() == 1 &&
+             delta.removed_item_ids(0) == 21,
+         "道具增量不正确");
+
+  Snapshot restored;
+  game_manager_snapshot::Apply(baseline, delta, &restored);
+  Expect(SameState(restored, current), "应用增量后应与当前快照一致");
+}
+
+// 离开房间的玩家：已确认基线的客户端不再收周期全量，必须经增量移除
+void TestRemovedPlayer() {
+  const Snapshot baseline = MakeBaseline();
+  Snapshot current = baseline;
+  current.tick = 12;
+  current.players.erase(current.players.begin() + 1);
+
+  const auto delta = MakeDelta(baseline, current);
+  Expect(delta.removed_player_ids_size() == 1 &&
+             delta.removed_player_ids(0) == 2,
+         "离开的玩家 2 应写入 removed_player_ids");
+  Expect(delta.players_size() == 0 && delta.full_players_size() == 0,
+         "其余玩家未变化，不应下发");
+
+  Snapshot restored;
+  game_manager_snapshot::Apply(baseline, delta, &restored);
+  Expect(SameState(restored, current), "应用增量后玩家 2 应被移除");
+}
+
+void TestUnchangedIsEmpty() {
+  const Snapshot baseline = MakeBaseline();
+  Snapshot current = baseline;
+  current.tick = 11;
+  lawnmower::S2C_GameStateDeltaSync delta;
+  DiffFollowups followups;
+  Expect(!game_manager_snapshot::Diff(baseline, current, &delta, &followups),
+         "无变化时应返回 false");
+  Expect(delta.ByteSizeLong() == 0, "无变化时不应写入任何实体");
+}
+
+void TestQuantizeHelpers() {
+  using game_manager_snapshot::DequantizeRotation;
+  using game_manager_snapshot::QuantizeCoord;
+  using game_manager_snapshot::QuantizeRotation;
+  Expect(QuantizeCoord(12.5f, 8) == 100 && QuantizeCoord(-0.0625f, 8) == -1,
+         "坐标定点化不正确");
+  Expect(QuantizeRotation(0.0f, 10) == 0 && QuantizeRotation(360.0f, 10) == 0,
+         "0/360 度应映射到同一刻度");
+  Expect(QuantizeRotation(-90.0f, 8) == 192, "负角度应折回 [0,360)");
+  Expect(DequantizeRotation(QuantizeRotation(90.0f, 10), 10) == 90.0f,
+         "朝向往返不一致");
+}
+
+void TestQuantizedRoundTrip() {
+  const QuantizeParams params;
+  const Snapshot baseline = MakeBaseline();
+  Snapshot current = baseline;
+  current.tick = 12;
+  current.players[0].x = 101.3f;
+  current.players[0].rotation = 45.0f;
+  current.players[1].x = 200.01f;  // 不足一个定点单位，应被丢弃
+  current.enemies[0].y = 299.0f;
+  current.enemies[1].health = 5;
+  current.items.push_back({23, 90.4f, 95.6f, 3});
+  current.SortById();
+
+  auto delta = MakeDelta(baseline, current);
+  game_manager_snapshot::Quantize(baseline, params, &delta);
+  Expect(delta.position_scale() == params.position_scale &&
+             delta.rotation_bits() == params.rotation_bits,
+         "应写入定点参数");
+  Expect(delta.players_size() == 1 && delta.players(0).player_id() == 1 &&
+             !delta.players(0).has_position() &&
+             delta.players(0).qx() == 10 && delta.players(0).has_qrotation(),
+         "玩家 1 应以相对定点坐标下发，玩家 2 应被移除");
+  Expect(delta.enemies_size() == 2 && delta.enemies(0).qy() == -8 &&
+             (delta.enemies(1).changed_mask() &
+              lawnmower::ENEMY_DELTA_POSITION) == 0,
+         "敌人定点增量不正确");
+  Expect(delta.items_size() == 1 && delta.items(0).qx() == 723 &&
+             delta.items(0).qy() == 765,
+         "新道具应为绝对定点坐标");
+
+  Snapshot restored;
+  game_manager_snapshot::Apply(baseline, delta, &restored);
+  Expect(NearState(restored, current, params),
+         "定点增量还原后应在精度内一致");
+}
+
+// 有损链路：增量与确认各 20% 丢包。客户端只在确认过的快照上应用增量，
+// 每次收到的增量都应精确还原出服务器在该 tick 的状态
+void RunLossyConvergence(const QuantizeParams* quantize) {
+  uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+  const auto next_rand = [&rng_state]() {
+    rng_state = rng_state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(rng_state >> 33);
+  };
+  const auto lost = [&next_rand]() { return next_rand() % 100 < 20; };
+
+  SnapshotRing server_ring(16);
+  Snapshot world = MakeBaseline();
+  world.tick = 0;
+  uint32_t server_acked = 0;  // 服务器看到的客户端确认 tick
+  std::vector<Snapshot> client_known;  // 客户端已还原的快照
+  uint32_t next_enemy_id = 100;
+  int applied = 0;
+  int full_resyncs = 0;
+
+  for (uint32_t tick = 1; tick <= 600; ++tick) {
+    world.tick = tick;
+    for (auto& player : world.players) {
+      player.x += static_cast<float>(next_rand() % 3);
+      player.input_seq += next_rand() % 2;
+      if (next_rand() % 50 == 0) {
+        player.full_version += 1;
+      }
+    }
+    for (auto& enemy : world.enemies) {
+      enemy.y -= 1.0f;
+      if (next_rand() % 10 == 0) {
+        enemy.health -= 1;
+      }
+    }
+    if (next_rand() % 8 == 0 && !world.enemies.empty()) {
+      world.enemies.erase(world.enemies.begin() +
+                          next_rand() % world.enemies.size());
+    }
+    if (next_rand() % 6 == 0) {
+      world.enemies.push_back({next_enemy_id++, 800.0f, 100.0f, 30, true});
+    }
+    if (tick == 200) {
+      world.players.pop_back();  // 中途有玩家离开房间
+    }
+    world.SortById();
+    Snapshot* recorded = server_ring.Record(tick);
+    *recorded = world;
+
+    const Snapshot* baseline =
+        server_acked != 0 ? server_ring.Find(server_acked) : nullptr;
+    if (baseline == nullptr) {
+      // 全量快照走 TCP，必达，并直接成为基线
+      client_known.push_back(world);
+      server_acked = tick;
+      ++full_resyncs;
+      continue;
+    }
+    auto delta = MakeDelta(*baseline, world);
+    if (quantize != nullptr) {
+      game_manager_snapshot::Quantize(*baseline, *quantize, &delta);
+    }
+    if (lost()) {
+      continue;
+    }
+    const Snapshot* client_base = nullptr;
+    for (const auto& known : client_known) {
+      if (known.tick == delta.baseline_tick()) {
+        client_base = &known;
+      }
+    }
+    Expect(client_base != nullptr,
+           "客户端应持有基线 tick=" + std::to_string(delta.baseline_tick()));
+    Snapshot restored;
+    game_manager_snapshot::Apply(*client_base, delta, &restored);
+    // 定点编码以相对差值传输，误差不随链路累积
+    Expect(quantize != nullptr ? NearState(restored, world, *quantize)
+                               : SameState(restored, world),
+           "还原结果与服务器不一致 tick=" + std::to_string(tick));
+    ++applied;
+    client_known.push_back(std::move(restored));
+    if (client_known.size() > 32) {
+      client_known.erase(client_known.begin());
+    }
+    if (!lost()) {
+      server_acked = tick;
+    }
+  }
+
+  Expect(applied > 300, "有效增量过少: " + std::to_string(applied));
+  Expect(full_resyncs < 20,
+         "全量重同步过多: " + std::to_string(full_resyncs));
+}
+
+void TestLossyConvergence() { RunLossyConvergence(nullptr); }
+
+void TestQuantizedLossyConvergence() {
+  const QuantizeParams params;
+  RunLossyConvergence(&params);
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"ring_record_and_find", TestRingRecordAndFind},
+      {"diff_apply_round_trip", TestDiffApplyRoundTrip},
+      {"removed_player", TestRemovedPlayer},
+      {"unchanged_is_empty", TestUnchangedIsEmpty},
+      {"lossy_convergence", TestLossyConvergence},
+      {"quantize_helpers", TestQuantizeHelpers},
+      {"quantized_round_trip", TestQuantizedRoundTrip},
+      {"quantized_lossy_convergence", TestQuantizedLossyConvergence},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "snapshot_delta_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "snapshot_delta_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
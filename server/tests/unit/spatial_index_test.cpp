@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_spatial.hpp"
+
+namespace {
+using game_manager_spatial::SpatialHit;
+using game_manager_spatial::SpatialIndex;
+
+struct Point {
+  uint32_t id = 0;
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+std::vector<Point> BuildPoints(std::size_t count, float width, float height,
+                               uint32_t seed) {
+  std::vector<Point> points;
+  points.reserve(count);
+  uint32_t rng = seed;
+  auto next_unit = [&rng]() {
+    rng = rng * 1664525u + 1013904223u;
+    return static_cast<float>(rng >> 8) / static_cast<float>(1u << 24);
+  };
+  for (std::size_t i = 0; i < count; ++i) {
+    points.push_back({static_cast<uint32_t>(i + 1), next_unit() * width,
+                      next_unit() * height});
+  }
+  return points;
+}
+
+// 暴力排序作为对照：按距离升序，等距按 id
+std::vector<SpatialHit> BruteForce(const std::vector<Point>& points, float x,
+                                   float y) {
+  std::vector<SpatialHit> hits;
+  hits.reserve(points.size());
+  for (const auto& p : points) {
+    const float dx = p.x - x;
+    const float dy = p.y - y;
+    hits.push_back({p.id, dx * dx + dy * dy});
+  }
+  std::sort(hits.begin(), hits.end(),
+            [](const SpatialHit& a, const SpatialHit& b) {
+              return a.dist_sq < b.dist_sq ||
+                     (a.dist_sq == b.dist_sq && a.id < b.id);
+            });
+  return hits;
+}
+
+void TestNearestAndKNearestMatchBruteForce() {
+  const float width = 2000.0f;
+  const float height = 1200.0f;
+  for (const std::size_t count : {5u, 40u, 2000u}) {
+    const auto points = BuildPoints(count, width, height, 7u + count);
+    SpatialIndex index;
+    index.Reset(width, height, 100.0f);
+    for (const auto& p : points) {
+      index.Insert(p.id, p.x, p.y);
+    }
+    index.Build();
+    Expect(index.Size() == count, "索引条目数应与插入数一致");
+
+    const auto queries = BuildPoints(64, width + 400.0f, height + 400.0f, 99u);
+    std::vector<SpatialHit> knn;
+    for (const auto& q : queries) {
+      // 查询点可能落在地图外（-200 偏移），覆盖边界 clamp 的情况
+      const float qx = q.x - 200.0f;
+      const float qy = q.y - 200.0f;
+      const auto expected = BruteForce(points, qx, qy);
+
+      SpatialHit hit;
+      Expect(index.Nearest(qx, qy, &hit), "非空索引应能找到最近点");
+      Expect(hit.id == expected.front().id, "最近点应与暴力结果一致");
+
+      const std::size_t k = std::min<std::size_t>(8, count);
+      Expect(index.KNearest(qx, qy, 8, &knn) == k, "k 近邻个数不正确");
+      for (std::size_t i = 0; i < k; ++i) {
+        Expect(knn[i].id == expected[i].id, "k 近邻顺序应与暴力结果一致");
+      }
+    }
+  }
+}
+
+void TestRebuildReusesIndexAndHandlesEmpty() {
+  SpatialIndex index;
+  index.Reset(1280.0f, 720.0f, 100.0f);
+  index.Build();
+  SpatialHit hit;
+  Expect(!index.Nearest(10.0f, 10.0f, &hit), "空索引不应返回结果");
+
+  // 等距时取 id 较小者，与插入顺序无关
+  index.Reset(1280.0f, 720.0f, 100.0f);
+  index.Insert(9, 300.0f, 200.0f);
+  index.Insert(4, 100.0f, 200.0f);
+  index.Build();
+  Expect(index.Nearest(200.0f, 200.0f, &hit) && hit.id == 4,
+         "等距时应返回 id 较小者");
+}
+
+void TestQueryRectMatchesBruteForce() {
+  const float width = 2000.0f;
+  const float height = 1200.0f;
+  auto points = BuildPoints(1500, width, height, 31u);
+  // 地图外的点落在边缘格，矩形越界时仍应命中
+  points.push_back({9001, -50.0f, 600.0f});
+  points.push_back({9002, 2100.0f, 1300.0f});
+  SpatialIndex index;
+  index.Reset(width, height, 100.0f);
+  for (const auto& p : points) {
+    index.Insert(p.id, p.x, p.y);
+  }
+  index.Build();
+
+  const auto corners = BuildPoints(64, width + 400.0f, height + 400.0f, 5u);
+  std::vector<uint32_t> got;
+  std::vector<uint32_t> expected;
+  for (std::size_t i = 0; i + 1 < corners.size(); i += 2) {
+    const float min_x = std::min(corners[i].x, corners[i + 1].x) - 200.0f;
+    const float max_x = std::max(corners[i].x, corners[i + 1].x) - 200.0f;
+    const float min_y = std::min(corners[i].y, corners[i + 1].y) - 200.0f;
+    const float max_y = std::max(corners[i].y, corners[i + 1].y) - 200.0f;
+    expected.clear();
+    for (const auto& p : points) {
+      if (p.x >= min_x && p.x <= max_x && p.y >= min_y && p.y <= max_y) {
+        expected.push_back(p.id);
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+    Expect(index.QueryRect(min_x, min_y, max_x, max_y, &got) ==
+                   expected.size() &&
+               got == expected,
+           "矩形查询结果应与暴力结果一致");
+  }
+
+  Expect(index.QueryRect(-100.0f, 500.0f, 0.0f, 700.0f, &got) == 1 &&
+             got.front() == 9001,
+         "地图外的点应能被越界矩形命中");
+  Expect(index.QueryRect(10.0f, 10.0f, 5.0f, 20.0f, &got) == 0,
+         "空矩形不应返回结果");
+}
+
+void TestMortonCodeInterleavesBits() {
+  using game_manager_spatial::MortonCode;
+  Expect(MortonCode(0, 0) == 0, "原点的 Morton 键应为 0");
+  Expect(MortonCode(1, 0) == 1 && MortonCode(0, 1) == 2 &&
+             MortonCode(1, 1) == 3,
+         "x 应占偶数位、y 占奇数位");
+  Expect(MortonCode(0xffff, 0xffff) == 0xffffffffu, "16 位坐标应填满 32 位");
+  // 2x2 块内的 Z 序：(0,0) (1,0) (0,1) (1,1) 先于下一块
+  Expect(MortonCode(1, 1) < MortonCode(2, 0), "Z 序块顺序不正确");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"nearest_and_knearest_match_brute_force",
+       TestNearestAndKNearestMatchBruteForce},
+      {"rebuild_reuses_index_and_handles_empty",
+       TestRebuildReusesIndexAndHandlesEmpty},
+      {"query_rect_matches_brute_force", TestQueryRectMatchesBruteForce},
+      {"morton_code_interleaves_bits", TestMortonCodeInterleavesBits},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "spatial_index_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "spatial_index_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}
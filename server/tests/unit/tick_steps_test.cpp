@@ -0,0 +1,156 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internal/game_manager_tick_steps.hpp"
+
+namespace {
+using game_manager_tick_steps::ComputeTickSteps;
+using game_manager_tick_steps::StepParams;
+using game_manager_tick_steps::SteadyDuration;
+using std::chrono::microseconds;
+
+[[noreturn]] void Fail(const std::string& msg) {
+  throw std::runtime_error(msg);
+}
+
+void Expect(bool cond, const std::string& msg) {
+  if (!cond) {
+    Fail(msg);
+  }
+}
+
+// 20ms 一步，便于用整数微秒构造墙钟间隔
+StepParams FixedParams() {
+  StepParams params;
+  params.tick_interval_seconds = 0.02;
+  params.max_substeps = 4;
+  return params;
+}
+
+SteadyDuration Us(int64_t us) {
+  return std::chrono::duration_cast<SteadyDuration>(microseconds(us));
+}
+
+void TestSteadyWakeupsAdvanceOneStep() {
+  const auto params = FixedParams();
+  SteadyDuration acc{};
+  for (int i = 0; i < 100; ++i) {
+    const auto result = ComputeTickSteps(params, Us(20'000), &acc);
+    Expect(result.steps == 1 && result.dt_seconds == 0.02,
+           "准点唤醒应每次推进一步");
+  }
+  Expect(acc == SteadyDuration::zero(), "准点唤醒不应累积误差");
+}
+
+void TestEarlyWakeBorrowsOneStep() {
+  const auto params = FixedParams();
+  SteadyDuration acc{};
+  // 早 2ms（不足一步的 1/8 = 2.5ms）：预支一步，差额记为负累积
+  auto result = ComputeTickSteps(params, Us(18'000), &acc);
+  Expect(result.steps == 1 && acc == -Us(2'000), "提前 1/8 以内应预支一步");
+  // 下一次晚 2ms 补回，正好一步
+  result = ComputeTickSteps(params, Us(22'000), &acc);
+  Expect(result.steps == 1 && acc == SteadyDuration::zero(),
+         "预支后下一次应恰好补平");
+}
+
+void TestZeroStepWhenTooEarly() {
+  const auto params = FixedParams();
+  SteadyDuration acc{};
+  // 早 5ms 超过 1/8：本次不推进（调用方按 paused_only 处理），时间留在累积里
+  auto result = ComputeTickSteps(params, Us(15'000), &acc);
+  Expect(result.steps == 0, "不足一步且超出预支范围应返回 0 步");
+  Expect(acc == Us(15'000), "0 步时累积时间应保留");
+  result = ComputeTickSteps(params, Us(5'000), &acc);
+  Expect(result.steps == 1 && acc == SteadyDuration::zero(),
+         "累积满一步后应推进");
+  // 负的墙钟间隔（时钟异常）按 0 处理
+  result = ComputeTickSteps(params, -Us(50'000), &acc);
+  Expect(result.steps == 0 && acc == SteadyDuration::zero(),
+         "负间隔不应推进也不应扣减累积");
+}
+
+void TestCatchUpAfterStall() {
+  const auto params = FixedParams();
+  SteadyDuration acc{};
+  // 卡顿 65ms：补跑 3 步，余下 5ms 留到下次
+  auto result = ComputeTickSteps(params, Us(65'000), &acc);
+  Expect(result.steps == 3 && acc == Us(5'000), "卡顿后应按累积时间补跑");
+  result = ComputeTickSteps(params, Us(15'000), &acc);
+  Expect(result.steps == 1 && acc == SteadyDuration::zero(),
+         "余量应在下一次唤醒中用掉");
+}
+
+void TestClampDropsBacklog() {
+  const auto params = FixedParams();
+  SteadyDuration acc{};
+  // 卡顿 1s = 50 步，超过上限 4：只跑 4 步并丢弃积压，不做追赶
+  auto result = ComputeTickSteps(params, Us(1'000'000), &acc);
+  Expect(result.steps == params.max_substeps, "积压超过上限应限制步数");
+  Expect(acc == SteadyDuration::zero(), "超过上限时应丢弃积压");
+  result = ComputeTickSteps(params, Us(20'000), &acc);
+  Expect(result.steps == 1, "丢弃积压后应恢复每次一步");
+  // 恰好等于上限时不丢弃
+  result = ComputeTickSteps(params, Us(80'000), &acc);
+  Expect(result.steps == 4 && acc == SteadyDuration::zero(),
+         "恰好等于上限时应完整推进");
+}
+
+void TestVariableAndReplayModes() {
+  StepParams variable = FixedParams();
+  variable.max_substeps = 0;
+  variable.max_delta_seconds = 0.1;
+  SteadyDuration acc{};
+  auto result = ComputeTickSteps(variable, Us(33'000), &acc);
+  Expect(result.steps == 1 && result.dt_seconds > 0.0329 &&
+             result.dt_seconds < 0.0331,
+         "变步长应以实际间隔作为 dt");
+  result = ComputeTickSteps(variable, Us(500'000), &acc);
+  Expect(result.steps == 1 && result.dt_seconds == 0.1,
+         "变步长 dt 应 clamp 到上限");
+  result = ComputeTickSteps(variable, SteadyDuration::zero(), &acc);
+  Expect(result.steps == 1 && result.dt_seconds == 0.02,
+         "间隔为 0 时应退回 tick 间隔");
+  Expect(acc == SteadyDuration::zero(), "变步长不应使用累积");
+
+  StepParams replay = FixedParams();
+  replay.deterministic_replay = true;
+  result = ComputeTickSteps(replay, Us(1'000'000), &acc);
+  Expect(result.steps == 1 && result.dt_seconds == 0.02 &&
+             acc == SteadyDuration::zero(),
+         "回放模式应固定推进一步");
+}
+
+void RunAll() {
+  const std::vector<std::pair<std::string, std::function<void()>>> tests = {
+      {"steady_wakeups_advance_one_step", TestSteadyWakeupsAdvanceOneStep},
+      {"early_wake_borrows_one_step", TestEarlyWakeBorrowsOneStep},
+      {"zero_step_when_too_early", TestZeroStepWhenTooEarly},
+      {"catch_up_after_stall", TestCatchUpAfterStall},
+      {"clamp_drops_backlog", TestClampDropsBacklog},
+      {"variable_and_replay_modes", TestVariableAndReplayModes},
+  };
+
+  for (const auto& [name, fn] : tests) {
+    fn();
+    std::cout << "[PASS] " << name << "\n";
+  }
+}
+}  // namespace
+
+int main() {
+  try {
+    RunAll();
+    std::cout << "tick_steps_test: PASS\n";
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "tick_steps_test: FAIL: " << ex.what() << "\n";
+    return 1;
+  }
+}